@@ -1,136 +1,276 @@
-
 /*
- * Just a very simple dynamic array implementation. No bells or whistles.
- * Do not expect this to have anywhere near the same performance as std::vector
+ * A simple dynamic array implementation.
+ * Storage grows geometrically, so appending elements takes amortized
+ * constant time. Elements are constructed in place within uninitialized
+ * memory and are moved, rather than copied, whenever the array reallocates.
+ * Trivially copyable elements are copied in blocks using memcpy/memmove.
+ * Memory is reserved through 'alloc_t' (see utils/allocator.h).
  */
 
 #ifndef __HL_DYNAMIC_ARRAY_H__
 #define __HL_DYNAMIC_ARRAY_H__
 
+#include <new>
+#include <utility>
+#include "../utils/allocator.h"
 #include "../utils/assert.h"
+#include "../utils/copy.h"
 
 namespace hamLibs {
 namespace containers {
 
-template <typename type>
+template <typename type, typename alloc_t = utils::heapAllocator>
 class array {
 	private:
+		alloc_t allocator;
 		type* Array;
 		int Size;
+		int Capacity;
+
+		type*			allocate	(int numItems);
+		void			deallocate	(type* items, int numItems);
+		void			destroy		(int first, int last);
+		void			reallocate	(int newCapacity);
+		void			grow		(int minCapacity);
+		template <typename... args_t>
+		HL_NOINLINE type&	emplaceRealloc	(args_t&&... args);
 
 	public:
+		typedef type*		iterator;
+		typedef const type*	constIterator;
+
 		array				();
-		array				(int numItems);
-		array				(const type& data);
-		array				(const type& data, int numCopies);
+		explicit array		(const alloc_t& a);
+		array				(int numItems, const alloc_t& a = alloc_t());
+		array				(const type& data, const alloc_t& a = alloc_t());
+		array				(const type& data, int numCopies, const alloc_t& a = alloc_t());
 		array				(const array& copy);
+		array				(array&& moved);
 		~array				();
 
 		//operators
 		array&	operator =	(const array& input);
+		array&	operator =	(array&& input);
 		array&	operator +=	(const array& input);
 		array	operator +	(const array& input) const;
 		bool		operator ==	(const array& compare) const;
 		bool		operator !=	(const array& compare) const;
 		type&		operator []	(int);
-		type		operator []	(int) const;
+		const type&	operator []	(int) const;
 
 		//deletion
 		void		popFront	();
 		void		popBack		();
 		void		pop			(int index);
+		void		erase		(int index);
+		void		erase		(int first, int last);
 
 		//insertion
 		void		pushFront	(const type& data);
+		void		pushFront	(type&& data);
 		void		pushBack	(const type& data);
+		void		pushBack	(type&& data);
 		void		push		(int index, const type& data);
+		void		push		(int index, type&& data);
 		void		pushAfter	(int index, const type& data);
+		void		pushAfter	(int index, type&& data);
+		template <typename... args_t>
+		type&		emplaceBack	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplaceFront	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplace		(int index, args_t&&... args);	//construct an element at 'index', shifting later elements up
 
 		//traversal
 		type&		front		();
 		type&		back		();
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
 
 		//miscellaneous
 		static void	copy		(array& dest, const array& source);
 		static void	append		(array& dest, const array& source);
 		void		resize		(int newSize);
+		void		reserve		(int numItems);
+		void		shrinkToFit	();
 		void		clear		();
 		bool		empty		() const;
 		int	size		() const;
+		int	capacity	() const;
 		type*		data		() const;
+		alloc_t&	getAllocator	();
 };
 
 //---------------------------------------------------------------------
-//			[Con/De]struction
+//			Storage
 //---------------------------------------------------------------------
-template <typename type>
-array<type>::array() {
-	Size = 0;
-	Array = new type[0];
+template <typename type, typename alloc_t>
+type* array<type, alloc_t>::allocate(int numItems) {
+	return utils::allocateItems<type>(allocator, (numItems > 0) ? numItems : 0);
 }
 
-template <typename type>
-array<type>::array(int numItems) {
-	Size = numItems;
-	Array = new type[numItems];
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::deallocate(type* items, int numItems) {
+	utils::deallocateItems(allocator, items, numItems);
 }
 
-template <typename type>
-array<type>::array(const array& copy) {
-	Array = new type [copy.Size];
-	Size = 0;
-	while (Size != copy.Size) {
-		Array[Size] = copy.Array[Size];
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::destroy(int first, int last) {
+	while (first < last) {
+		Array[first].~type();
+		++first;
+	}
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::reallocate(int newCapacity) {
+	type* temp = allocate(newCapacity);
+	utils::relocateItems(temp, Array, Size);
+	deallocate(Array, Capacity);
+	Array = temp;
+	Capacity = newCapacity;
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::grow(int minCapacity) {
+	//double the capacity so that appending takes amortized constant time
+	int newCapacity = (Capacity) ? Capacity*2 : 4;
+	if (newCapacity < minCapacity) {
+		newCapacity = minCapacity;
+	}
+	reallocate(newCapacity);
+}
+
+//---------------------------------------------------------------------
+//			[Con/De]struction
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+array<type, alloc_t>::array() :
+	allocator(),
+	Array(nullptr),
+	Size(0),
+	Capacity(0)
+{}
+
+template <typename type, typename alloc_t>
+array<type, alloc_t>::array(const alloc_t& a) :
+	allocator(a),
+	Array(nullptr),
+	Size(0),
+	Capacity(0)
+{}
+
+template <typename type, typename alloc_t>
+array<type, alloc_t>::array(int numItems, const alloc_t& a) :
+	allocator(a),
+	Array(allocate(numItems)),
+	Size(0),
+	Capacity((numItems > 0) ? numItems : 0)
+{
+	while (Size < numItems) {
+		new(Array+Size) type();
 		++Size;
 	}
 }
 
-template <typename type>
-array<type>::array(const type& data) {
-	Array = new type[1];
-	Array[0] = data;
-	Size = 1;
+template <typename type, typename alloc_t>
+array<type, alloc_t>::array(const array& copy) :
+	allocator(copy.allocator),
+	Array(allocate(copy.Size)),
+	Size(copy.Size),
+	Capacity(copy.Size)
+{
+	utils::constructItems(Array, copy.Array, Size);
 }
 
-template <typename type>
-array<type>::array(const type& data, int numCopies) {
-	Array = new type[numCopies];
-	Size = 0;
+template <typename type, typename alloc_t>
+array<type, alloc_t>::array(array&& moved) :
+	allocator(std::move(moved.allocator)),
+	Array(moved.Array),
+	Size(moved.Size),
+	Capacity(moved.Capacity)
+{
+	moved.Array = nullptr;
+	moved.Size = 0;
+	moved.Capacity = 0;
+}
+
+template <typename type, typename alloc_t>
+array<type, alloc_t>::array(const type& data, const alloc_t& a) :
+	allocator(a),
+	Array(allocate(1)),
+	Size(1),
+	Capacity(1)
+{
+	new(Array) type(data);
+}
+
+template <typename type, typename alloc_t>
+array<type, alloc_t>::array(const type& data, int numCopies, const alloc_t& a) :
+	allocator(a),
+	Array(allocate(numCopies)),
+	Size(0),
+	Capacity((numCopies > 0) ? numCopies : 0)
+{
 	while (Size < numCopies) {
-		Array[Size] = data;
+		new(Array+Size) type(data);
 		++Size;
 	}
 }
 
-template <typename type>
-array<type>::~array() {
-	delete [] Array;
+template <typename type, typename alloc_t>
+array<type, alloc_t>::~array() {
+	destroy(0, Size);
+	deallocate(Array, Capacity);
 }
 
 //---------------------------------------------------------------------
 //			Operators
 //---------------------------------------------------------------------
-template <typename type>
-array<type>& array<type>::operator = (const array& input) {
-	copy(*this, input);
+template <typename type, typename alloc_t>
+array<type, alloc_t>& array<type, alloc_t>::operator = (const array& input) {
+	if (this != &input) {
+		copy(*this, input);
+	}
 	return *this;
 }
 
-template <typename type>
-array<type>& array<type>::operator += (const array& input) {
+template <typename type, typename alloc_t>
+array<type, alloc_t>& array<type, alloc_t>::operator = (array&& input) {
+	if (this != &input) {
+		//the allocator moves along with the memory it reserved
+		destroy(0, Size);
+		deallocate(Array, Capacity);
+		allocator = std::move(input.allocator);
+		Array = input.Array;
+		Size = input.Size;
+		Capacity = input.Capacity;
+		input.Array = nullptr;
+		input.Size = 0;
+		input.Capacity = 0;
+	}
+	return *this;
+}
+
+template <typename type, typename alloc_t>
+array<type, alloc_t>& array<type, alloc_t>::operator += (const array& input) {
 	append(*this, input);
 	return *this;
 }
 
-template <typename type>
-array<type> array<type>::operator + (const array& input) const {
-	array<type> temp(*this);
+template <typename type, typename alloc_t>
+array<type, alloc_t> array<type, alloc_t>::operator + (const array& input) const {
+	array<type, alloc_t> temp(allocator);
+	temp.reserve(Size + input.Size);
+	append(temp, *this);
 	append(temp, input);
 	return temp;
 }
 
-template <typename type>
-bool array<type>::operator == (const array& compare) const {
+template <typename type, typename alloc_t>
+bool array<type, alloc_t>::operator == (const array& compare) const {
 	if (Size != compare.Size) return false;
 	int iter = 0;
 	while (iter < Size) {
@@ -141,8 +281,8 @@ bool array<type>::operator == (const array& compare) const {
 	return true;
 }
 
-template <typename type>
-bool array<type>::operator != (const array& compare) const {
+template <typename type, typename alloc_t>
+bool array<type, alloc_t>::operator != (const array& compare) const {
 	if (Size != compare.Size) return true;
 	int iter = 0;
 	while (iter < Size) {
@@ -153,14 +293,14 @@ bool array<type>::operator != (const array& compare) const {
 	return false;
 }
 
-template <typename type>
-type& array<type>::operator [] (int index) {
+template <typename type, typename alloc_t>
+type& array<type, alloc_t>::operator [] (int index) {
 	HL_ASSERT(index >= 0);
 	return Array[index];
 }
 
-template <typename type>
-type array<type>::operator [] (int index) const {
+template <typename type, typename alloc_t>
+const type& array<type, alloc_t>::operator [] (int index) const {
 	HL_ASSERT(index >= 0);
 	return Array[index];
 }
@@ -168,203 +308,266 @@ type array<type>::operator [] (int index) const {
 //---------------------------------------------------------------------
 //			Deletion
 //---------------------------------------------------------------------
-template <typename type>
-void array<type>::popFront() {
-	if (!Size) return;
-	int i = 0;
-	--Size;
-	type* temp = new type[Size];
-	while (i < Size) {
-		temp[i] = Array[i+1];
-		++i;
-	}
-	delete [] Array;
-	Array = temp;
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::popFront() {
+	erase(0);
 }
 
-template <typename type>
-void array<type>::popBack() {
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::popBack() {
 	if (!Size) return;
 	--Size;
-	int i = 0;
-	type* temp = new type[Size];
-	while (i < Size) {
-		temp[i] = Array[i];
-		++i;
-	}
-	delete [] Array;
-	Array = temp;
+	Array[Size].~type();
 }
 
-template <typename type>
-void array<type>::pop(int index) {
-	if (Size == 0 || index >= Size) return;
-	
-	--Size;
-	int i = 0;
-	int j = 0;
-	type* temp = new type[Size];
-	while (i < Size) {
-		temp[i] = (i != index) ? Array[j] : Array[++j];
-		++i; ++j;
-	}
-	delete [] Array;
-	Array = temp;
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::pop(int index) {
+	erase(index);
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::erase(int index) {
+	if (index < 0 || index >= Size) return;
+	erase(index, index+1);
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::erase(int first, int last) {
+	//remove the elements in [first, last) by shifting the remainder down
+	if (first < 0) first = 0;
+	if (last > Size) last = Size;
+	if (first >= last) return;
+
+	utils::moveItems(Array+first, Array+last, Size-last);
+	destroy(Size-(last-first), Size);
+	Size -= last-first;
 }
 
 //---------------------------------------------------------------------
 //			Insertion
 //---------------------------------------------------------------------
-template <typename type>
-void array<type>::pushFront(const type& data) {
-	++Size;
-	type* temp = new type[Size];
-	temp[0] = data;
-	int i = 1;
-	while (i < Size) {
-		temp[i] = Array[i-1];
-		++i;
-	}
-	delete [] Array;
-	Array = temp;
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::pushFront(const type& data) {
+	emplace(0, data);
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::pushFront(type&& data) {
+	emplace(0, std::move(data));
 }
 
-template <typename type>
-void array<type>::pushBack(const type& data) {
-	type* temp = new type[Size+1];
-	int i = 0;
-	while (i < Size) {
-		temp[i] = Array[i];
-		++i;
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& array<type, alloc_t>::emplaceFront(args_t&&... args) {
+	return emplace(0, std::forward<args_t>(args)...);
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::pushBack(const type& data) {
+	emplaceBack(data);
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::pushBack(type&& data) {
+	emplaceBack(std::move(data));
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& array<type, alloc_t>::emplaceBack(args_t&&... args) {
+	const int index = Size;
+	if (index == Capacity) {
+		return emplaceRealloc(std::forward<args_t>(args)...);
 	}
-	temp[Size] = data;
-	++Size;
-	delete [] Array;
+	type* const item = new(Array+index) type(std::forward<args_t>(args)...);
+	Size = index+1;
+	return *item;
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& array<type, alloc_t>::emplaceRealloc(args_t&&... args) {
+	//construct the new element first in case the arguments refer to an
+	//element of this array
+	const int newCapacity = (Capacity) ? Capacity*2 : 4;
+	type* temp = allocate(newCapacity);
+	new(temp+Size) type(std::forward<args_t>(args)...);
+	utils::relocateItems(temp, Array, Size);
+	deallocate(Array, Capacity);
 	Array = temp;
+	Capacity = newCapacity;
+	return Array[Size++];
 }
 
-template <typename type>
-void array<type>:: push(int index, const type& data) {
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& array<type, alloc_t>::emplace(int index, args_t&&... args) {
 	//Resize if trying to access an out-of-bounds element
+	if (index < 0) index = 0;
 	if (index >= Size) {
-		pushBack(data);
-		return;
+		return emplaceBack(std::forward<args_t>(args)...);
 	}
-	
-	++Size;
-	int i = 0;
-	int j = 0;
-	type* temp = new type[Size];
-	
-	while (i < Size) {
-		if (i != index) {
-			temp[i] = Array[j];
-			++j;
-		}
-		else {
-			temp[i] = data;
-		}
-		++i;
+
+	//construct first in case the arguments refer to an element of this array
+	type temp(std::forward<args_t>(args)...);
+	if (Size == Capacity) {
+		grow(Size+1);
 	}
-	delete [] Array;
-	Array = temp;
+
+	//shift the elements after 'index' up by one
+	utils::insertItem(Array, Size, index, std::move(temp));
+	++Size;
+	return Array[index];
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::push(int index, const type& data) {
+	emplace(index, data);
 }
 
-template <typename type>
-void array<type>::pushAfter(int index, const type& data) {
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::push(int index, type&& data) {
+	emplace(index, std::move(data));
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::pushAfter(int index, const type& data) {
 	push(++index, data);
 }
 
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::pushAfter(int index, type&& data) {
+	push(++index, std::move(data));
+}
+
 //---------------------------------------------------------------------
 //			Traversal
 //---------------------------------------------------------------------
-template <typename type>
-type& array<type>::front() {
+template <typename type, typename alloc_t>
+type& array<type, alloc_t>::front() {
 	return Array[0];
 }
 
-template <typename type>
-type& array<type>::back() {
+template <typename type, typename alloc_t>
+type& array<type, alloc_t>::back() {
 	return Array[Size-1];
 }
 
+template <typename type, typename alloc_t>
+typename array<type, alloc_t>::iterator array<type, alloc_t>::begin() {
+	return data();
+}
+
+template <typename type, typename alloc_t>
+typename array<type, alloc_t>::iterator array<type, alloc_t>::end() {
+	return data() + Size;
+}
+
+template <typename type, typename alloc_t>
+typename array<type, alloc_t>::constIterator array<type, alloc_t>::begin() const {
+	return data();
+}
+
+template <typename type, typename alloc_t>
+typename array<type, alloc_t>::constIterator array<type, alloc_t>::end() const {
+	return data() + Size;
+}
+
 //---------------------------------------------------------------------
 //			Misc
 //---------------------------------------------------------------------
-template <typename type>
-void array<type>::copy(array& dest, const array& source) {
-	delete [] dest.Array;
-	dest.Array = new type[source.Size];
-	
-	int iter = dest.Size = source.Size;
-	while (iter--) {
-		dest.Array[iter] = source.Array[iter];
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::copy(array& dest, const array& source) {
+	if (&dest == &source) return;
+
+	dest.clear();
+	if (dest.Capacity < source.Size) {
+		dest.deallocate(dest.Array, dest.Capacity);
+		dest.Array = dest.allocate(source.Size);
+		dest.Capacity = source.Size;
 	}
+
+	utils::constructItems(dest.Array, source.Array, source.Size);
+	dest.Size = source.Size;
 }
 
-template <typename type>
-void array<type>::append(array& dest, const array& source) {
-	int firstHalf= 0;
-	int secondHalf = source.Size;
-	int newSize = dest.Size + source.Size;
-	type* temp = new type[newSize];
-	
-	while (firstHalf < dest.Size) {
-		temp[firstHalf] = dest.Array[firstHalf];
-		++firstHalf;
-	}
-	firstHalf = 0;
-	while (secondHalf < newSize) {
-		temp[secondHalf] = source.Array[firstHalf];
-		++firstHalf;
-		++secondHalf;
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::append(array& dest, const array& source) {
+	//'source' may be the same array as 'dest'
+	const int numItems = source.Size;
+	if (dest.Capacity < dest.Size + numItems) {
+		dest.grow(dest.Size + numItems);
 	}
-	delete [] dest.Array;
-	dest.Array = temp;
-	dest.Size = newSize;
+
+	utils::constructItems(dest.Array+dest.Size, source.Array, numItems);
+	dest.Size += numItems;
 }
 
-template <typename type>
-void array<type>::resize(int newSize) {
-	//this function may leave uninitialized variables if newSize > Size
-	if (newSize == Size) return;
-	else if (!newSize) {
-		clear();
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::resize(int newSize) {
+	//new elements are default-constructed
+	if (newSize < 0) newSize = 0;
+	if (newSize <= Size) {
+		destroy(newSize, Size);
+		Size = newSize;
 		return;
 	}
-	
-	type* temp = new type[newSize];
-	int iter = (newSize > Size) ? Size : newSize;
-	while (iter--) { //insures only preexisting variables are copied
-		temp[iter] = Array[iter];
+
+	if (newSize > Capacity) {
+		reallocate(newSize);
+	}
+	while (Size < newSize) {
+		new(Array+Size) type();
+		++Size;
+	}
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::reserve(int numItems) {
+	if (numItems > Capacity) {
+		reallocate(numItems);
 	}
-	delete [] Array;
-	Array = temp;
-	Size = newSize;
 }
 
-template <typename type>
-void array<type>::clear() {
-	delete [] Array;
-	Array = new type[0];
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::shrinkToFit() {
+	if (Size < Capacity) {
+		reallocate(Size);
+	}
+}
+
+template <typename type, typename alloc_t>
+void array<type, alloc_t>::clear() {
+	//the allocated storage is kept for reuse, see shrinkToFit()
+	destroy(0, Size);
 	Size = 0;
 }
 
-template <typename type>
-bool array<type>::empty() const {
+template <typename type, typename alloc_t>
+bool array<type, alloc_t>::empty() const {
 	return (Size) ? false : true;
 }
 
-template <typename type>
-int array<type>::size() const {
+template <typename type, typename alloc_t>
+int array<type, alloc_t>::size() const {
 	return Size;
 }
 
-template <typename type>
-type* array<type>::data() const {
+template <typename type, typename alloc_t>
+int array<type, alloc_t>::capacity() const {
+	return Capacity;
+}
+
+template <typename type, typename alloc_t>
+type* array<type, alloc_t>::data() const {
 	return Array;
 }
 
+template <typename type, typename alloc_t>
+alloc_t& array<type, alloc_t>::getAllocator() {
+	return allocator;
+}
+
 } //end containers namespace
 } //end hamLibs namespace
 
@@ -0,0 +1,904 @@
+/*
+ * File:   arttree.h
+ * Author: hammy
+ *
+ * Adaptive Radix Tree (ART). A byte-wise alternative to the bTree.
+ */
+
+#ifndef __HL_ART_TREE_H__
+#define __HL_ART_TREE_H__
+
+#include <utility>
+#include "../defs/preprocessor.h"
+#include "../utils/allocator.h"
+#include "../utils/bits.h"
+
+#ifdef HL_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace hamLibs {
+namespace containers {
+
+/******************************************************************************
+ *  Adaptive Radix Tree Structure Setup
+ *
+ * Keys are decomposed with utils::getByte(), like the bTree, but each level of
+ * the tree consumes a whole byte instead of a single bit. This makes the tree
+ * one eighth as deep as a bTree holding the same keys.
+ *
+ * A node with 256 child pointers would waste most of its memory in sparse
+ * regions of the tree, so each node uses the smallest of four layouts that
+ * can hold its children:
+ *      Node4   - sorted key bytes and children, searched linearly.
+ *      Node16  - sorted key bytes and children, searched with SSE2.
+ *      Node48  - a 256-entry byte index into 48 child slots.
+ *      Node256 - a child pointer for every possible byte.
+ * Nodes are grown as children are pushed and shrunk as they are popped.
+ *
+ * Nodes and values are reserved through 'alloc_t'.
+******************************************************************************/
+template <typename key_t, typename data_t, typename alloc_t = utils::heapAllocator>
+class artTree {
+
+    private:
+        enum art_node_t : unsigned char {
+            ART_NODE_4,
+            ART_NODE_16,
+            ART_NODE_48,
+            ART_NODE_256
+        };
+
+        enum : unsigned {
+            ART_SHRINK_16   = 3,    // Node16 -> Node4
+            ART_SHRINK_48   = 12,   // Node48 -> Node16
+            ART_SHRINK_256  = 40    // Node256 -> Node48
+        };
+
+        struct artNode {
+            data_t*     data        = nullptr;
+            art_node_t  type;
+            unsigned    numChildren = 0;
+
+            explicit artNode( art_node_t t ) : type{t} {}
+        };
+
+        struct artNode4 : artNode {
+            unsigned char   keys[ 4 ];
+            artNode*        children[ 4 ];
+
+            artNode4() : artNode{ART_NODE_4}, keys(), children() {}
+        };
+
+        struct artNode16 : artNode {
+            unsigned char   keys[ 16 ];
+            artNode*        children[ 16 ];
+
+            artNode16() : artNode{ART_NODE_16}, keys(), children() {}
+        };
+
+        struct artNode48 : artNode {
+            unsigned char   childIndex[ 256 ]; // 0 if empty, otherwise slot+1
+            artNode*        children[ 48 ];
+
+            artNode48() : artNode{ART_NODE_48}, childIndex(), children() {}
+        };
+
+        struct artNode256 : artNode {
+            artNode*        children[ 256 ];
+
+            artNode256() : artNode{ART_NODE_256}, children() {}
+        };
+
+    protected:
+        alloc_t         allocator;
+        artNode*        head = nullptr;
+        unsigned        numNodes = 0;
+
+    private:
+        static unsigned getKeyBytes     ( const key_t* k, const unsigned char** outBytes );
+        static unsigned findIndex       ( const unsigned char* keys, unsigned count, unsigned char byte );
+        static artNode** findChild      ( artNode* n, unsigned char byte );
+        static unsigned getDepth        ( const artNode* n );
+
+        artNode**       addChild        ( artNode** ref, unsigned char byte, artNode* child );
+        void            removeChild     ( artNode** ref, unsigned char byte );
+        void            grow            ( artNode** ref );
+        void            shrink          ( artNode** ref );
+        artNode*        copyNode        ( const artNode* n );
+        void            deleteNode      ( artNode* n, bool deleteChildren );
+
+        artNode*        iterate         ( const key_t* k, bool createNodes );
+        bool            popNode         ( artNode** ref, const unsigned char* bytes, unsigned numBytes, unsigned depth );
+
+    public:
+        artTree             ();
+        explicit artTree    ( const alloc_t& );
+        artTree             ( const artTree& );
+        artTree             ( artTree&& );
+
+        ~artTree            () { clear(); }
+
+        artTree&        operator=   ( const artTree& );
+        artTree&        operator=   ( artTree&& );
+
+        // STL-Map behavior
+        data_t&         operator [] ( const key_t& k );
+
+        void            push        ( const key_t& k, const data_t& d );
+        void            push        ( const key_t& k, data_t&& d );
+        template <typename... args_t>
+        data_t&         emplace     ( const key_t& k, args_t&&... args );
+        void            pop         ( const key_t& k );
+        bool            hasData     ( const key_t& k );
+        const data_t*   getData     ( const key_t& k );
+        unsigned        size        () const { return numNodes; }
+        unsigned        depth       () const { return getDepth( head ); }
+        void            clear       ();
+
+        alloc_t&        getAllocator() { return allocator; }
+};
+
+/*
+ * Adaptive Radix Tree -- Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+artTree<key_t, data_t, alloc_t>::artTree() :
+    allocator{},
+    head{nullptr},
+    numNodes{0}
+{}
+
+/*
+ * Adaptive Radix Tree -- Allocator Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+artTree<key_t, data_t, alloc_t>::artTree( const alloc_t& a ) :
+    allocator{ a },
+    head{nullptr},
+    numNodes{0}
+{}
+
+/*
+ * Adaptive Radix Tree -- Copy Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+artTree<key_t, data_t, alloc_t>::artTree( const artTree& at ) :
+    allocator{ at.allocator },
+    head{nullptr},
+    numNodes{ at.numNodes }
+{
+    head = copyNode( at.head );
+}
+
+/*
+ * Adaptive Radix Tree -- Move Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+artTree<key_t, data_t, alloc_t>::artTree( artTree&& at ) :
+    allocator{ at.allocator },
+    head{ at.head },
+    numNodes{ at.numNodes }
+{
+    at.head = nullptr;
+    at.numNodes = 0;
+}
+
+/*
+ * Adaptive Radix Tree -- Copy Operator
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+artTree<key_t, data_t, alloc_t>& artTree<key_t, data_t, alloc_t>::operator =( const artTree& at ) {
+    if ( this != &at ) {
+        clear();
+        head = copyNode( at.head );
+        numNodes = at.numNodes;
+    }
+    return *this;
+}
+
+/*
+ * Adaptive Radix Tree -- Move Operator
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+artTree<key_t, data_t, alloc_t>& artTree<key_t, data_t, alloc_t>::operator =( artTree&& at ) {
+    if ( this != &at ) {
+        clear();
+
+        // the allocator moves along with the nodes it reserved
+        allocator = std::move( at.allocator );
+
+        head = at.head;
+        at.head = nullptr;
+
+        numNodes = at.numNodes;
+        at.numNodes = 0;
+    }
+    return *this;
+}
+
+/*
+ * Adaptive Radix Tree -- Key Decomposition
+ * Returns the number of bytes in a key and a pointer to the first one.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+unsigned artTree<key_t, data_t, alloc_t>::getKeyBytes( const key_t* k, const unsigned char** outBytes ) {
+    unsigned numBytes = 0;
+
+    while ( utils::getByte< key_t >( k, numBytes ) ) {
+        ++numBytes;
+    }
+
+    *outBytes = numBytes
+        ? reinterpret_cast< const unsigned char* >( utils::getByte< key_t >( k, 0 ) )
+        : nullptr;
+
+    return numBytes;
+}
+
+/*
+ * Adaptive Radix Tree -- Sorted Key Search
+ * Returns the index of a byte within a sorted Node4/Node16 key array, or the
+ * number of keys if the byte is not present.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+inline unsigned artTree<key_t, data_t, alloc_t>::findIndex( const unsigned char* keys, unsigned count, unsigned char byte ) {
+#ifdef HL_SIMD_SSE2
+    if ( count > 4 ) {
+        const __m128i cmp = _mm_cmpeq_epi8(
+            _mm_set1_epi8( static_cast< char >( byte ) ),
+            _mm_loadu_si128( reinterpret_cast< const __m128i* >( keys ) )
+        );
+        unsigned mask = static_cast< unsigned >( _mm_movemask_epi8( cmp ) );
+        mask &= (1u << count) - 1;
+
+        if ( !mask ) {
+            return count;
+        }
+
+    #ifdef HL_COMPILER_GNU
+        return static_cast< unsigned >( __builtin_ctz( mask ) );
+    #else
+        unsigned i = 0;
+        while ( !(mask & (1u << i)) ) {
+            ++i;
+        }
+        return i;
+    #endif
+    }
+#endif
+
+    for ( unsigned i = 0; i < count; ++i ) {
+        if ( keys[ i ] == byte ) {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Adaptive Radix Tree -- Child Lookup
+ * Returns the address of the link to a child node, or nullptr if there is no
+ * child at the requested byte.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+typename artTree<key_t, data_t, alloc_t>::artNode** artTree<key_t, data_t, alloc_t>::findChild( artNode* n, unsigned char byte ) {
+    switch ( n->type ) {
+        case ART_NODE_4: {
+            artNode4* n4 = static_cast< artNode4* >( n );
+            const unsigned i = findIndex( n4->keys, n4->numChildren, byte );
+            return (i < n4->numChildren) ? &n4->children[ i ] : nullptr;
+        }
+
+        case ART_NODE_16: {
+            artNode16* n16 = static_cast< artNode16* >( n );
+            const unsigned i = findIndex( n16->keys, n16->numChildren, byte );
+            return (i < n16->numChildren) ? &n16->children[ i ] : nullptr;
+        }
+
+        case ART_NODE_48: {
+            artNode48* n48 = static_cast< artNode48* >( n );
+            const unsigned i = n48->childIndex[ byte ];
+            return i ? &n48->children[ i-1 ] : nullptr;
+        }
+
+        case ART_NODE_256: {
+            artNode256* n256 = static_cast< artNode256* >( n );
+            return n256->children[ byte ] ? &n256->children[ byte ] : nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+/*
+ * Adaptive Radix Tree -- Node Growth
+ * Replace a full node with the next larger node type.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void artTree<key_t, data_t, alloc_t>::grow( artNode** ref ) {
+    artNode* n = *ref;
+    artNode* grown = nullptr;
+
+    switch ( n->type ) {
+        case ART_NODE_4: {
+            artNode4* n4 = static_cast< artNode4* >( n );
+            artNode16* n16 = utils::createItem< artNode16 >( allocator );
+
+            for ( unsigned i = 0; i < n4->numChildren; ++i ) {
+                n16->keys[ i ] = n4->keys[ i ];
+                n16->children[ i ] = n4->children[ i ];
+            }
+            grown = n16;
+            break;
+        }
+
+        case ART_NODE_16: {
+            artNode16* n16 = static_cast< artNode16* >( n );
+            artNode48* n48 = utils::createItem< artNode48 >( allocator );
+
+            for ( unsigned i = 0; i < n16->numChildren; ++i ) {
+                n48->childIndex[ n16->keys[ i ] ] = static_cast< unsigned char >( i+1 );
+                n48->children[ i ] = n16->children[ i ];
+            }
+            grown = n48;
+            break;
+        }
+
+        case ART_NODE_48: {
+            artNode48* n48 = static_cast< artNode48* >( n );
+            artNode256* n256 = utils::createItem< artNode256 >( allocator );
+
+            for ( unsigned i = 0; i < 256; ++i ) {
+                if ( n48->childIndex[ i ] ) {
+                    n256->children[ i ] = n48->children[ n48->childIndex[ i ]-1 ];
+                }
+            }
+            grown = n256;
+            break;
+        }
+
+        case ART_NODE_256:
+            return;
+    }
+
+    grown->data = n->data;
+    grown->numChildren = n->numChildren;
+    deleteNode( n, false );
+    *ref = grown;
+}
+
+/*
+ * Adaptive Radix Tree -- Node Shrinking
+ * Replace a sparse node with the next smaller node type.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void artTree<key_t, data_t, alloc_t>::shrink( artNode** ref ) {
+    artNode* n = *ref;
+    artNode* shrunk = nullptr;
+
+    switch ( n->type ) {
+        case ART_NODE_4:
+            return;
+
+        case ART_NODE_16: {
+            artNode16* n16 = static_cast< artNode16* >( n );
+            artNode4* n4 = utils::createItem< artNode4 >( allocator );
+
+            for ( unsigned i = 0; i < n16->numChildren; ++i ) {
+                n4->keys[ i ] = n16->keys[ i ];
+                n4->children[ i ] = n16->children[ i ];
+            }
+            shrunk = n4;
+            break;
+        }
+
+        case ART_NODE_48: {
+            artNode48* n48 = static_cast< artNode48* >( n );
+            artNode16* n16 = utils::createItem< artNode16 >( allocator );
+            unsigned j = 0;
+
+            for ( unsigned i = 0; i < 256; ++i ) {
+                if ( n48->childIndex[ i ] ) {
+                    n16->keys[ j ] = static_cast< unsigned char >( i );
+                    n16->children[ j ] = n48->children[ n48->childIndex[ i ]-1 ];
+                    ++j;
+                }
+            }
+            shrunk = n16;
+            break;
+        }
+
+        case ART_NODE_256: {
+            artNode256* n256 = static_cast< artNode256* >( n );
+            artNode48* n48 = utils::createItem< artNode48 >( allocator );
+            unsigned j = 0;
+
+            for ( unsigned i = 0; i < 256; ++i ) {
+                if ( n256->children[ i ] ) {
+                    n48->childIndex[ i ] = static_cast< unsigned char >( j+1 );
+                    n48->children[ j ] = n256->children[ i ];
+                    ++j;
+                }
+            }
+            shrunk = n48;
+            break;
+        }
+    }
+
+    shrunk->data = n->data;
+    shrunk->numChildren = n->numChildren;
+    deleteNode( n, false );
+    *ref = shrunk;
+}
+
+/*
+ * Adaptive Radix Tree -- Child Insertion
+ * Link a new child into the node at "ref", growing the node if it's full.
+ * Returns the address of the link to the new child.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+typename artTree<key_t, data_t, alloc_t>::artNode** artTree<key_t, data_t, alloc_t>::addChild( artNode** ref, unsigned char byte, artNode* child ) {
+    artNode* n = *ref;
+
+    if ( (n->type == ART_NODE_4 && n->numChildren == 4)
+    ||   (n->type == ART_NODE_16 && n->numChildren == 16)
+    ||   (n->type == ART_NODE_48 && n->numChildren == 48)
+    ) {
+        grow( ref );
+        n = *ref;
+    }
+
+    ++n->numChildren;
+
+    switch ( n->type ) {
+        case ART_NODE_4:
+        case ART_NODE_16: {
+            unsigned char* keys;
+            artNode** children;
+
+            if ( n->type == ART_NODE_4 ) {
+                keys = static_cast< artNode4* >( n )->keys;
+                children = static_cast< artNode4* >( n )->children;
+            }
+            else {
+                keys = static_cast< artNode16* >( n )->keys;
+                children = static_cast< artNode16* >( n )->children;
+            }
+
+            // keep the keys sorted so they can be traversed in order
+            unsigned i = n->numChildren - 1;
+            while ( i > 0 && keys[ i-1 ] > byte ) {
+                keys[ i ] = keys[ i-1 ];
+                children[ i ] = children[ i-1 ];
+                --i;
+            }
+
+            keys[ i ] = byte;
+            children[ i ] = child;
+            return &children[ i ];
+        }
+
+        case ART_NODE_48: {
+            artNode48* n48 = static_cast< artNode48* >( n );
+            unsigned i = 0;
+
+            while ( n48->children[ i ] ) {
+                ++i;
+            }
+
+            n48->childIndex[ byte ] = static_cast< unsigned char >( i+1 );
+            n48->children[ i ] = child;
+            return &n48->children[ i ];
+        }
+
+        case ART_NODE_256: {
+            artNode256* n256 = static_cast< artNode256* >( n );
+            n256->children[ byte ] = child;
+            return &n256->children[ byte ];
+        }
+    }
+
+    return nullptr;
+}
+
+/*
+ * Adaptive Radix Tree -- Child Removal
+ * Unlink the child at "byte" from the node at "ref", shrinking the node if
+ * it has become sparse. The child itself is not deleted.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void artTree<key_t, data_t, alloc_t>::removeChild( artNode** ref, unsigned char byte ) {
+    artNode* n = *ref;
+
+    switch ( n->type ) {
+        case ART_NODE_4:
+        case ART_NODE_16: {
+            unsigned char* keys;
+            artNode** children;
+
+            if ( n->type == ART_NODE_4 ) {
+                keys = static_cast< artNode4* >( n )->keys;
+                children = static_cast< artNode4* >( n )->children;
+            }
+            else {
+                keys = static_cast< artNode16* >( n )->keys;
+                children = static_cast< artNode16* >( n )->children;
+            }
+
+            unsigned i = findIndex( keys, n->numChildren, byte );
+            if ( i == n->numChildren ) {
+                return;
+            }
+
+            while ( ++i < n->numChildren ) {
+                keys[ i-1 ] = keys[ i ];
+                children[ i-1 ] = children[ i ];
+            }
+
+            --n->numChildren;
+            keys[ n->numChildren ] = 0;
+            children[ n->numChildren ] = nullptr;
+
+            if ( n->type == ART_NODE_16 && n->numChildren <= ART_SHRINK_16 ) {
+                shrink( ref );
+            }
+            break;
+        }
+
+        case ART_NODE_48: {
+            artNode48* n48 = static_cast< artNode48* >( n );
+            const unsigned i = n48->childIndex[ byte ];
+
+            if ( !i ) {
+                return;
+            }
+
+            n48->childIndex[ byte ] = 0;
+            n48->children[ i-1 ] = nullptr;
+            --n48->numChildren;
+
+            if ( n48->numChildren <= ART_SHRINK_48 ) {
+                shrink( ref );
+            }
+            break;
+        }
+
+        case ART_NODE_256: {
+            artNode256* n256 = static_cast< artNode256* >( n );
+            n256->children[ byte ] = nullptr;
+            --n256->numChildren;
+
+            if ( n256->numChildren <= ART_SHRINK_256 ) {
+                shrink( ref );
+            }
+            break;
+        }
+    }
+}
+
+/*
+ * Adaptive Radix Tree -- Deep Copy
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+typename artTree<key_t, data_t, alloc_t>::artNode* artTree<key_t, data_t, alloc_t>::copyNode( const artNode* n ) {
+    if ( !n ) {
+        return nullptr;
+    }
+
+    artNode* ret = nullptr;
+    artNode** children = nullptr;
+    unsigned numSlots = 0;
+
+    switch ( n->type ) {
+        case ART_NODE_4: {
+            artNode4* n4 = utils::createItem< artNode4 >( allocator, *static_cast< const artNode4* >( n ) );
+            children = n4->children;
+            numSlots = 4;
+            ret = n4;
+            break;
+        }
+
+        case ART_NODE_16: {
+            artNode16* n16 = utils::createItem< artNode16 >( allocator, *static_cast< const artNode16* >( n ) );
+            children = n16->children;
+            numSlots = 16;
+            ret = n16;
+            break;
+        }
+
+        case ART_NODE_48: {
+            artNode48* n48 = utils::createItem< artNode48 >( allocator, *static_cast< const artNode48* >( n ) );
+            children = n48->children;
+            numSlots = 48;
+            ret = n48;
+            break;
+        }
+
+        case ART_NODE_256: {
+            artNode256* n256 = utils::createItem< artNode256 >( allocator, *static_cast< const artNode256* >( n ) );
+            children = n256->children;
+            numSlots = 256;
+            ret = n256;
+            break;
+        }
+    }
+
+    ret->data = n->data ? utils::createItem< data_t >( allocator, *n->data ) : nullptr;
+
+    for ( unsigned i = 0; i < numSlots; ++i ) {
+        children[ i ] = copyNode( children[ i ] );
+    }
+
+    return ret;
+}
+
+/*
+ * Adaptive Radix Tree -- Node Deletion
+ * When "deleteChildren" is false, only the node itself is freed. This is used
+ * when a node's contents have been moved into a differently sized node.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void artTree<key_t, data_t, alloc_t>::deleteNode( artNode* n, bool deleteChildren ) {
+    if ( !n ) {
+        return;
+    }
+
+    artNode** children = nullptr;
+    unsigned numSlots = 0;
+
+    switch ( n->type ) {
+        case ART_NODE_4:
+            children = static_cast< artNode4* >( n )->children;
+            numSlots = 4;
+            break;
+        case ART_NODE_16:
+            children = static_cast< artNode16* >( n )->children;
+            numSlots = 16;
+            break;
+        case ART_NODE_48:
+            children = static_cast< artNode48* >( n )->children;
+            numSlots = 48;
+            break;
+        case ART_NODE_256:
+            children = static_cast< artNode256* >( n )->children;
+            numSlots = 256;
+            break;
+    }
+
+    if ( deleteChildren ) {
+        utils::destroyItem( allocator, n->data );
+
+        for ( unsigned i = 0; i < numSlots; ++i ) {
+            deleteNode( children[ i ], true );
+        }
+    }
+
+    switch ( n->type ) {
+        case ART_NODE_4:    utils::destroyItem( allocator, static_cast< artNode4* >( n ) );   break;
+        case ART_NODE_16:   utils::destroyItem( allocator, static_cast< artNode16* >( n ) );  break;
+        case ART_NODE_48:   utils::destroyItem( allocator, static_cast< artNode48* >( n ) );  break;
+        case ART_NODE_256:  utils::destroyItem( allocator, static_cast< artNode256* >( n ) ); break;
+    }
+}
+
+/*
+ * Adaptive Radix Tree -- Depth
+ * The longest chain of nodes between the head and a leaf.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+unsigned artTree<key_t, data_t, alloc_t>::getDepth( const artNode* n ) {
+    if ( !n ) {
+        return 0;
+    }
+
+    unsigned maxDepth = 0;
+
+    for ( unsigned i = 0; i < 256; ++i ) {
+        const artNode* const* child = findChild( const_cast< artNode* >( n ), static_cast< unsigned char >( i ) );
+
+        if ( child ) {
+            const unsigned d = getDepth( *child );
+            maxDepth = HL_MAX( maxDepth, d );
+        }
+    }
+
+    return 1 + maxDepth;
+}
+
+/*
+ * Adaptive Radix Tree -- Element iteration
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+typename artTree<key_t, data_t, alloc_t>::artNode* artTree<key_t, data_t, alloc_t>::iterate( const key_t* k, bool createNodes ) {
+    if ( !head ) {
+        if ( !createNodes ) {
+            return nullptr;
+        }
+        head = utils::createItem< artNode4 >( allocator );
+    }
+
+    const unsigned char* bytes = nullptr;
+    const unsigned numBytes = getKeyBytes( k, &bytes );
+    artNode** ref = &head;
+
+    for ( unsigned i = 0; i < numBytes; ++i ) {
+        artNode** child = findChild( *ref, bytes[ i ] );
+
+        // check to see if a new node needs to be made
+        if ( !child ) {
+            if ( !createNodes ) {
+                return nullptr;
+            }
+
+            child = addChild( ref, bytes[ i ], utils::createItem< artNode4 >( allocator ) );
+        }
+
+        ref = child;
+    }
+
+    return *ref;
+}
+
+/*
+ * Adaptive Radix Tree -- Recursive Removal
+ * Removes the data at a key, then frees any nodes along the key's path which
+ * are left without data or children.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+bool artTree<key_t, data_t, alloc_t>::popNode( artNode** ref, const unsigned char* bytes, unsigned numBytes, unsigned depth ) {
+    artNode* n = *ref;
+
+    if ( depth == numBytes ) {
+        if ( !n->data ) {
+            return false;
+        }
+
+        utils::destroyItem( allocator, n->data );
+        n->data = nullptr;
+    }
+    else {
+        artNode** child = findChild( n, bytes[ depth ] );
+
+        if ( !child || !popNode( child, bytes, numBytes, depth+1 ) ) {
+            return false;
+        }
+
+        if ( !*child ) {
+            removeChild( ref, bytes[ depth ] );
+            n = *ref;
+        }
+    }
+
+    if ( ref != &head && !n->data && !n->numChildren ) {
+        deleteNode( n, false );
+        *ref = nullptr;
+    }
+
+    return true;
+}
+
+/*
+ * Adaptive Radix Tree -- Clear
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void artTree<key_t, data_t, alloc_t>::clear() {
+    deleteNode( head, true );
+
+    head = nullptr;
+    numNodes = 0;
+}
+
+/*
+ * Adaptive Radix Tree -- Array Subscript operators
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+data_t& artTree<key_t, data_t, alloc_t>::operator []( const key_t& k ) {
+    artNode* iter = iterate( &k, true );
+
+    if ( !iter->data ) {
+        iter->data = utils::createItem< data_t >( allocator );
+        ++numNodes;
+    }
+
+    return *iter->data;
+}
+
+/*
+ * Adaptive Radix Tree -- Push
+ * Push a data element to the tree using a key
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void artTree<key_t, data_t, alloc_t>::push( const key_t& k, const data_t& d ) {
+    artNode* iter = iterate( &k, true );
+
+    if ( !iter->data ) {
+        iter->data = utils::createItem< data_t >( allocator, d );
+        ++numNodes;
+    }
+    else {
+        *iter->data = d;
+    }
+}
+
+template <typename key_t, typename data_t, typename alloc_t>
+void artTree<key_t, data_t, alloc_t>::push( const key_t& k, data_t&& d ) {
+    artNode* iter = iterate( &k, true );
+
+    if ( !iter->data ) {
+        iter->data = utils::createItem< data_t >( allocator, std::move( d ) );
+        ++numNodes;
+    }
+    else {
+        *iter->data = std::move( d );
+    }
+}
+
+/*
+ * Adaptive Radix Tree -- Emplace
+ * Construct a data element at a key from a set of arguments. An element
+ * which already lies at the key is replaced.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+template <typename... args_t>
+data_t& artTree<key_t, data_t, alloc_t>::emplace( const key_t& k, args_t&&... args ) {
+    artNode* iter = iterate( &k, true );
+
+    if ( !iter->data ) {
+        iter->data = utils::createItem< data_t >( allocator, std::forward< args_t >( args )... );
+        ++numNodes;
+    }
+    else {
+        // the arguments may refer to the old element, so build its replacement first
+        *iter->data = data_t( std::forward< args_t >( args )... );
+    }
+
+    return *iter->data;
+}
+
+/*
+ * Adaptive Radix Tree -- Pop
+ * Remove whichever element lies at the key
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void artTree<key_t, data_t, alloc_t>::pop( const key_t& k ) {
+    if ( !head ) {
+        return;
+    }
+
+    const unsigned char* bytes = nullptr;
+    const unsigned numBytes = getKeyBytes( &k, &bytes );
+
+    if ( popNode( &head, bytes, numBytes, 0 ) ) {
+        --numNodes;
+    }
+}
+
+/*
+ * Adaptive Radix Tree -- Has Data
+ * Return true if there is a data element at the key
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+bool artTree<key_t, data_t, alloc_t>::hasData( const key_t& k ) {
+    artNode* iter = iterate( &k, false );
+
+    return iter && ( iter->data != nullptr );
+}
+
+/*
+ * Adaptive Radix Tree -- Get Data
+ * Return a pointer to the data that lies at a key
+ * Returns a nullptr if no data exists
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+const data_t* artTree<key_t, data_t, alloc_t>::getData( const key_t& k ) {
+    artNode* iter = iterate( &k, false );
+
+    return iter ? iter->data : nullptr;
+}
+
+} // end containers namespace
+} // end hamLibs namespace
+
+#endif  /* __HL_ART_TREE_H__ */
@@ -8,9 +8,15 @@
 #ifndef __HL_B_TREE_H__
 #define __HL_B_TREE_H__
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <new>
+#include <type_traits>
+#include <utility>
+#include "../defs/preprocessor.h"
 #include "../utils/bits.h"
+#include "../utils/nodePool.h"
 
 namespace hamLibs {
 namespace containers {
@@ -21,137 +27,542 @@ enum bnode_dir : unsigned {
     BNODE_MAX
 };
 
+/**
+ * Binary Tree Node Data
+ * 
+ * Values which are small and trivially copyable are stored directly within
+ * each node. Anything else is allocated separately, from the allocator of the
+ * tree which owns the node, and referenced by pointer.
+ */
+template <
+    typename data_t,
+    bool = std::is_trivially_copyable< data_t >::value && (sizeof( data_t ) <= sizeof( void* ))
+>
+class bTreeData {
+    private:
+        data_t*         pData = nullptr;
+        
+    public:
+        enum : bool { IS_INLINE = false };
+        
+        bool            hasData () const            { return pData != nullptr; }
+        data_t*         get     ()                  { return pData; }
+        const data_t*   get     () const            { return pData; }
+        
+        template <typename alloc_t, typename... args_t>
+        void            create  ( alloc_t& a, args_t&&... args ) { pData = utils::createItem< data_t >( a, std::forward< args_t >( args )... ); }
+        
+        template <typename alloc_t>
+        void            destroy ( alloc_t& a )                  { utils::destroyItem( a, pData ); pData = nullptr; }
+};
+
+template <typename data_t>
+class bTreeData< data_t, true > {
+    private:
+        data_t          value;
+        bool            used = false;
+        
+    public:
+        enum : bool { IS_INLINE = true };
+        
+        bool            hasData () const            { return used; }
+        data_t*         get     ()                  { return used ? &value : nullptr; }
+        const data_t*   get     () const            { return used ? &value : nullptr; }
+        
+        template <typename alloc_t, typename... args_t>
+        void            create  ( alloc_t&, args_t&&... args )  { value = data_t( std::forward< args_t >( args )... ); used = true; }
+        
+        template <typename alloc_t>
+        void            destroy ( alloc_t& )                    { used = false; }
+};
+
+template <typename data_t>
+struct bTreeBranch;
+
 /**
  * Binary Tree Node
+ * 
+ * Nodes are created in pairs (one per branch direction) from a pool owned by
+ * the bTree they belong to. Nodes do not own any memory themselves; their
+ * data and sub-nodes are released by the bTree.
  */
 template <typename data_t>
 class bTreeNode {
     private:
-        template <typename, typename>
+        template <typename, typename, typename>
         friend class bTree;
+        
+        template <typename>
+        friend class bTreeIterator;
+        
+        template <typename, typename>
+        friend class bTreeImage;
     
-        data_t*     data        = nullptr;
-        bTreeNode*  subNodes    = nullptr;
+        bTreeData<data_t>       data        = bTreeData<data_t>();
+        bTreeBranch<data_t>*    subNodes    = nullptr;
         
     public:
+        bTreeNode() {}
+        bTreeNode( const bTreeNode& ) = delete;
+        bTreeNode( bTreeNode&& ) = delete;
         
-        constexpr bTreeNode();
-        bTreeNode( const bTreeNode& btn );
-        bTreeNode( bTreeNode&& btn );
-
-        ~bTreeNode();
+        ~bTreeNode() {}
         
-        bTreeNode& operator=( const bTreeNode& btn );
-        bTreeNode& operator=( bTreeNode&& btn );
+        bTreeNode& operator=( const bTreeNode& ) = delete;
+        bTreeNode& operator=( bTreeNode&& ) = delete;
 };
 
 /**
- * B-Tree Node Constructor
+ * Binary Tree Branch
+ * A pair of nodes, indexed using the "bnode_dir" enumeration.
  */
 template <typename data_t>
-constexpr bTreeNode<data_t>::bTreeNode() {}
+struct bTreeBranch {
+    bTreeNode<data_t> nodes[ BNODE_MAX ];
+};
 
 /**
- * B-Tree Node Copy Constructor
+ * Binary Tree Traversal Stack
+ * 
+ * A growable stack used to walk a tree without recursion. Memory is only
+ * reallocated when the stack grows beyond its largest size so far.
  */
-template <typename data_t>
-bTreeNode<data_t>::bTreeNode( const bTreeNode& btn ) :
-    data{
-        btn.data != nullptr
-            ? new(std::nothrow) data_t(*btn.data)
-            : nullptr
-    },
-    subNodes{nullptr}
+template <typename type>
+class bTreeStack {
+    private:
+        type*       items       = nullptr;
+        unsigned    count       = 0;
+        unsigned    capacity    = 0;
+        
+        void        reserve ( unsigned newCapacity );
+        
+    public:
+        bTreeStack() {}
+        bTreeStack( const bTreeStack& );
+        bTreeStack( bTreeStack&& );
+        ~bTreeStack() { delete [] items; }
+        
+        bTreeStack& operator=( const bTreeStack& );
+        bTreeStack& operator=( bTreeStack&& );
+        
+        const type& operator[]( unsigned i ) const { return items[ i ]; }
+        
+        bool        empty   () const { return count == 0; }
+        unsigned    size    () const { return count; }
+        const type& top     () const { return items[ count-1 ]; }
+        type        pop     () { return items[ --count ]; }
+        void        push    ( const type& item );
+        void        clear   () { count = 0; }
+};
+
+/*
+ * Binary Tree Traversal Stack -- Copy Constructor
+ */
+template <typename type>
+bTreeStack<type>::bTreeStack( const bTreeStack& bts ) {
+    *this = bts;
+}
+
+/*
+ * Binary Tree Traversal Stack -- Move Constructor
+ */
+template <typename type>
+bTreeStack<type>::bTreeStack( bTreeStack&& bts ) :
+    items{ bts.items },
+    count{ bts.count },
+    capacity{ bts.capacity }
 {
-    if (btn.subNodes != nullptr) {
-        subNodes = new(std::nothrow) bTreeNode[ BNODE_MAX ];
-        subNodes[ BNODE_LEFT ] = btn.subNodes[ BNODE_LEFT ];
-        subNodes[ BNODE_RIGHT ] = btn.subNodes[ BNODE_RIGHT ];
+    bts.items = nullptr;
+    bts.count = bts.capacity = 0;
+}
+
+/*
+ * Binary Tree Traversal Stack -- Copy Operator
+ * Existing memory is reused if it can hold all of the items being copied.
+ */
+template <typename type>
+bTreeStack<type>& bTreeStack<type>::operator=( const bTreeStack& bts ) {
+    if ( this != &bts ) {
+        count = 0;
+        
+        if ( capacity < bts.count ) {
+            reserve( bts.count );
+        }
+        
+        for ( unsigned i = 0; i < bts.count; ++i ) {
+            items[ i ] = bts.items[ i ];
+        }
+        
+        count = bts.count;
+    }
+    return *this;
+}
+
+/*
+ * Binary Tree Traversal Stack -- Move Operator
+ */
+template <typename type>
+bTreeStack<type>& bTreeStack<type>::operator=( bTreeStack&& bts ) {
+    if ( this != &bts ) {
+        delete [] items;
+        
+        items = bts.items;
+        count = bts.count;
+        capacity = bts.capacity;
+        
+        bts.items = nullptr;
+        bts.count = bts.capacity = 0;
+    }
+    return *this;
+}
+
+/*
+ * Binary Tree Traversal Stack -- Reallocation
+ */
+template <typename type>
+void bTreeStack<type>::reserve( unsigned newCapacity ) {
+    type* temp = new type[ newCapacity ];
+
+    for ( unsigned i = 0; i < count; ++i ) {
+        temp[ i ] = items[ i ];
     }
+
+    delete [] items;
+    items = temp;
+    capacity = newCapacity;
+}
+
+/*
+ * Binary Tree Traversal Stack -- Push
+ */
+template <typename type>
+void bTreeStack<type>::push( const type& item ) {
+    if ( count == capacity ) {
+        reserve( capacity ? capacity * 2 : 64 );
+    }
+    
+    items[ count++ ] = item;
 }
 
 /**
- * B-Tree Node Move Constructor
+ * Binary Tree Iterator
+ * 
+ * Visits each element of a bTree in key order. Keys are ordered by their
+ * bytes (as returned by utils::getByte()), and each byte is ordered from its
+ * most significant bit to its least. This gives a lexicographic ordering of
+ * strings, where a key is always visited before any key which it prefixes.
+ * 
+ * The iterator keeps an explicit stack of every node between the root of the
+ * tree and the current element, so stepping through the tree never recurses
+ * and only touches the heap when the stack grows deeper than it has been
+ * before. An iterator with an empty stack is the end of the tree.
+ * 
+ * Iterators remain valid while elements are popped, as long as the element
+ * they refer to is not the one being removed.
+ * 
+ * Iterators define the standard iterator traits, so they can be passed to the
+ * algorithms in <algorithm>.
  */
 template <typename data_t>
-bTreeNode<data_t>::bTreeNode( bTreeNode&& btn ) :
-    data{ btn.data },
-    subNodes{ btn.subNodes }
-{
-    btn.data = nullptr;
-    btn.subNodes = nullptr;
+class bTreeIterator {
+    private:
+        template <typename, typename, typename>
+        friend class bTree;
+        
+        bTreeNode<data_t>*                  root = nullptr;
+        bTreeStack< bTreeNode<data_t>* >    path;
+        
+        explicit bTreeIterator( bTreeNode<data_t>* r ) : root{r} {}
+        
+        bTreeNode<data_t>*  current     () const { return path.empty() ? nullptr : path.top(); }
+        bool                isRight     ( unsigned level ) const;
+        void                descendLast ();
+        bool                nextNode    ( bool descend );
+        bool                prevNode    ();
+        void                seekNext    ( bool descend );
+        void                seekPrev    ();
+        
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef data_t                          value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef data_t*                         pointer;
+        typedef data_t&                         reference;
+        
+        bTreeIterator() {}
+        bTreeIterator( const bTreeIterator& ) = default;
+        bTreeIterator( bTreeIterator&& ) = default;
+        
+        ~bTreeIterator() {}
+        
+        bTreeIterator&  operator=   ( const bTreeIterator& ) = default;
+        bTreeIterator&  operator=   ( bTreeIterator&& ) = default;
+        
+        data_t&         operator*   () const { return *path.top()->data.get(); }
+        data_t*         operator->  () const { return path.top()->data.get(); }
+        
+        bTreeIterator&  operator++  ()      { seekNext( true ); return *this; }
+        bTreeIterator   operator++  ( int ) { bTreeIterator temp( *this ); seekNext( true ); return temp; }
+        bTreeIterator&  operator--  ()      { seekPrev(); return *this; }
+        bTreeIterator   operator--  ( int ) { bTreeIterator temp( *this ); seekPrev(); return temp; }
+        
+        bool operator== ( const bTreeIterator& i ) const { return current() == i.current(); }
+        bool operator!= ( const bTreeIterator& i ) const { return current() != i.current(); }
+        
+        // Key reconstruction
+        unsigned        keySize     () const;
+        void            getKeyBytes ( unsigned char* outBytes ) const;
+};
+
+/*
+ * Binary Tree Iterator -- Direction Check
+ * Determine if the node at some depth of the path is a right-hand node.
+ */
+template <typename data_t>
+inline bool bTreeIterator<data_t>::isRight( unsigned level ) const {
+    return path[ level ] == &path[ level-1 ]->subNodes->nodes[ BNODE_RIGHT ];
 }
 
-/**
- * B-Tree Node Destructor
+/*
+ * Binary Tree Iterator -- Last Descendant
+ * Move to the last node (in key order) beneath the current node.
  */
 template <typename data_t>
-bTreeNode<data_t>::~bTreeNode() {
-    delete data;
-    data = nullptr;
+void bTreeIterator<data_t>::descendLast() {
+    bTreeNode<data_t>* node = path.top();
     
-    delete [] subNodes;
-    subNodes = nullptr;
+    while ( node->subNodes ) {
+        node = &node->subNodes->nodes[ BNODE_RIGHT ];
+        path.push( node );
+    }
 }
 
-/**
- * B-Tree Node Copy Operator
+/*
+ * Binary Tree Iterator -- Next Node
+ * Move to the next node in key order, whether or not it holds data. Nodes
+ * below the current one are skipped if 'descend' is false. Returns false
+ * when there are no nodes left.
  */
 template <typename data_t>
-bTreeNode<data_t>& bTreeNode<data_t>::operator=( const bTreeNode& btn ) {
-    delete data;
-    if (btn.data) {
-        data = new(std::nothrow) data_t;
-        *data = *btn.data;
+bool bTreeIterator<data_t>::nextNode( bool descend ) {
+    bTreeNode<data_t>* node = path.top();
+    
+    if ( descend && node->subNodes ) {
+        path.push( &node->subNodes->nodes[ BNODE_LEFT ] );
+        return true;
     }
-    else {
-        data = nullptr;
+    
+    // climb until an unvisited right-hand sibling is found
+    while ( path.size() > 1 ) {
+        const bool wasRight = isRight( path.size()-1 );
+        path.pop();
+        
+        if ( !wasRight ) {
+            path.push( &path.top()->subNodes->nodes[ BNODE_RIGHT ] );
+            return true;
+        }
     }
     
-    delete subNodes;
-    if (btn.subNodes) {
-        subNodes = new(std::nothrow) bTreeNode[ BNODE_MAX ];
-        subNodes[ BNODE_LEFT ] = btn.subNodes[ BNODE_LEFT ];
-        subNodes[ BNODE_RIGHT ] = btn.subNodes[ BNODE_RIGHT ];
+    path.clear();
+    return false;
+}
+
+/*
+ * Binary Tree Iterator -- Previous Node
+ * Move to the previous node in key order, whether or not it holds data.
+ * Returns false when there are no nodes left.
+ */
+template <typename data_t>
+bool bTreeIterator<data_t>::prevNode() {
+    if ( path.size() <= 1 ) {
+        path.clear();
+        return false;
     }
-    else {
-        subNodes = nullptr;
+    
+    const bool wasRight = isRight( path.size()-1 );
+    path.pop();
+    
+    // a left-hand node is preceded by its parent
+    if ( wasRight ) {
+        path.push( &path.top()->subNodes->nodes[ BNODE_LEFT ] );
+        descendLast();
     }
+    
+    return true;
 }
 
-/**
- * B-Tree Node Move Operator
+/*
+ * Binary Tree Iterator -- Increment
+ * Move to the next node containing data.
  */
 template <typename data_t>
-bTreeNode<data_t>& bTreeNode<data_t>::operator=( bTreeNode&& btn ) {
-    data = btn.data;
-    btn.data = nullptr;
+void bTreeIterator<data_t>::seekNext( bool descend ) {
+    if ( path.empty() ) {
+        return;
+    }
     
-    subNodes = btn.subNodes;
-    btn.subNodes = nullptr;
+    while ( nextNode( descend ) ) {
+        if ( path.top()->data.hasData() ) {
+            return;
+        }
+        descend = true;
+    }
+}
+
+/*
+ * Binary Tree Iterator -- Decrement
+ * Move to the previous node containing data. Decrementing the end of a tree
+ * moves to its last element.
+ */
+template <typename data_t>
+void bTreeIterator<data_t>::seekPrev() {
+    if ( path.empty() ) {
+        if ( !root ) {
+            return;
+        }
+        
+        path.push( root );
+        descendLast();
+        
+        if ( path.top()->data.hasData() ) {
+            return;
+        }
+    }
+    
+    while ( prevNode() ) {
+        if ( path.top()->data.hasData() ) {
+            return;
+        }
+    }
+}
+
+/*
+ * Binary Tree Iterator -- Key Size
+ * Returns the number of bytes in the key of the current element.
+ */
+template <typename data_t>
+inline unsigned bTreeIterator<data_t>::keySize() const {
+    return path.empty() ? 0 : (path.size()-1) / HL_BITS_PER_BYTE;
+}
+
+/*
+ * Binary Tree Iterator -- Key Reconstruction
+ * Write the bytes of the current element's key into a buffer of at least
+ * keySize() bytes.
+ */
+template <typename data_t>
+void bTreeIterator<data_t>::getKeyBytes( unsigned char* outBytes ) const {
+    const unsigned numBytes = keySize();
+    
+    for ( unsigned i = 0; i < numBytes; ++i ) {
+        unsigned char byte = 0;
+        
+        for ( unsigned bit = 0; bit < HL_BITS_PER_BYTE; ++bit ) {
+            byte = (byte << 1) | (isRight( i*HL_BITS_PER_BYTE + bit + 1 ) ? 1 : 0);
+        }
+        
+        outBytes[ i ] = byte;
+    }
 }
 
+/**
+ * Binary Tree Reverse Iterator
+ * Visits each element of a bTree in the opposite order of a bTreeIterator.
+ */
+template <typename data_t>
+class bTreeReverseIterator {
+    private:
+        template <typename, typename, typename>
+        friend class bTree;
+        
+        bTreeIterator<data_t> iter;
+        
+        explicit bTreeReverseIterator( bTreeIterator<data_t> i ) : iter{ std::move( i ) } {}
+        
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef data_t                          value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef data_t*                         pointer;
+        typedef data_t&                         reference;
+        
+        bTreeReverseIterator() {}
+        
+        data_t&                 operator*   () const { return *iter; }
+        data_t*                 operator->  () const { return iter.operator->(); }
+        
+        bTreeReverseIterator&   operator++  ()      { --iter; return *this; }
+        bTreeReverseIterator    operator++  ( int ) { bTreeReverseIterator temp( *this ); --iter; return temp; }
+        bTreeReverseIterator&   operator--  ()      { ++iter; return *this; }
+        bTreeReverseIterator    operator--  ( int ) { bTreeReverseIterator temp( *this ); ++iter; return temp; }
+        
+        bool operator== ( const bTreeReverseIterator& i ) const { return iter == i.iter; }
+        bool operator!= ( const bTreeReverseIterator& i ) const { return iter != i.iter; }
+        
+        unsigned                keySize     () const { return iter.keySize(); }
+        void                    getKeyBytes ( unsigned char* outBytes ) const { iter.getKeyBytes( outBytes ); }
+        
+        // Retrieve a forward iterator to the same element
+        const bTreeIterator<data_t>& base() const { return iter; }
+};
+
 /******************************************************************************
  *  Binary-Tree Structure Setup
  * 
- * TODO Add iterators
+ * All nodes are allocated from a pool owned by the tree, so building a tree
+ * costs one heap allocation per block of branches rather than one per branch.
+ * Popping an element returns any branches which no longer lead to data back
+ * to the pool for reuse. The pool itself only shrinks when the tree is
+ * compacted with shrinkToFit(), or released in bulk by clear().
+ * 
+ * Elements can be visited in key order using iterators, which are described
+ * above bTreeIterator.
 ******************************************************************************/
-template <typename key_t, typename data_t>
+template <typename key_t, typename data_t, typename alloc_t = utils::heapAllocator>
 class bTree {
-
+    
+    template <typename, typename>
+    friend class bTreeImage;
+    
+    public:
+        enum : unsigned {
+            BATCH_SIZE = 8 // lookups interleaved by findBatch()
+        };
+    
     protected:
-        bTreeNode<data_t>   head = bTreeNode<data_t>();
+        bTreeNode<data_t>   head;
         unsigned            numNodes = 0;
+        // Branches are pooled. Boxed values are allocated separately from the
+        // pool's allocator.
+        typedef utils::nodePool< bTreeBranch<data_t>, 256, alloc_t > pool_t;
+        
+        pool_t              branchPool;
         
     private:
-        bTreeNode<data_t>* iterate( const key_t* k, bool createNodes );
+        // Reused by pop() to avoid reallocating a path for every call
+        bTreeStack< bTreeNode<data_t>* > popPath;
+        
+        bTreeNode<data_t>*      iterate         ( const key_t* k, bool createNodes );
+        bTreeBranch<data_t>*    createBranch    ();
+        void                    prune           ( bTreeStack< bTreeNode<data_t>* >& path );
+        void                    destroyData     ();
+        void                    copyNodes       ( const bTree& );
+        void                    moveNodes       ( bTree&& );
+        bool                    findPath        ( const key_t* k, unsigned maxBits, bTreeStack< bTreeNode<data_t>* >& outPath );
+        
+        static const key_t*     keyAddress      ( const key_t& k ) { return &k; }
+        static const key_t*     keyAddress      ( const key_t* k ) { return k; }
         
     public:
-        constexpr bTree ();
+        typedef bTreeIterator<data_t>           iterator;
+        typedef bTreeReverseIterator<data_t>    reverseIterator;
+        
+        bTree           ();
+        explicit bTree  ( const alloc_t& );
         bTree           ( const bTree& );
         bTree           ( bTree&& );
         
-        ~bTree          () {}
+        ~bTree          () { clear(); }
         
         bTree&          operator=   ( const bTree& );
         bTree&          operator=   ( bTree&& );
@@ -160,72 +571,246 @@ class bTree {
         data_t&         operator [] ( const key_t& k );
         
         void            push        ( const key_t& k, const data_t& d );
+        void            push        ( const key_t& k, data_t&& d );
+        template <typename... args_t>
+        data_t&         emplace     ( const key_t& k, args_t&&... args );
         void            pop         ( const key_t& k );
+        iterator        pop         ( iterator iter );
+        void            pop         ( iterator first, const iterator& last );
         bool            hasData     ( const key_t& k );
         const data_t*   getData     ( const key_t& k );
         unsigned        size        () const { return numNodes; }
+        
+        // Batch operations
+        template <typename pairIter_t>
+        void            bulkLoad    ( pairIter_t begin, pairIter_t end );
+        
+        template <typename keyIter_t>
+        void            findBatch   ( keyIter_t keys, unsigned n, const data_t** outData );
         void            clear       ();
+        void            shrinkToFit ();
+        
+        // Ordered traversal
+        iterator        begin       ();
+        iterator        end         () { return iterator( &head ); }
+        reverseIterator rbegin      () { return reverseIterator( --end() ); }
+        reverseIterator rend        () { return reverseIterator( end() ); }
+        
+        iterator        lowerBound  ( const key_t& k );
+        iterator        upperBound  ( const key_t& k );
+        std::pair< iterator, iterator > prefixRange ( const key_t& k, unsigned numBits = ~0u );
+        
+        // Memory statistics
+        unsigned        numBranches     () const { return branchPool.size(); }
+        unsigned        numAllocations  () const { return branchPool.numAllocations(); }
+        unsigned long   numBytes        () const { return branchPool.numBytes(); }
+        unsigned long   memoryUsage     () const;
+        
+        alloc_t&        getAllocator    () { return branchPool.getAllocator(); }
 };
 
 /*
  * Binary Tree -- Constructor
  */
-template <typename key_t, typename data_t>
-constexpr bTree<key_t, data_t>::bTree() :
+template <typename key_t, typename data_t, typename alloc_t>
+bTree<key_t, data_t, alloc_t>::bTree() :
     head{},
-    numNodes{0}
+    numNodes{0},
+    branchPool{},
+    popPath{}
 {}
 
 /*
- * Binary Tree -- Copy Constructor
+ * Binary Tree -- Allocator Constructor
  */
-template <typename key_t, typename data_t>
-bTree<key_t, data_t>::bTree( const bTree& bt ) :
-    head{ bt.head },
-    numNodes{ bt.numNodes }
+template <typename key_t, typename data_t, typename alloc_t>
+bTree<key_t, data_t, alloc_t>::bTree( const alloc_t& a ) :
+    head{},
+    numNodes{0},
+    branchPool{ a },
+    popPath{}
 {}
 
+/*
+ * Binary Tree -- Copy Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+bTree<key_t, data_t, alloc_t>::bTree( const bTree& bt ) :
+    bTree{ bt.branchPool.getAllocator() }
+{
+    copyNodes( bt );
+}
+
 /*
  * Binary Tree -- Move Constructor
  */
-template <typename key_t, typename data_t>
-bTree<key_t, data_t>::bTree( bTree&& bt ) {
-    head.subNodes = bt.head.subNodes;
-    bt.head.subNodes = nullptr;
-    
-    numNodes = bt.numNodes;
-    bt.numNodes = 0;
+template <typename key_t, typename data_t, typename alloc_t>
+bTree<key_t, data_t, alloc_t>::bTree( bTree&& bt ) :
+    bTree{}
+{
+    moveNodes( std::move( bt ) );
 }
 
 /*
  * Binary Tree -- Copy Operator
  */
-template <typename key_t, typename data_t>
-bTree<key_t, data_t>& bTree<key_t, data_t>::operator =( const bTree& bt ) {
-    head = bt.head;
-    numNodes = bt.numNodes;
+template <typename key_t, typename data_t, typename alloc_t>
+bTree<key_t, data_t, alloc_t>& bTree<key_t, data_t, alloc_t>::operator =( const bTree& bt ) {
+    if ( this != &bt ) {
+        clear();
+        copyNodes( bt );
+    }
     return *this;
 }
 
 /*
  * Binary Tree -- Move Operator
  */
-template <typename key_t, typename data_t>
-bTree<key_t, data_t>& bTree<key_t, data_t>::operator =( bTree&& bt ) {
+template <typename key_t, typename data_t, typename alloc_t>
+bTree<key_t, data_t, alloc_t>& bTree<key_t, data_t, alloc_t>::operator =( bTree&& bt ) {
+    if ( this != &bt ) {
+        clear();
+        moveNodes( std::move( bt ) );
+    }
+    return *this;
+}
+
+/*
+ * Binary Tree -- Branch Creation
+ * Construct a new pair of nodes within the node pool.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+inline bTreeBranch<data_t>* bTree<key_t, data_t, alloc_t>::createBranch() {
+    return new( branchPool.allocate() ) bTreeBranch<data_t>();
+}
+
+/*
+ * Binary Tree -- Pruning
+ * Walk up a path from the bottom, returning every branch whose nodes hold no
+ * data and have no sub-nodes to the node pool. Nodes leading to data are
+ * never removed, so iterators to other elements are not invalidated.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::prune( bTreeStack< bTreeNode<data_t>* >& path ) {
+    while ( path.size() > 1 ) {
+        const bTreeNode<data_t>* node = path.pop();
+        
+        if ( node->data.hasData() || node->subNodes ) {
+            return;
+        }
+        
+        bTreeNode<data_t>* const parent = path.top();
+        bTreeBranch<data_t>* const branch = parent->subNodes;
+        const bTreeNode<data_t>& sibling = branch->nodes[ node == &branch->nodes[ BNODE_LEFT ] ];
+        
+        if ( sibling.data.hasData() || sibling.subNodes ) {
+            return;
+        }
+        
+        branch->~bTreeBranch<data_t>();
+        branchPool.deallocate( branch );
+        parent->subNodes = nullptr;
+    }
+}
+
+/*
+ * Binary Tree -- Data Destruction
+ * Values which are stored inline are trivially destructible and can be
+ * released along with the node pool. Values which were allocated separately
+ * need to be found and deleted individually.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::destroyData() {
+    head.data.destroy( getAllocator() );
+    
+    if ( bTreeData<data_t>::IS_INLINE || !head.subNodes ) {
+        return;
+    }
+    
+    bTreeStack< bTreeBranch<data_t>* > branches;
+    branches.push( head.subNodes );
+    
+    while ( !branches.empty() ) {
+        bTreeBranch<data_t>* branch = branches.pop();
+        
+        for ( unsigned dir = BNODE_LEFT; dir < BNODE_MAX; ++dir ) {
+            bTreeNode<data_t>& node = branch->nodes[ dir ];
+            node.data.destroy( getAllocator() );
+            
+            if ( node.subNodes ) {
+                branches.push( node.subNodes );
+            }
+        }
+    }
+}
+
+/*
+ * Binary Tree -- Deep Copy
+ * Duplicate the nodes of another tree into the node pool of *this.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::copyNodes( const bTree& bt ) {
+    struct branchPair {
+        const bTreeBranch<data_t>*  src;
+        bTreeBranch<data_t>*        dst;
+    };
+    
+    if ( bt.head.data.hasData() ) {
+        head.data.create( getAllocator(), *bt.head.data.get() );
+    }
+    
+    numNodes = bt.numNodes;
+    
+    if ( !bt.head.subNodes ) {
+        return;
+    }
+    
+    bTreeStack< branchPair > branches;
+    head.subNodes = createBranch();
+    branches.push( branchPair{ bt.head.subNodes, head.subNodes } );
+    
+    while ( !branches.empty() ) {
+        const branchPair pair = branches.pop();
+        
+        for ( unsigned dir = BNODE_LEFT; dir < BNODE_MAX; ++dir ) {
+            const bTreeNode<data_t>& src = pair.src->nodes[ dir ];
+            bTreeNode<data_t>& dst = pair.dst->nodes[ dir ];
+            
+            if ( src.data.hasData() ) {
+                dst.data.create( getAllocator(), *src.data.get() );
+            }
+            
+            if ( src.subNodes ) {
+                dst.subNodes = createBranch();
+                branches.push( branchPair{ src.subNodes, dst.subNodes } );
+            }
+        }
+    }
+}
+
+/*
+ * Binary Tree -- Move
+ * Take ownership of the nodes of another tree. *this must be empty.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::moveNodes( bTree&& bt ) {
+    head.data = bt.head.data;
+    bt.head.data = bTreeData<data_t>();
+    
     head.subNodes = bt.head.subNodes;
     bt.head.subNodes = nullptr;
     
     numNodes = bt.numNodes;
     bt.numNodes = 0;
     
-    return *this;
+    branchPool = std::move( bt.branchPool );
 }
 
 /*
  * Binary-Tree -- Element iteration
  */
-template <typename key_t, typename data_t>
-bTreeNode<data_t>* bTree<key_t, data_t>::iterate( const key_t* k, bool createNodes ) {
+template <typename key_t, typename data_t, typename alloc_t>
+bTreeNode<data_t>* bTree<key_t, data_t, alloc_t>::iterate( const key_t* k, bool createNodes ) {
     
     unsigned            bytePos     = 0;
     bTreeNode<data_t>*  bNodeIter   = &head;
@@ -239,7 +824,7 @@ bTreeNode<data_t>* bTree<key_t, data_t>::iterate( const key_t* k, bool createNod
             if ( !bNodeIter->subNodes ) {
                 if ( createNodes ) {
                     // create and initialize the upcoming sub bTreeNode
-                    bNodeIter->subNodes = new bTreeNode<data_t>[ BNODE_MAX ];
+                    bNodeIter->subNodes = createBranch();
                 }
                 else {
                     return nullptr;
@@ -248,83 +833,208 @@ bTreeNode<data_t>* bTree<key_t, data_t>::iterate( const key_t* k, bool createNod
             
             // move to the next bTreeNode
             const int dir = byteIter->get( currBit );
-            bNodeIter = &(bNodeIter->subNodes[ dir ]);
+            bNodeIter = &(bNodeIter->subNodes->nodes[ dir ]);
         }
     }
     
     return bNodeIter;
 }
 
+/*
+ * Binary-Tree -- Key Path
+ * Push each node along the path of a key's first 'maxBits' bits onto a stack.
+ * Returns false if the path ends before all of those bits are used, leaving
+ * the last node found on the top of the stack.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+bool bTree<key_t, data_t, alloc_t>::findPath( const key_t* k, unsigned maxBits, bTreeStack< bTreeNode<data_t>* >& outPath ) {
+    
+    unsigned            bytePos     = 0;
+    bTreeNode<data_t>*  bNodeIter   = &head;
+    const utils::bitMask* byteIter  = nullptr;
+    
+    outPath.clear();
+    outPath.push( bNodeIter );
+    
+    while ( maxBits && (byteIter = hamLibs::utils::getByte< key_t >( k, bytePos++ )) ) {
+        
+        for ( unsigned currBit = HL_BITS_PER_BYTE; currBit-- && maxBits; --maxBits ) {
+            if ( !bNodeIter->subNodes ) {
+                return false;
+            }
+            
+            const int dir = byteIter->get( currBit );
+            bNodeIter = &(bNodeIter->subNodes->nodes[ dir ]);
+            outPath.push( bNodeIter );
+        }
+    }
+    
+    return true;
+}
+
 /*
  * Binary-Tree -- Destructor
  */
-template <typename key_t, typename data_t>
-void bTree<key_t, data_t>::clear() {
-    delete head.data;
-    delete [] head.subNodes;
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::clear() {
+    destroyData();
     
-    head.data = nullptr;
     head.subNodes = nullptr;
+    branchPool.clear();
     numNodes = 0;
 }
 
+/*
+ * Binary-Tree -- Compaction
+ * Rebuild the tree into a new node pool which is only as large as needed.
+ * Branches are laid out in the order of a depth-first walk, so a parent is
+ * usually close to its children in memory. Data is moved rather than copied.
+ * All iterators are invalidated.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::shrinkToFit() {
+    struct branchPair {
+        const bTreeBranch<data_t>*  src;
+        bTreeBranch<data_t>*        dst;
+    };
+    
+    pool_t newPool{ branchPool.getAllocator() };
+    
+    if ( head.subNodes ) {
+        bTreeStack< branchPair > branches;
+        bTreeBranch<data_t>* const root = new( newPool.allocate() ) bTreeBranch<data_t>();
+        
+        branches.push( branchPair{ head.subNodes, root } );
+        head.subNodes = root;
+        
+        while ( !branches.empty() ) {
+            const branchPair pair = branches.pop();
+            
+            for ( unsigned dir = BNODE_MAX; dir--; ) {
+                const bTreeNode<data_t>& src = pair.src->nodes[ dir ];
+                bTreeNode<data_t>& dst = pair.dst->nodes[ dir ];
+                
+                dst.data = src.data;
+                
+                if ( src.subNodes ) {
+                    dst.subNodes = new( newPool.allocate() ) bTreeBranch<data_t>();
+                    branches.push( branchPair{ src.subNodes, dst.subNodes } );
+                }
+            }
+        }
+    }
+    
+    // The old pool still references the moved data, but never destroys it
+    branchPool = std::move( newPool );
+}
+
+/*
+ * Binary-Tree -- Memory Usage
+ * Return the total number of bytes held by the tree, including its node pool
+ * and any data which is not stored within the nodes.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+unsigned long bTree<key_t, data_t, alloc_t>::memoryUsage() const {
+    unsigned long ret = sizeof( *this ) + branchPool.numBytes();
+    
+    if ( !bTreeData<data_t>::IS_INLINE ) {
+        ret += numNodes * sizeof( data_t );
+    }
+    
+    return ret;
+}
+
 /*
  * Binary-Tree -- Array Subscript operators
  */
-template <typename key_t, typename data_t>
-data_t& bTree<key_t, data_t>::operator []( const key_t& k ) {
+template <typename key_t, typename data_t, typename alloc_t>
+data_t& bTree<key_t, data_t, alloc_t>::operator []( const key_t& k ) {
     bTreeNode<data_t>* iter = iterate( &k, true );
     
-    if ( !iter->data ) {
-        iter->data = new data_t();
+    if ( !iter->data.hasData() ) {
+        iter->data.create( getAllocator() );
         ++numNodes;
     }
     
-    return *iter->data;
+    return *iter->data.get();
 }
 
 /*
  * Binary-Tree -- Push
  * Push a data element to the tree using a key
  */
-template <typename key_t, typename data_t>
-void bTree<key_t, data_t>::push( const key_t& k, const data_t& d ) {
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::push( const key_t& k, const data_t& d ) {
+    bTreeNode<data_t>* iter = iterate( &k, true );
+    
+    if ( !iter->data.hasData() ) {
+        iter->data.create( getAllocator(), d );
+        ++numNodes;
+    }
+    else {
+        *iter->data.get() = d;
+    }
+}
+
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::push( const key_t& k, data_t&& d ) {
+    bTreeNode<data_t>* iter = iterate( &k, true );
+    
+    if ( !iter->data.hasData() ) {
+        iter->data.create( getAllocator(), std::move( d ) );
+        ++numNodes;
+    }
+    else {
+        *iter->data.get() = std::move( d );
+    }
+}
+
+/*
+ * Binary-Tree -- Emplace
+ * Construct a data element at a key from a set of arguments. An element
+ * which already lies at the key is replaced.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+template <typename... args_t>
+data_t& bTree<key_t, data_t, alloc_t>::emplace( const key_t& k, args_t&&... args ) {
     bTreeNode<data_t>* iter = iterate( &k, true );
     
-    if ( !iter->data ) {
-        iter->data = new data_t( d );
+    if ( !iter->data.hasData() ) {
+        iter->data.create( getAllocator(), std::forward< args_t >( args )... );
         ++numNodes;
     }
     else {
-        *iter->data = d;
+        // the arguments may refer to the old element, so build its replacement first
+        *iter->data.get() = data_t( std::forward< args_t >( args )... );
     }
+    
+    return *iter->data.get();
 }
 
 /*
  * Binary-Tree -- Pop
- * Remove whichever element lies at the key
+ * Remove whichever element lies at the key, along with any branches which
+ * only led to it.
  */
-template <typename key_t, typename data_t>
-void bTree<key_t, data_t>::pop( const key_t& k ) {
-    bTreeNode<data_t>* iter = iterate( &k, false );
-
-    if ( !iter || !iter->data )
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::pop( const key_t& k ) {
+    if ( !findPath( &k, ~0u, popPath ) || !popPath.top()->data.hasData() )
         return;
 
-    delete iter->data;
-    iter->data = nullptr;
+    popPath.top()->data.destroy( getAllocator() );
     --numNodes;
+    prune( popPath );
 }
 
 /*
  * Binary-Tree -- Has Data
  * Return true if there is a data element at the key
  */
-template <typename key_t, typename data_t>
-bool bTree<key_t, data_t>::hasData( const key_t& k ) {
+template <typename key_t, typename data_t, typename alloc_t>
+bool bTree<key_t, data_t, alloc_t>::hasData( const key_t& k ) {
     bTreeNode<data_t>* iter = iterate( &k, false );
 
-    return iter && ( iter->data != nullptr );
+    return iter && iter->data.hasData();
 }
 
 /*
@@ -332,14 +1042,265 @@ bool bTree<key_t, data_t>::hasData( const key_t& k ) {
  * Return a pointer to the data that lies at a key
  * Returns a nullptr if no data exists
  */
-template <typename key_t, typename data_t>
-const data_t* bTree<key_t, data_t>::getData( const key_t& k ) {
+template <typename key_t, typename data_t, typename alloc_t>
+const data_t* bTree<key_t, data_t, alloc_t>::getData( const key_t& k ) {
     bTreeNode<data_t>* iter = iterate( &k, false );
 
     if ( !iter )
         return nullptr;
 
-    return iter->data;
+    return iter->data.get();
+}
+
+/*
+ * Binary-Tree -- Bulk Load
+ * Push a sequence of key/value pairs, such as std::pair objects, into the
+ * tree. The path to each key is kept and reused for the next one, so only
+ * the bits after the prefix shared by consecutive keys need to be walked.
+ * Any order of keys is accepted, but sorting them into the tree's key order
+ * (see bTreeIterator) maximizes the number of shared bits.
+ * 
+ * For string keys, each pair's key must reference the first character of
+ * its string.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+template <typename pairIter_t>
+void bTree<key_t, data_t, alloc_t>::bulkLoad( pairIter_t begin, pairIter_t end ) {
+    bTreeStack< bTreeNode<data_t>* > path;
+    bTreeStack< unsigned char > prevBytes, currBytes;
+    
+    path.push( &head );
+    
+    for ( ; begin != end; ++begin ) {
+        const key_t* const k = &(begin->first);
+        const utils::bitMask* byteIter = nullptr;
+        
+        currBytes.clear();
+        for ( unsigned bytePos = 0; (byteIter = utils::getByte< key_t >( k, bytePos )); ++bytePos ) {
+            currBytes.push( byteIter->byte );
+        }
+        
+        // count the bits shared with the previous key
+        const unsigned numBytes = HL_MIN( prevBytes.size(), currBytes.size() );
+        unsigned sharedBytes = 0;
+        
+        while ( sharedBytes < numBytes && prevBytes[ sharedBytes ] == currBytes[ sharedBytes ] ) {
+            ++sharedBytes;
+        }
+        
+        unsigned sharedBits = sharedBytes * HL_BITS_PER_BYTE;
+        
+        if ( sharedBytes < numBytes ) {
+            const unsigned diff = prevBytes[ sharedBytes ] ^ currBytes[ sharedBytes ];
+            
+            for ( unsigned bit = HL_BITS_PER_BYTE; bit-- && !(diff & (1u << bit)); ) {
+                ++sharedBits;
+            }
+        }
+        
+        while ( path.size() > sharedBits + 1 ) {
+            path.pop();
+        }
+        
+        // walk the remaining bits of the key, creating nodes as needed
+        bTreeNode<data_t>* bNodeIter = path.top();
+        const unsigned numBits = currBytes.size() * HL_BITS_PER_BYTE;
+        
+        for ( unsigned bitPos = sharedBits; bitPos < numBits; ++bitPos ) {
+            if ( !bNodeIter->subNodes ) {
+                bNodeIter->subNodes = createBranch();
+            }
+            
+            const unsigned char byte = currBytes[ bitPos / HL_BITS_PER_BYTE ];
+            const int dir = (byte >> (HL_BITS_PER_BYTE - 1 - bitPos % HL_BITS_PER_BYTE)) & 1;
+            
+            bNodeIter = &(bNodeIter->subNodes->nodes[ dir ]);
+            path.push( bNodeIter );
+        }
+        
+        if ( !bNodeIter->data.hasData() ) {
+            bNodeIter->data.create( getAllocator(), begin->second );
+            ++numNodes;
+        }
+        else {
+            *bNodeIter->data.get() = begin->second;
+        }
+        
+        std::swap( prevBytes, currBytes );
+    }
+}
+
+/*
+ * Binary-Tree -- Batched Lookup
+ * Find the data for 'n' keys, writing a pointer to each key's data (or a
+ * nullptr) into 'outData'. Up to BATCH_SIZE lookups are walked in lockstep,
+ * and the next node of each one is prefetched before any of them are read.
+ * This overlaps the cache misses of several lookups rather than waiting on
+ * each miss in turn.
+ * 
+ * 'keys' may iterate over keys or, for string keys, over pointers to the
+ * first character of each string.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+template <typename keyIter_t>
+void bTree<key_t, data_t, alloc_t>::findBatch( keyIter_t keys, unsigned n, const data_t** outData ) {
+    struct lookup {
+        const key_t*            key;
+        const utils::bitMask*   byteIter;
+        bTreeNode<data_t>*      node;
+        unsigned                bytePos;
+        unsigned                bitPos;
+        unsigned                index;
+    };
+    
+    lookup lanes[ BATCH_SIZE ];
+    unsigned numLanes = 0;
+    unsigned nextIndex = 0;
+    
+    while ( nextIndex < n || numLanes ) {
+        
+        // fill empty lanes with new lookups
+        while ( numLanes < BATCH_SIZE && nextIndex < n ) {
+            lookup& l = lanes[ numLanes++ ];
+            l.key       = keyAddress( *keys );
+            l.byteIter  = utils::getByte< key_t >( l.key, 0 );
+            l.node      = &head;
+            l.bytePos   = 0;
+            l.bitPos    = HL_BITS_PER_BYTE;
+            l.index     = nextIndex++;
+            ++keys;
+        }
+        
+        // advance every lane by one level
+        for ( unsigned i = 0; i < numLanes; ) {
+            lookup& l = lanes[ i ];
+            
+            if ( l.bitPos == 0 ) {
+                l.byteIter = utils::getByte< key_t >( l.key, ++l.bytePos );
+                l.bitPos = HL_BITS_PER_BYTE;
+            }
+            
+            if ( !l.byteIter || !l.node->subNodes ) {
+                outData[ l.index ] = l.byteIter ? nullptr : l.node->data.get();
+                l = lanes[ --numLanes ];
+                continue;
+            }
+            
+            l.node = &(l.node->subNodes->nodes[ l.byteIter->get( --l.bitPos ) ]);
+            HL_PREFETCH( l.node );
+            ++i;
+        }
+    }
+}
+
+/*
+ * Binary-Tree -- Pop (Iterator)
+ * Remove the element at an iterator. Returns an iterator to the element which
+ * followed it.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+typename bTree<key_t, data_t, alloc_t>::iterator bTree<key_t, data_t, alloc_t>::pop( iterator iter ) {
+    bTreeNode<data_t>* node = iter.current();
+    
+    if ( node && node->data.hasData() ) {
+        popPath = iter.path;
+        ++iter;
+        node->data.destroy( getAllocator() );
+        --numNodes;
+        prune( popPath );
+    }
+    
+    return iter;
+}
+
+/*
+ * Binary-Tree -- Pop (Range)
+ * Remove every element in the range [first, last).
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void bTree<key_t, data_t, alloc_t>::pop( iterator first, const iterator& last ) {
+    while ( first != last ) {
+        bTreeNode<data_t>* node = first.current();
+        popPath = first.path;
+        ++first;
+        node->data.destroy( getAllocator() );
+        --numNodes;
+        prune( popPath );
+    }
+}
+
+/*
+ * Binary-Tree -- Begin
+ * Return an iterator to the first element in key order.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+typename bTree<key_t, data_t, alloc_t>::iterator bTree<key_t, data_t, alloc_t>::begin() {
+    iterator iter( &head );
+    iter.path.push( &head );
+    
+    if ( !head.data.hasData() ) {
+        iter.seekNext( true );
+    }
+    
+    return iter;
+}
+
+/*
+ * Binary-Tree -- Lower Bound
+ * Return an iterator to the first element whose key is not ordered before
+ * 'k', or end() if there is no such element.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+typename bTree<key_t, data_t, alloc_t>::iterator bTree<key_t, data_t, alloc_t>::lowerBound( const key_t& k ) {
+    iterator iter( &head );
+    
+    if ( !findPath( &k, ~0u, iter.path ) || !iter.current()->data.hasData() ) {
+        // Every node below the key's path is ordered after it. If the path
+        // ended early, the last node found has nothing below it.
+        iter.seekNext( true );
+    }
+    
+    return iter;
+}
+
+/*
+ * Binary-Tree -- Upper Bound
+ * Return an iterator to the first element whose key is ordered after 'k', or
+ * end() if there is no such element.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+typename bTree<key_t, data_t, alloc_t>::iterator bTree<key_t, data_t, alloc_t>::upperBound( const key_t& k ) {
+    iterator iter( &head );
+    findPath( &k, ~0u, iter.path );
+    iter.seekNext( true );
+    return iter;
+}
+
+/*
+ * Binary-Tree -- Prefix Range
+ * Return the range of all elements whose keys begin with the first 'numBits'
+ * bits of 'k'. By default, every bit of 'k' is used, so a string key returns
+ * all elements which start with that string.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+std::pair<
+    typename bTree<key_t, data_t, alloc_t>::iterator,
+    typename bTree<key_t, data_t, alloc_t>::iterator
+> bTree<key_t, data_t, alloc_t>::prefixRange( const key_t& k, unsigned numBits ) {
+    iterator first( &head );
+    
+    if ( !findPath( &k, numBits, first.path ) ) {
+        return std::make_pair( end(), end() );
+    }
+    
+    iterator last( first );
+    last.seekNext( false );
+    
+    if ( !first.current()->data.hasData() ) {
+        first.seekNext( true );
+    }
+    
+    return std::make_pair( std::move( first ), std::move( last ) );
 }
 
 } // end containers namespace
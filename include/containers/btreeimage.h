@@ -0,0 +1,431 @@
+/*
+ * File:   btreeimage.h
+ * Author: hammy
+ *
+ * Flat, pointer-free snapshots of a bTree which can be queried in place.
+ */
+
+#ifndef __HL_B_TREE_IMAGE_H__
+#define __HL_B_TREE_IMAGE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "../utils/bits.h"
+#include "../utils/mappedFile.h"
+#include "btree.h"
+
+namespace hamLibs {
+namespace containers {
+
+/**
+ * Binary Tree Image Node
+ *
+ * Nodes reference their sub-nodes and data by index rather than by address,
+ * so an image is valid wherever it is loaded in memory. An index of 0 means
+ * there is nothing to reference; all other indices are 1 more than the
+ * position of their branch or data within the image.
+ */
+struct bTreeImageNode {
+    std::uint32_t subNodes;
+    std::uint32_t data;
+};
+
+/**
+ * Binary Tree Image Header
+ *
+ * An image is laid out as:
+ *      bTreeImageHeader
+ *      bTreeImageNode[ numBranches ][ BNODE_MAX ]
+ *      data_t[ numData ]
+ * Both arrays begin on a 16-byte boundary relative to the start of the image.
+ */
+struct bTreeImageHeader {
+    char            magic[ 4 ];
+    std::uint32_t   version;
+    std::uint32_t   dataSize;
+    std::uint32_t   numBranches;
+    std::uint32_t   numData;
+    std::uint32_t   reserved;
+    bTreeImageNode  head;
+};
+
+/******************************************************************************
+ *  Binary-Tree Image Setup
+ *
+ * freeze() and write() convert a bTree into an image. A bTreeImage can then
+ * open that image directly from memory or from a memory-mapped file, without
+ * deserializing it or allocating anything from the heap. Lookups walk the same
+ * path of key bits as the bTree that the image was made from.
+ *
+ * Images are read-only, and can only be made for data which is trivially
+ * copyable. Images store integers in the native byte order of the machine
+ * which made them.
+******************************************************************************/
+template <typename key_t, typename data_t>
+class bTreeImage {
+
+    static_assert(
+        std::is_trivially_copyable< data_t >::value,
+        "bTreeImage data must be trivially copyable."
+    );
+
+    static_assert(
+        alignof( data_t ) <= 16,
+        "bTreeImage data cannot be aligned beyond 16 bytes."
+    );
+
+    public:
+        enum : std::uint32_t {
+            IMAGE_VERSION = 1
+        };
+
+    private:
+        const bTreeImageHeader* header      = nullptr;
+        const bTreeImageNode*   branches    = nullptr;
+        const data_t*           values      = nullptr;
+        utils::mappedFile       file;
+
+        static std::size_t      alignOffset ( std::size_t offset ) { return (offset + 15) & ~std::size_t( 15 ); }
+        static std::size_t      branchOffset();
+        static std::size_t      dataOffset  ( std::size_t numBranches );
+        template <typename alloc_t>
+        static std::size_t      countBranches( const bTree<key_t, data_t, alloc_t>& tree );
+
+        const bTreeImageNode*   iterate     ( const key_t* k ) const;
+
+    public:
+        bTreeImage      () {}
+        bTreeImage      ( const void* image, std::size_t numBytes );
+        bTreeImage      ( const bTreeImage& ) = delete;
+        bTreeImage      ( bTreeImage&& );
+
+        ~bTreeImage     () { close(); }
+
+        bTreeImage&     operator=   ( const bTreeImage& ) = delete;
+        bTreeImage&     operator=   ( bTreeImage&& );
+
+        // Image creation
+        template <typename alloc_t>
+        static std::size_t  imageSize   ( const bTree<key_t, data_t, alloc_t>& tree );
+
+        template <typename alloc_t>
+        static void         freeze      ( const bTree<key_t, data_t, alloc_t>& tree, void* outImage );
+
+        template <typename alloc_t>
+        static bool         write       ( const bTree<key_t, data_t, alloc_t>& tree, const char* filename );
+
+        // Image access
+        bool            open        ( const void* image, std::size_t numBytes );
+        bool            open        ( const char* filename );
+        void            close       ();
+        bool            isOpen      () const { return header != nullptr; }
+
+        bool            hasData     ( const key_t& k ) const;
+        const data_t*   getData     ( const key_t& k ) const;
+        unsigned        size        () const { return header ? header->numData : 0; }
+};
+
+/*
+ * Binary Tree Image -- Memory Constructor
+ */
+template <typename key_t, typename data_t>
+bTreeImage<key_t, data_t>::bTreeImage( const void* image, std::size_t numBytes ) {
+    open( image, numBytes );
+}
+
+/*
+ * Binary Tree Image -- Move Constructor
+ */
+template <typename key_t, typename data_t>
+bTreeImage<key_t, data_t>::bTreeImage( bTreeImage&& bti ) {
+    *this = std::move( bti );
+}
+
+/*
+ * Binary Tree Image -- Move Operator
+ */
+template <typename key_t, typename data_t>
+bTreeImage<key_t, data_t>& bTreeImage<key_t, data_t>::operator =( bTreeImage&& bti ) {
+    if ( this != &bti ) {
+        close();
+
+        header = bti.header;
+        branches = bti.branches;
+        values = bti.values;
+        file = std::move( bti.file );
+
+        bti.header = nullptr;
+        bti.branches = nullptr;
+        bti.values = nullptr;
+    }
+    return *this;
+}
+
+/*
+ * Binary Tree Image -- Section Offsets
+ */
+template <typename key_t, typename data_t>
+inline std::size_t bTreeImage<key_t, data_t>::branchOffset() {
+    return alignOffset( sizeof( bTreeImageHeader ) );
+}
+
+template <typename key_t, typename data_t>
+inline std::size_t bTreeImage<key_t, data_t>::dataOffset( std::size_t numBranches ) {
+    return alignOffset( branchOffset() + numBranches * sizeof( bTreeImageNode ) * BNODE_MAX );
+}
+
+/*
+ * Binary Tree Image -- Branch Count
+ */
+template <typename key_t, typename data_t>
+template <typename alloc_t>
+std::size_t bTreeImage<key_t, data_t>::countBranches( const bTree<key_t, data_t, alloc_t>& tree ) {
+    std::size_t numBranches = 0;
+    bTreeStack< const bTreeBranch<data_t>* > stack;
+
+    if ( tree.head.subNodes ) {
+        stack.push( tree.head.subNodes );
+    }
+
+    while ( !stack.empty() ) {
+        const bTreeBranch<data_t>* branch = stack.pop();
+        ++numBranches;
+
+        for ( unsigned dir = BNODE_LEFT; dir < BNODE_MAX; ++dir ) {
+            if ( branch->nodes[ dir ].subNodes ) {
+                stack.push( branch->nodes[ dir ].subNodes );
+            }
+        }
+    }
+
+    return numBranches;
+}
+
+/*
+ * Binary Tree Image -- Image Size
+ * Returns the number of bytes needed to freeze a tree.
+ */
+template <typename key_t, typename data_t>
+template <typename alloc_t>
+std::size_t bTreeImage<key_t, data_t>::imageSize( const bTree<key_t, data_t, alloc_t>& tree ) {
+    return dataOffset( countBranches( tree ) ) + tree.size() * sizeof( data_t );
+}
+
+/*
+ * Binary Tree Image -- Freeze
+ * Write a tree into a buffer of at least imageSize() bytes.
+ */
+template <typename key_t, typename data_t>
+template <typename alloc_t>
+void bTreeImage<key_t, data_t>::freeze( const bTree<key_t, data_t, alloc_t>& tree, void* outImage ) {
+    struct branchPair {
+        const bTreeBranch<data_t>*  src;
+        std::uint32_t               index;
+    };
+
+    const std::size_t numBranches = countBranches( tree );
+    unsigned char* const bytes = static_cast< unsigned char* >( outImage );
+
+    std::memset( bytes, 0, dataOffset( numBranches ) );
+
+    bTreeImageHeader* const outHeader = reinterpret_cast< bTreeImageHeader* >( bytes );
+    bTreeImageNode* const outBranches = reinterpret_cast< bTreeImageNode* >( bytes + branchOffset() );
+    unsigned char* const outData = bytes + dataOffset( numBranches );
+
+    std::uint32_t numBranchesUsed = 0;
+    std::uint32_t numDataUsed = 0;
+
+    // Reserve an index for a node's data and copy it into the image
+    auto freezeNode = [&]( const bTreeNode<data_t>& src, bTreeImageNode& dst ) {
+        if ( src.data.hasData() ) {
+            std::memcpy( outData + numDataUsed * sizeof( data_t ), src.data.get(), sizeof( data_t ) );
+            dst.data = ++numDataUsed;
+        }
+    };
+
+    std::memcpy( outHeader->magic, "HLBT", 4 );
+    outHeader->version = IMAGE_VERSION;
+    outHeader->dataSize = sizeof( data_t );
+    outHeader->numBranches = static_cast< std::uint32_t >( numBranches );
+    outHeader->numData = tree.size();
+
+    freezeNode( tree.head, outHeader->head );
+
+    if ( !tree.head.subNodes ) {
+        return;
+    }
+
+    bTreeStack< branchPair > stack;
+    outHeader->head.subNodes = ++numBranchesUsed;
+    stack.push( branchPair{ tree.head.subNodes, 0 } );
+
+    while ( !stack.empty() ) {
+        const branchPair pair = stack.pop();
+        bTreeImageNode* const dst = outBranches + pair.index * BNODE_MAX;
+
+        for ( unsigned dir = BNODE_LEFT; dir < BNODE_MAX; ++dir ) {
+            const bTreeNode<data_t>& src = pair.src->nodes[ dir ];
+            freezeNode( src, dst[ dir ] );
+
+            if ( src.subNodes ) {
+                stack.push( branchPair{ src.subNodes, numBranchesUsed } );
+                dst[ dir ].subNodes = ++numBranchesUsed;
+            }
+        }
+    }
+}
+
+/*
+ * Binary Tree Image -- Write
+ * Freeze a tree and save the image to a file. Returns false if the file could
+ * not be written.
+ */
+template <typename key_t, typename data_t>
+template <typename alloc_t>
+bool bTreeImage<key_t, data_t>::write( const bTree<key_t, data_t, alloc_t>& tree, const char* filename ) {
+    const std::size_t numBytes = imageSize( tree );
+    unsigned char* const image = new unsigned char[ numBytes ];
+
+    freeze( tree, image );
+
+    std::FILE* const outFile = std::fopen( filename, "wb" );
+    bool ret = outFile != nullptr;
+
+    if ( outFile ) {
+        ret = std::fwrite( image, 1, numBytes, outFile ) == numBytes;
+        ret = (std::fclose( outFile ) == 0) && ret;
+    }
+
+    delete [] image;
+    return ret;
+}
+
+/*
+ * Binary Tree Image -- Open From Memory
+ * Use an existing image in place. The image must stay in memory, and be
+ * aligned to at least 16 bytes, until the bTreeImage is closed. Returns false
+ * if the memory does not contain a valid image.
+ *
+ * Only the header is checked here. Branch and data indices are checked as
+ * lookups reach them, so a corrupted image makes lookups fail rather than read
+ * past the end of the image.
+ */
+template <typename key_t, typename data_t>
+bool bTreeImage<key_t, data_t>::open( const void* image, std::size_t numBytes ) {
+    close();
+
+    if ( !image || numBytes < sizeof( bTreeImageHeader ) ) {
+        return false;
+    }
+
+    const unsigned char* const bytes = static_cast< const unsigned char* >( image );
+    const bTreeImageHeader* const imgHeader = static_cast< const bTreeImageHeader* >( image );
+
+    // counts are bounded by the size of the image before computing offsets, so
+    // the offsets cannot overflow
+    if ( std::memcmp( imgHeader->magic, "HLBT", 4 ) != 0
+    || imgHeader->version != IMAGE_VERSION
+    || imgHeader->dataSize != sizeof( data_t )
+    || imgHeader->numBranches > numBytes / (sizeof( bTreeImageNode ) * BNODE_MAX)
+    || imgHeader->numData > numBytes / sizeof( data_t )
+    || numBytes < dataOffset( imgHeader->numBranches ) + imgHeader->numData * sizeof( data_t )
+    || imgHeader->head.subNodes > imgHeader->numBranches
+    || imgHeader->head.data > imgHeader->numData
+    ) {
+        return false;
+    }
+
+    header = imgHeader;
+    branches = reinterpret_cast< const bTreeImageNode* >( bytes + branchOffset() );
+    values = reinterpret_cast< const data_t* >( bytes + dataOffset( imgHeader->numBranches ) );
+
+    return true;
+}
+
+/*
+ * Binary Tree Image -- Open From File
+ * Memory-map an image which was saved with write().
+ */
+template <typename key_t, typename data_t>
+bool bTreeImage<key_t, data_t>::open( const char* filename ) {
+    close();
+
+    utils::mappedFile imgFile;
+
+    if ( !imgFile.open( filename ) || !open( imgFile.data(), imgFile.size() ) ) {
+        return false;
+    }
+
+    file = std::move( imgFile );
+    return true;
+}
+
+/*
+ * Binary Tree Image -- Close
+ */
+template <typename key_t, typename data_t>
+void bTreeImage<key_t, data_t>::close() {
+    header = nullptr;
+    branches = nullptr;
+    values = nullptr;
+    file.close();
+}
+
+/*
+ * Binary Tree Image -- Element Iteration
+ * Returns a nullptr if the key leads to a branch index outside of the image.
+ */
+template <typename key_t, typename data_t>
+const bTreeImageNode* bTreeImage<key_t, data_t>::iterate( const key_t* k ) const {
+    if ( !header ) {
+        return nullptr;
+    }
+
+    unsigned                bytePos     = 0;
+    const bTreeImageNode*   bNodeIter   = &header->head;
+    const utils::bitMask*   byteIter    = nullptr;
+
+    while ( (byteIter = hamLibs::utils::getByte< key_t >( k, bytePos++ )) ) {
+
+        for ( unsigned currBit = HL_BITS_PER_BYTE; currBit--; ) {
+            if ( !bNodeIter->subNodes || bNodeIter->subNodes > header->numBranches ) {
+                return nullptr;
+            }
+
+            const int dir = byteIter->get( currBit );
+            bNodeIter = branches + (bNodeIter->subNodes - 1) * BNODE_MAX + dir;
+        }
+    }
+
+    return bNodeIter;
+}
+
+/*
+ * Binary Tree Image -- Has Data
+ * Return true if there is a data element at the key
+ */
+template <typename key_t, typename data_t>
+bool bTreeImage<key_t, data_t>::hasData( const key_t& k ) const {
+    const bTreeImageNode* const iter = iterate( &k );
+    return iter && iter->data && iter->data <= header->numData;
+}
+
+/*
+ * Binary Tree Image -- Get Data
+ * Return a pointer to the data that lies at a key
+ * Returns a nullptr if no data exists
+ */
+template <typename key_t, typename data_t>
+const data_t* bTreeImage<key_t, data_t>::getData( const key_t& k ) const {
+    const bTreeImageNode* const iter = iterate( &k );
+    return (iter && iter->data && iter->data <= header->numData) ? values + (iter->data - 1) : nullptr;
+}
+
+} // end containers namespace
+} // end hamLibs namespace
+
+#endif  /* __HL_B_TREE_IMAGE_H__ */
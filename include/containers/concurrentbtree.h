@@ -0,0 +1,513 @@
+/*
+ * File:   concurrentbtree.h
+ * Author: hammy
+ *
+ * Read-mostly variant of the bTree which may be shared between threads.
+ */
+
+#ifndef __HL_CONCURRENT_B_TREE_H__
+#define __HL_CONCURRENT_B_TREE_H__
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include "../utils/bits.h"
+#include "../utils/nodePool.h"
+#include "btree.h"
+
+namespace hamLibs {
+namespace containers {
+
+template <typename data_t>
+struct concurrentBTreeBranch;
+
+/**
+ * Concurrent Binary Tree Node
+ *
+ * Both the data and the sub-nodes of a node are published with atomic stores
+ * so they can be read without locking. A node's data is always allocated
+ * separately, allowing a writer to swap in a new value while readers are
+ * still copying the old one.
+ */
+template <typename data_t>
+struct concurrentBTreeNode {
+    std::atomic< data_t* >                          data;
+    std::atomic< concurrentBTreeBranch<data_t>* >   subNodes;
+
+    concurrentBTreeNode() : data{nullptr}, subNodes{nullptr} {}
+    concurrentBTreeNode( const concurrentBTreeNode& ) = delete;
+    concurrentBTreeNode& operator=( const concurrentBTreeNode& ) = delete;
+};
+
+/**
+ * Concurrent Binary Tree Branch
+ * A pair of nodes, indexed using the "bnode_dir" enumeration.
+ */
+template <typename data_t>
+struct concurrentBTreeBranch {
+    concurrentBTreeNode<data_t> nodes[ BNODE_MAX ];
+};
+
+/******************************************************************************
+ *  Concurrent Binary-Tree Structure Setup
+ *
+ * Any number of threads may call hasData() and getData() while another thread
+ * is pushing or popping elements. Readers never lock; they walk the tree
+ * through atomic pointers and copy data out before returning. Writers are
+ * serialized with a mutex.
+ *
+ * Memory is reclaimed using epochs. Each reader announces the current global
+ * epoch in a reader slot for the duration of a lookup. Values which have been
+ * replaced or popped are retired along with the epoch in which they were
+ * unlinked, and are only deleted once every active reader has announced a
+ * later epoch. A reader fences between announcing its epoch and reading the
+ * tree, and a writer fences between unlinking values and scanning the reader
+ * slots, so a reader is either seen by the scan or sees the unlinked values
+ * gone. Branches are never unlinked while the tree is in use, so they are
+ * kept in a node pool and only released by clear().
+ *
+ * Up to MAX_READERS threads can be inside a lookup at once without
+ * contending. Additional readers will spin until a slot is available.
+ *
+ * Branches and values are reserved through 'alloc_t'. The allocator is only
+ * used by writers while holding the write lock, so it does not need to be
+ * thread-safe.
+******************************************************************************/
+template <typename key_t, typename data_t, typename alloc_t = utils::heapAllocator>
+class concurrentBTree {
+
+    public:
+        enum : unsigned {
+            MAX_READERS     = 64,
+            RECLAIM_LIMIT   = 64   // retired values held before a reclaim
+        };
+
+    private:
+        /*
+         * Reader slots are padded to keep each one on its own cache line.
+         */
+        struct readerSlot {
+            std::atomic< unsigned long > epoch;
+            char padding[ 64 - sizeof( std::atomic< unsigned long > ) ];
+
+            readerSlot() : epoch{0} {}
+        };
+
+        struct retiredData {
+            data_t*         pData;
+            unsigned long   epoch;
+        };
+
+        concurrentBTreeNode<data_t>             head;
+        std::atomic< unsigned >                 numNodes;
+        mutable std::atomic< unsigned long >    globalEpoch;
+        mutable readerSlot                      readers[ MAX_READERS ];
+
+        // Members below are only accessed while holding 'writeLock'
+        std::mutex                                      writeLock;
+        utils::nodePool< concurrentBTreeBranch<data_t>, 256, alloc_t > branchPool;
+        bTreeStack< retiredData >                       retired;
+        bTreeStack< retiredData >                       retiredSwap;
+
+        static unsigned     readerHint      ();
+        unsigned            enterRead       () const;
+        void                exitRead        ( unsigned slot ) const;
+
+        const concurrentBTreeNode<data_t>*  find    ( const key_t* k ) const;
+        concurrentBTreeNode<data_t>*        create  ( const key_t* k );
+
+        void                retire          ( data_t* pData );
+        void                reclaim         ();
+        void                synchronize     ();
+        void                destroyNodes    ();
+
+    public:
+        concurrentBTree     ();
+        explicit concurrentBTree( const alloc_t& );
+        concurrentBTree     ( const concurrentBTree& ) = delete;
+        concurrentBTree     ( concurrentBTree&& ) = delete;
+
+        ~concurrentBTree    ();
+
+        concurrentBTree&    operator=   ( const concurrentBTree& ) = delete;
+        concurrentBTree&    operator=   ( concurrentBTree&& ) = delete;
+
+        // Writers
+        void                push        ( const key_t& k, const data_t& d ) { emplace( k, d ); }
+        void                push        ( const key_t& k, data_t&& d )      { emplace( k, std::move( d ) ); }
+        template <typename... args_t>
+        void                emplace     ( const key_t& k, args_t&&... args );
+        void                pop         ( const key_t& k );
+        void                clear       ();
+
+        // Readers
+        bool                hasData     ( const key_t& k ) const;
+        bool                getData     ( const key_t& k, data_t& outData ) const;
+        unsigned            size        () const { return numNodes.load( std::memory_order_relaxed ); }
+};
+
+/*
+ * Concurrent Binary Tree -- Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+concurrentBTree<key_t, data_t, alloc_t>::concurrentBTree() :
+    head{},
+    numNodes{0},
+    globalEpoch{1},
+    readers{},
+    writeLock{},
+    branchPool{},
+    retired{},
+    retiredSwap{}
+{}
+
+/*
+ * Concurrent Binary Tree -- Allocator Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+concurrentBTree<key_t, data_t, alloc_t>::concurrentBTree( const alloc_t& a ) :
+    head{},
+    numNodes{0},
+    globalEpoch{1},
+    readers{},
+    writeLock{},
+    branchPool{ a },
+    retired{},
+    retiredSwap{}
+{}
+
+/*
+ * Concurrent Binary Tree -- Destructor
+ * No readers may be using the tree while it is destroyed.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+concurrentBTree<key_t, data_t, alloc_t>::~concurrentBTree() {
+    destroyNodes();
+
+    while ( !retired.empty() ) {
+        utils::destroyItem( branchPool.getAllocator(), retired.pop().pData );
+    }
+}
+
+/*
+ * Concurrent Binary Tree -- Reader Slot Hint
+ * Give each thread a different starting slot so readers rarely collide.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+unsigned concurrentBTree<key_t, data_t, alloc_t>::readerHint() {
+    static std::atomic< unsigned > nextHint{0};
+    static thread_local unsigned hint = nextHint.fetch_add( 1, std::memory_order_relaxed );
+    return hint % MAX_READERS;
+}
+
+/*
+ * Concurrent Binary Tree -- Begin Read
+ * Announce the current epoch in a free reader slot. Returns the slot used.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+unsigned concurrentBTree<key_t, data_t, alloc_t>::enterRead() const {
+    unsigned slot = readerHint();
+
+    for ( ;; ) {
+        unsigned long idle = 0;
+        const unsigned long epoch = globalEpoch.load();
+
+        if ( readers[ slot ].epoch.compare_exchange_strong( idle, epoch ) ) {
+            // Pairs with the fence in reclaim(). Either the writer's scan sees
+            // this slot, or this reader's loads see every value unlinked
+            // before that scan.
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            return slot;
+        }
+
+        if ( ++slot == MAX_READERS ) {
+            slot = 0;
+            std::this_thread::yield();
+        }
+    }
+}
+
+/*
+ * Concurrent Binary Tree -- End Read
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+inline void concurrentBTree<key_t, data_t, alloc_t>::exitRead( unsigned slot ) const {
+    readers[ slot ].epoch.store( 0, std::memory_order_release );
+}
+
+/*
+ * Concurrent Binary Tree -- Lookup
+ * Find the node at a key without creating any nodes. The caller must be
+ * within a read.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+const concurrentBTreeNode<data_t>* concurrentBTree<key_t, data_t, alloc_t>::find( const key_t* k ) const {
+
+    unsigned bytePos = 0;
+    const concurrentBTreeNode<data_t>* bNodeIter = &head;
+    const utils::bitMask* byteIter = nullptr;
+
+    while ( (byteIter = hamLibs::utils::getByte< key_t >( k, bytePos++ )) ) {
+
+        for ( unsigned currBit = HL_BITS_PER_BYTE; currBit--; ) {
+            const concurrentBTreeBranch<data_t>* const branch
+                = bNodeIter->subNodes.load( std::memory_order_acquire );
+
+            if ( !branch ) {
+                return nullptr;
+            }
+
+            bNodeIter = &(branch->nodes[ byteIter->get( currBit ) ]);
+        }
+    }
+
+    return bNodeIter;
+}
+
+/*
+ * Concurrent Binary Tree -- Node Creation
+ * Find the node at a key, creating any missing nodes along the way. The
+ * caller must hold the write lock. New branches are fully constructed before
+ * being published to readers.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+concurrentBTreeNode<data_t>* concurrentBTree<key_t, data_t, alloc_t>::create( const key_t* k ) {
+
+    unsigned bytePos = 0;
+    concurrentBTreeNode<data_t>* bNodeIter = &head;
+    const utils::bitMask* byteIter = nullptr;
+
+    while ( (byteIter = hamLibs::utils::getByte< key_t >( k, bytePos++ )) ) {
+
+        for ( unsigned currBit = HL_BITS_PER_BYTE; currBit--; ) {
+            concurrentBTreeBranch<data_t>* branch
+                = bNodeIter->subNodes.load( std::memory_order_relaxed );
+
+            if ( !branch ) {
+                branch = new( branchPool.allocate() ) concurrentBTreeBranch<data_t>();
+                bNodeIter->subNodes.store( branch, std::memory_order_release );
+            }
+
+            bNodeIter = &(branch->nodes[ byteIter->get( currBit ) ]);
+        }
+    }
+
+    return bNodeIter;
+}
+
+/*
+ * Concurrent Binary Tree -- Retire
+ * Queue a value which has been unlinked from the tree for deletion. The
+ * caller must hold the write lock.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void concurrentBTree<key_t, data_t, alloc_t>::retire( data_t* pData ) {
+    retired.push( retiredData{ pData, globalEpoch.fetch_add( 1 ) } );
+
+    if ( retired.size() >= RECLAIM_LIMIT ) {
+        reclaim();
+    }
+}
+
+/*
+ * Concurrent Binary Tree -- Reclaim
+ * Delete all retired values which can no longer be seen by any reader. The
+ * caller must hold the write lock.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void concurrentBTree<key_t, data_t, alloc_t>::reclaim() {
+    unsigned long minEpoch = ~0ul;
+
+    // Order the unlinking exchanges before the scan of reader slots; pairs
+    // with the fence in enterRead().
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+    for ( unsigned i = 0; i < MAX_READERS; ++i ) {
+        const unsigned long epoch = readers[ i ].epoch.load();
+
+        if ( epoch && epoch < minEpoch ) {
+            minEpoch = epoch;
+        }
+    }
+
+    // A reader which announced an epoch later than a value's retirement
+    // started after the value was unlinked.
+    while ( !retired.empty() ) {
+        const retiredData rd = retired.pop();
+
+        if ( rd.epoch < minEpoch ) {
+            utils::destroyItem( branchPool.getAllocator(), rd.pData );
+        }
+        else {
+            retiredSwap.push( rd );
+        }
+    }
+
+    std::swap( retired, retiredSwap );
+}
+
+/*
+ * Concurrent Binary Tree -- Synchronize
+ * Wait until every reader which may have seen an unlinked node has finished.
+ * The caller must hold the write lock.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void concurrentBTree<key_t, data_t, alloc_t>::synchronize() {
+    const unsigned long epoch = globalEpoch.fetch_add( 1 );
+
+    for ( unsigned i = 0; i < MAX_READERS; ++i ) {
+        unsigned long readerEpoch = readers[ i ].epoch.load();
+
+        while ( readerEpoch && readerEpoch <= epoch ) {
+            std::this_thread::yield();
+            readerEpoch = readers[ i ].epoch.load();
+        }
+    }
+}
+
+/*
+ * Concurrent Binary Tree -- Node Destruction
+ * Delete all values and return every branch to the pool. No readers may be
+ * able to reach the nodes being destroyed.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void concurrentBTree<key_t, data_t, alloc_t>::destroyNodes() {
+    utils::destroyItem( branchPool.getAllocator(), head.data.exchange( nullptr ) );
+
+    concurrentBTreeBranch<data_t>* const root = head.subNodes.exchange( nullptr );
+
+    if ( root ) {
+        bTreeStack< concurrentBTreeBranch<data_t>* > branches;
+        branches.push( root );
+
+        while ( !branches.empty() ) {
+            concurrentBTreeBranch<data_t>* branch = branches.pop();
+
+            for ( unsigned dir = BNODE_LEFT; dir < BNODE_MAX; ++dir ) {
+                concurrentBTreeNode<data_t>& node = branch->nodes[ dir ];
+                utils::destroyItem( branchPool.getAllocator(), node.data.load( std::memory_order_relaxed ) );
+
+                if ( concurrentBTreeBranch<data_t>* sub = node.subNodes.load( std::memory_order_relaxed ) ) {
+                    branches.push( sub );
+                }
+            }
+
+            branch->~concurrentBTreeBranch<data_t>();
+        }
+    }
+
+    branchPool.clear();
+    numNodes.store( 0, std::memory_order_relaxed );
+}
+
+/*
+ * Concurrent Binary Tree -- Emplace
+ * Construct a data element at a key from a set of arguments, replacing any
+ * element already there. Readers will either see the previous value at the
+ * key or the new one. push() forwards here.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+template <typename... args_t>
+void concurrentBTree<key_t, data_t, alloc_t>::emplace( const key_t& k, args_t&&... args ) {
+    std::lock_guard< std::mutex > guard( writeLock );
+
+    data_t* const pData = utils::createItem< data_t >( branchPool.getAllocator(), std::forward< args_t >( args )... );
+
+    data_t* const pOld = create( &k )->data.exchange( pData, std::memory_order_acq_rel );
+
+    if ( pOld ) {
+        retire( pOld );
+    }
+    else {
+        numNodes.fetch_add( 1, std::memory_order_relaxed );
+    }
+}
+
+/*
+ * Concurrent Binary Tree -- Pop
+ * Remove whichever element lies at the key
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void concurrentBTree<key_t, data_t, alloc_t>::pop( const key_t& k ) {
+    std::lock_guard< std::mutex > guard( writeLock );
+
+    // Branches are never removed, so nothing can be unlinked while searching
+    concurrentBTreeNode<data_t>* const node = const_cast< concurrentBTreeNode<data_t>* >( find( &k ) );
+
+    if ( !node ) {
+        return;
+    }
+
+    data_t* const pOld = node->data.exchange( nullptr, std::memory_order_acq_rel );
+
+    if ( pOld ) {
+        retire( pOld );
+        numNodes.fetch_sub( 1, std::memory_order_relaxed );
+    }
+}
+
+/*
+ * Concurrent Binary Tree -- Clear
+ * Unlink every node from the tree, then wait for readers to leave it before
+ * freeing any memory.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void concurrentBTree<key_t, data_t, alloc_t>::clear() {
+    std::lock_guard< std::mutex > guard( writeLock );
+
+    data_t* const pHeadData = head.data.exchange( nullptr );
+    concurrentBTreeBranch<data_t>* const root = head.subNodes.exchange( nullptr );
+
+    synchronize();
+
+    // Readers can no longer reach the old nodes; relink them for destruction
+    head.data.store( pHeadData, std::memory_order_relaxed );
+    head.subNodes.store( root, std::memory_order_relaxed );
+    destroyNodes();
+
+    while ( !retired.empty() ) {
+        utils::destroyItem( branchPool.getAllocator(), retired.pop().pData );
+    }
+}
+
+/*
+ * Concurrent Binary Tree -- Has Data
+ * Return true if there is a data element at the key
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+bool concurrentBTree<key_t, data_t, alloc_t>::hasData( const key_t& k ) const {
+    const unsigned slot = enterRead();
+
+    const concurrentBTreeNode<data_t>* const node = find( &k );
+    const bool ret = node && node->data.load( std::memory_order_acquire ) != nullptr;
+
+    exitRead( slot );
+    return ret;
+}
+
+/*
+ * Concurrent Binary Tree -- Get Data
+ * Copy the data at a key into 'outData'. Returns false, leaving 'outData'
+ * untouched, if no data exists at the key.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+bool concurrentBTree<key_t, data_t, alloc_t>::getData( const key_t& k, data_t& outData ) const {
+    const unsigned slot = enterRead();
+
+    const concurrentBTreeNode<data_t>* const node = find( &k );
+    const data_t* const pData = node ? node->data.load( std::memory_order_acquire ) : nullptr;
+
+    if ( pData ) {
+        outData = *pData;
+    }
+
+    exitRead( slot );
+    return pData != nullptr;
+}
+
+} // end containers namespace
+} // end hamLibs namespace
+
+#endif  /* __HL_CONCURRENT_B_TREE_H__ */
@@ -0,0 +1,499 @@
+/*
+ * A double-ended queue built from fixed-size blocks.
+ * Elements are stored in blocks of roughly 4KB which are listed, in order,
+ * by a block map. Pushing or popping at either end only ever allocates or
+ * releases a single block, so elements never move once they are placed and
+ * references to them stay valid until they are popped. Elements are found
+ * by index in constant time, and each block can be walked as a plain array
+ * using numBlocks(), blockData() and blockSize(). Random-access iterators
+ * from begin() and end() visit the elements by index.
+ *
+ * One emptied block is kept in reserve, so a deque which repeatedly grows
+ * and shrinks across a block boundary does not reallocate.
+ *
+ * Memory is reserved through 'alloc_t' (see utils/allocator.h).
+ */
+
+#ifndef __HL_DEQUE_H__
+#define __HL_DEQUE_H__
+
+#include <new>
+#include <utility>
+#include "../utils/allocator.h"
+#include "../utils/assert.h"
+#include "../utils/iterators.h"
+
+namespace hamLibs {
+namespace containers {
+
+template <typename type, typename alloc_t = utils::heapAllocator>
+class deque {
+	public:
+		enum : int {
+			//number of elements per block, as a power of two
+			BLOCK_BITS = (sizeof(type) <= 4) ? 10
+				: (sizeof(type) <= 8) ? 9
+				: (sizeof(type) <= 16) ? 8
+				: (sizeof(type) <= 32) ? 7
+				: (sizeof(type) <= 64) ? 6
+				: (sizeof(type) <= 128) ? 5
+				: 4,
+			BLOCK_SIZE = 1 << BLOCK_BITS
+		};
+
+	private:
+		alloc_t allocator;
+		type** Map;			// block pointers, used blocks are in [FirstBlock, FirstBlock+NumBlocks)
+		int MapCapacity;
+		int FirstBlock;
+		int NumBlocks;
+		int Start;			// offset of the first element within the first block
+		int Size;
+		type* Spare;		// an unused block kept for reuse
+
+		type*			item		(int index) const;
+		type*			newBlock	();
+		void			freeBlock	(type* block);
+		void			reshapeMap	();
+		void			addFrontBlock	();
+		void			addBackBlock	();
+		void			destroyAll	();
+		void			release		();
+
+	public:
+		typedef utils::indexIterator<deque, type>				iterator;
+		typedef utils::indexIterator<const deque, const type>	constIterator;
+
+		deque			();
+		explicit deque	(const alloc_t& a);
+		deque			(const deque& copy);
+		deque			(deque&& moved);
+		~deque			();
+
+		//operators
+		deque&		operator =	(const deque& input);
+		deque&		operator =	(deque&& input);
+		bool		operator ==	(const deque& compare) const;
+		bool		operator !=	(const deque& compare) const;
+		type&		operator []	(int);
+		const type&	operator []	(int) const;
+
+		//deletion
+		void		popFront	();
+		void		popBack		();
+
+		//insertion
+		void		pushFront	(const type& data);
+		void		pushFront	(type&& data);
+		void		pushBack	(const type& data);
+		void		pushBack	(type&& data);
+		template <typename... args_t>
+		type&		emplaceFront	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplaceBack		(args_t&&... args);
+
+		//traversal
+		type&		front		();
+		type&		back		();
+		int			numBlocks	() const;
+		type*		blockData	(int block) const;
+		int			blockSize	(int block) const;
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
+		//miscellaneous
+		void		shrinkToFit	();
+		void		clear		();
+		bool		empty		() const;
+		int			size		() const;
+		alloc_t&	getAllocator	();
+};
+
+//---------------------------------------------------------------------
+//			Storage
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+inline type* deque<type, alloc_t>::item(int index) const {
+	const int pos = Start + index;
+	return Map[FirstBlock + (pos >> BLOCK_BITS)] + (pos & (BLOCK_SIZE-1));
+}
+
+template <typename type, typename alloc_t>
+type* deque<type, alloc_t>::newBlock() {
+	if (Spare) {
+		type* const block = Spare;
+		Spare = nullptr;
+		return block;
+	}
+	return utils::allocateItems<type>(allocator, BLOCK_SIZE);
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::freeBlock(type* block) {
+	if (!Spare) {
+		Spare = block;
+	}
+	else {
+		utils::deallocateItems(allocator, block, BLOCK_SIZE);
+	}
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::reshapeMap() {
+	//recenter the used blocks when the map is mostly empty, otherwise grow it
+	const int newCapacity = (NumBlocks*2 < MapCapacity) ? MapCapacity : HL_MAX(MapCapacity*2, 8);
+	const int newFirst = (newCapacity - NumBlocks) / 2;
+	type** const newMap = (newCapacity == MapCapacity)
+		? Map
+		: utils::allocateItems<type*>(allocator, newCapacity);
+
+	if (newMap == Map && newFirst > FirstBlock) {
+		for (int i = NumBlocks-1; i >= 0; --i) {
+			newMap[newFirst+i] = Map[FirstBlock+i];
+		}
+	}
+	else {
+		for (int i = 0; i < NumBlocks; ++i) {
+			newMap[newFirst+i] = Map[FirstBlock+i];
+		}
+	}
+
+	if (newMap != Map) {
+		utils::deallocateItems(allocator, Map, MapCapacity);
+		Map = newMap;
+		MapCapacity = newCapacity;
+	}
+	FirstBlock = newFirst;
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::addFrontBlock() {
+	if (FirstBlock == 0) {
+		reshapeMap();
+	}
+	Map[FirstBlock-1] = newBlock();
+	--FirstBlock;
+	++NumBlocks;
+	Start += BLOCK_SIZE;
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::addBackBlock() {
+	if (FirstBlock + NumBlocks == MapCapacity) {
+		reshapeMap();
+	}
+	Map[FirstBlock+NumBlocks] = newBlock();
+	++NumBlocks;
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::destroyAll() {
+	for (int b = 0; b < NumBlocks; ++b) {
+		type* const block = blockData(b);
+		const int count = blockSize(b);
+		for (int i = 0; i < count; ++i) {
+			block[i].~type();
+		}
+	}
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::release() {
+	for (int b = 0; b < NumBlocks; ++b) {
+		utils::deallocateItems(allocator, Map[FirstBlock+b], BLOCK_SIZE);
+	}
+	if (Spare) {
+		utils::deallocateItems(allocator, Spare, BLOCK_SIZE);
+	}
+	utils::deallocateItems(allocator, Map, MapCapacity);
+}
+
+//---------------------------------------------------------------------
+//			[Con/De]struction
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+deque<type, alloc_t>::deque() :
+	deque(alloc_t())
+{}
+
+template <typename type, typename alloc_t>
+deque<type, alloc_t>::deque(const alloc_t& a) :
+	allocator(a),
+	Map(nullptr),
+	MapCapacity(0),
+	FirstBlock(0),
+	NumBlocks(0),
+	Start(0),
+	Size(0),
+	Spare(nullptr)
+{}
+
+template <typename type, typename alloc_t>
+deque<type, alloc_t>::deque(const deque& copy) :
+	deque(copy.allocator)
+{
+	*this = copy;
+}
+
+template <typename type, typename alloc_t>
+deque<type, alloc_t>::deque(deque&& moved) :
+	deque(moved.allocator)
+{
+	*this = std::move(moved);
+}
+
+template <typename type, typename alloc_t>
+deque<type, alloc_t>::~deque() {
+	destroyAll();
+	release();
+}
+
+//---------------------------------------------------------------------
+//			Operators
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+deque<type, alloc_t>& deque<type, alloc_t>::operator = (const deque& input) {
+	if (this != &input) {
+		clear();
+		for (int b = 0; b < input.numBlocks(); ++b) {
+			const type* const block = input.blockData(b);
+			const int count = input.blockSize(b);
+			for (int i = 0; i < count; ++i) {
+				emplaceBack(block[i]);
+			}
+		}
+	}
+	return *this;
+}
+
+template <typename type, typename alloc_t>
+deque<type, alloc_t>& deque<type, alloc_t>::operator = (deque&& input) {
+	if (this == &input) return *this;
+
+	destroyAll();
+	release();
+
+	//the allocator moves along with the memory it reserved
+	allocator = std::move(input.allocator);
+	Map = input.Map;
+	MapCapacity = input.MapCapacity;
+	FirstBlock = input.FirstBlock;
+	NumBlocks = input.NumBlocks;
+	Start = input.Start;
+	Size = input.Size;
+	Spare = input.Spare;
+
+	input.Map = nullptr;
+	input.Spare = nullptr;
+	input.MapCapacity = input.FirstBlock = input.NumBlocks = 0;
+	input.Start = input.Size = 0;
+	return *this;
+}
+
+template <typename type, typename alloc_t>
+bool deque<type, alloc_t>::operator == (const deque& compare) const {
+	if (Size != compare.Size) return false;
+	for (int i = 0; i < Size; ++i) {
+		if (*item(i) != *compare.item(i))
+			return false;
+	}
+	return true;
+}
+
+template <typename type, typename alloc_t>
+bool deque<type, alloc_t>::operator != (const deque& compare) const {
+	return !(*this == compare);
+}
+
+template <typename type, typename alloc_t>
+type& deque<type, alloc_t>::operator [] (int index) {
+	HL_ASSERT(index >= 0 && index < Size);
+	return *item(index);
+}
+
+template <typename type, typename alloc_t>
+const type& deque<type, alloc_t>::operator [] (int index) const {
+	HL_ASSERT(index >= 0 && index < Size);
+	return *item(index);
+}
+
+//---------------------------------------------------------------------
+//			Deletion
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::popFront() {
+	if (!Size) return;
+	item(0)->~type();
+	++Start;
+	--Size;
+
+	if (Start >= BLOCK_SIZE) {
+		freeBlock(Map[FirstBlock]);
+		++FirstBlock;
+		--NumBlocks;
+		Start -= BLOCK_SIZE;
+	}
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::popBack() {
+	if (!Size) return;
+	--Size;
+	item(Size)->~type();
+
+	if (Start + Size <= (NumBlocks-1) * BLOCK_SIZE) {
+		--NumBlocks;
+		freeBlock(Map[FirstBlock+NumBlocks]);
+	}
+}
+
+//---------------------------------------------------------------------
+//			Insertion
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::pushFront(const type& data) {
+	emplaceFront(data);
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::pushFront(type&& data) {
+	emplaceFront(std::move(data));
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::pushBack(const type& data) {
+	emplaceBack(data);
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::pushBack(type&& data) {
+	emplaceBack(std::move(data));
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& deque<type, alloc_t>::emplaceFront(args_t&&... args) {
+	//adding a block never moves elements, so 'args' may refer to one
+	if (Start == 0) {
+		addFrontBlock();
+	}
+	type* const p = Map[FirstBlock + ((Start-1) >> BLOCK_BITS)] + ((Start-1) & (BLOCK_SIZE-1));
+	new(p) type(std::forward<args_t>(args)...);
+	--Start;
+	++Size;
+	return *p;
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& deque<type, alloc_t>::emplaceBack(args_t&&... args) {
+	if (Start + Size == NumBlocks * BLOCK_SIZE) {
+		addBackBlock();
+	}
+	type* const p = new(item(Size)) type(std::forward<args_t>(args)...);
+	++Size;
+	return *p;
+}
+
+//---------------------------------------------------------------------
+//			Traversal
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+type& deque<type, alloc_t>::front() {
+	return *item(0);
+}
+
+template <typename type, typename alloc_t>
+type& deque<type, alloc_t>::back() {
+	return *item(Size-1);
+}
+
+template <typename type, typename alloc_t>
+int deque<type, alloc_t>::numBlocks() const {
+	return NumBlocks;
+}
+
+template <typename type, typename alloc_t>
+type* deque<type, alloc_t>::blockData(int block) const {
+	HL_ASSERT(block >= 0 && block < NumBlocks);
+	return Map[FirstBlock+block] + ((block == 0) ? Start : 0);
+}
+
+template <typename type, typename alloc_t>
+int deque<type, alloc_t>::blockSize(int block) const {
+	//the first and last blocks may be partially filled
+	const int first = HL_MAX(block * BLOCK_SIZE, Start);
+	const int last = (block+1) * BLOCK_SIZE < Start + Size ? (block+1) * BLOCK_SIZE : Start + Size;
+	return (last > first) ? last - first : 0;
+}
+
+template <typename type, typename alloc_t>
+typename deque<type, alloc_t>::iterator deque<type, alloc_t>::begin() {
+	return iterator(this, 0);
+}
+
+template <typename type, typename alloc_t>
+typename deque<type, alloc_t>::iterator deque<type, alloc_t>::end() {
+	return iterator(this, Size);
+}
+
+template <typename type, typename alloc_t>
+typename deque<type, alloc_t>::constIterator deque<type, alloc_t>::begin() const {
+	return constIterator(this, 0);
+}
+
+template <typename type, typename alloc_t>
+typename deque<type, alloc_t>::constIterator deque<type, alloc_t>::end() const {
+	return constIterator(this, Size);
+}
+
+//---------------------------------------------------------------------
+//			Misc
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::shrinkToFit() {
+	if (Spare) {
+		utils::deallocateItems(allocator, Spare, BLOCK_SIZE);
+		Spare = nullptr;
+	}
+	if (!NumBlocks) {
+		utils::deallocateItems(allocator, Map, MapCapacity);
+		Map = nullptr;
+		MapCapacity = FirstBlock = 0;
+	}
+}
+
+template <typename type, typename alloc_t>
+void deque<type, alloc_t>::clear() {
+	//every block but the spare is released
+	while (Size) {
+		popBack();
+	}
+	while (NumBlocks) {
+		--NumBlocks;
+		freeBlock(Map[FirstBlock+NumBlocks]);
+	}
+	Start = 0;
+}
+
+template <typename type, typename alloc_t>
+bool deque<type, alloc_t>::empty() const {
+	return Size == 0;
+}
+
+template <typename type, typename alloc_t>
+int deque<type, alloc_t>::size() const {
+	return Size;
+}
+
+template <typename type, typename alloc_t>
+alloc_t& deque<type, alloc_t>::getAllocator() {
+	return allocator;
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+
+#endif /* __HL_DEQUE_H__ */
@@ -0,0 +1,394 @@
+/*
+ * An intrusive doubly linked list.
+ * Rather than copying objects into nodes of its own, the list links objects
+ * through a listHook which they inherit. The list never allocates memory and
+ * never owns the objects it links; pushing and popping only rewires
+ * pointers, so both take constant time, as does removing an object from the
+ * middle of the list.
+ *
+ * An object can sit in several lists at once by inheriting one hook per list,
+ * each distinguished by a tag type:
+ *
+ *		struct eventTag {};
+ *		struct dirtyTag {};
+ *
+ *		struct entity : listHook<eventTag>, listHook<dirtyTag> {...};
+ *
+ *		intrusiveList<entity, eventTag> events;
+ *		intrusiveList<entity, dirtyTag> dirty;
+ *
+ * Since any object can be unlinked in constant time, hooks also suit hash
+ * table buckets whose entries are removed by identity.
+ *
+ * Objects must be popped from a list before they are destroyed, and must not
+ * move in memory while they are linked. Copying an object does not copy its
+ * links. Destroying a list unlinks every object in it.
+ *
+ * An object can only be popped from the list it is linked into. Popping it
+ * from another list of the same kind would unlink it anyway, leaving both
+ * lists with the wrong size(); builds which define HL_DEBUG assert against
+ * this, at the cost of walking the list on every pop().
+ *
+ * Lists can be walked with bidirectional iterators from begin() and end().
+ */
+
+#ifndef __HL_INTRUSIVE_LIST_H__
+#define __HL_INTRUSIVE_LIST_H__
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "../utils/assert.h"
+
+namespace hamLibs {
+namespace containers {
+
+struct defaultListTag {};
+
+template <typename type, typename tag_t>
+class intrusiveList;
+
+//---------------------------------------------------------------------
+//			List Hook
+//---------------------------------------------------------------------
+template <typename tag_t = defaultListTag>
+class listHook {
+	template <typename, typename> friend class intrusiveList;
+
+	private:
+		listHook* next;
+		listHook* prev;
+
+	public:
+		listHook() : next(nullptr), prev(nullptr) {}
+		listHook(const listHook&) : next(nullptr), prev(nullptr) {}
+
+		listHook& operator = (const listHook&) { return *this; }
+
+		bool isLinked() const { return next != nullptr; }
+};
+
+//---------------------------------------------------------------------
+//			Intrusive List
+//---------------------------------------------------------------------
+template <typename type, typename tag_t = defaultListTag>
+class intrusiveList {
+	private:
+		typedef listHook<tag_t> hook_t;
+
+		hook_t	mainHook;	//links the list's first and last objects together
+		int		numLinks;
+
+		static hook_t*	toHook		(type& obj) { return static_cast<hook_t*>(&obj); }
+		type*			toObject	(hook_t* h) const;
+		void			link		(hook_t* h, hook_t* pos);
+		void			unlink		(hook_t* h);
+		void			steal		(intrusiveList& other);
+
+		//iterates through objects by their hooks
+		template <typename value_t>
+		class hookIterator {
+			friend class intrusiveList;
+			template <typename> friend class hookIterator;
+
+			private:
+				hook_t*	current;
+
+				explicit hookIterator(hook_t* h) : current(h) {}
+
+			public:
+				typedef std::bidirectional_iterator_tag				iterator_category;
+				typedef typename std::remove_const<value_t>::type	value_type;
+				typedef std::ptrdiff_t								difference_type;
+				typedef value_t*									pointer;
+				typedef value_t&									reference;
+
+				hookIterator() : current(nullptr) {}
+
+				template <typename other_t, typename = typename std::enable_if<std::is_convertible<other_t*, value_t*>::value>::type>
+				hookIterator(const hookIterator<other_t>& i) : current(i.current) {}
+
+				value_t&		operator *	() const { return static_cast<value_t&>(*current); }
+				value_t*		operator ->	() const { return static_cast<value_t*>(current); }
+
+				hookIterator&	operator ++	()		{ current = current->next; return *this; }
+				hookIterator	operator ++	(int)	{ hookIterator temp(*this); current = current->next; return temp; }
+				hookIterator&	operator --	()		{ current = current->prev; return *this; }
+				hookIterator	operator --	(int)	{ hookIterator temp(*this); current = current->prev; return temp; }
+
+				template <typename other_t>
+				bool operator ==	(const hookIterator<other_t>& i) const { return current == i.current; }
+				template <typename other_t>
+				bool operator !=	(const hookIterator<other_t>& i) const { return current != i.current; }
+		};
+
+	public:
+		typedef hookIterator<type>			iterator;
+		typedef hookIterator<const type>	constIterator;
+
+		intrusiveList	();
+		intrusiveList	(const intrusiveList&) = delete;
+		intrusiveList	(intrusiveList&& moved);
+		~intrusiveList	();
+
+		intrusiveList&	operator =	(const intrusiveList&) = delete;
+		intrusiveList&	operator =	(intrusiveList&& moved);
+
+		//data acquisition
+		type*		getFirst	() const;			//returns nullptr if the list is empty
+		type*		getLast		() const;
+		type*		getNext		(type& obj) const;	//returns nullptr at the end of the list
+		type*		getPrev		(type& obj) const;	//returns nullptr at the beginning of the list
+
+		//insertion
+		void		pushFront	(type& obj);
+		void		pushBack	(type& obj);
+		void		pushBefore	(type& pos, type& obj);	//link "obj" in front of "pos", which must be in this list
+		void		pushAfter	(type& pos, type& obj);
+		void		spliceBack	(intrusiveList& other);	//move every object of "other" to the end of this list
+
+		//deletion
+		void		pop			(type& obj);		//unlink an object, which must be in this list
+		void		popFront	();
+		void		popBack		();
+		void		clear		();
+
+		//iteration
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
+		//miscellaneous
+		static bool	isLinked	(const type& obj);	//check if an object is in any list of this kind
+		bool		contains	(const type& obj) const;	//check if an object is in this list, by walking it
+		int			size		() const;
+		bool		empty		() const;
+};
+
+//---------------------------------------------------------------------
+//			Linking
+//---------------------------------------------------------------------
+template <typename type, typename tag_t>
+inline type* intrusiveList<type, tag_t>::toObject(hook_t* h) const {
+	return (h == &mainHook) ? nullptr : static_cast<type*>(h);
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::link(hook_t* h, hook_t* pos) {
+	HL_ASSERT(!h->isLinked());
+	h->next = pos;
+	h->prev = pos->prev;
+	pos->prev->next = h;
+	pos->prev = h;
+	++numLinks;
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::unlink(hook_t* h) {
+	h->prev->next = h->next;
+	h->next->prev = h->prev;
+	h->next = h->prev = nullptr;
+	--numLinks;
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::steal(intrusiveList& other) {
+	if (other.empty()) return;
+
+	//the end objects point at the other list's main hook, so relink them
+	mainHook.next = other.mainHook.next;
+	mainHook.prev = other.mainHook.prev;
+	mainHook.next->prev = &mainHook;
+	mainHook.prev->next = &mainHook;
+	numLinks = other.numLinks;
+
+	other.mainHook.next = other.mainHook.prev = &other.mainHook;
+	other.numLinks = 0;
+}
+
+//---------------------------------------------------------------------
+//			[Con/De]struction
+//---------------------------------------------------------------------
+template <typename type, typename tag_t>
+intrusiveList<type, tag_t>::intrusiveList() :
+	mainHook(),
+	numLinks(0)
+{
+	mainHook.next = mainHook.prev = &mainHook;
+}
+
+template <typename type, typename tag_t>
+intrusiveList<type, tag_t>::intrusiveList(intrusiveList&& moved) :
+	intrusiveList()
+{
+	steal(moved);
+}
+
+template <typename type, typename tag_t>
+intrusiveList<type, tag_t>::~intrusiveList() {
+	clear();
+	mainHook.next = mainHook.prev = nullptr;
+}
+
+template <typename type, typename tag_t>
+intrusiveList<type, tag_t>& intrusiveList<type, tag_t>::operator = (intrusiveList&& moved) {
+	if (this != &moved) {
+		clear();
+		steal(moved);
+	}
+	return *this;
+}
+
+//---------------------------------------------------------------------
+//			Data Acquisition
+//---------------------------------------------------------------------
+template <typename type, typename tag_t>
+type* intrusiveList<type, tag_t>::getFirst() const {
+	return toObject(mainHook.next);
+}
+
+template <typename type, typename tag_t>
+type* intrusiveList<type, tag_t>::getLast() const {
+	return toObject(mainHook.prev);
+}
+
+template <typename type, typename tag_t>
+type* intrusiveList<type, tag_t>::getNext(type& obj) const {
+	return toObject(toHook(obj)->next);
+}
+
+template <typename type, typename tag_t>
+type* intrusiveList<type, tag_t>::getPrev(type& obj) const {
+	return toObject(toHook(obj)->prev);
+}
+
+//---------------------------------------------------------------------
+//			Insertion
+//---------------------------------------------------------------------
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::pushFront(type& obj) {
+	link(toHook(obj), mainHook.next);
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::pushBack(type& obj) {
+	link(toHook(obj), &mainHook);
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::pushBefore(type& pos, type& obj) {
+	link(toHook(obj), toHook(pos));
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::pushAfter(type& pos, type& obj) {
+	link(toHook(obj), toHook(pos)->next);
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::spliceBack(intrusiveList& other) {
+	if (this == &other || other.empty()) return;
+
+	hook_t* first = other.mainHook.next;
+	hook_t* last = other.mainHook.prev;
+	first->prev = mainHook.prev;
+	last->next = &mainHook;
+	mainHook.prev->next = first;
+	mainHook.prev = last;
+	numLinks += other.numLinks;
+
+	other.mainHook.next = other.mainHook.prev = &other.mainHook;
+	other.numLinks = 0;
+}
+
+//---------------------------------------------------------------------
+//			Deletion
+//---------------------------------------------------------------------
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::pop(type& obj) {
+	hook_t* h = toHook(obj);
+	if (h->isLinked()) {
+	#ifdef HL_DEBUG
+		HL_ASSERT(contains(obj));
+	#endif
+		unlink(h);
+	}
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::popFront() {
+	if (!empty()) {
+		unlink(mainHook.next);
+	}
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::popBack() {
+	if (!empty()) {
+		unlink(mainHook.prev);
+	}
+}
+
+template <typename type, typename tag_t>
+void intrusiveList<type, tag_t>::clear() {
+	while (!empty()) {
+		unlink(mainHook.next);
+	}
+}
+
+//---------------------------------------------------------------------
+//			Iteration
+//---------------------------------------------------------------------
+template <typename type, typename tag_t>
+typename intrusiveList<type, tag_t>::iterator intrusiveList<type, tag_t>::begin() {
+	return iterator(mainHook.next);
+}
+
+template <typename type, typename tag_t>
+typename intrusiveList<type, tag_t>::iterator intrusiveList<type, tag_t>::end() {
+	return iterator(&mainHook);
+}
+
+template <typename type, typename tag_t>
+typename intrusiveList<type, tag_t>::constIterator intrusiveList<type, tag_t>::begin() const {
+	return constIterator(mainHook.next);
+}
+
+template <typename type, typename tag_t>
+typename intrusiveList<type, tag_t>::constIterator intrusiveList<type, tag_t>::end() const {
+	//the main hook is never written through a const iterator
+	return constIterator(const_cast<hook_t*>(&mainHook));
+}
+
+//---------------------------------------------------------------------
+//			Miscellaneous
+//---------------------------------------------------------------------
+template <typename type, typename tag_t>
+bool intrusiveList<type, tag_t>::isLinked(const type& obj) {
+	return static_cast<const hook_t&>(obj).isLinked();
+}
+
+template <typename type, typename tag_t>
+bool intrusiveList<type, tag_t>::contains(const type& obj) const {
+	const hook_t* const h = &static_cast<const hook_t&>(obj);
+	for (const hook_t* iter = mainHook.next; iter != &mainHook; iter = iter->next) {
+		if (iter == h) return true;
+	}
+	return false;
+}
+
+template <typename type, typename tag_t>
+int intrusiveList<type, tag_t>::size() const {
+	return numLinks;
+}
+
+template <typename type, typename tag_t>
+bool intrusiveList<type, tag_t>::empty() const {
+	return mainHook.next == &mainHook;
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+
+#endif /* __HL_INTRUSIVE_LIST_H__ */
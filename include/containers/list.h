@@ -1,291 +1,691 @@
-/*
- * linked list class
- * --------------------------------------------------------------------
- * 
- * I really feel like shit for writing this code the way I did, but I did it to
- * make the implementation as easy and efficient as I know how.
- * 
- * The linked list is actually implemented as a "looped" list so that the start
- * and endpoints of the list are linked together.
- * In order to avoid problems with this kind of implementation, and to ease in
- * node navigation, I inserted a spacer in between the first and last nodes.
- * This was necessary, but actually turned into a happy accident.
- * --------------------------------------------------------------------
- * 
- * NOTES:
- * The head node is a pointer which navigates through the list.
- * After any insertion, the head node will point to the node which was inserted.
- * After any deletion, the head pointer will point to the next element in the
- * list. If the item deleted is the last node in the list, then the head node
- * will point to the next-to-last node (which becomes the last node).
- * Popping a node off the list WILL NOT free the data that the node points to.
- * I decided to leave it up to the users implementation to determine how the
- * data in a node is deleted.
-*/
-
-#ifndef __HL_LINKEDLIST__
-#define __HL_LINKEDLIST__
-
-namespace hamLibs {
-namespace containers {
-
-template <typename type>
-class list {
-	private:
-		struct node {
-			type	data;
-			node	*next;
-			node	*prev;
-			node();
-		};
-		
-		node		mainNode;	//mainNode serves as the list's beginning and end
-		node		*iter;		//List navigation pointer
-		int	numNodes;
-		
-	public:
-		list	();
-		list	(const list& listCopy);
-		~list	();
-		list&	operator=	(const list& listCopy);
-
-		//link navigation
-		void		goToFront	();			//immediately move "iter" to the front of the list
-		void		goToBack	();			//immediately move "iter" to the end of the list
-		void		goToNext	();			//move iter to the next node in the list if it's not at the end
-		void		goToPrev	();			//move iter to the previous node in the list if it's not at the beginning
-
-		//data acquisition
-		type*		getFirst	() const;		//get the first item. returns nullptr if no objects exist within the list. Does not move the iterator
-		type*		getLast		() const;		//get the last item. returns nullptr if no objects exist within the list. Does not move the iterator.
-		type*		getCurrent	() const;		//get currently selected item. returns nullptr if no objects exist within the list
-		type*		getNext		() const;		//increment selection ("iter") pointer, return its data (returns nullptr if at the end of the list)
-		type*		getPrev		() const;		//decrement selection ("iter") pointer, return its data (returns nullptr if at the end of the list)
-		type*		peekNext	() const;		//get the next item in the list without incrementing the "iter" pointer
-		type*		peekPrev	() const;
-
-		//insertion
-		void		pushFront	(const type& object);	//add an element to the front of the list
-		void		pushBack	(const type& object);	//add an element to the end of the list
-		void		pushBefore	(const type& object);	//add an element in front of the "iter" pointer; move the iter pointer to the new node
-		void		pushAfter	(const type& object);	//add an element behind the "iter" pointer, move the iter pointer to the new node
-
-		//deletion
-		void		popnode		();				//delete the node pointer to by "iter", move to the next node
-		void		popFront	();				//delete the front node; move "iter" to the following node
-		void		popBack		();				//delete the node pointed to by "iter". move to the next node. (will move to the previous node if at the end of the list)
-		void		clear		();				//delete all elements in the list
-
-		//miscellaneous
-		int	size		() const;
-		bool		empty		() const;		//check if the list is empty
-};
-
-//-----------------------------------------------------------------------------
-//			Construction & Destruction
-//-----------------------------------------------------------------------------
-template <typename type>
-list<type>::node::node() :
-	data(),
-	next(nullptr),
-	prev(nullptr)
-{}
-
-template <typename type>
-list<type>::list() :
-	mainNode(),
-	iter(&mainNode),
-	numNodes(0)
-{
-	iter->next = iter;
-	iter->prev = iter;
-}
-
-template <typename type>
-list<type>::list(const list& listCopy) {
-	*this = listCopy;
-}
-
-template <typename type>
-list<type>::~list() {
-	clear();
-}
-
-template <typename type>
-list<type>& list<type>::operator =(const list& listCopy) {
-	const node* iterPos = iter; //preserve the iteration position
-	int iterating(size);
-	
-	listCopy.clear();
-	this->goToFront();
-	while (iterating--) {
-		listCopy.pushBack( this->getCurrent() );
-		this->goToNext();
-	}
-	iter = iterPos; //restore the iteration position
-}
-
-//-----------------------------------------------------------------------------
-//			Link Navigation
-//-----------------------------------------------------------------------------
-template <typename type>
-void list<type>::goToFront() {
-	iter = mainNode.next;
-}
-
-template <typename type>
-void list<type>::goToBack() {
-	iter = mainNode.prev;
-}
-
-template <typename type>
-void list<type>::goToNext() {
-	if (iter->next != &mainNode) {
-		iter = iter->next;
-	}
-}
-
-template <typename type>
-void list<type>::goToPrev() {
-	if (iter->prev != &mainNode) {
-		iter = iter->prev;
-	}
-}
-
-//-----------------------------------------------------------------------------
-//			Data Acquisition
-//-----------------------------------------------------------------------------
-template <typename type>
-type* list<type>::getFirst() const {
-	return &(mainNode.next->data);
-}
-template <typename type>
-type* list<type>::getLast() const {
-	return &(mainNode.prev->data);
-}
-template <typename type>
-type* list<type>::getCurrent() const {
-	return &(iter->data);
-}
-
-template <typename type>
-type* list<type>::getNext() const {
-	if (iter->next != &mainNode) {
-		iter = iter->next;
-		return &(iter->data);
-	}
-	else {
-		return nullptr;
-	}
-}
-
-template <typename type>
-type* list<type>::getPrev() const {
-	if (iter->prev != &mainNode) {
-		iter = iter->prev;
-		return &(iter->data);
-	}
-	else {
-		return nullptr;
-	}
-}
-
-template <typename type>
-type* list<type>::peekNext() const {
-	return &(iter->next->data);
-}
-
-template <typename type>
-type* list<type>::peekPrev() const {
-	return &(iter->prev->data);
-}
-
-//-----------------------------------------------------------------------------
-//			Insertion
-//-----------------------------------------------------------------------------
-template <typename type>
-void list<type>::pushFront(const type& object) {
-	iter = mainNode.next;
-	pushBefore(object);
-}
-
-template <typename type>
-void list<type>::pushBack(const type& object) {
-	iter = &mainNode;
-	pushBefore(object);
-}
-
-template <typename type>
-void list<type>::pushBefore(const type& object) {
-	node* temp = new node;
-	temp->data = object;
-	
-	temp->next = iter;
-	temp->prev = iter->prev;
-	temp->prev->next = temp;
-	iter->prev = temp;
-	iter = temp;
-	
-	++numNodes;
-}
-
-template <typename type>
-void list<type>::pushAfter(const type& object) {
-	iter = iter->next;
-	pushBefore(object);
-}
-
-//-----------------------------------------------------------------------------
-//			Deletion
-//-----------------------------------------------------------------------------
-template <typename type>
-void list<type>::popnode() {
-	//make sure that there's actually something to delete
-	if (iter == &mainNode) return;
-	node* temp = iter;
-	iter = iter->next;
-	iter->prev = temp->prev;
-	temp->prev->next = iter;
-	delete temp;
-
-	//move to the last node if necessary
-	if (iter == &mainNode) iter = mainNode.prev;
-	--numNodes;
-}
-
-template <typename type>
-void list<type>::popFront() {
-	iter = mainNode.next;
-	popnode();
-}
-
-template <typename type>
-void list<type>::popBack() {
-	iter = mainNode.prev;
-	popnode();
-}
-
-template <typename type>
-void list<type>::clear() {
-	iter = mainNode.next;
-	while (iter != &mainNode) {
-		popnode();
-	}
-}
-
-//-----------------------------------------------------------------------------
-//			Miscellaneous
-//-----------------------------------------------------------------------------
-template <typename type>
-int list<type>::size() const {
-	return numNodes;
-}
-
-template <typename type>
-bool list<type>::empty() const {
-	return (mainNode.next != &mainNode) ? false : true;
-}
-
-} //end containers namespace
-} //end hamLibs namespace
-#endif //__HL_LINKEDLIST__
+/*
+ * linked list class
+ * --------------------------------------------------------------------
+ * 
+ * I really feel like shit for writing this code the way I did, but I did it to
+ * make the implementation as easy and efficient as I know how.
+ * 
+ * The linked list is actually implemented as a "looped" list so that the start
+ * and endpoints of the list are linked together.
+ * In order to avoid problems with this kind of implementation, and to ease in
+ * node navigation, I inserted a spacer in between the first and last nodes.
+ * This was necessary, but actually turned into a happy accident.
+ * --------------------------------------------------------------------
+ * 
+ * NOTES:
+ * The head node is a pointer which navigates through the list.
+ * After any insertion, the head node will point to the node which was inserted.
+ * After any deletion, the head pointer will point to the next element in the
+ * list. If the item deleted is the last node in the list, then the head node
+ * will point to the next-to-last node (which becomes the last node).
+ * Popping a node off the list WILL NOT free the data that the node points to.
+ * I decided to leave it up to the users implementation to determine how the
+ * data in a node is deleted.
+ *
+ * Nodes are carved out of blocks by a node pool, and popped nodes are kept on
+ * a freelist for reuse, so pushing and popping rarely touches the heap and
+ * neighboring nodes tend to sit next to each other in memory. The blocks are
+ * reserved through 'alloc_t' (see utils/allocator.h).
+ *
+ * Splicing and merging relink nodes from another list without reallocating
+ * them. The two lists then share one pool, which lives until the last list
+ * using it is destroyed. Lists whose allocators differ cannot share a pool,
+ * so their elements are moved into new nodes instead.
+ * The shared pool is not thread-safe: pushing or popping on any list which
+ * uses it touches the same freelist. Lists which have exchanged nodes must
+ * stay on one thread, unless detachPool() is called first to move a list's
+ * elements into a pool of its own.
+ *
+ * Besides "iter", the list can be walked with bidirectional iterators from
+ * begin() and end(). These only hold a node pointer, so they never disturb
+ * "iter" or each other, and a const list can be read by several threads at
+ * once through them.
+*/
+
+#ifndef __HL_LINKEDLIST__
+#define __HL_LINKEDLIST__
+
+#include <functional>
+#include <new>
+#include <utility>
+#include "../utils/allocator.h"
+#include "../utils/iterators.h"
+#include "../utils/nodePool.h"
+
+namespace hamLibs {
+namespace containers {
+
+template <typename type, typename alloc_t = utils::heapAllocator>
+class list {
+	private:
+		struct node {
+			type	data;
+			node	*next;
+			node	*prev;
+			template <typename... args_t>
+			node(args_t&&... args);
+		};
+
+		typedef utils::nodePool<node, 64, alloc_t> pool_t;
+
+		//pool of nodes shared by every list which has exchanged nodes
+		struct nodeStore {
+			pool_t		pool;
+			nodeStore	*merged;	//store which absorbed this one's blocks
+			int			numRefs;	//lists and merged stores using this one
+			nodeStore(const alloc_t& a);
+		};
+		
+		alloc_t		allocator;
+		node		mainNode;	//mainNode serves as the list's beginning and end
+		node		*iter;		//List navigation pointer
+		nodeStore	*store;		//created along with the first node
+		int	numNodes;
+
+		nodeStore*	getStore	();
+		void		releaseStore	(nodeStore* s);
+		bool		sharePool	(list& other);
+		template <typename... args_t>
+		node*		createNode	(args_t&&... args);
+		void		destroyNode	(node* n);
+		void		link		(node* n, node* pos);
+		node*		unlink		(node* n);
+		node*		takeNode	(list& other, node* n, bool shared);
+		
+	public:
+		typedef utils::nodeIterator<node, type, std::bidirectional_iterator_tag>		iterator;
+		typedef utils::nodeIterator<node, const type, std::bidirectional_iterator_tag>	constIterator;
+
+		list	();
+		explicit list	(const alloc_t& a);
+		list	(const list& listCopy);
+		list	(list&& moved);
+		~list	();
+		list&	operator=	(const list& listCopy);
+		list&	operator=	(list&& moved);
+
+		//link navigation
+		void		goToFront	();			//immediately move "iter" to the front of the list
+		void		goToBack	();			//immediately move "iter" to the end of the list
+		void		goToNext	();			//move iter to the next node in the list if it's not at the end
+		void		goToPrev	();			//move iter to the previous node in the list if it's not at the beginning
+
+		//data acquisition
+		type*		getFirst	() const;		//get the first item. returns nullptr if no objects exist within the list. Does not move the iterator
+		type*		getLast		() const;		//get the last item. returns nullptr if no objects exist within the list. Does not move the iterator.
+		type*		getCurrent	() const;		//get currently selected item. returns nullptr if no objects exist within the list
+		type*		getNext		();				//increment selection ("iter") pointer, return its data (returns nullptr if at the end of the list)
+		type*		getPrev		();				//decrement selection ("iter") pointer, return its data (returns nullptr if at the end of the list)
+		type*		peekNext	() const;		//get the next item in the list without incrementing the "iter" pointer
+		type*		peekPrev	() const;
+
+		//insertion
+		void		pushFront	(const type& object);	//add an element to the front of the list
+		void		pushBack	(const type& object);	//add an element to the end of the list
+		void		pushBefore	(const type& object);	//add an element in front of the "iter" pointer; move the iter pointer to the new node
+		void		pushAfter	(const type& object);	//add an element behind the "iter" pointer, move the iter pointer to the new node
+		void		pushFront	(type&& object);
+		void		pushBack	(type&& object);
+		void		pushBefore	(type&& object);
+		void		pushAfter	(type&& object);
+		template <typename... args_t>
+		type&		emplaceFront	(args_t&&... args);	//construct an element in place; "iter" moves to it as with the push methods
+		template <typename... args_t>
+		type&		emplaceBack		(args_t&&... args);
+		template <typename... args_t>
+		type&		emplaceBefore	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplaceAfter	(args_t&&... args);
+
+		//deletion
+		void		popnode		();				//delete the node pointer to by "iter", move to the next node
+		void		popFront	();				//delete the front node; move "iter" to the following node
+		void		popBack		();				//delete the node pointed to by "iter". move to the next node. (will move to the previous node if at the end of the list)
+		void		clear		();				//delete all elements in the list
+
+		//node transfer
+		void		spliceBefore	(list& other);	//move every node of "other" in front of the "iter" pointer; move the iter pointer to the first moved node
+		void		spliceAfter		(list& other);	//move every node of "other" behind the "iter" pointer; move the iter pointer to the first moved node
+		void		spliceNode		(list& other);	//move the node at other's "iter" pointer in front of this list's "iter" pointer; move the iter pointer to it
+		template <typename compare_t = std::less<type>>
+		void		merge		(list& other, compare_t comp = compare_t());	//merge the sorted list "other" into this sorted list, leaving "other" empty
+		void		detachPool	();				//stop sharing a pool with other lists by moving every element into a new one; "iter" keeps its position
+
+		//iteration, independent of "iter"
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
+		//miscellaneous
+		int	size		() const;
+		bool		empty		() const;		//check if the list is empty
+		alloc_t&	getAllocator	();
+};
+
+//-----------------------------------------------------------------------------
+//			Construction & Destruction
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+template <typename... args_t>
+list<type, alloc_t>::node::node(args_t&&... args) :
+	data(std::forward<args_t>(args)...),
+	next(nullptr),
+	prev(nullptr)
+{}
+
+template <typename type, typename alloc_t>
+list<type, alloc_t>::nodeStore::nodeStore(const alloc_t& a) :
+	pool(a),
+	merged(nullptr),
+	numRefs(1)
+{}
+
+template <typename type, typename alloc_t>
+list<type, alloc_t>::list() :
+	allocator(),
+	mainNode(),
+	iter(&mainNode),
+	store(nullptr),
+	numNodes(0)
+{
+	iter->next = iter;
+	iter->prev = iter;
+}
+
+template <typename type, typename alloc_t>
+list<type, alloc_t>::list(const alloc_t& a) :
+	allocator(a),
+	mainNode(),
+	iter(&mainNode),
+	store(nullptr),
+	numNodes(0)
+{
+	iter->next = iter;
+	iter->prev = iter;
+}
+
+template <typename type, typename alloc_t>
+list<type, alloc_t>::list(const list& listCopy) :
+	list(listCopy.allocator)
+{
+	*this = listCopy;
+}
+
+template <typename type, typename alloc_t>
+list<type, alloc_t>::list(list&& moved) :
+	list(moved.allocator)
+{
+	*this = std::move(moved);
+}
+
+template <typename type, typename alloc_t>
+list<type, alloc_t>::~list() {
+	clear();
+	releaseStore(store);
+}
+
+template <typename type, typename alloc_t>
+list<type, alloc_t>& list<type, alloc_t>::operator =(const list& listCopy) {
+	if (this == &listCopy) return *this;
+
+	clear();
+	for (const type& object : listCopy) {
+		pushBack(object);
+	}
+	goToFront();
+	return *this;
+}
+
+template <typename type, typename alloc_t>
+list<type, alloc_t>& list<type, alloc_t>::operator =(list&& moved) {
+	if (this == &moved) return *this;
+
+	//the nodes stay in their pool, which now belongs to this list
+	clear();
+	releaseStore(store);
+	store = moved.store;
+	moved.store = nullptr;
+
+	if (!moved.empty()) {
+		//the end nodes point at the other list's main node, so relink them
+		mainNode.next = moved.mainNode.next;
+		mainNode.prev = moved.mainNode.prev;
+		mainNode.next->prev = &mainNode;
+		mainNode.prev->next = &mainNode;
+		iter = (moved.iter != &moved.mainNode) ? moved.iter : mainNode.next;
+		numNodes = moved.numNodes;
+
+		moved.mainNode.next = moved.mainNode.prev = &moved.mainNode;
+		moved.iter = &moved.mainNode;
+		moved.numNodes = 0;
+	}
+
+	allocator = std::move(moved.allocator);
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+//			Node Storage
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+typename list<type, alloc_t>::nodeStore* list<type, alloc_t>::getStore() {
+	if (!store) {
+		store = utils::createItem<nodeStore>(allocator, allocator);
+	}
+
+	//follow stores which were merged into others, dropping the old ones
+	while (store->merged) {
+		nodeStore* next = store->merged;
+		++next->numRefs;
+		releaseStore(store);
+		store = next;
+	}
+	return store;
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::releaseStore(nodeStore* s) {
+	while (s && --s->numRefs == 0) {
+		nodeStore* next = s->merged;
+		utils::destroyItem(allocator, s);
+		s = next;
+	}
+}
+
+template <typename type, typename alloc_t>
+bool list<type, alloc_t>::sharePool(list& other) {
+	if (!(allocator == other.allocator)) return false;
+
+	nodeStore* mine = getStore();
+	nodeStore* theirs = other.getStore();
+	if (mine != theirs) {
+		mine->pool.absorb(theirs->pool);
+		theirs->merged = mine;
+		++mine->numRefs;
+		other.getStore();
+	}
+	return true;
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+typename list<type, alloc_t>::node* list<type, alloc_t>::createNode(args_t&&... args) {
+	pool_t& pool = getStore()->pool;
+	node* n = pool.allocate();
+
+	try {
+		return new(n) node(std::forward<args_t>(args)...);
+	}
+	catch (...) {
+		pool.deallocate(n);
+		throw;
+	}
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::destroyNode(node* n) {
+	n->~node();
+	getStore()->pool.deallocate(n);
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::link(node* n, node* pos) {
+	n->next = pos;
+	n->prev = pos->prev;
+	pos->prev->next = n;
+	pos->prev = n;
+	++numNodes;
+}
+
+template <typename type, typename alloc_t>
+typename list<type, alloc_t>::node* list<type, alloc_t>::unlink(node* n) {
+	//the iterator follows the same rules as popnode()
+	if (iter == n) {
+		iter = (n->next != &mainNode) ? n->next : n->prev;
+	}
+	n->prev->next = n->next;
+	n->next->prev = n->prev;
+	--numNodes;
+	return n;
+}
+
+template <typename type, typename alloc_t>
+typename list<type, alloc_t>::node* list<type, alloc_t>::takeNode(list& other, node* n, bool shared) {
+	other.unlink(n);
+	if (shared) return n;
+
+	//the pools are separate, so the element moves into a node of our own
+	node* temp;
+	try {
+		temp = createNode(std::move(n->data));
+	}
+	catch (...) {
+		other.link(n, n->next);
+		throw;
+	}
+	other.destroyNode(n);
+	return temp;
+}
+
+//-----------------------------------------------------------------------------
+//			Link Navigation
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::goToFront() {
+	iter = mainNode.next;
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::goToBack() {
+	iter = mainNode.prev;
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::goToNext() {
+	if (iter->next != &mainNode) {
+		iter = iter->next;
+	}
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::goToPrev() {
+	if (iter->prev != &mainNode) {
+		iter = iter->prev;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//			Data Acquisition
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+type* list<type, alloc_t>::getFirst() const {
+	return &(mainNode.next->data);
+}
+template <typename type, typename alloc_t>
+type* list<type, alloc_t>::getLast() const {
+	return &(mainNode.prev->data);
+}
+template <typename type, typename alloc_t>
+type* list<type, alloc_t>::getCurrent() const {
+	return &(iter->data);
+}
+
+template <typename type, typename alloc_t>
+type* list<type, alloc_t>::getNext() {
+	if (iter->next != &mainNode) {
+		iter = iter->next;
+		return &(iter->data);
+	}
+	else {
+		return nullptr;
+	}
+}
+
+template <typename type, typename alloc_t>
+type* list<type, alloc_t>::getPrev() {
+	if (iter->prev != &mainNode) {
+		iter = iter->prev;
+		return &(iter->data);
+	}
+	else {
+		return nullptr;
+	}
+}
+
+template <typename type, typename alloc_t>
+type* list<type, alloc_t>::peekNext() const {
+	return &(iter->next->data);
+}
+
+template <typename type, typename alloc_t>
+type* list<type, alloc_t>::peekPrev() const {
+	return &(iter->prev->data);
+}
+
+//-----------------------------------------------------------------------------
+//			Insertion
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::pushFront(const type& object) {
+	emplaceFront(object);
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::pushFront(type&& object) {
+	emplaceFront(std::move(object));
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::pushBack(const type& object) {
+	emplaceBack(object);
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::pushBack(type&& object) {
+	emplaceBack(std::move(object));
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::pushBefore(const type& object) {
+	emplaceBefore(object);
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::pushBefore(type&& object) {
+	emplaceBefore(std::move(object));
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::pushAfter(const type& object) {
+	emplaceAfter(object);
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::pushAfter(type&& object) {
+	emplaceAfter(std::move(object));
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& list<type, alloc_t>::emplaceFront(args_t&&... args) {
+	iter = mainNode.next;
+	return emplaceBefore(std::forward<args_t>(args)...);
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& list<type, alloc_t>::emplaceBack(args_t&&... args) {
+	iter = &mainNode;
+	return emplaceBefore(std::forward<args_t>(args)...);
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& list<type, alloc_t>::emplaceBefore(args_t&&... args) {
+	node* temp = createNode(std::forward<args_t>(args)...);
+	link(temp, iter);
+	iter = temp;
+	return temp->data;
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& list<type, alloc_t>::emplaceAfter(args_t&&... args) {
+	iter = iter->next;
+	return emplaceBefore(std::forward<args_t>(args)...);
+}
+
+//-----------------------------------------------------------------------------
+//			Deletion
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::popnode() {
+	//make sure that there's actually something to delete
+	if (iter == &mainNode) return;
+	node* temp = iter;
+	iter = iter->next;
+	iter->prev = temp->prev;
+	temp->prev->next = iter;
+	destroyNode(temp);
+
+	//move to the last node if necessary
+	if (iter == &mainNode) iter = mainNode.prev;
+	--numNodes;
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::popFront() {
+	iter = mainNode.next;
+	popnode();
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::popBack() {
+	iter = mainNode.prev;
+	popnode();
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::clear() {
+	iter = mainNode.next;
+	while (iter != &mainNode) {
+		popnode();
+	}
+}
+
+//-----------------------------------------------------------------------------
+//			Node Transfer
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::spliceBefore(list& other) {
+	if (&other == this || other.empty()) return;
+
+	if (!sharePool(other)) {
+		node* first = nullptr;
+		while (!other.empty()) {
+			node* n = takeNode(other, other.mainNode.next, false);
+			link(n, iter);
+			if (!first) first = n;
+		}
+		iter = first;
+		return;
+	}
+
+	//relink the whole chain of nodes at once
+	node* first = other.mainNode.next;
+	node* last = other.mainNode.prev;
+	other.mainNode.next = &other.mainNode;
+	other.mainNode.prev = &other.mainNode;
+	other.iter = &other.mainNode;
+
+	first->prev = iter->prev;
+	last->next = iter;
+	iter->prev->next = first;
+	iter->prev = last;
+	iter = first;
+
+	numNodes += other.numNodes;
+	other.numNodes = 0;
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::spliceAfter(list& other) {
+	if (&other == this || other.empty()) return;
+	iter = iter->next;
+	spliceBefore(other);
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::spliceNode(list& other) {
+	if (&other == this || other.iter == &other.mainNode) return;
+
+	node* n = takeNode(other, other.iter, sharePool(other));
+	link(n, iter);
+	iter = n;
+}
+
+template <typename type, typename alloc_t>
+template <typename compare_t>
+void list<type, alloc_t>::merge(list& other, compare_t comp) {
+	if (&other == this || other.empty()) return;
+
+	//equal elements from this list are kept in front of those from "other"
+	const bool shared = sharePool(other);
+	node* pos = mainNode.next;
+
+	while (!other.empty()) {
+		node* n = other.mainNode.next;
+		while (pos != &mainNode && !comp(n->data, pos->data)) {
+			pos = pos->next;
+		}
+		link(takeNode(other, n, shared), pos);
+	}
+}
+
+template <typename type, typename alloc_t>
+void list<type, alloc_t>::detachPool() {
+	if (!store || getStore()->numRefs == 1) return;
+
+	//move the elements into a list with a fresh pool, then take its nodes
+	list detached(allocator);
+	int position = 0;
+	for (node* n = mainNode.next; n != iter; n = n->next) {
+		++position;
+	}
+	for (type& object : *this) {
+		detached.pushBack(std::move(object));
+	}
+
+	*this = std::move(detached);
+	iter = mainNode.next;
+	while (position--) {
+		iter = iter->next;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//			Iteration
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+typename list<type, alloc_t>::iterator list<type, alloc_t>::begin() {
+	return iterator(mainNode.next);
+}
+
+template <typename type, typename alloc_t>
+typename list<type, alloc_t>::iterator list<type, alloc_t>::end() {
+	return iterator(&mainNode);
+}
+
+template <typename type, typename alloc_t>
+typename list<type, alloc_t>::constIterator list<type, alloc_t>::begin() const {
+	return constIterator(mainNode.next);
+}
+
+template <typename type, typename alloc_t>
+typename list<type, alloc_t>::constIterator list<type, alloc_t>::end() const {
+	//the sentinel is never written through a const iterator
+	return constIterator(const_cast<node*>(&mainNode));
+}
+
+//-----------------------------------------------------------------------------
+//			Miscellaneous
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+int list<type, alloc_t>::size() const {
+	return numNodes;
+}
+
+template <typename type, typename alloc_t>
+bool list<type, alloc_t>::empty() const {
+	return (mainNode.next != &mainNode) ? false : true;
+}
+
+template <typename type, typename alloc_t>
+alloc_t& list<type, alloc_t>::getAllocator() {
+	return allocator;
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+#endif //__HL_LINKEDLIST__
@@ -0,0 +1,417 @@
+/*
+ * File:   mpmcqueue.h
+ * Author: hammy
+ *
+ * Bounded, lock-free queue which may be shared by any number of producer and
+ * consumer threads.
+ */
+
+#ifndef __HL_MPMC_QUEUE_H__
+#define __HL_MPMC_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "../utils/allocator.h"
+
+namespace hamLibs {
+namespace containers {
+
+/******************************************************************************
+ *  Multi-Producer/Multi-Consumer Queue Structure Setup
+ *
+ * Elements are stored in a ring of cells whose size is a power of two. Each
+ * cell carries a sequence number which tells producers and consumers whether
+ * it is free to write or ready to read for the current lap around the ring
+ * (after Dmitry Vyukov's bounded MPMC queue). A thread claims a cell by
+ * advancing the enqueue or dequeue position with a single compare-exchange,
+ * then publishes the cell by bumping its sequence number. No locks are taken,
+ * and producers never contend with consumers on the same position.
+ *
+ * The enqueue and dequeue positions are padded onto separate cache lines so
+ * that producers and consumers do not falsely share them.
+ *
+ * tryPush() and tryPop() fail instead of blocking when the queue is full or
+ * empty. The batch variants claim a run of consecutive cells with a single
+ * compare-exchange and return how many elements were moved.
+ *
+ * Elements should not throw while being copied or moved into and out of the
+ * queue, otherwise the cell which was claimed can never be released.
+ *
+ * The ring is reserved through 'alloc_t' when the queue is constructed and is
+ * never resized.
+******************************************************************************/
+template <typename type, typename alloc_t = utils::heapAllocator>
+class mpmcQueue {
+
+    public:
+        enum : unsigned {
+            CACHE_LINE_SIZE = 64
+        };
+
+    private:
+        struct cell {
+            std::atomic< std::size_t >  sequence;
+            alignas(type) unsigned char storage[ sizeof( type ) ];
+
+            type*   data() { return reinterpret_cast< type* >( storage ); }
+        };
+
+        /*
+         * Queue positions are padded to keep each one on its own cache line.
+         */
+        struct paddedPosition {
+            std::atomic< std::size_t > pos;
+            char padding[ CACHE_LINE_SIZE - sizeof( std::atomic< std::size_t > ) ];
+
+            paddedPosition() : pos{0} {}
+        };
+
+        // Members below are never written after construction
+        alloc_t         allocator;
+        cell*           buffer;
+        std::size_t     mask;
+        char            padding[ CACHE_LINE_SIZE ];
+
+        paddedPosition  enqueuePos;
+        paddedPosition  dequeuePos;
+
+        static std::size_t  ringSize        ( unsigned requested );
+        static std::ptrdiff_t distance      ( std::size_t seq, std::size_t pos );
+
+        cell*               claimPush       ();
+        cell*               claimPop        ();
+        std::size_t         claimPushBatch  ( unsigned count, unsigned& outCount );
+        std::size_t         claimPopBatch   ( unsigned count, unsigned& outCount );
+
+    public:
+        explicit mpmcQueue  ( unsigned capacity );
+        mpmcQueue           ( unsigned capacity, const alloc_t& );
+        mpmcQueue           ( const mpmcQueue& ) = delete;
+        mpmcQueue           ( mpmcQueue&& ) = delete;
+
+        ~mpmcQueue          ();
+
+        mpmcQueue&          operator=   ( const mpmcQueue& ) = delete;
+        mpmcQueue&          operator=   ( mpmcQueue&& ) = delete;
+
+        // Producers
+        bool                tryPush     ( const type& data )    { return tryEmplace( data ); }
+        bool                tryPush     ( type&& data )         { return tryEmplace( std::move( data ) ); }
+        template <typename... args_t>
+        bool                tryEmplace  ( args_t&&... args );
+        unsigned            tryPushBatch( const type* items, unsigned count );
+
+        // Consumers
+        bool                tryPop      ( type& outData );
+        unsigned            tryPopBatch ( type* outItems, unsigned maxCount );
+
+        // Miscellaneous
+        unsigned            capacity    () const { return unsigned( mask + 1 ); }
+        unsigned            size        () const;
+        bool                empty       () const { return size() == 0; }
+};
+
+/*
+ * MPMC Queue -- Ring Size
+ * Round a requested capacity up to a power of two. The sequence numbers need
+ * at least two cells to tell a full ring from an empty one.
+ */
+template <typename type, typename alloc_t>
+std::size_t mpmcQueue<type, alloc_t>::ringSize( unsigned requested ) {
+    std::size_t numCells = 2;
+
+    while ( numCells < requested ) {
+        numCells <<= 1;
+    }
+
+    return numCells;
+}
+
+/*
+ * MPMC Queue -- Sequence Distance
+ * Compare a cell's sequence number against a queue position, allowing either
+ * one to have wrapped around.
+ */
+template <typename type, typename alloc_t>
+inline std::ptrdiff_t mpmcQueue<type, alloc_t>::distance( std::size_t seq, std::size_t pos ) {
+    return static_cast< std::ptrdiff_t >( seq - pos );
+}
+
+/*
+ * MPMC Queue -- Constructor
+ */
+template <typename type, typename alloc_t>
+mpmcQueue<type, alloc_t>::mpmcQueue( unsigned capacity ) :
+    mpmcQueue( capacity, alloc_t{} )
+{}
+
+/*
+ * MPMC Queue -- Allocator Constructor
+ * Each cell starts out free to write on the first lap around the ring.
+ */
+template <typename type, typename alloc_t>
+mpmcQueue<type, alloc_t>::mpmcQueue( unsigned capacity, const alloc_t& a ) :
+    allocator{ a },
+    buffer{ nullptr },
+    mask{ ringSize( capacity ) - 1 },
+    padding{},
+    enqueuePos{},
+    dequeuePos{}
+{
+    buffer = utils::allocateItems< cell >( allocator, mask + 1 );
+
+    for ( std::size_t i = 0; i <= mask; ++i ) {
+        new( &buffer[ i ].sequence ) std::atomic< std::size_t >( i );
+    }
+}
+
+/*
+ * MPMC Queue -- Destructor
+ * No other threads may be using the queue while it is destroyed.
+ */
+template <typename type, typename alloc_t>
+mpmcQueue<type, alloc_t>::~mpmcQueue() {
+    const std::size_t last = enqueuePos.pos.load( std::memory_order_relaxed );
+
+    for ( std::size_t pos = dequeuePos.pos.load( std::memory_order_relaxed ); pos != last; ++pos ) {
+        buffer[ pos & mask ].data()->~type();
+    }
+
+    utils::deallocateItems( allocator, buffer, mask + 1 );
+}
+
+/*
+ * MPMC Queue -- Claim Push
+ * Reserve the cell at the enqueue position. Returns null if the queue is
+ * full.
+ */
+template <typename type, typename alloc_t>
+typename mpmcQueue<type, alloc_t>::cell* mpmcQueue<type, alloc_t>::claimPush() {
+    std::size_t pos = enqueuePos.pos.load( std::memory_order_relaxed );
+
+    for ( ;; ) {
+        cell* const c = &buffer[ pos & mask ];
+        const std::ptrdiff_t diff = distance( c->sequence.load( std::memory_order_acquire ), pos );
+
+        if ( diff == 0 ) {
+            if ( enqueuePos.pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+                return c;
+            }
+        }
+        else if ( diff < 0 ) {
+            // the cell still holds an element from the previous lap
+            return nullptr;
+        }
+        else {
+            pos = enqueuePos.pos.load( std::memory_order_relaxed );
+        }
+    }
+}
+
+/*
+ * MPMC Queue -- Claim Pop
+ * Reserve the cell at the dequeue position. Returns null if the queue is
+ * empty.
+ */
+template <typename type, typename alloc_t>
+typename mpmcQueue<type, alloc_t>::cell* mpmcQueue<type, alloc_t>::claimPop() {
+    std::size_t pos = dequeuePos.pos.load( std::memory_order_relaxed );
+
+    for ( ;; ) {
+        cell* const c = &buffer[ pos & mask ];
+        const std::ptrdiff_t diff = distance( c->sequence.load( std::memory_order_acquire ), pos + 1 );
+
+        if ( diff == 0 ) {
+            if ( dequeuePos.pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+                return c;
+            }
+        }
+        else if ( diff < 0 ) {
+            // the cell has not been written on this lap
+            return nullptr;
+        }
+        else {
+            pos = dequeuePos.pos.load( std::memory_order_relaxed );
+        }
+    }
+}
+
+/*
+ * MPMC Queue -- Claim Push Batch
+ * Reserve up to 'count' consecutive cells starting at the enqueue position.
+ * Every cell in the run is checked before the position is advanced, since
+ * consumers may release cells out of order. Returns the first position
+ * claimed and stores the number of cells claimed in 'outCount'.
+ */
+template <typename type, typename alloc_t>
+std::size_t mpmcQueue<type, alloc_t>::claimPushBatch( unsigned count, unsigned& outCount ) {
+    std::size_t pos = enqueuePos.pos.load( std::memory_order_relaxed );
+
+    for ( ;; ) {
+        unsigned n = 0;
+        std::ptrdiff_t diff = 0;
+
+        while ( n < count ) {
+            diff = distance( buffer[ (pos + n) & mask ].sequence.load( std::memory_order_acquire ), pos + n );
+            if ( diff != 0 ) {
+                break;
+            }
+            ++n;
+        }
+
+        // nothing to claim, or nothing was asked for
+        if ( n == 0 && diff <= 0 ) {
+            outCount = 0;
+            return pos;
+        }
+
+        if ( n > 0 && enqueuePos.pos.compare_exchange_weak( pos, pos + n, std::memory_order_relaxed ) ) {
+            outCount = n;
+            return pos;
+        }
+
+        if ( n == 0 ) {
+            pos = enqueuePos.pos.load( std::memory_order_relaxed );
+        }
+    }
+}
+
+/*
+ * MPMC Queue -- Claim Pop Batch
+ * Reserve up to 'count' consecutive cells starting at the dequeue position.
+ */
+template <typename type, typename alloc_t>
+std::size_t mpmcQueue<type, alloc_t>::claimPopBatch( unsigned count, unsigned& outCount ) {
+    std::size_t pos = dequeuePos.pos.load( std::memory_order_relaxed );
+
+    for ( ;; ) {
+        unsigned n = 0;
+        std::ptrdiff_t diff = 0;
+
+        while ( n < count ) {
+            diff = distance( buffer[ (pos + n) & mask ].sequence.load( std::memory_order_acquire ), pos + n + 1 );
+            if ( diff != 0 ) {
+                break;
+            }
+            ++n;
+        }
+
+        // nothing to claim, or nothing was asked for
+        if ( n == 0 && diff <= 0 ) {
+            outCount = 0;
+            return pos;
+        }
+
+        if ( n > 0 && dequeuePos.pos.compare_exchange_weak( pos, pos + n, std::memory_order_relaxed ) ) {
+            outCount = n;
+            return pos;
+        }
+
+        if ( n == 0 ) {
+            pos = dequeuePos.pos.load( std::memory_order_relaxed );
+        }
+    }
+}
+
+/*
+ * MPMC Queue -- Emplace
+ * Construct an element at the back of the queue. Returns false, without
+ * constructing anything, if the queue is full.
+ */
+template <typename type, typename alloc_t>
+template <typename... args_t>
+bool mpmcQueue<type, alloc_t>::tryEmplace( args_t&&... args ) {
+    cell* const c = claimPush();
+
+    if ( !c ) {
+        return false;
+    }
+
+    const std::size_t seq = c->sequence.load( std::memory_order_relaxed );
+    new( c->data() ) type( std::forward< args_t >( args )... );
+    c->sequence.store( seq + 1, std::memory_order_release );
+
+    return true;
+}
+
+/*
+ * MPMC Queue -- Push Batch
+ * Copy up to 'count' elements to the back of the queue, in order. Returns
+ * the number of elements which were pushed.
+ */
+template <typename type, typename alloc_t>
+unsigned mpmcQueue<type, alloc_t>::tryPushBatch( const type* items, unsigned count ) {
+    unsigned numClaimed = 0;
+    const std::size_t first = claimPushBatch( count, numClaimed );
+
+    for ( unsigned i = 0; i < numClaimed; ++i ) {
+        cell& c = buffer[ (first + i) & mask ];
+        new( c.data() ) type( items[ i ] );
+        c.sequence.store( first + i + 1, std::memory_order_release );
+    }
+
+    return numClaimed;
+}
+
+/*
+ * MPMC Queue -- Pop
+ * Move the element at the front of the queue into 'outData'. Returns false
+ * if the queue is empty.
+ */
+template <typename type, typename alloc_t>
+bool mpmcQueue<type, alloc_t>::tryPop( type& outData ) {
+    cell* const c = claimPop();
+
+    if ( !c ) {
+        return false;
+    }
+
+    const std::size_t seq = c->sequence.load( std::memory_order_relaxed );
+    outData = std::move( *c->data() );
+    c->data()->~type();
+
+    // free the cell for the producer of the next lap
+    c->sequence.store( seq + mask, std::memory_order_release );
+
+    return true;
+}
+
+/*
+ * MPMC Queue -- Pop Batch
+ * Move up to 'maxCount' elements from the front of the queue into
+ * 'outItems', in order. Returns the number of elements which were popped.
+ */
+template <typename type, typename alloc_t>
+unsigned mpmcQueue<type, alloc_t>::tryPopBatch( type* outItems, unsigned maxCount ) {
+    unsigned numClaimed = 0;
+    const std::size_t first = claimPopBatch( maxCount, numClaimed );
+
+    for ( unsigned i = 0; i < numClaimed; ++i ) {
+        cell& c = buffer[ (first + i) & mask ];
+        outItems[ i ] = std::move( *c.data() );
+        c.data()->~type();
+        c.sequence.store( first + i + mask + 1, std::memory_order_release );
+    }
+
+    return numClaimed;
+}
+
+/*
+ * MPMC Queue -- Size
+ * Only a snapshot; other threads may push or pop at any time.
+ */
+template <typename type, typename alloc_t>
+unsigned mpmcQueue<type, alloc_t>::size() const {
+    const std::size_t tail = dequeuePos.pos.load( std::memory_order_relaxed );
+    const std::size_t head = enqueuePos.pos.load( std::memory_order_relaxed );
+    const std::ptrdiff_t diff = distance( head, tail );
+
+    return (diff > 0) ? unsigned( diff ) : 0;
+}
+
+} // end containers namespace
+} // end hamLibs namespace
+
+#endif  /* __HL_MPMC_QUEUE_H__ */
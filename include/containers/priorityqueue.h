@@ -0,0 +1,604 @@
+/*
+ * Priority queues stored as d-ary heaps in a containers::array.
+ * The element at the top of the queue is the one which should leave first,
+ * as decided by 'compare_t': compare(a, b) returns true when 'a' should
+ * leave before 'b'. The default, std::less, makes a min-heap.
+ *
+ * 'D' is the number of children per heap node. Binary heaps (D = 2) do the
+ * fewest comparisons when popping, while 4-ary heaps are shallower and keep
+ * a node's children on a single cache line for small elements, which usually
+ * makes pushes and decreaseKey() faster.
+ *
+ * pushBatch() appends a run of elements at once. When the run is at least as
+ * large as the queue it joins, the whole heap is rebuilt bottom-up in linear
+ * time; otherwise each new element is sifted up on its own.
+ *
+ * indexedPriorityQueue also hands out an integer handle for every element,
+ * which can be used to find, re-prioritize or remove that element in
+ * logarithmic time. Handles are reused once their element leaves the queue.
+ *
+ * Memory is reserved through 'alloc_t' (see utils/allocator.h).
+ */
+
+#ifndef __HL_PRIORITY_QUEUE_H__
+#define __HL_PRIORITY_QUEUE_H__
+
+#include <functional>
+#include <utility>
+#include "../utils/assert.h"
+#include "array.h"
+
+namespace hamLibs {
+namespace containers {
+
+//---------------------------------------------------------------------
+//			D-ary Heap Algorithms
+//---------------------------------------------------------------------
+/*
+ * Sifts elements through a heap stored in an array. Elements are moved into
+ * a hole rather than swapped. 'placed(item, index)' is called every time an
+ * element lands at a new index, so that callers can track positions.
+ */
+template <int D>
+struct dAryHeap {
+	static_assert(D >= 2, "A heap needs at least two children per node.");
+
+	static int	parent		(int index) { return (index-1) / D; }
+	static int	firstChild	(int index) { return index*D + 1; }
+
+	template <typename type, typename before_t, typename placed_t>
+	static void	siftUp		(type* items, int index, before_t before, placed_t placed);
+
+	template <typename type, typename before_t, typename placed_t>
+	static void	siftDown	(type* items, int size, int index, before_t before, placed_t placed);
+
+	template <typename type, typename before_t, typename placed_t>
+	static void	refill		(type* items, int size, int index, type&& item, before_t before, placed_t placed);
+
+	template <typename type, typename before_t, typename placed_t>
+	static void	heapify		(type* items, int size, before_t before, placed_t placed);
+};
+
+template <int D>
+template <typename type, typename before_t, typename placed_t>
+void dAryHeap<D>::siftUp(type* items, int index, before_t before, placed_t placed) {
+	type temp(std::move(items[index]));
+
+	while (index > 0) {
+		const int p = parent(index);
+		if (!before(temp, items[p])) {
+			break;
+		}
+		items[index] = std::move(items[p]);
+		placed(items[index], index);
+		index = p;
+	}
+
+	items[index] = std::move(temp);
+	placed(items[index], index);
+}
+
+template <int D>
+template <typename type, typename before_t, typename placed_t>
+void dAryHeap<D>::siftDown(type* items, int size, int index, before_t before, placed_t placed) {
+	type temp(std::move(items[index]));
+
+	for (int child = firstChild(index); child < size; child = firstChild(index)) {
+		//pick whichever child should leave first
+		const int lastChild = (child + D < size) ? child + D : size;
+		int best = child;
+		for (int c = child+1; c < lastChild; ++c) {
+			if (before(items[c], items[best])) {
+				best = c;
+			}
+		}
+
+		if (!before(items[best], temp)) {
+			break;
+		}
+		items[index] = std::move(items[best]);
+		placed(items[index], index);
+		index = best;
+	}
+
+	items[index] = std::move(temp);
+	placed(items[index], index);
+}
+
+/*
+ * Fill the hole left at 'index' with 'item'. The hole is first walked down to
+ * a leaf along the path of best children, then 'item' is sifted up from
+ * there. Refilling with the last element of a heap, which usually belongs
+ * near the bottom, takes about half the comparisons of a plain siftDown().
+ */
+template <int D>
+template <typename type, typename before_t, typename placed_t>
+void dAryHeap<D>::refill(type* items, int size, int index, type&& item, before_t before, placed_t placed) {
+	for (int child = firstChild(index); child < size; child = firstChild(index)) {
+		const int lastChild = (child + D < size) ? child + D : size;
+		int best = child;
+		for (int c = child+1; c < lastChild; ++c) {
+			if (before(items[c], items[best])) {
+				best = c;
+			}
+		}
+
+		items[index] = std::move(items[best]);
+		placed(items[index], index);
+		index = best;
+	}
+
+	items[index] = std::move(item);
+	siftUp(items, index, before, placed);
+}
+
+template <int D>
+template <typename type, typename before_t, typename placed_t>
+void dAryHeap<D>::heapify(type* items, int size, before_t before, placed_t placed) {
+	//leaves are already heaps, so start from the last parent
+	for (int i = (size > 1) ? parent(size-1) : -1; i >= 0; --i) {
+		siftDown(items, size, i, before, placed);
+	}
+}
+
+//---------------------------------------------------------------------
+//			Priority Queue
+//---------------------------------------------------------------------
+template <
+	typename type,
+	int D = 2,
+	typename compare_t = std::less<type>,
+	typename alloc_t = utils::heapAllocator
+>
+class priorityQueue {
+	private:
+		typedef dAryHeap<D> heap;
+
+		struct notPlaced {
+			void operator() (const type&, int) const {}
+		};
+
+		array<type, alloc_t> items;
+		compare_t compare;
+
+	public:
+		priorityQueue			();
+		explicit priorityQueue	(const compare_t& c, const alloc_t& a = alloc_t());
+		priorityQueue			(const priorityQueue&) = default;
+		priorityQueue			(priorityQueue&& moved);
+		~priorityQueue			() = default;
+
+		priorityQueue&	operator =	(const priorityQueue&) = default;
+		priorityQueue&	operator =	(priorityQueue&& input);
+
+		//data acquisition
+		const type*	top			() const;
+
+		//insertion & deletion
+		void		push		(const type& object);
+		void		push		(type&& object);
+		template <typename... args_t>
+		void		emplace		(args_t&&... args);
+		void		pushBatch	(const type* objects, int count);
+		void		pop			();
+		void		clear		();
+
+		//miscellaneous
+		void		reserve		(int numItems);
+		int			size		() const;
+		bool		empty		() const;
+		const type*	data		() const;	//the heap, in array order
+		alloc_t&	getAllocator	();
+};
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+priorityQueue<type, D, compare_t, alloc_t>::priorityQueue() :
+	items(),
+	compare()
+{}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+priorityQueue<type, D, compare_t, alloc_t>::priorityQueue(const compare_t& c, const alloc_t& a) :
+	items(a),
+	compare(c)
+{}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+priorityQueue<type, D, compare_t, alloc_t>::priorityQueue(priorityQueue&& moved) :
+	items(std::move(moved.items)),
+	compare(std::move(moved.compare))
+{}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+priorityQueue<type, D, compare_t, alloc_t>& priorityQueue<type, D, compare_t, alloc_t>::operator = (priorityQueue&& input) {
+	items = std::move(input.items);
+	compare = std::move(input.compare);
+	return *this;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+const type* priorityQueue<type, D, compare_t, alloc_t>::top() const {
+	return (items.size()) ? items.data() : nullptr;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void priorityQueue<type, D, compare_t, alloc_t>::push(const type& object) {
+	emplace(object);
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void priorityQueue<type, D, compare_t, alloc_t>::push(type&& object) {
+	emplace(std::move(object));
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+template <typename... args_t>
+void priorityQueue<type, D, compare_t, alloc_t>::emplace(args_t&&... args) {
+	items.emplaceBack(std::forward<args_t>(args)...);
+	heap::siftUp(items.data(), items.size()-1, compare, notPlaced());
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void priorityQueue<type, D, compare_t, alloc_t>::pushBatch(const type* objects, int count) {
+	const int oldSize = items.size();
+	items.reserve(oldSize + count);
+	for (int i = 0; i < count; ++i) {
+		items.emplaceBack(objects[i]);
+	}
+
+	if (count >= oldSize) {
+		heap::heapify(items.data(), items.size(), compare, notPlaced());
+	}
+	else {
+		for (int i = oldSize; i < items.size(); ++i) {
+			heap::siftUp(items.data(), i, compare, notPlaced());
+		}
+	}
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void priorityQueue<type, D, compare_t, alloc_t>::pop() {
+	const int last = items.size()-1;
+	if (last < 0) return;
+
+	if (last > 0) {
+		type* const heapItems = items.data();
+		heap::refill(heapItems, last, 0, std::move(heapItems[last]), compare, notPlaced());
+	}
+	items.popBack();
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void priorityQueue<type, D, compare_t, alloc_t>::clear() {
+	items.clear();
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void priorityQueue<type, D, compare_t, alloc_t>::reserve(int numItems) {
+	items.reserve(numItems);
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+int priorityQueue<type, D, compare_t, alloc_t>::size() const {
+	return items.size();
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+bool priorityQueue<type, D, compare_t, alloc_t>::empty() const {
+	return items.size() == 0;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+const type* priorityQueue<type, D, compare_t, alloc_t>::data() const {
+	return items.data();
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+alloc_t& priorityQueue<type, D, compare_t, alloc_t>::getAllocator() {
+	return items.getAllocator();
+}
+
+//---------------------------------------------------------------------
+//			Indexed Priority Queue
+//---------------------------------------------------------------------
+template <
+	typename type,
+	int D = 2,
+	typename compare_t = std::less<type>,
+	typename alloc_t = utils::heapAllocator
+>
+class indexedPriorityQueue {
+	private:
+		typedef dAryHeap<D> heap;
+
+		struct node {
+			type data;
+			int handle;
+
+			template <typename... args_t>
+			node(int h, args_t&&... args) : data(std::forward<args_t>(args)...), handle(h) {}
+		};
+
+		struct nodeCompare {
+			const compare_t* compare;
+			bool operator() (const node& a, const node& b) const { return (*compare)(a.data, b.data); }
+		};
+
+		struct nodePlaced {
+			int* positions;
+			void operator() (const node& n, int index) const { positions[n.handle] = index; }
+		};
+
+		array<node, alloc_t> items;
+		array<int, alloc_t> positions;		//heap index of each handle, or -1 if the handle is free
+		array<int, alloc_t> freeHandles;
+		compare_t compare;
+
+		int			newHandle	();
+		void		freeHandle	(int handle);
+		void		removeAt	(int index);
+		void		siftUp		(int index);
+		void		siftDown	(int index);
+
+	public:
+		indexedPriorityQueue			();
+		explicit indexedPriorityQueue	(const compare_t& c, const alloc_t& a = alloc_t());
+		indexedPriorityQueue			(const indexedPriorityQueue&) = default;
+		indexedPriorityQueue			(indexedPriorityQueue&& moved);
+		~indexedPriorityQueue			() = default;
+
+		indexedPriorityQueue&	operator =	(const indexedPriorityQueue&) = default;
+		indexedPriorityQueue&	operator =	(indexedPriorityQueue&& input);
+
+		//data acquisition
+		const type*	top			() const;
+		int			topHandle	() const;		//-1 if the queue is empty
+		const type&	get			(int handle) const;
+		bool		contains	(int handle) const;
+
+		//insertion & deletion, each insertion returns the new element's handle
+		int			push		(const type& object);
+		int			push		(type&& object);
+		template <typename... args_t>
+		int			emplace		(args_t&&... args);
+		void		pushBatch	(const type* objects, int count, int* outHandles = nullptr);
+		void		pop			();
+		void		remove		(int handle);
+		void		clear		();
+
+		//re-prioritization
+		void		decreaseKey	(int handle, const type& object);	//'object' must not leave after the current value
+		void		decreaseKey	(int handle, type&& object);
+		void		update		(int handle, const type& object);	//'object' may have any priority
+		void		update		(int handle, type&& object);
+
+		//miscellaneous
+		void		reserve		(int numItems);
+		int			size		() const;
+		bool		empty		() const;
+		alloc_t&	getAllocator	();
+};
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+int indexedPriorityQueue<type, D, compare_t, alloc_t>::newHandle() {
+	if (freeHandles.size()) {
+		const int handle = freeHandles.back();
+		freeHandles.popBack();
+		return handle;
+	}
+	positions.pushBack(-1);
+	return positions.size()-1;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+inline void indexedPriorityQueue<type, D, compare_t, alloc_t>::freeHandle(int handle) {
+	positions.data()[handle] = -1;
+	freeHandles.pushBack(handle);
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+inline void indexedPriorityQueue<type, D, compare_t, alloc_t>::siftUp(int index) {
+	heap::siftUp(items.data(), index, nodeCompare{&compare}, nodePlaced{positions.data()});
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+inline void indexedPriorityQueue<type, D, compare_t, alloc_t>::siftDown(int index) {
+	heap::siftDown(items.data(), items.size(), index, nodeCompare{&compare}, nodePlaced{positions.data()});
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::removeAt(int index) {
+	node* const heapItems = items.data();
+	const int last = items.size()-1;
+
+	//the last element may belong either above or below the hole it fills
+	freeHandle(heapItems[index].handle);
+	if (index != last) {
+		heap::refill(heapItems, last, index, std::move(heapItems[last]), nodeCompare{&compare}, nodePlaced{positions.data()});
+	}
+	items.popBack();
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+indexedPriorityQueue<type, D, compare_t, alloc_t>::indexedPriorityQueue() :
+	indexedPriorityQueue(compare_t())
+{}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+indexedPriorityQueue<type, D, compare_t, alloc_t>::indexedPriorityQueue(const compare_t& c, const alloc_t& a) :
+	items(a),
+	positions(a),
+	freeHandles(a),
+	compare(c)
+{}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+indexedPriorityQueue<type, D, compare_t, alloc_t>::indexedPriorityQueue(indexedPriorityQueue&& moved) :
+	items(std::move(moved.items)),
+	positions(std::move(moved.positions)),
+	freeHandles(std::move(moved.freeHandles)),
+	compare(std::move(moved.compare))
+{}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+indexedPriorityQueue<type, D, compare_t, alloc_t>& indexedPriorityQueue<type, D, compare_t, alloc_t>::operator = (indexedPriorityQueue&& input) {
+	items = std::move(input.items);
+	positions = std::move(input.positions);
+	freeHandles = std::move(input.freeHandles);
+	compare = std::move(input.compare);
+	return *this;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+const type* indexedPriorityQueue<type, D, compare_t, alloc_t>::top() const {
+	return (items.size()) ? &items.data()->data : nullptr;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+int indexedPriorityQueue<type, D, compare_t, alloc_t>::topHandle() const {
+	return (items.size()) ? items.data()->handle : -1;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+const type& indexedPriorityQueue<type, D, compare_t, alloc_t>::get(int handle) const {
+	HL_ASSERT(contains(handle));
+	return items.data()[positions.data()[handle]].data;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+bool indexedPriorityQueue<type, D, compare_t, alloc_t>::contains(int handle) const {
+	return handle >= 0 && handle < positions.size() && positions.data()[handle] >= 0;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+int indexedPriorityQueue<type, D, compare_t, alloc_t>::push(const type& object) {
+	return emplace(object);
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+int indexedPriorityQueue<type, D, compare_t, alloc_t>::push(type&& object) {
+	return emplace(std::move(object));
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+template <typename... args_t>
+int indexedPriorityQueue<type, D, compare_t, alloc_t>::emplace(args_t&&... args) {
+	const int handle = newHandle();
+	try {
+		items.emplaceBack(handle, std::forward<args_t>(args)...);
+	}
+	catch (...) {
+		freeHandle(handle);
+		throw;
+	}
+	siftUp(items.size()-1);
+	return handle;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::pushBatch(const type* objects, int count, int* outHandles) {
+	const int oldSize = items.size();
+	items.reserve(oldSize + count);
+
+	for (int i = 0; i < count; ++i) {
+		const int handle = newHandle();
+		items.emplaceBack(handle, objects[i]);
+		positions.data()[handle] = items.size()-1;
+		if (outHandles) {
+			outHandles[i] = handle;
+		}
+	}
+
+	if (count >= oldSize) {
+		heap::heapify(items.data(), items.size(), nodeCompare{&compare}, nodePlaced{positions.data()});
+	}
+	else {
+		for (int i = oldSize; i < items.size(); ++i) {
+			siftUp(i);
+		}
+	}
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::pop() {
+	if (items.size()) {
+		removeAt(0);
+	}
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::remove(int handle) {
+	if (contains(handle)) {
+		removeAt(positions.data()[handle]);
+	}
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::clear() {
+	items.clear();
+	positions.clear();
+	freeHandles.clear();
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::decreaseKey(int handle, const type& object) {
+	HL_ASSERT(contains(handle));
+	const int index = positions.data()[handle];
+	items.data()[index].data = object;
+	siftUp(index);
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::decreaseKey(int handle, type&& object) {
+	HL_ASSERT(contains(handle));
+	const int index = positions.data()[handle];
+	items.data()[index].data = std::move(object);
+	siftUp(index);
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::update(int handle, const type& object) {
+	update(handle, type(object));
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::update(int handle, type&& object) {
+	HL_ASSERT(contains(handle));
+	const int index = positions.data()[handle];
+	type& data = items.data()[index].data;
+	const bool raised = compare(object, data);
+
+	data = std::move(object);
+	if (raised) {
+		siftUp(index);
+	}
+	else {
+		siftDown(index);
+	}
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+void indexedPriorityQueue<type, D, compare_t, alloc_t>::reserve(int numItems) {
+	items.reserve(numItems);
+	positions.reserve(numItems);
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+int indexedPriorityQueue<type, D, compare_t, alloc_t>::size() const {
+	return items.size();
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+bool indexedPriorityQueue<type, D, compare_t, alloc_t>::empty() const {
+	return items.size() == 0;
+}
+
+template <typename type, int D, typename compare_t, typename alloc_t>
+alloc_t& indexedPriorityQueue<type, D, compare_t, alloc_t>::getAllocator() {
+	return items.getAllocator();
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+
+#endif /* __HL_PRIORITY_QUEUE_H__ */
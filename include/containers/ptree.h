@@ -0,0 +1,571 @@
+/*
+ * File:   ptree.h
+ * Author: hammy
+ *
+ * Path-compressed (PATRICIA) variant of the bTree.
+ */
+
+#ifndef __HL_P_TREE_H__
+#define __HL_P_TREE_H__
+
+#include <utility>
+#include "../defs/preprocessor.h"
+#include "../utils/allocator.h"
+#include "../utils/bits.h"
+#include "btree.h"
+
+namespace hamLibs {
+namespace containers {
+
+/**
+ * PATRICIA Tree Node
+ *
+ * Branch nodes only store the index of the bit at which their two subtrees
+ * diverge, so any run of bits shared by all keys below a branch is skipped
+ * entirely. Leaf nodes hold the data and a copy of the key's bytes, which is
+ * used to verify the skipped bits once a lookup reaches the bottom of the tree.
+ *
+ * Nodes do not own any memory themselves. Their data, keys, and sub-nodes are
+ * allocated and released by the pTree they belong to.
+ */
+template <typename data_t>
+class pTreeNode {
+    private:
+        template <typename, typename, typename>
+        friend class pTree;
+
+        data_t*         data        = nullptr; // leaves only
+        unsigned char*  keyBytes    = nullptr; // leaves only
+        unsigned        numBytes    = 0;       // leaves only
+        unsigned        bitIndex    = 0;       // branches only
+        pTreeNode*      subNodes[ BNODE_MAX ] = {nullptr, nullptr};
+
+    public:
+        constexpr pTreeNode() {}
+        pTreeNode( const pTreeNode& ) = delete;
+        pTreeNode( pTreeNode&& ) = delete;
+
+        ~pTreeNode() {}
+
+        pTreeNode& operator=( const pTreeNode& ) = delete;
+        pTreeNode& operator=( pTreeNode&& ) = delete;
+
+        bool isLeaf() const { return data != nullptr; }
+};
+
+/******************************************************************************
+ *  PATRICIA-Tree Structure Setup
+ *
+ * This tree has the same interface as the bTree and decomposes its keys in the
+ * same way (using utils::getByte()), but only branches where two keys differ.
+ * A lookup costs one pointer hop per branch rather than one per key bit, so the
+ * depth of the tree is bound by the number of keys it holds instead of by the
+ * size of each key.
+ *
+ * Nodes, values, and key copies are reserved through 'alloc_t'.
+******************************************************************************/
+template <typename key_t, typename data_t, typename alloc_t = utils::heapAllocator>
+class pTree {
+
+    protected:
+        alloc_t             allocator;
+        pTreeNode<data_t>*  head = nullptr;
+        unsigned            numNodes = 0;
+
+    private:
+        static unsigned     getKeyBytes ( const key_t* k, const unsigned char** outBytes );
+        static int          getBit      ( const unsigned char* bytes, unsigned numBytes, unsigned bitIndex );
+        static bool         findCritBit (
+                                const unsigned char* a, unsigned aLen,
+                                const unsigned char* b, unsigned bLen,
+                                unsigned& outBit
+                            );
+        static unsigned     getDepth    ( const pTreeNode<data_t>* node );
+
+        pTreeNode<data_t>*  copyNode    ( const pTreeNode<data_t>* node );
+        void                destroyNode ( pTreeNode<data_t>* node );
+
+        pTreeNode<data_t>*  iterate     ( const key_t* k ) const;
+        template <typename... args_t>
+        pTreeNode<data_t>*  insert      ( const key_t* k, bool& inserted, args_t&&... args );
+
+    public:
+        pTree           ();
+        explicit pTree  ( const alloc_t& );
+        pTree           ( const pTree& );
+        pTree           ( pTree&& );
+
+        ~pTree          () { clear(); }
+
+        pTree&          operator=   ( const pTree& );
+        pTree&          operator=   ( pTree&& );
+
+        // STL-Map behavior
+        data_t&         operator [] ( const key_t& k );
+
+        void            push        ( const key_t& k, const data_t& d );
+        void            push        ( const key_t& k, data_t&& d );
+        template <typename... args_t>
+        data_t&         emplace     ( const key_t& k, args_t&&... args );
+        void            pop         ( const key_t& k );
+        bool            hasData     ( const key_t& k ) const;
+        const data_t*   getData     ( const key_t& k ) const;
+        unsigned        size        () const { return numNodes; }
+        unsigned        depth       () const { return getDepth( head ); }
+        void            clear       ();
+
+        alloc_t&        getAllocator() { return allocator; }
+};
+
+/*
+ * PATRICIA Tree -- Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+pTree<key_t, data_t, alloc_t>::pTree() :
+    allocator{},
+    head{nullptr},
+    numNodes{0}
+{}
+
+/*
+ * PATRICIA Tree -- Allocator Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+pTree<key_t, data_t, alloc_t>::pTree( const alloc_t& a ) :
+    allocator{ a },
+    head{nullptr},
+    numNodes{0}
+{}
+
+/*
+ * PATRICIA Tree -- Copy Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+pTree<key_t, data_t, alloc_t>::pTree( const pTree& pt ) :
+    allocator{ pt.allocator },
+    head{nullptr},
+    numNodes{ pt.numNodes }
+{
+    head = copyNode( pt.head );
+}
+
+/*
+ * PATRICIA Tree -- Move Constructor
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+pTree<key_t, data_t, alloc_t>::pTree( pTree&& pt ) :
+    allocator{ pt.allocator },
+    head{ pt.head },
+    numNodes{ pt.numNodes }
+{
+    pt.head = nullptr;
+    pt.numNodes = 0;
+}
+
+/*
+ * PATRICIA Tree -- Copy Operator
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+pTree<key_t, data_t, alloc_t>& pTree<key_t, data_t, alloc_t>::operator =( const pTree& pt ) {
+    if ( this != &pt ) {
+        clear();
+        head = copyNode( pt.head );
+        numNodes = pt.numNodes;
+    }
+    return *this;
+}
+
+/*
+ * PATRICIA Tree -- Move Operator
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+pTree<key_t, data_t, alloc_t>& pTree<key_t, data_t, alloc_t>::operator =( pTree&& pt ) {
+    if ( this != &pt ) {
+        clear();
+
+        // the allocator moves along with the nodes it reserved
+        allocator = std::move( pt.allocator );
+
+        head = pt.head;
+        pt.head = nullptr;
+
+        numNodes = pt.numNodes;
+        pt.numNodes = 0;
+    }
+    return *this;
+}
+
+/*
+ * PATRICIA Tree -- Key Decomposition
+ * Returns the number of bytes in a key and a pointer to the first one.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+unsigned pTree<key_t, data_t, alloc_t>::getKeyBytes( const key_t* k, const unsigned char** outBytes ) {
+    unsigned numBytes = 0;
+
+    while ( utils::getByte< key_t >( k, numBytes ) ) {
+        ++numBytes;
+    }
+
+    *outBytes = numBytes
+        ? reinterpret_cast< const unsigned char* >( utils::getByte< key_t >( k, 0 ) )
+        : nullptr;
+
+    return numBytes;
+}
+
+/*
+ * PATRICIA Tree -- Bit Retrieval
+ * Bits are ordered from the most significant bit of each byte to the least, in
+ * the same order as the bTree walks them. Keys are treated as if they were
+ * padded with zeroes past their last byte.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+inline int pTree<key_t, data_t, alloc_t>::getBit( const unsigned char* bytes, unsigned numBytes, unsigned bitIndex ) {
+    const unsigned byteIndex = bitIndex / HL_BITS_PER_BYTE;
+
+    if ( byteIndex >= numBytes ) {
+        return 0;
+    }
+
+    const unsigned shift = HL_BITS_PER_BYTE - 1 - (bitIndex % HL_BITS_PER_BYTE);
+    return (bytes[ byteIndex ] >> shift) & 1;
+}
+
+/*
+ * PATRICIA Tree -- Critical Bit
+ * Locate the first bit at which two keys differ. Returns false if the keys
+ * are identical.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+bool pTree<key_t, data_t, alloc_t>::findCritBit(
+    const unsigned char* a, unsigned aLen,
+    const unsigned char* b, unsigned bLen,
+    unsigned& outBit
+) {
+    const unsigned maxLen = HL_MAX( aLen, bLen );
+
+    for ( unsigned i = 0; i < maxLen; ++i ) {
+        const unsigned aByte = (i < aLen) ? a[ i ] : 0;
+        const unsigned bByte = (i < bLen) ? b[ i ] : 0;
+        const unsigned diff = aByte ^ bByte;
+
+        if ( !diff ) {
+            continue;
+        }
+
+        unsigned bitPos = 0;
+        while ( !(diff & (1u << (HL_BITS_PER_BYTE - 1 - bitPos))) ) {
+            ++bitPos;
+        }
+
+        outBit = i * HL_BITS_PER_BYTE + bitPos;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * PATRICIA Tree -- Depth
+ * The longest chain of nodes between the head and a leaf.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+unsigned pTree<key_t, data_t, alloc_t>::getDepth( const pTreeNode<data_t>* node ) {
+    if ( !node ) {
+        return 0;
+    }
+
+    if ( node->isLeaf() ) {
+        return 1;
+    }
+
+    const unsigned l = getDepth( node->subNodes[ BNODE_LEFT ] );
+    const unsigned r = getDepth( node->subNodes[ BNODE_RIGHT ] );
+    return 1 + HL_MAX( l, r );
+}
+
+/*
+ * PATRICIA Tree -- Node Copy
+ * Duplicate a node, its data, its key, and all nodes below it.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+pTreeNode<data_t>* pTree<key_t, data_t, alloc_t>::copyNode( const pTreeNode<data_t>* node ) {
+    if ( !node ) {
+        return nullptr;
+    }
+
+    pTreeNode<data_t>* const ret = utils::createItem< pTreeNode<data_t> >( allocator );
+
+    if ( node->data ) {
+        ret->data = utils::createItem< data_t >( allocator, *node->data );
+    }
+
+    if ( node->keyBytes ) {
+        ret->keyBytes = utils::allocateItems< unsigned char >( allocator, node->numBytes );
+        ret->numBytes = node->numBytes;
+
+        for ( unsigned i = 0; i < ret->numBytes; ++i ) {
+            ret->keyBytes[ i ] = node->keyBytes[ i ];
+        }
+    }
+
+    ret->bitIndex = node->bitIndex;
+
+    if ( node->subNodes[ BNODE_LEFT ] ) {
+        ret->subNodes[ BNODE_LEFT ] = copyNode( node->subNodes[ BNODE_LEFT ] );
+        ret->subNodes[ BNODE_RIGHT ] = copyNode( node->subNodes[ BNODE_RIGHT ] );
+    }
+
+    return ret;
+}
+
+/*
+ * PATRICIA Tree -- Node Destruction
+ * Frees a node's data, key, and all nodes below it.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void pTree<key_t, data_t, alloc_t>::destroyNode( pTreeNode<data_t>* node ) {
+    if ( !node ) {
+        return;
+    }
+
+    utils::destroyItem( allocator, node->data );
+    utils::deallocateItems( allocator, node->keyBytes, node->numBytes );
+
+    destroyNode( node->subNodes[ BNODE_LEFT ] );
+    destroyNode( node->subNodes[ BNODE_RIGHT ] );
+
+    utils::destroyItem( allocator, node );
+}
+
+/*
+ * PATRICIA Tree -- Element iteration
+ * Returns the leaf which holds a key, or nullptr if the key does not exist.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+pTreeNode<data_t>* pTree<key_t, data_t, alloc_t>::iterate( const key_t* k ) const {
+    if ( !head ) {
+        return nullptr;
+    }
+
+    const unsigned char* bytes = nullptr;
+    const unsigned numBytes = getKeyBytes( k, &bytes );
+    pTreeNode<data_t>* pNodeIter = head;
+
+    while ( !pNodeIter->isLeaf() ) {
+        const int dir = getBit( bytes, numBytes, pNodeIter->bitIndex );
+        pNodeIter = pNodeIter->subNodes[ dir ];
+    }
+
+    // Verify the bits which were skipped on the way down.
+    unsigned critBit;
+    if ( findCritBit( bytes, numBytes, pNodeIter->keyBytes, pNodeIter->numBytes, critBit ) ) {
+        return nullptr;
+    }
+
+    return pNodeIter;
+}
+
+/*
+ * PATRICIA Tree -- Insertion
+ * Returns the leaf for a key, creating one if necessary. The data for a new
+ * leaf is constructed from "args", or value-initialized if there are none.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+template <typename... args_t>
+pTreeNode<data_t>* pTree<key_t, data_t, alloc_t>::insert( const key_t* k, bool& inserted, args_t&&... args ) {
+    const unsigned char* bytes = nullptr;
+    const unsigned numBytes = getKeyBytes( k, &bytes );
+
+    inserted = false;
+
+    // Find the leaf which shares the longest prefix with the new key
+    pTreeNode<data_t>* pNodeIter = head;
+
+    if ( pNodeIter ) {
+        while ( !pNodeIter->isLeaf() ) {
+            const int dir = getBit( bytes, numBytes, pNodeIter->bitIndex );
+            pNodeIter = pNodeIter->subNodes[ dir ];
+        }
+    }
+
+    unsigned critBit = 0;
+    if ( pNodeIter
+    && !findCritBit( bytes, numBytes, pNodeIter->keyBytes, pNodeIter->numBytes, critBit )
+    ) {
+        return pNodeIter;
+    }
+
+    // create and initialize the new leaf
+    pTreeNode<data_t>* leaf = utils::createItem< pTreeNode<data_t> >( allocator );
+    leaf->data = utils::createItem< data_t >( allocator, std::forward< args_t >( args )... );
+    leaf->keyBytes = utils::allocateItems< unsigned char >( allocator, numBytes );
+    leaf->numBytes = numBytes;
+
+    for ( unsigned i = 0; i < numBytes; ++i ) {
+        leaf->keyBytes[ i ] = bytes[ i ];
+    }
+
+    inserted = true;
+    ++numNodes;
+
+    if ( !head ) {
+        head = leaf;
+        return leaf;
+    }
+
+    // Branches are ordered by increasing bit index from the head downwards.
+    // Find the first link which skips over the critical bit and split it.
+    pTreeNode<data_t>** link = &head;
+
+    while ( !(*link)->isLeaf() && (*link)->bitIndex < critBit ) {
+        const int dir = getBit( bytes, numBytes, (*link)->bitIndex );
+        link = &((*link)->subNodes[ dir ]);
+    }
+
+    const int newDir = getBit( bytes, numBytes, critBit );
+    pTreeNode<data_t>* branch = utils::createItem< pTreeNode<data_t> >( allocator );
+
+    branch->bitIndex = critBit;
+    branch->subNodes[ newDir ] = leaf;
+    branch->subNodes[ !newDir ] = *link;
+    *link = branch;
+
+    return leaf;
+}
+
+/*
+ * PATRICIA Tree -- Clear
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void pTree<key_t, data_t, alloc_t>::clear() {
+    destroyNode( head );
+
+    head = nullptr;
+    numNodes = 0;
+}
+
+/*
+ * PATRICIA Tree -- Array Subscript operators
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+data_t& pTree<key_t, data_t, alloc_t>::operator []( const key_t& k ) {
+    bool inserted;
+    return *insert( &k, inserted )->data;
+}
+
+/*
+ * PATRICIA Tree -- Push
+ * Push a data element to the tree using a key
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void pTree<key_t, data_t, alloc_t>::push( const key_t& k, const data_t& d ) {
+    bool inserted;
+    pTreeNode<data_t>* iter = insert( &k, inserted, d );
+
+    if ( !inserted ) {
+        *iter->data = d;
+    }
+}
+
+template <typename key_t, typename data_t, typename alloc_t>
+void pTree<key_t, data_t, alloc_t>::push( const key_t& k, data_t&& d ) {
+    bool inserted;
+    pTreeNode<data_t>* iter = insert( &k, inserted, std::move( d ) );
+
+    if ( !inserted ) {
+        *iter->data = std::move( d );
+    }
+}
+
+/*
+ * PATRICIA Tree -- Emplace
+ * Construct a data element at a key from a set of arguments. An element
+ * which already lies at the key is replaced.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+template <typename... args_t>
+data_t& pTree<key_t, data_t, alloc_t>::emplace( const key_t& k, args_t&&... args ) {
+    bool inserted;
+    pTreeNode<data_t>* iter = insert( &k, inserted, std::forward< args_t >( args )... );
+
+    if ( !inserted ) {
+        // the arguments may refer to the old element, so build its replacement first
+        *iter->data = data_t( std::forward< args_t >( args )... );
+    }
+
+    return *iter->data;
+}
+
+/*
+ * PATRICIA Tree -- Pop
+ * Remove whichever element lies at the key. The branch above the removed leaf
+ * is no longer needed and is replaced by the leaf's sibling.
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+void pTree<key_t, data_t, alloc_t>::pop( const key_t& k ) {
+    if ( !head ) {
+        return;
+    }
+
+    const unsigned char* bytes = nullptr;
+    const unsigned numBytes = getKeyBytes( &k, &bytes );
+
+    pTreeNode<data_t>** link = &head;
+    pTreeNode<data_t>** parentLink = nullptr;
+    int dir = 0;
+
+    while ( !(*link)->isLeaf() ) {
+        parentLink = link;
+        dir = getBit( bytes, numBytes, (*link)->bitIndex );
+        link = &((*link)->subNodes[ dir ]);
+    }
+
+    pTreeNode<data_t>* leaf = *link;
+    unsigned critBit;
+
+    if ( findCritBit( bytes, numBytes, leaf->keyBytes, leaf->numBytes, critBit ) ) {
+        return;
+    }
+
+    if ( !parentLink ) {
+        head = nullptr;
+    }
+    else {
+        pTreeNode<data_t>* branch = *parentLink;
+        *parentLink = branch->subNodes[ !dir ];
+
+        branch->subNodes[ BNODE_LEFT ] = branch->subNodes[ BNODE_RIGHT ] = nullptr;
+        destroyNode( branch );
+    }
+
+    destroyNode( leaf );
+    --numNodes;
+}
+
+/*
+ * PATRICIA Tree -- Has Data
+ * Return true if there is a data element at the key
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+bool pTree<key_t, data_t, alloc_t>::hasData( const key_t& k ) const {
+    return iterate( &k ) != nullptr;
+}
+
+/*
+ * PATRICIA Tree -- Get Data
+ * Return a pointer to the data that lies at a key
+ * Returns a nullptr if no data exists
+ */
+template <typename key_t, typename data_t, typename alloc_t>
+const data_t* pTree<key_t, data_t, alloc_t>::getData( const key_t& k ) const {
+    pTreeNode<data_t>* iter = iterate( &k );
+
+    return iter ? iter->data : nullptr;
+}
+
+} // end containers namespace
+} // end hamLibs namespace
+
+#endif  /* __HL_P_TREE_H__ */
@@ -1,28 +1,48 @@
 /*
  * stack class
+ * push() and emplace() link new elements in front of the others, and pop()
+ * removes the element at the front, so elements leave in the reverse of the
+ * order they were pushed. back() returns the oldest element.
+ * Nodes are reserved through 'alloc_t' (see utils/allocator.h).
 */
 
 #ifndef __HL_QUEUE__
 #define __HL_QUEUE__
 
+#include <utility>
+#include "../utils/allocator.h"
+#include "../utils/iterators.h"
+
 namespace hamLibs {
 namespace containers {
 
-template <typename type>
+template <typename type, typename alloc_t = utils::heapAllocator>
 class queue {
 	private:
 		struct node {
 			type data;
-			node *next = nullptr;
+			node *next;
+			template <typename... args_t>
+			node(args_t&&... args);
 		};
+		alloc_t		allocator;
 		node		*first = nullptr;		//List navigation
 		node		*last = nullptr;
 		int	numNodes;
 		
 		
 	public:
+		typedef utils::nodeIterator<node, type>			iterator;
+		typedef utils::nodeIterator<node, const type>	constIterator;
+
 		queue		();
+		explicit queue	(const alloc_t& a);
+		queue		(const queue&) = delete;
+		queue		(queue&& moved);
 		~queue		();
+		
+		queue&		operator =	(const queue&) = delete;
+		queue&		operator =	(queue&& moved);
 
 		//data acquisition
 		type*		front		() const;
@@ -31,74 +51,133 @@ class queue {
 
 		//insertion & deletion
 		void		push		(const type& object);
+		void		push		(type&& object);
+		template <typename... args_t>
+		type&		emplace		(args_t&&... args);	//construct an element in place and push it
 		void		pop			();
 		void		clear		();
 
+		//iteration, from the front of the queue to the back
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
 		//miscellaneous
 		int	size		() const;
 		bool		empty		() const;
+		alloc_t&	getAllocator	();
 };
 
 //-----------------------------------------------------------------------------
 //			Construction & Destruction
 //-----------------------------------------------------------------------------
-template <typename type>
-queue<type>::queue() :
+template <typename type, typename alloc_t>
+template <typename... args_t>
+queue<type, alloc_t>::node::node(args_t&&... args) :
+	data(std::forward<args_t>(args)...),
+	next(nullptr)
+{}
+
+template <typename type, typename alloc_t>
+queue<type, alloc_t>::queue() :
+	allocator(),
 	first( nullptr ),
 	last( nullptr ),
 	numNodes( 0 )
 {}
 
-template <typename type>
-queue<type>::~queue() {
+template <typename type, typename alloc_t>
+queue<type, alloc_t>::queue(const alloc_t& a) :
+	allocator( a ),
+	first( nullptr ),
+	last( nullptr ),
+	numNodes( 0 )
+{}
+
+template <typename type, typename alloc_t>
+queue<type, alloc_t>::queue(queue&& moved) :
+	queue(moved.allocator)
+{
+	*this = std::move(moved);
+}
+
+template <typename type, typename alloc_t>
+queue<type, alloc_t>::~queue() {
+	clear();
+}
+
+template <typename type, typename alloc_t>
+queue<type, alloc_t>& queue<type, alloc_t>::operator =(queue&& moved) {
+	if (this == &moved) return *this;
+
 	clear();
+	first = moved.first;
+	last = moved.last;
+	numNodes = moved.numNodes;
+	allocator = std::move(moved.allocator);
+
+	moved.first = moved.last = nullptr;
+	moved.numNodes = 0;
+	return *this;
 }
 
 //-----------------------------------------------------------------------------
 //			Data Acquisition
 //-----------------------------------------------------------------------------
-template <typename type>
-type* queue<type>::front() const {
+template <typename type, typename alloc_t>
+type* queue<type, alloc_t>::front() const {
 	return (first) ? (&first->data) : nullptr;
 }
 
-template <typename type>
-type* queue<type>::peekNext() const {
+template <typename type, typename alloc_t>
+type* queue<type, alloc_t>::peekNext() const {
 	if (first && first->next)
 		return &(first->next->data);
 	return nullptr;
 }
 
-template <typename type>
-type* queue<type>::back() const {
+template <typename type, typename alloc_t>
+type* queue<type, alloc_t>::back() const {
 	return (last) ? &(last->data) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
 //			Insertion
 //-----------------------------------------------------------------------------
-template <typename type>
-void queue<type>::push(const type& object) {
-	node* temp = new node;
-	temp->data = object;
+template <typename type, typename alloc_t>
+void queue<type, alloc_t>::push(const type& object) {
+	emplace(object);
+}
+
+template <typename type, typename alloc_t>
+void queue<type, alloc_t>::push(type&& object) {
+	emplace(std::move(object));
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& queue<type, alloc_t>::emplace(args_t&&... args) {
+	node* temp = utils::createItem<node>(allocator, std::forward<args_t>(args)...);
 	temp->next = first;
 	first = temp;
 	++numNodes;
 	
 	if (numNodes == 1)
 		last = first;
+	return temp->data;
 }
 
 //-----------------------------------------------------------------------------
 //			Deletion
 //-----------------------------------------------------------------------------
-template <typename type>
-void queue<type>::pop() {
+template <typename type, typename alloc_t>
+void queue<type, alloc_t>::pop() {
 	if (first == nullptr)
 		return;
 	
 	node* temp( first->next );
-	delete first;
+	utils::destroyItem(allocator, first);
 	--numNodes;
 	
 	first = temp;	
@@ -106,26 +185,54 @@ void queue<type>::pop() {
 		last = nullptr;
 }
 
-template <typename type>
-void queue<type>::clear() {
+template <typename type, typename alloc_t>
+void queue<type, alloc_t>::clear() {
 	while (first != nullptr) {
 		pop();
 	}
 }
 
+//-----------------------------------------------------------------------------
+//			Iteration
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+typename queue<type, alloc_t>::iterator queue<type, alloc_t>::begin() {
+	return iterator(first);
+}
+
+template <typename type, typename alloc_t>
+typename queue<type, alloc_t>::iterator queue<type, alloc_t>::end() {
+	return iterator(nullptr);
+}
+
+template <typename type, typename alloc_t>
+typename queue<type, alloc_t>::constIterator queue<type, alloc_t>::begin() const {
+	return constIterator(first);
+}
+
+template <typename type, typename alloc_t>
+typename queue<type, alloc_t>::constIterator queue<type, alloc_t>::end() const {
+	return constIterator(nullptr);
+}
+
 //-----------------------------------------------------------------------------
 //			Miscellaneous
 //-----------------------------------------------------------------------------
-template <typename type>
-int queue<type>::size() const {
+template <typename type, typename alloc_t>
+int queue<type, alloc_t>::size() const {
 	return numNodes;
 }
 
-template <typename type>
-bool queue<type>::empty() const {
+template <typename type, typename alloc_t>
+bool queue<type, alloc_t>::empty() const {
 	return (first == nullptr) ? true : false;
 }
 
+template <typename type, typename alloc_t>
+alloc_t& queue<type, alloc_t>::getAllocator() {
+	return allocator;
+}
+
 } //end containers namespace
 } //end hamlibs namespace
 #endif //__HL_QUEUE__
@@ -0,0 +1,354 @@
+/*
+ * A first-in, first-out queue stored in a circular buffer.
+ * It offers the same interface as containers::queue, but elements sit
+ * contiguously in a single ring of memory rather than in separately
+ * allocated nodes. Unlike containers::queue, which pops the most recently
+ * pushed element first, elements leave in the order they were pushed. Pushing and popping never allocate once the ring is large
+ * enough; when the ring fills up, its capacity doubles and the elements are
+ * moved into the new ring, front first.
+ *
+ * The capacity is always a power of two so that positions wrap around with a
+ * mask rather than a division. Pushing an element invalidates pointers to
+ * the other elements whenever the ring grows.
+ *
+ * Memory is reserved through 'alloc_t' (see utils/allocator.h).
+ */
+
+#ifndef __HL_RING_QUEUE_H__
+#define __HL_RING_QUEUE_H__
+
+#include <new>
+#include <utility>
+#include "../utils/allocator.h"
+#include "../utils/assert.h"
+#include "../utils/copy.h"
+#include "../utils/iterators.h"
+
+namespace hamLibs {
+namespace containers {
+
+template <typename type, typename alloc_t = utils::heapAllocator>
+class ringQueue {
+	private:
+		alloc_t allocator;
+		type* Ring;
+		int Capacity;		// always zero or a power of two
+		int Start;			// position of the front element within the ring
+		int Size;
+
+		type*			item		(int index) const;
+		void			relocate	(type* dest);
+		void			reallocate	(int newCapacity);
+		void			release		();
+		template <typename... args_t>
+		HL_NOINLINE type&	emplaceRealloc	(args_t&&... args);
+
+	public:
+		typedef utils::indexIterator<ringQueue, type>				iterator;
+		typedef utils::indexIterator<const ringQueue, const type>	constIterator;
+
+		ringQueue			();
+		explicit ringQueue	(const alloc_t& a);
+		ringQueue			(const ringQueue& copy);
+		ringQueue			(ringQueue&& moved);
+		~ringQueue			();
+
+		ringQueue&	operator =	(const ringQueue& input);
+		ringQueue&	operator =	(ringQueue&& input);
+		type&		operator []	(int);			//elements are indexed from the front
+		const type&	operator []	(int) const;
+
+		//data acquisition
+		type*		front		() const;
+		type*		peekNext	() const;
+		type*		back		() const;
+
+		//insertion & deletion
+		void		push		(const type& object);
+		void		push		(type&& object);
+		template <typename... args_t>
+		type&		emplace		(args_t&&... args);	//construct an element in place at the back of the queue
+		void		pop			();
+		void		clear		();
+
+		//iteration, from the front of the queue to the back
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
+		//miscellaneous
+		void		reserve		(int numItems);
+		int			capacity	() const;
+		int			size		() const;
+		bool		empty		() const;
+		alloc_t&	getAllocator	();
+};
+
+//---------------------------------------------------------------------
+//			Storage
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+inline type* ringQueue<type, alloc_t>::item(int index) const {
+	return Ring + ((Start + index) & (Capacity-1));
+}
+
+template <typename type, typename alloc_t>
+void ringQueue<type, alloc_t>::relocate(type* dest) {
+	//the ring is unwrapped so that the front lands at the start of 'dest'
+	const int firstRun = (Start + Size <= Capacity) ? Size : Capacity - Start;
+	utils::relocateItems(dest, Ring + Start, firstRun);
+	utils::relocateItems(dest + firstRun, Ring, Size - firstRun);
+}
+
+template <typename type, typename alloc_t>
+void ringQueue<type, alloc_t>::reallocate(int newCapacity) {
+	type* const temp = utils::allocateItems<type>(allocator, newCapacity);
+	relocate(temp);
+	utils::deallocateItems(allocator, Ring, Capacity);
+	Ring = temp;
+	Capacity = newCapacity;
+	Start = 0;
+}
+
+template <typename type, typename alloc_t>
+void ringQueue<type, alloc_t>::release() {
+	clear();
+	utils::deallocateItems(allocator, Ring, Capacity);
+	Ring = nullptr;
+	Capacity = 0;
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& ringQueue<type, alloc_t>::emplaceRealloc(args_t&&... args) {
+	//the new element is built before the old ones move, in case 'args'
+	//refers to one of them
+	const int newCapacity = (Capacity) ? Capacity*2 : 8;
+	type* const temp = utils::allocateItems<type>(allocator, newCapacity);
+
+	try {
+		new(temp + Size) type(std::forward<args_t>(args)...);
+	}
+	catch (...) {
+		utils::deallocateItems(allocator, temp, newCapacity);
+		throw;
+	}
+
+	relocate(temp);
+	utils::deallocateItems(allocator, Ring, Capacity);
+	Ring = temp;
+	Capacity = newCapacity;
+	Start = 0;
+
+	return Ring[Size++];
+}
+
+//---------------------------------------------------------------------
+//			[Con/De]struction
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+ringQueue<type, alloc_t>::ringQueue() :
+	ringQueue(alloc_t())
+{}
+
+template <typename type, typename alloc_t>
+ringQueue<type, alloc_t>::ringQueue(const alloc_t& a) :
+	allocator(a),
+	Ring(nullptr),
+	Capacity(0),
+	Start(0),
+	Size(0)
+{}
+
+template <typename type, typename alloc_t>
+ringQueue<type, alloc_t>::ringQueue(const ringQueue& copy) :
+	ringQueue(copy.allocator)
+{
+	*this = copy;
+}
+
+template <typename type, typename alloc_t>
+ringQueue<type, alloc_t>::ringQueue(ringQueue&& moved) :
+	ringQueue(moved.allocator)
+{
+	*this = std::move(moved);
+}
+
+template <typename type, typename alloc_t>
+ringQueue<type, alloc_t>::~ringQueue() {
+	release();
+}
+
+//---------------------------------------------------------------------
+//			Operators
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+ringQueue<type, alloc_t>& ringQueue<type, alloc_t>::operator = (const ringQueue& input) {
+	if (this != &input) {
+		clear();
+		reserve(input.Size);
+		for (int i = 0; i < input.Size; ++i) {
+			new(Ring + i) type(*input.item(i));
+			++Size;
+		}
+	}
+	return *this;
+}
+
+template <typename type, typename alloc_t>
+ringQueue<type, alloc_t>& ringQueue<type, alloc_t>::operator = (ringQueue&& input) {
+	if (this == &input) return *this;
+
+	release();
+
+	//the allocator moves along with the memory it reserved
+	allocator = std::move(input.allocator);
+	Ring = input.Ring;
+	Capacity = input.Capacity;
+	Start = input.Start;
+	Size = input.Size;
+
+	input.Ring = nullptr;
+	input.Capacity = input.Start = input.Size = 0;
+	return *this;
+}
+
+template <typename type, typename alloc_t>
+type& ringQueue<type, alloc_t>::operator [] (int index) {
+	HL_ASSERT(index >= 0 && index < Size);
+	return *item(index);
+}
+
+template <typename type, typename alloc_t>
+const type& ringQueue<type, alloc_t>::operator [] (int index) const {
+	HL_ASSERT(index >= 0 && index < Size);
+	return *item(index);
+}
+
+//---------------------------------------------------------------------
+//			Data Acquisition
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+type* ringQueue<type, alloc_t>::front() const {
+	return (Size) ? Ring + Start : nullptr;
+}
+
+template <typename type, typename alloc_t>
+type* ringQueue<type, alloc_t>::peekNext() const {
+	return (Size > 1) ? item(1) : nullptr;
+}
+
+template <typename type, typename alloc_t>
+type* ringQueue<type, alloc_t>::back() const {
+	return (Size) ? item(Size-1) : nullptr;
+}
+
+//---------------------------------------------------------------------
+//			Insertion
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void ringQueue<type, alloc_t>::push(const type& object) {
+	emplace(object);
+}
+
+template <typename type, typename alloc_t>
+void ringQueue<type, alloc_t>::push(type&& object) {
+	emplace(std::move(object));
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+inline type& ringQueue<type, alloc_t>::emplace(args_t&&... args) {
+	if (Size == Capacity) {
+		return emplaceRealloc(std::forward<args_t>(args)...);
+	}
+
+	type* const slot = item(Size);
+	new(slot) type(std::forward<args_t>(args)...);
+	++Size;
+	return *slot;
+}
+
+//---------------------------------------------------------------------
+//			Deletion
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void ringQueue<type, alloc_t>::pop() {
+	if (!Size) return;
+
+	Ring[Start].~type();
+	Start = (Start + 1) & (Capacity-1);
+	--Size;
+}
+
+template <typename type, typename alloc_t>
+void ringQueue<type, alloc_t>::clear() {
+	for (int i = 0; i < Size; ++i) {
+		item(i)->~type();
+	}
+	Start = 0;
+	Size = 0;
+}
+
+//---------------------------------------------------------------------
+//			Iteration
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+typename ringQueue<type, alloc_t>::iterator ringQueue<type, alloc_t>::begin() {
+	return iterator(this, 0);
+}
+
+template <typename type, typename alloc_t>
+typename ringQueue<type, alloc_t>::iterator ringQueue<type, alloc_t>::end() {
+	return iterator(this, Size);
+}
+
+template <typename type, typename alloc_t>
+typename ringQueue<type, alloc_t>::constIterator ringQueue<type, alloc_t>::begin() const {
+	return constIterator(this, 0);
+}
+
+template <typename type, typename alloc_t>
+typename ringQueue<type, alloc_t>::constIterator ringQueue<type, alloc_t>::end() const {
+	return constIterator(this, Size);
+}
+
+//---------------------------------------------------------------------
+//			Miscellaneous
+//---------------------------------------------------------------------
+template <typename type, typename alloc_t>
+void ringQueue<type, alloc_t>::reserve(int numItems) {
+	if (numItems <= Capacity) return;
+
+	int newCapacity = (Capacity) ? Capacity : 8;
+	while (newCapacity < numItems) {
+		newCapacity *= 2;
+	}
+	reallocate(newCapacity);
+}
+
+template <typename type, typename alloc_t>
+int ringQueue<type, alloc_t>::capacity() const {
+	return Capacity;
+}
+
+template <typename type, typename alloc_t>
+int ringQueue<type, alloc_t>::size() const {
+	return Size;
+}
+
+template <typename type, typename alloc_t>
+bool ringQueue<type, alloc_t>::empty() const {
+	return Size == 0;
+}
+
+template <typename type, typename alloc_t>
+alloc_t& ringQueue<type, alloc_t>::getAllocator() {
+	return allocator;
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+
+#endif /* __HL_RING_QUEUE_H__ */
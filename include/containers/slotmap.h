@@ -0,0 +1,517 @@
+/*
+ * A slot map, which stores elements densely and refers to them by
+ * generational handles.
+ * Pushing an element returns a handle which stays valid until that element
+ * is popped, no matter how many other elements are added or removed.
+ * Insertion, removal and lookup all take constant time. Removing an element
+ * moves the last element into its place, so the elements always sit in one
+ * contiguous block which can be iterated with begin() and end(), or data()
+ * and size().
+ *
+ * Each handle packs a slot index with the generation of that slot. Popping
+ * an element advances the generation of its slot, so handles to removed
+ * elements are detected rather than aliasing whatever reuses the slot.
+ * Handles are 32 bits (20 index bits, 12 generation bits) or 64 bits (32 and
+ * 32). The highest index marks the end of the free slot list, so a map holds
+ * at most 2^20-1 or 2^32-1 slots; pushing past that fails an HL_ASSERT. A
+ * slot whose generation runs out is retired and never reused. A handle of 0
+ * never refers to an element.
+ *
+ * Memory is reserved through 'alloc_t' (see utils/allocator.h).
+ */
+
+#ifndef __HL_SLOT_MAP_H__
+#define __HL_SLOT_MAP_H__
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../utils/allocator.h"
+#include "../utils/assert.h"
+#include "../utils/copy.h"
+
+namespace hamLibs {
+namespace containers {
+
+template <typename type, typename handle_t = std::uint32_t, typename alloc_t = utils::heapAllocator>
+class slotMap {
+	static_assert(
+		std::is_same<handle_t, std::uint32_t>::value || std::is_same<handle_t, std::uint64_t>::value,
+		"slotMap handles must be either 32 or 64-bit unsigned integers."
+	);
+
+	private:
+		/*
+		 * Every slot holds a generation in its upper bits. Odd generations
+		 * belong to live elements, and the lower bits hold the element's
+		 * position in the dense array. Even generations belong to free
+		 * slots, and the lower bits link to the next free slot.
+		 */
+		enum : unsigned {
+			INDEX_BITS = (sizeof(handle_t) == 4) ? 20 : 32
+		};
+
+		static constexpr handle_t INDEX_MASK = (handle_t(1) << INDEX_BITS) - 1;
+		static constexpr handle_t MAX_GENERATION = handle_t(~handle_t(0)) >> INDEX_BITS;
+		static constexpr handle_t NO_SLOT = INDEX_MASK;
+
+		alloc_t allocator;
+		type* Items;		// densely packed elements
+		handle_t* Owners;	// slot index of each element
+		handle_t* Slots;
+		int Size;
+		int Capacity;
+		int NumSlots;
+		int SlotCapacity;
+		handle_t FreeSlots;	// head of the free slot list
+
+		static handle_t	generation	(handle_t h) { return h >> INDEX_BITS; }
+		static handle_t	makeHandle	(handle_t gen, handle_t index) { return (gen << INDEX_BITS) | index; }
+
+		int				find		(handle_t h) const;
+		void			reallocate	(int newCapacity);
+		void			reserveSlot	();
+		handle_t		claimSlot	(int itemIndex);
+		void			releaseSlot	(handle_t slot);
+		void			release		();
+		void			steal		(slotMap& moved);
+		template <typename... args_t>
+		HL_NOINLINE handle_t	emplaceRealloc	(args_t&&... args);
+
+	public:
+		typedef type*		iterator;
+		typedef const type*	constIterator;
+
+		slotMap			();
+		explicit slotMap	(const alloc_t& a);
+		slotMap			(const slotMap& copy);
+		slotMap			(slotMap&& moved);
+		~slotMap			();
+
+		//operators
+		slotMap&	operator =	(const slotMap& input);
+		slotMap&	operator =	(slotMap&& input);
+		type&		operator []	(int);
+		const type&	operator []	(int) const;
+
+		//deletion
+		bool		pop			(handle_t h);
+
+		//insertion
+		handle_t	push		(const type& data);
+		handle_t	push		(type&& data);
+		template <typename... args_t>
+		handle_t	emplace		(args_t&&... args);
+
+		//lookup
+		type*		getData		(handle_t h);
+		const type*	getData		(handle_t h) const;
+		bool		hasData		(handle_t h) const;
+		handle_t	getHandle	(int index) const;
+
+		//traversal
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
+		//miscellaneous
+		void		reserve		(int numItems);
+		void		clear		();
+		bool		empty		() const;
+		int			size		() const;
+		int			capacity	() const;
+		type*		data		() const;
+		alloc_t&	getAllocator	();
+};
+
+//---------------------------------------------------------------------
+//			Storage
+//---------------------------------------------------------------------
+template <typename type, typename handle_t, typename alloc_t>
+int slotMap<type, handle_t, alloc_t>::find(handle_t h) const {
+	const handle_t slot = h & INDEX_MASK;
+	if (slot >= handle_t(NumSlots)) return -1;
+
+	//the generation must match and belong to a live element
+	const handle_t current = Slots[slot];
+	if (generation(current ^ h) != 0 || (generation(h) & 1) == 0) return -1;
+
+	return int(current & INDEX_MASK);
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+void slotMap<type, handle_t, alloc_t>::reallocate(int newCapacity) {
+	type* tempItems = utils::allocateItems<type>(allocator, newCapacity);
+	handle_t* tempOwners;
+
+	try {
+		tempOwners = utils::allocateItems<handle_t>(allocator, newCapacity);
+	}
+	catch (...) {
+		utils::deallocateItems(allocator, tempItems, newCapacity);
+		throw;
+	}
+
+	utils::relocateItems(tempItems, Items, Size);
+	utils::constructItems(tempOwners, Owners, Size);
+	release();
+
+	Items = tempItems;
+	Owners = tempOwners;
+	Capacity = newCapacity;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+void slotMap<type, handle_t, alloc_t>::reserveSlot() {
+	//make sure claimSlot() cannot fail once an element has been constructed
+	if (FreeSlots != NO_SLOT) return;
+
+	//fresh slots stop short of NO_SLOT, which ends the free list
+	HL_ASSERT(handle_t(NumSlots) < NO_SLOT);
+	if (NumSlots < SlotCapacity) return;
+
+	int newCapacity = (SlotCapacity) ? SlotCapacity*2 : 4;
+	if (handle_t(newCapacity) > NO_SLOT) {
+		newCapacity = int(NO_SLOT);
+	}
+	handle_t* temp = utils::allocateItems<handle_t>(allocator, newCapacity);
+	utils::constructItems(temp, Slots, NumSlots);
+	utils::deallocateItems(allocator, Slots, SlotCapacity);
+	Slots = temp;
+	SlotCapacity = newCapacity;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+handle_t slotMap<type, handle_t, alloc_t>::claimSlot(int itemIndex) {
+	handle_t slot;
+
+	if (FreeSlots != NO_SLOT) {
+		slot = FreeSlots;
+		FreeSlots = Slots[slot] & INDEX_MASK;
+	}
+	else {
+		slot = handle_t(NumSlots++);
+		Slots[slot] = 0;
+	}
+
+	const handle_t gen = generation(Slots[slot]) + 1;
+	Slots[slot] = makeHandle(gen, handle_t(itemIndex));
+	Owners[itemIndex] = slot;
+	return makeHandle(gen, slot);
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+void slotMap<type, handle_t, alloc_t>::releaseSlot(handle_t slot) {
+	const handle_t gen = generation(Slots[slot]);
+
+	//slots which have used up every generation are left off the free list
+	if (gen == MAX_GENERATION) {
+		Slots[slot] = 0;
+		return;
+	}
+
+	Slots[slot] = makeHandle(gen + 1, FreeSlots);
+	FreeSlots = slot;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+void slotMap<type, handle_t, alloc_t>::release() {
+	utils::deallocateItems(allocator, Items, Capacity);
+	utils::deallocateItems(allocator, Owners, Capacity);
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+void slotMap<type, handle_t, alloc_t>::steal(slotMap& moved) {
+	Items = moved.Items;
+	Owners = moved.Owners;
+	Slots = moved.Slots;
+	Size = moved.Size;
+	Capacity = moved.Capacity;
+	NumSlots = moved.NumSlots;
+	SlotCapacity = moved.SlotCapacity;
+	FreeSlots = moved.FreeSlots;
+
+	moved.Items = nullptr;
+	moved.Owners = nullptr;
+	moved.Slots = nullptr;
+	moved.Size = moved.Capacity = 0;
+	moved.NumSlots = moved.SlotCapacity = 0;
+	moved.FreeSlots = NO_SLOT;
+}
+
+//---------------------------------------------------------------------
+//			[Con/De]struction
+//---------------------------------------------------------------------
+template <typename type, typename handle_t, typename alloc_t>
+slotMap<type, handle_t, alloc_t>::slotMap() :
+	slotMap(alloc_t())
+{}
+
+template <typename type, typename handle_t, typename alloc_t>
+slotMap<type, handle_t, alloc_t>::slotMap(const alloc_t& a) :
+	allocator(a),
+	Items(nullptr),
+	Owners(nullptr),
+	Slots(nullptr),
+	Size(0),
+	Capacity(0),
+	NumSlots(0),
+	SlotCapacity(0),
+	FreeSlots(NO_SLOT)
+{}
+
+template <typename type, typename handle_t, typename alloc_t>
+slotMap<type, handle_t, alloc_t>::slotMap(const slotMap& copy) :
+	slotMap(copy.allocator)
+{
+	//slots are copied as they are, so handles from 'copy' work on the copy
+	*this = copy;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+slotMap<type, handle_t, alloc_t>::slotMap(slotMap&& moved) :
+	allocator(std::move(moved.allocator))
+{
+	steal(moved);
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+slotMap<type, handle_t, alloc_t>::~slotMap() {
+	clear();
+	release();
+	utils::deallocateItems(allocator, Slots, SlotCapacity);
+}
+
+//---------------------------------------------------------------------
+//			Operators
+//---------------------------------------------------------------------
+template <typename type, typename handle_t, typename alloc_t>
+slotMap<type, handle_t, alloc_t>& slotMap<type, handle_t, alloc_t>::operator = (const slotMap& input) {
+	if (this == &input) return *this;
+
+	clear();
+	if (Capacity < input.Size) {
+		reallocate(input.Size);
+	}
+	if (SlotCapacity < input.NumSlots) {
+		handle_t* temp = utils::allocateItems<handle_t>(allocator, input.NumSlots);
+		utils::deallocateItems(allocator, Slots, SlotCapacity);
+		Slots = temp;
+		SlotCapacity = input.NumSlots;
+	}
+
+	utils::constructItems(Items, input.Items, input.Size);
+	utils::constructItems(Owners, input.Owners, input.Size);
+	utils::constructItems(Slots, input.Slots, input.NumSlots);
+	Size = input.Size;
+	NumSlots = input.NumSlots;
+	FreeSlots = input.FreeSlots;
+	return *this;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+slotMap<type, handle_t, alloc_t>& slotMap<type, handle_t, alloc_t>::operator = (slotMap&& input) {
+	if (this != &input) {
+		clear();
+		release();
+		utils::deallocateItems(allocator, Slots, SlotCapacity);
+		//the allocator moves along with the memory it reserved
+		allocator = std::move(input.allocator);
+		steal(input);
+	}
+	return *this;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+type& slotMap<type, handle_t, alloc_t>::operator [] (int index) {
+	HL_ASSERT(index >= 0 && index < Size);
+	return Items[index];
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+const type& slotMap<type, handle_t, alloc_t>::operator [] (int index) const {
+	HL_ASSERT(index >= 0 && index < Size);
+	return Items[index];
+}
+
+//---------------------------------------------------------------------
+//			Deletion
+//---------------------------------------------------------------------
+template <typename type, typename handle_t, typename alloc_t>
+bool slotMap<type, handle_t, alloc_t>::pop(handle_t h) {
+	const int index = find(h);
+	if (index < 0) return false;
+
+	//fill the gap with the last element to keep the items contiguous
+	const int last = Size-1;
+	if (index != last) {
+		Items[index] = std::move(Items[last]);
+		Owners[index] = Owners[last];
+		Slots[Owners[index]] = (Slots[Owners[index]] & ~INDEX_MASK) | handle_t(index);
+	}
+
+	Items[last].~type();
+	Size = last;
+	releaseSlot(h & INDEX_MASK);
+	return true;
+}
+
+//---------------------------------------------------------------------
+//			Insertion
+//---------------------------------------------------------------------
+template <typename type, typename handle_t, typename alloc_t>
+handle_t slotMap<type, handle_t, alloc_t>::push(const type& data) {
+	return emplace(data);
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+handle_t slotMap<type, handle_t, alloc_t>::push(type&& data) {
+	return emplace(std::move(data));
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+template <typename... args_t>
+handle_t slotMap<type, handle_t, alloc_t>::emplace(args_t&&... args) {
+	reserveSlot();
+	if (Size == Capacity) {
+		return emplaceRealloc(std::forward<args_t>(args)...);
+	}
+	new(Items+Size) type(std::forward<args_t>(args)...);
+	const handle_t h = claimSlot(Size);
+	++Size;
+	return h;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+template <typename... args_t>
+handle_t slotMap<type, handle_t, alloc_t>::emplaceRealloc(args_t&&... args) {
+	//construct the new element first in case the arguments refer to an
+	//element of this map
+	const int newCapacity = (Capacity) ? Capacity*2 : 4;
+	type* tempItems = utils::allocateItems<type>(allocator, newCapacity);
+	handle_t* tempOwners = nullptr;
+
+	try {
+		tempOwners = utils::allocateItems<handle_t>(allocator, newCapacity);
+		new(tempItems+Size) type(std::forward<args_t>(args)...);
+	}
+	catch (...) {
+		utils::deallocateItems(allocator, tempOwners, newCapacity);
+		utils::deallocateItems(allocator, tempItems, newCapacity);
+		throw;
+	}
+
+	utils::relocateItems(tempItems, Items, Size);
+	utils::constructItems(tempOwners, Owners, Size);
+	release();
+
+	Items = tempItems;
+	Owners = tempOwners;
+	Capacity = newCapacity;
+
+	const handle_t h = claimSlot(Size);
+	++Size;
+	return h;
+}
+
+//---------------------------------------------------------------------
+//			Lookup
+//---------------------------------------------------------------------
+template <typename type, typename handle_t, typename alloc_t>
+type* slotMap<type, handle_t, alloc_t>::getData(handle_t h) {
+	const int index = find(h);
+	return (index < 0) ? nullptr : Items+index;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+const type* slotMap<type, handle_t, alloc_t>::getData(handle_t h) const {
+	const int index = find(h);
+	return (index < 0) ? nullptr : Items+index;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+bool slotMap<type, handle_t, alloc_t>::hasData(handle_t h) const {
+	return find(h) >= 0;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+handle_t slotMap<type, handle_t, alloc_t>::getHandle(int index) const {
+	HL_ASSERT(index >= 0 && index < Size);
+	const handle_t slot = Owners[index];
+	return (Slots[slot] & ~INDEX_MASK) | slot;
+}
+
+//---------------------------------------------------------------------
+//			Traversal
+//---------------------------------------------------------------------
+template <typename type, typename handle_t, typename alloc_t>
+typename slotMap<type, handle_t, alloc_t>::iterator slotMap<type, handle_t, alloc_t>::begin() {
+	return Items;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+typename slotMap<type, handle_t, alloc_t>::iterator slotMap<type, handle_t, alloc_t>::end() {
+	return Items + Size;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+typename slotMap<type, handle_t, alloc_t>::constIterator slotMap<type, handle_t, alloc_t>::begin() const {
+	return Items;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+typename slotMap<type, handle_t, alloc_t>::constIterator slotMap<type, handle_t, alloc_t>::end() const {
+	return Items + Size;
+}
+
+//---------------------------------------------------------------------
+//			Misc
+//---------------------------------------------------------------------
+template <typename type, typename handle_t, typename alloc_t>
+void slotMap<type, handle_t, alloc_t>::reserve(int numItems) {
+	if (numItems > Capacity) {
+		reallocate(numItems);
+	}
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+void slotMap<type, handle_t, alloc_t>::clear() {
+	//every outstanding handle becomes stale
+	for (int i = 0; i < Size; ++i) {
+		Items[i].~type();
+		releaseSlot(Owners[i]);
+	}
+	Size = 0;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+bool slotMap<type, handle_t, alloc_t>::empty() const {
+	return Size == 0;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+int slotMap<type, handle_t, alloc_t>::size() const {
+	return Size;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+int slotMap<type, handle_t, alloc_t>::capacity() const {
+	return Capacity;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+type* slotMap<type, handle_t, alloc_t>::data() const {
+	return Items;
+}
+
+template <typename type, typename handle_t, typename alloc_t>
+alloc_t& slotMap<type, handle_t, alloc_t>::getAllocator() {
+	return allocator;
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+
+#endif /* __HL_SLOT_MAP_H__ */
@@ -0,0 +1,570 @@
+/*
+ * A dynamic array which keeps its first N elements inside the object itself.
+ * Arrays which never hold more than N elements never touch the heap. Larger
+ * arrays spill onto the heap and grow geometrically, like containers::array.
+ * Heap memory is reserved through 'alloc_t' (see utils/allocator.h).
+ */
+
+#ifndef __HL_SMALL_ARRAY_H__
+#define __HL_SMALL_ARRAY_H__
+
+#include <new>
+#include <utility>
+#include "../utils/allocator.h"
+#include "../utils/assert.h"
+#include "../utils/copy.h"
+
+namespace hamLibs {
+namespace containers {
+
+template <typename type, int N = 8, typename alloc_t = utils::heapAllocator>
+class smallArray {
+	static_assert(N > 0, "smallArray requires room for at least one inline element.");
+
+	private:
+		alloc_t allocator;
+		type* Array;
+		int Size;
+		int Capacity;
+		alignas(type) unsigned char Inline[sizeof(type) * N];
+
+		type*			inlineData	() { return reinterpret_cast<type*>(Inline); }
+		bool			isInline	() const { return Array == reinterpret_cast<const type*>(Inline); }
+		void			destroy		(int first, int last);
+		void			release		();
+		void			reallocate	(int newCapacity);
+		void			grow		(int minCapacity);
+		void			steal		(smallArray& moved);
+		template <typename... args_t>
+		HL_NOINLINE type&	emplaceRealloc	(args_t&&... args);
+
+	public:
+		typedef type*		iterator;
+		typedef const type*	constIterator;
+
+		smallArray			();
+		explicit smallArray	(const alloc_t& a);
+		smallArray			(int numItems, const alloc_t& a = alloc_t());
+		smallArray			(const type& data, const alloc_t& a = alloc_t());
+		smallArray			(const type& data, int numCopies, const alloc_t& a = alloc_t());
+		smallArray			(const smallArray& copy);
+		smallArray			(smallArray&& moved);
+		~smallArray			();
+
+		//operators
+		smallArray&	operator =	(const smallArray& input);
+		smallArray&	operator =	(smallArray&& input);
+		smallArray&	operator +=	(const smallArray& input);
+		smallArray	operator +	(const smallArray& input) const;
+		bool		operator ==	(const smallArray& compare) const;
+		bool		operator !=	(const smallArray& compare) const;
+		type&		operator []	(int);
+		const type&	operator []	(int) const;
+
+		//deletion
+		void		popFront	();
+		void		popBack		();
+		void		pop			(int index);
+		void		erase		(int index);
+		void		erase		(int first, int last);
+
+		//insertion
+		void		pushFront	(const type& data);
+		void		pushFront	(type&& data);
+		void		pushBack	(const type& data);
+		void		pushBack	(type&& data);
+		void		push		(int index, const type& data);
+		void		push		(int index, type&& data);
+		void		pushAfter	(int index, const type& data);
+		void		pushAfter	(int index, type&& data);
+		template <typename... args_t>
+		type&		emplaceBack	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplaceFront	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplace		(int index, args_t&&... args);	//construct an element at 'index', shifting later elements up
+
+		//traversal
+		type&		front		();
+		type&		back		();
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
+		//miscellaneous
+		static void	copy		(smallArray& dest, const smallArray& source);
+		static void	append		(smallArray& dest, const smallArray& source);
+		void		resize		(int newSize);
+		void		reserve		(int numItems);
+		void		shrinkToFit	();
+		void		clear		();
+		bool		empty		() const;
+		int	size		() const;
+		int	capacity	() const;
+		bool		isSpilled	() const;
+		type*		data		() const;
+		alloc_t&	getAllocator	();
+};
+
+//---------------------------------------------------------------------
+//			Storage
+//---------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::destroy(int first, int last) {
+	while (first < last) {
+		Array[first].~type();
+		++first;
+	}
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::release() {
+	if (!isInline()) {
+		utils::deallocateItems(allocator, Array, Capacity);
+	}
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::reallocate(int newCapacity) {
+	//elements move back into the inline buffer whenever they fit
+	type* temp = (newCapacity > N)
+		? utils::allocateItems<type>(allocator, newCapacity)
+		: inlineData();
+
+	if (temp == Array) return;
+
+	utils::relocateItems(temp, Array, Size);
+	release();
+	Array = temp;
+	Capacity = (newCapacity > N) ? newCapacity : N;
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::grow(int minCapacity) {
+	int newCapacity = Capacity*2;
+	if (newCapacity < minCapacity) {
+		newCapacity = minCapacity;
+	}
+	reallocate(newCapacity);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::steal(smallArray& moved) {
+	//heap storage changes owners, inline elements have to be moved
+	if (moved.isInline()) {
+		Array = inlineData();
+		Capacity = N;
+		utils::relocateItems(Array, moved.Array, moved.Size);
+	}
+	else {
+		allocator = std::move(moved.allocator);
+		Array = moved.Array;
+		Capacity = moved.Capacity;
+		moved.Array = moved.inlineData();
+		moved.Capacity = N;
+	}
+	Size = moved.Size;
+	moved.Size = 0;
+}
+
+//---------------------------------------------------------------------
+//			[Con/De]struction
+//---------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>::smallArray() :
+	allocator(),
+	Array(inlineData()),
+	Size(0),
+	Capacity(N)
+{}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>::smallArray(const alloc_t& a) :
+	allocator(a),
+	Array(inlineData()),
+	Size(0),
+	Capacity(N)
+{}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>::smallArray(int numItems, const alloc_t& a) :
+	smallArray(a)
+{
+	resize(numItems);
+}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>::smallArray(const smallArray& copy) :
+	smallArray(copy.allocator)
+{
+	reserve(copy.Size);
+	utils::constructItems(Array, copy.Array, copy.Size);
+	Size = copy.Size;
+}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>::smallArray(smallArray&& moved) :
+	allocator(moved.allocator),
+	Array(nullptr),
+	Size(0),
+	Capacity(0)
+{
+	steal(moved);
+}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>::smallArray(const type& data, const alloc_t& a) :
+	smallArray(a)
+{
+	new(Array) type(data);
+	Size = 1;
+}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>::smallArray(const type& data, int numCopies, const alloc_t& a) :
+	smallArray(a)
+{
+	reserve(numCopies);
+	while (Size < numCopies) {
+		new(Array+Size) type(data);
+		++Size;
+	}
+}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>::~smallArray() {
+	destroy(0, Size);
+	release();
+}
+
+//---------------------------------------------------------------------
+//			Operators
+//---------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>& smallArray<type, N, alloc_t>::operator = (const smallArray& input) {
+	if (this != &input) {
+		copy(*this, input);
+	}
+	return *this;
+}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>& smallArray<type, N, alloc_t>::operator = (smallArray&& input) {
+	if (this != &input) {
+		destroy(0, Size);
+		release();
+		steal(input);
+	}
+	return *this;
+}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t>& smallArray<type, N, alloc_t>::operator += (const smallArray& input) {
+	append(*this, input);
+	return *this;
+}
+
+template <typename type, int N, typename alloc_t>
+smallArray<type, N, alloc_t> smallArray<type, N, alloc_t>::operator + (const smallArray& input) const {
+	smallArray<type, N, alloc_t> temp(allocator);
+	temp.reserve(Size + input.Size);
+	append(temp, *this);
+	append(temp, input);
+	return temp;
+}
+
+template <typename type, int N, typename alloc_t>
+bool smallArray<type, N, alloc_t>::operator == (const smallArray& compare) const {
+	if (Size != compare.Size) return false;
+	int iter = 0;
+	while (iter < Size) {
+		if (Array[iter] != compare.Array[iter])
+			return false;
+		++iter;
+	}
+	return true;
+}
+
+template <typename type, int N, typename alloc_t>
+bool smallArray<type, N, alloc_t>::operator != (const smallArray& compare) const {
+	return !(*this == compare);
+}
+
+template <typename type, int N, typename alloc_t>
+type& smallArray<type, N, alloc_t>::operator [] (int index) {
+	HL_ASSERT(index >= 0);
+	return Array[index];
+}
+
+template <typename type, int N, typename alloc_t>
+const type& smallArray<type, N, alloc_t>::operator [] (int index) const {
+	HL_ASSERT(index >= 0);
+	return Array[index];
+}
+
+//---------------------------------------------------------------------
+//			Deletion
+//---------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::popFront() {
+	erase(0);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::popBack() {
+	if (!Size) return;
+	--Size;
+	Array[Size].~type();
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::pop(int index) {
+	erase(index);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::erase(int index) {
+	if (index < 0 || index >= Size) return;
+	erase(index, index+1);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::erase(int first, int last) {
+	//remove the elements in [first, last) by shifting the remainder down
+	if (first < 0) first = 0;
+	if (last > Size) last = Size;
+	if (first >= last) return;
+
+	utils::moveItems(Array+first, Array+last, Size-last);
+	destroy(Size-(last-first), Size);
+	Size -= last-first;
+}
+
+//---------------------------------------------------------------------
+//			Insertion
+//---------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::pushFront(const type& data) {
+	emplace(0, data);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::pushFront(type&& data) {
+	emplace(0, std::move(data));
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& smallArray<type, N, alloc_t>::emplaceFront(args_t&&... args) {
+	return emplace(0, std::forward<args_t>(args)...);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::pushBack(const type& data) {
+	emplaceBack(data);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::pushBack(type&& data) {
+	emplaceBack(std::move(data));
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& smallArray<type, N, alloc_t>::emplaceBack(args_t&&... args) {
+	const int index = Size;
+	if (index == Capacity) {
+		return emplaceRealloc(std::forward<args_t>(args)...);
+	}
+	type* const item = new(Array+index) type(std::forward<args_t>(args)...);
+	Size = index+1;
+	return *item;
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& smallArray<type, N, alloc_t>::emplaceRealloc(args_t&&... args) {
+	//construct the new element first in case the arguments refer to an
+	//element of this array
+	const int newCapacity = Capacity*2;
+	type* temp = utils::allocateItems<type>(allocator, newCapacity);
+	new(temp+Size) type(std::forward<args_t>(args)...);
+	utils::relocateItems(temp, Array, Size);
+	release();
+	Array = temp;
+	Capacity = newCapacity;
+	return Array[Size++];
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& smallArray<type, N, alloc_t>::emplace(int index, args_t&&... args) {
+	//Resize if trying to access an out-of-bounds element
+	if (index < 0) index = 0;
+	if (index >= Size) {
+		return emplaceBack(std::forward<args_t>(args)...);
+	}
+
+	//construct first in case the arguments refer to an element of this array
+	type temp(std::forward<args_t>(args)...);
+	if (Size == Capacity) {
+		grow(Size+1);
+	}
+
+	//shift the elements after 'index' up by one
+	utils::insertItem(Array, Size, index, std::move(temp));
+	++Size;
+	return Array[index];
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::push(int index, const type& data) {
+	emplace(index, data);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::push(int index, type&& data) {
+	emplace(index, std::move(data));
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::pushAfter(int index, const type& data) {
+	push(++index, data);
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::pushAfter(int index, type&& data) {
+	push(++index, std::move(data));
+}
+
+//---------------------------------------------------------------------
+//			Traversal
+//---------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+type& smallArray<type, N, alloc_t>::front() {
+	return Array[0];
+}
+
+template <typename type, int N, typename alloc_t>
+type& smallArray<type, N, alloc_t>::back() {
+	return Array[Size-1];
+}
+
+template <typename type, int N, typename alloc_t>
+typename smallArray<type, N, alloc_t>::iterator smallArray<type, N, alloc_t>::begin() {
+	return data();
+}
+
+template <typename type, int N, typename alloc_t>
+typename smallArray<type, N, alloc_t>::iterator smallArray<type, N, alloc_t>::end() {
+	return data() + Size;
+}
+
+template <typename type, int N, typename alloc_t>
+typename smallArray<type, N, alloc_t>::constIterator smallArray<type, N, alloc_t>::begin() const {
+	return data();
+}
+
+template <typename type, int N, typename alloc_t>
+typename smallArray<type, N, alloc_t>::constIterator smallArray<type, N, alloc_t>::end() const {
+	return data() + Size;
+}
+
+//---------------------------------------------------------------------
+//			Misc
+//---------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::copy(smallArray& dest, const smallArray& source) {
+	if (&dest == &source) return;
+
+	dest.clear();
+	dest.reserve(source.Size);
+	utils::constructItems(dest.Array, source.Array, source.Size);
+	dest.Size = source.Size;
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::append(smallArray& dest, const smallArray& source) {
+	//'source' may be the same array as 'dest'
+	const int numItems = source.Size;
+	if (dest.Capacity < dest.Size + numItems) {
+		dest.grow(dest.Size + numItems);
+	}
+
+	utils::constructItems(dest.Array+dest.Size, source.Array, numItems);
+	dest.Size += numItems;
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::resize(int newSize) {
+	//new elements are default-constructed
+	if (newSize < 0) newSize = 0;
+	if (newSize <= Size) {
+		destroy(newSize, Size);
+		Size = newSize;
+		return;
+	}
+
+	reserve(newSize);
+	while (Size < newSize) {
+		new(Array+Size) type();
+		++Size;
+	}
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::reserve(int numItems) {
+	if (numItems > Capacity) {
+		reallocate(numItems);
+	}
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::shrinkToFit() {
+	if (Size < Capacity) {
+		reallocate(Size);
+	}
+}
+
+template <typename type, int N, typename alloc_t>
+void smallArray<type, N, alloc_t>::clear() {
+	//any heap storage is kept for reuse, see shrinkToFit()
+	destroy(0, Size);
+	Size = 0;
+}
+
+template <typename type, int N, typename alloc_t>
+bool smallArray<type, N, alloc_t>::empty() const {
+	return (Size) ? false : true;
+}
+
+template <typename type, int N, typename alloc_t>
+int smallArray<type, N, alloc_t>::size() const {
+	return Size;
+}
+
+template <typename type, int N, typename alloc_t>
+int smallArray<type, N, alloc_t>::capacity() const {
+	return Capacity;
+}
+
+template <typename type, int N, typename alloc_t>
+bool smallArray<type, N, alloc_t>::isSpilled() const {
+	return !isInline();
+}
+
+template <typename type, int N, typename alloc_t>
+type* smallArray<type, N, alloc_t>::data() const {
+	return Array;
+}
+
+template <typename type, int N, typename alloc_t>
+alloc_t& smallArray<type, N, alloc_t>::getAllocator() {
+	return allocator;
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+
+#endif //__HL_SMALL_ARRAY_H__
@@ -0,0 +1,320 @@
+/*
+ * File:   spscqueue.h
+ * Author: hammy
+ *
+ * Bounded, wait-free queue between exactly one producer thread and one
+ * consumer thread.
+ */
+
+#ifndef __HL_SPSC_QUEUE_H__
+#define __HL_SPSC_QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "../utils/allocator.h"
+
+namespace hamLibs {
+namespace containers {
+
+/******************************************************************************
+ *  Single-Producer/Single-Consumer Queue Structure Setup
+ *
+ * Elements are stored in a ring whose size is a power of two. The producer
+ * owns the write position and the consumer owns the read position; each side
+ * only ever stores to its own position and loads the other's, so every
+ * operation finishes in a bounded number of steps using acquire and release
+ * atomics alone.
+ *
+ * Each side also keeps a private copy of the other side's position, which is
+ * only refreshed when the copy says the ring is full (or empty). Most pushes
+ * and pops therefore never touch the cache line the other thread writes to.
+ * The two positions are padded onto separate cache lines.
+ *
+ * Every slot holds a live, default-constructed element from the moment the
+ * queue is created. Producers may fill slots in place by calling
+ * reserveWrite(), assigning to the slots it returns, then publishing them
+ * with commitWrite(). Consumers may read elements in place with peekRead()
+ * and hand the slots back with releaseRead(). Reserved and peeked runs never
+ * wrap around the end of the ring, so they can be shorter than requested even
+ * when more room is available; calling again returns the rest. Popped
+ * elements are moved out, leaving their moved-from value in the slot until it
+ * is overwritten.
+ *
+ * Only one thread may call the producer functions, and only one thread may
+ * call the consumer functions, at any time.
+ *
+ * The ring is reserved through 'alloc_t' when the queue is constructed and is
+ * never resized.
+******************************************************************************/
+template <typename type, typename alloc_t = utils::heapAllocator>
+class spscQueue {
+
+    public:
+        enum : unsigned {
+            CACHE_LINE_SIZE = 64
+        };
+
+    private:
+        /*
+         * Each side's position shares a cache line with its cached copy of the
+         * other side's position, since only the owning thread reads the copy.
+         */
+        struct paddedPosition {
+            std::atomic< std::size_t >  pos;
+            std::size_t                 cachedOther;
+            char padding[ CACHE_LINE_SIZE - sizeof( std::atomic< std::size_t > ) - sizeof( std::size_t ) ];
+
+            paddedPosition() : pos{0}, cachedOther{0}, padding{} {}
+        };
+
+        // Members below are never written after construction
+        alloc_t         allocator;
+        type*           buffer;
+        std::size_t     mask;
+        char            padding[ CACHE_LINE_SIZE ];
+
+        paddedPosition  writePos;   // producer
+        paddedPosition  readPos;    // consumer
+
+        static std::size_t  ringSize    ( unsigned requested );
+
+    public:
+        explicit spscQueue  ( unsigned capacity );
+        spscQueue           ( unsigned capacity, const alloc_t& );
+        spscQueue           ( const spscQueue& ) = delete;
+        spscQueue           ( spscQueue&& ) = delete;
+
+        ~spscQueue          ();
+
+        spscQueue&          operator=   ( const spscQueue& ) = delete;
+        spscQueue&          operator=   ( spscQueue&& ) = delete;
+
+        // Producer
+        bool                tryPush     ( const type& data );
+        bool                tryPush     ( type&& data );
+        unsigned            reserveWrite( unsigned count, type*& outSlots );
+        void                commitWrite ( unsigned count );
+
+        // Consumer
+        bool                tryPop      ( type& outData );
+        unsigned            peekRead    ( unsigned count, type*& outItems );
+        void                releaseRead ( unsigned count );
+
+        // Miscellaneous
+        unsigned            capacity    () const { return unsigned( mask + 1 ); }
+        unsigned            size        () const;
+        bool                empty       () const { return size() == 0; }
+};
+
+/*
+ * SPSC Queue -- Ring Size
+ * Round a requested capacity up to a power of two.
+ */
+template <typename type, typename alloc_t>
+std::size_t spscQueue<type, alloc_t>::ringSize( unsigned requested ) {
+    std::size_t numSlots = 1;
+
+    while ( numSlots < requested ) {
+        numSlots <<= 1;
+    }
+
+    return numSlots;
+}
+
+/*
+ * SPSC Queue -- Constructor
+ */
+template <typename type, typename alloc_t>
+spscQueue<type, alloc_t>::spscQueue( unsigned capacity ) :
+    spscQueue( capacity, alloc_t{} )
+{}
+
+/*
+ * SPSC Queue -- Allocator Constructor
+ */
+template <typename type, typename alloc_t>
+spscQueue<type, alloc_t>::spscQueue( unsigned capacity, const alloc_t& a ) :
+    allocator{ a },
+    buffer{ nullptr },
+    mask{ ringSize( capacity ) - 1 },
+    padding{},
+    writePos{},
+    readPos{}
+{
+    buffer = utils::allocateItems< type >( allocator, mask + 1 );
+    std::size_t i = 0;
+
+    try {
+        for ( ; i <= mask; ++i ) {
+            new( buffer + i ) type();
+        }
+    }
+    catch ( ... ) {
+        while ( i-- ) {
+            buffer[ i ].~type();
+        }
+        utils::deallocateItems( allocator, buffer, mask + 1 );
+        throw;
+    }
+}
+
+/*
+ * SPSC Queue -- Destructor
+ * Neither thread may be using the queue while it is destroyed.
+ */
+template <typename type, typename alloc_t>
+spscQueue<type, alloc_t>::~spscQueue() {
+    for ( std::size_t i = 0; i <= mask; ++i ) {
+        buffer[ i ].~type();
+    }
+
+    utils::deallocateItems( allocator, buffer, mask + 1 );
+}
+
+/*
+ * SPSC Queue -- Push
+ * Copy an element to the back of the queue. Returns false if the queue is
+ * full.
+ */
+template <typename type, typename alloc_t>
+bool spscQueue<type, alloc_t>::tryPush( const type& data ) {
+    type* slot = nullptr;
+
+    if ( !reserveWrite( 1, slot ) ) {
+        return false;
+    }
+
+    *slot = data;
+    commitWrite( 1 );
+
+    return true;
+}
+
+/*
+ * SPSC Queue -- Push (move)
+ */
+template <typename type, typename alloc_t>
+bool spscQueue<type, alloc_t>::tryPush( type&& data ) {
+    type* slot = nullptr;
+
+    if ( !reserveWrite( 1, slot ) ) {
+        return false;
+    }
+
+    *slot = std::move( data );
+    commitWrite( 1 );
+
+    return true;
+}
+
+/*
+ * SPSC Queue -- Reserve Write
+ * Find up to 'count' consecutive free slots at the back of the queue.
+ * Returns the number of slots found, and points 'outSlots' at the first one.
+ * Nothing is visible to the consumer until commitWrite() is called.
+ */
+template <typename type, typename alloc_t>
+unsigned spscQueue<type, alloc_t>::reserveWrite( unsigned count, type*& outSlots ) {
+    const std::size_t head = writePos.pos.load( std::memory_order_relaxed );
+    std::size_t numFree = mask + 1 - (head - writePos.cachedOther);
+
+    if ( numFree < count ) {
+        writePos.cachedOther = readPos.pos.load( std::memory_order_acquire );
+        numFree = mask + 1 - (head - writePos.cachedOther);
+    }
+
+    const std::size_t index = head & mask;
+    const std::size_t untilWrap = mask + 1 - index;
+
+    std::size_t numSlots = (count < numFree) ? count : numFree;
+    numSlots = (numSlots < untilWrap) ? numSlots : untilWrap;
+
+    outSlots = buffer + index;
+    return unsigned( numSlots );
+}
+
+/*
+ * SPSC Queue -- Commit Write
+ * Publish the first 'count' slots returned by the last call to
+ * reserveWrite().
+ */
+template <typename type, typename alloc_t>
+inline void spscQueue<type, alloc_t>::commitWrite( unsigned count ) {
+    const std::size_t head = writePos.pos.load( std::memory_order_relaxed );
+    writePos.pos.store( head + count, std::memory_order_release );
+}
+
+/*
+ * SPSC Queue -- Pop
+ * Move the element at the front of the queue into 'outData'. Returns false
+ * if the queue is empty.
+ */
+template <typename type, typename alloc_t>
+bool spscQueue<type, alloc_t>::tryPop( type& outData ) {
+    type* item = nullptr;
+
+    if ( !peekRead( 1, item ) ) {
+        return false;
+    }
+
+    outData = std::move( *item );
+    releaseRead( 1 );
+
+    return true;
+}
+
+/*
+ * SPSC Queue -- Peek Read
+ * Find up to 'count' consecutive elements at the front of the queue.
+ * Returns the number of elements found, and points 'outItems' at the first
+ * one. The elements stay in the queue until releaseRead() is called.
+ */
+template <typename type, typename alloc_t>
+unsigned spscQueue<type, alloc_t>::peekRead( unsigned count, type*& outItems ) {
+    const std::size_t tail = readPos.pos.load( std::memory_order_relaxed );
+    std::size_t numItems = readPos.cachedOther - tail;
+
+    if ( numItems < count ) {
+        readPos.cachedOther = writePos.pos.load( std::memory_order_acquire );
+        numItems = readPos.cachedOther - tail;
+    }
+
+    const std::size_t index = tail & mask;
+    const std::size_t untilWrap = mask + 1 - index;
+
+    std::size_t numFound = (count < numItems) ? count : numItems;
+    numFound = (numFound < untilWrap) ? numFound : untilWrap;
+
+    outItems = buffer + index;
+    return unsigned( numFound );
+}
+
+/*
+ * SPSC Queue -- Release Read
+ * Hand the first 'count' elements returned by the last call to peekRead()
+ * back to the producer.
+ */
+template <typename type, typename alloc_t>
+inline void spscQueue<type, alloc_t>::releaseRead( unsigned count ) {
+    const std::size_t tail = readPos.pos.load( std::memory_order_relaxed );
+    readPos.pos.store( tail + count, std::memory_order_release );
+}
+
+/*
+ * SPSC Queue -- Size
+ * Only a snapshot when called while the other thread is active.
+ */
+template <typename type, typename alloc_t>
+unsigned spscQueue<type, alloc_t>::size() const {
+    const std::size_t tail = readPos.pos.load( std::memory_order_acquire );
+    const std::size_t head = writePos.pos.load( std::memory_order_acquire );
+
+    return unsigned( head - tail );
+}
+
+} // end containers namespace
+} // end hamLibs namespace
+
+#endif  /* __HL_SPSC_QUEUE_H__ */
@@ -1,118 +1,212 @@
 /*
  * stack class
+ * Nodes are reserved through 'alloc_t' (see utils/allocator.h).
 */
 
 #ifndef __HL_STACK__
 #define __HL_STACK__
 
+#include <utility>
+#include "../utils/allocator.h"
+#include "../utils/iterators.h"
+
 namespace hamLibs {
 namespace containers {
 
-template <typename type>
+template <typename type, typename alloc_t = utils::heapAllocator>
 class stack {
 	private:
 		struct node {
-			type *data;
+			type data;
 			node *next;
+			template <typename... args_t>
+			node(node* n, args_t&&... args);
 		};
 		
-		node *iter;		//List navigation
+		alloc_t allocator;
+		node *iter;		//List navigation, NULL when empty
 		int numNodes;
-		static const node bottom;
 		
 	public:
+		typedef utils::nodeIterator<node, type>			iterator;
+		typedef utils::nodeIterator<node, const type>	constIterator;
+
 		stack		();
+		explicit stack	(const alloc_t& a);
+		stack		(const stack&) = delete;
+		stack		(stack&& moved);
 		~stack		();
+		
+		stack&		operator =	(const stack&) = delete;
+		stack&		operator =	(stack&& moved);
 
 		//data acquisition
 		type*		top			() const;
 		type*		peekNext	() const;
 
 		//insertion & deletion
-		void		push		(const type& ptr);
+		void		push		(const type& object);
+		void		push		(type&& object);
+		template <typename... args_t>
+		type&		emplace		(args_t&&... args);	//construct an element in place on top of the stack
 		void		pop			();
 		void		clear		();
 
+		//iteration, from the top of the stack down
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
 		//miscellaneous
 		int	size		() const;
 		bool		empty		() const;
+		alloc_t&	getAllocator	();
 };
 
 //-----------------------------------------------------------------------------
 //			Construction & Destruction
 //-----------------------------------------------------------------------------
-template <typename type>
-const typename stack<type>::node stack<type>::bottom = {nullptr, nullptr};
+template <typename type, typename alloc_t>
+template <typename... args_t>
+stack<type, alloc_t>::node::node(node* n, args_t&&... args) :
+	data(std::forward<args_t>(args)...),
+	next(n)
+{}
+
+template <typename type, typename alloc_t>
+stack<type, alloc_t>::stack() :
+	allocator(),
+	iter(nullptr),
+	numNodes(0)
+{}
+
+template <typename type, typename alloc_t>
+stack<type, alloc_t>::stack(const alloc_t& a) :
+	allocator(a),
+	iter(nullptr),
+	numNodes(0)
+{}
+
+template <typename type, typename alloc_t>
+stack<type, alloc_t>::stack(stack&& moved) :
+	stack(moved.allocator)
+{
+	*this = std::move(moved);
+}
 
-template <typename type>
-stack<type>::stack() {
-	iter = const_cast<type*>(&bottom);
-	numNodes = 0;
+template <typename type, typename alloc_t>
+stack<type, alloc_t>::~stack() {
+	clear();
 }
 
-template <typename type>
-stack<type>::~stack() {
+template <typename type, typename alloc_t>
+stack<type, alloc_t>& stack<type, alloc_t>::operator =(stack&& moved) {
+	if (this == &moved) return *this;
+
 	clear();
+	iter = moved.iter;
+	numNodes = moved.numNodes;
+	allocator = std::move(moved.allocator);
+
+	moved.iter = nullptr;
+	moved.numNodes = 0;
+	return *this;
 }
 
 //-----------------------------------------------------------------------------
 //			Data Acquisition
 //-----------------------------------------------------------------------------
-template <typename type>
-type* stack<type>::top() const {
-	return iter->data;
+template <typename type, typename alloc_t>
+type* stack<type, alloc_t>::top() const {
+	return (iter) ? &iter->data : nullptr;
 }
 
-template <typename type>
-type* stack<type>::peekNext() const {
-	return (iter->next) ? iter->next->data : nullptr;
+template <typename type, typename alloc_t>
+type* stack<type, alloc_t>::peekNext() const {
+	return (iter && iter->next) ? &iter->next->data : nullptr;
 }
 
 //-----------------------------------------------------------------------------
 //			Insertion
 //-----------------------------------------------------------------------------
-template <typename type>
-void stack<type>::push(const type& object) {
-	node* temp = new node;
-	*temp->data = object;
-	
-	temp->next = iter;
-	iter = temp;
-	
+template <typename type, typename alloc_t>
+void stack<type, alloc_t>::push(const type& object) {
+	emplace(object);
+}
+
+template <typename type, typename alloc_t>
+void stack<type, alloc_t>::push(type&& object) {
+	emplace(std::move(object));
+}
+
+template <typename type, typename alloc_t>
+template <typename... args_t>
+type& stack<type, alloc_t>::emplace(args_t&&... args) {
+	iter = utils::createItem<node>(allocator, iter, std::forward<args_t>(args)...);
 	++numNodes;
+	return iter->data;
 }
 
 //-----------------------------------------------------------------------------
 //			Deletion
 //-----------------------------------------------------------------------------
-template <typename type>
-void stack<type>::pop() {
-	if (iter != &bottom) {
-		const node* temp = iter;
+template <typename type, typename alloc_t>
+void stack<type, alloc_t>::pop() {
+	if (iter) {
+		node* temp = iter;
 		iter = iter->next;
-		delete temp;
+		utils::destroyItem(allocator, temp);
 		--numNodes;
 	}
 }
 
-template <typename type>
-void stack<type>::clear() {
-	while (iter->data != nullptr) {
+template <typename type, typename alloc_t>
+void stack<type, alloc_t>::clear() {
+	while (iter) {
 		pop();
 	}
 }
 
+//-----------------------------------------------------------------------------
+//			Iteration
+//-----------------------------------------------------------------------------
+template <typename type, typename alloc_t>
+typename stack<type, alloc_t>::iterator stack<type, alloc_t>::begin() {
+	return iterator(iter);
+}
+
+template <typename type, typename alloc_t>
+typename stack<type, alloc_t>::iterator stack<type, alloc_t>::end() {
+	return iterator(nullptr);
+}
+
+template <typename type, typename alloc_t>
+typename stack<type, alloc_t>::constIterator stack<type, alloc_t>::begin() const {
+	return constIterator(iter);
+}
+
+template <typename type, typename alloc_t>
+typename stack<type, alloc_t>::constIterator stack<type, alloc_t>::end() const {
+	return constIterator(nullptr);
+}
+
 //-----------------------------------------------------------------------------
 //			Miscellaneous
 //-----------------------------------------------------------------------------
-template <typename type>
-int stack<type>::size() const {
+template <typename type, typename alloc_t>
+int stack<type, alloc_t>::size() const {
 	return numNodes;
 }
 
-template <typename type>
-bool stack<type>::empty() const {
-	return iter == &bottom;
+template <typename type, typename alloc_t>
+bool stack<type, alloc_t>::empty() const {
+	return iter == nullptr;
+}
+
+template <typename type, typename alloc_t>
+alloc_t& stack<type, alloc_t>::getAllocator() {
+	return allocator;
 }
 
 } //end containers namespace
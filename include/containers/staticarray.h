@@ -0,0 +1,461 @@
+/*
+ * A fixed-capacity array which never allocates memory.
+ * Up to N elements are stored inside the object itself and are constructed
+ * as they are pushed. Exceeding the capacity is caught by HL_ASSERT.
+ */
+
+#ifndef __HL_STATIC_ARRAY_H__
+#define __HL_STATIC_ARRAY_H__
+
+#include <new>
+#include <utility>
+#include "../utils/assert.h"
+#include "../utils/copy.h"
+
+namespace hamLibs {
+namespace containers {
+
+template <typename type, int N>
+class staticArray {
+	static_assert(N > 0, "staticArray requires room for at least one element.");
+
+	private:
+		int Size;
+		alignas(type) unsigned char Storage[sizeof(type) * N];
+
+		type*			items		() { return reinterpret_cast<type*>(Storage); }
+		const type*		items		() const { return reinterpret_cast<const type*>(Storage); }
+		void			destroy		(int first, int last);
+
+	public:
+		typedef type*		iterator;
+		typedef const type*	constIterator;
+
+		staticArray			();
+		staticArray			(int numItems);
+		staticArray			(const type& data);
+		staticArray			(const type& data, int numCopies);
+		staticArray			(const staticArray& copy);
+		staticArray			(staticArray&& moved);
+		~staticArray			();
+
+		//operators
+		staticArray&	operator =	(const staticArray& input);
+		staticArray&	operator =	(staticArray&& input);
+		staticArray&	operator +=	(const staticArray& input);
+		staticArray	operator +	(const staticArray& input) const;
+		bool		operator ==	(const staticArray& compare) const;
+		bool		operator !=	(const staticArray& compare) const;
+		type&		operator []	(int);
+		const type&	operator []	(int) const;
+
+		//deletion
+		void		popFront	();
+		void		popBack		();
+		void		pop			(int index);
+		void		erase		(int index);
+		void		erase		(int first, int last);
+
+		//insertion
+		void		pushFront	(const type& data);
+		void		pushFront	(type&& data);
+		void		pushBack	(const type& data);
+		void		pushBack	(type&& data);
+		void		push		(int index, const type& data);
+		void		push		(int index, type&& data);
+		void		pushAfter	(int index, const type& data);
+		void		pushAfter	(int index, type&& data);
+		template <typename... args_t>
+		type&		emplaceBack	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplaceFront	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplace		(int index, args_t&&... args);	//construct an element at 'index', shifting later elements up
+
+		//traversal
+		type&		front		();
+		type&		back		();
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
+		//miscellaneous
+		static void	copy		(staticArray& dest, const staticArray& source);
+		static void	append		(staticArray& dest, const staticArray& source);
+		void		resize		(int newSize);
+		void		reserve		(int numItems);
+		void		shrinkToFit	() {}
+		void		clear		();
+		bool		empty		() const;
+		bool		full		() const;
+		int	size		() const;
+		int	capacity	() const;
+		type*		data		() const;
+};
+
+//---------------------------------------------------------------------
+//			Storage
+//---------------------------------------------------------------------
+template <typename type, int N>
+void staticArray<type, N>::destroy(int first, int last) {
+	while (first < last) {
+		items()[first].~type();
+		++first;
+	}
+}
+
+//---------------------------------------------------------------------
+//			[Con/De]struction
+//---------------------------------------------------------------------
+template <typename type, int N>
+staticArray<type, N>::staticArray() :
+	Size(0)
+{}
+
+template <typename type, int N>
+staticArray<type, N>::staticArray(int numItems) :
+	Size(0)
+{
+	resize(numItems);
+}
+
+template <typename type, int N>
+staticArray<type, N>::staticArray(const staticArray& copy) :
+	Size(copy.Size)
+{
+	utils::constructItems(items(), copy.items(), Size);
+}
+
+template <typename type, int N>
+staticArray<type, N>::staticArray(staticArray&& moved) :
+	Size(moved.Size)
+{
+	utils::relocateItems(items(), moved.items(), Size);
+	moved.Size = 0;
+}
+
+template <typename type, int N>
+staticArray<type, N>::staticArray(const type& data) :
+	Size(1)
+{
+	new(items()) type(data);
+}
+
+template <typename type, int N>
+staticArray<type, N>::staticArray(const type& data, int numCopies) :
+	Size(0)
+{
+	HL_ASSERT(numCopies <= N);
+	while (Size < numCopies) {
+		new(items()+Size) type(data);
+		++Size;
+	}
+}
+
+template <typename type, int N>
+staticArray<type, N>::~staticArray() {
+	destroy(0, Size);
+}
+
+//---------------------------------------------------------------------
+//			Operators
+//---------------------------------------------------------------------
+template <typename type, int N>
+staticArray<type, N>& staticArray<type, N>::operator = (const staticArray& input) {
+	if (this != &input) {
+		copy(*this, input);
+	}
+	return *this;
+}
+
+template <typename type, int N>
+staticArray<type, N>& staticArray<type, N>::operator = (staticArray&& input) {
+	if (this != &input) {
+		destroy(0, Size);
+		utils::relocateItems(items(), input.items(), input.Size);
+		Size = input.Size;
+		input.Size = 0;
+	}
+	return *this;
+}
+
+template <typename type, int N>
+staticArray<type, N>& staticArray<type, N>::operator += (const staticArray& input) {
+	append(*this, input);
+	return *this;
+}
+
+template <typename type, int N>
+staticArray<type, N> staticArray<type, N>::operator + (const staticArray& input) const {
+	staticArray<type, N> temp(*this);
+	append(temp, input);
+	return temp;
+}
+
+template <typename type, int N>
+bool staticArray<type, N>::operator == (const staticArray& compare) const {
+	if (Size != compare.Size) return false;
+	int iter = 0;
+	while (iter < Size) {
+		if (items()[iter] != compare.items()[iter])
+			return false;
+		++iter;
+	}
+	return true;
+}
+
+template <typename type, int N>
+bool staticArray<type, N>::operator != (const staticArray& compare) const {
+	return !(*this == compare);
+}
+
+template <typename type, int N>
+type& staticArray<type, N>::operator [] (int index) {
+	HL_ASSERT(index >= 0);
+	return items()[index];
+}
+
+template <typename type, int N>
+const type& staticArray<type, N>::operator [] (int index) const {
+	HL_ASSERT(index >= 0);
+	return items()[index];
+}
+
+//---------------------------------------------------------------------
+//			Deletion
+//---------------------------------------------------------------------
+template <typename type, int N>
+void staticArray<type, N>::popFront() {
+	erase(0);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::popBack() {
+	if (!Size) return;
+	--Size;
+	items()[Size].~type();
+}
+
+template <typename type, int N>
+void staticArray<type, N>::pop(int index) {
+	erase(index);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::erase(int index) {
+	if (index < 0 || index >= Size) return;
+	erase(index, index+1);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::erase(int first, int last) {
+	//remove the elements in [first, last) by shifting the remainder down
+	if (first < 0) first = 0;
+	if (last > Size) last = Size;
+	if (first >= last) return;
+
+	utils::moveItems(items()+first, items()+last, Size-last);
+	destroy(Size-(last-first), Size);
+	Size -= last-first;
+}
+
+//---------------------------------------------------------------------
+//			Insertion
+//---------------------------------------------------------------------
+template <typename type, int N>
+void staticArray<type, N>::pushFront(const type& data) {
+	emplace(0, data);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::pushFront(type&& data) {
+	emplace(0, std::move(data));
+}
+
+template <typename type, int N>
+template <typename... args_t>
+type& staticArray<type, N>::emplaceFront(args_t&&... args) {
+	return emplace(0, std::forward<args_t>(args)...);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::pushBack(const type& data) {
+	emplaceBack(data);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::pushBack(type&& data) {
+	emplaceBack(std::move(data));
+}
+
+template <typename type, int N>
+template <typename... args_t>
+type& staticArray<type, N>::emplaceBack(args_t&&... args) {
+	if (Size >= N) {
+		//elements are never written past the end, even if assertions return
+		HL_ASSERT(Size < N);
+		return items()[N-1];
+	}
+	type* const item = new(items()+Size) type(std::forward<args_t>(args)...);
+	++Size;
+	return *item;
+}
+
+template <typename type, int N>
+template <typename... args_t>
+type& staticArray<type, N>::emplace(int index, args_t&&... args) {
+	//Resize if trying to access an out-of-bounds element
+	if (index < 0) index = 0;
+	if (index >= Size) {
+		return emplaceBack(std::forward<args_t>(args)...);
+	}
+	if (Size >= N) {
+		//elements are never written past the end, even if assertions return
+		HL_ASSERT(Size < N);
+		return items()[index];
+	}
+
+	//construct first in case the arguments refer to an element of this array
+	type temp(std::forward<args_t>(args)...);
+
+	//shift the elements after 'index' up by one
+	type* const pItems = items();
+	utils::insertItem(pItems, Size, index, std::move(temp));
+	++Size;
+	return pItems[index];
+}
+
+template <typename type, int N>
+void staticArray<type, N>::push(int index, const type& data) {
+	emplace(index, data);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::push(int index, type&& data) {
+	emplace(index, std::move(data));
+}
+
+template <typename type, int N>
+void staticArray<type, N>::pushAfter(int index, const type& data) {
+	push(++index, data);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::pushAfter(int index, type&& data) {
+	push(++index, std::move(data));
+}
+
+//---------------------------------------------------------------------
+//			Traversal
+//---------------------------------------------------------------------
+template <typename type, int N>
+type& staticArray<type, N>::front() {
+	return items()[0];
+}
+
+template <typename type, int N>
+type& staticArray<type, N>::back() {
+	return items()[Size-1];
+}
+
+template <typename type, int N>
+typename staticArray<type, N>::iterator staticArray<type, N>::begin() {
+	return data();
+}
+
+template <typename type, int N>
+typename staticArray<type, N>::iterator staticArray<type, N>::end() {
+	return data() + Size;
+}
+
+template <typename type, int N>
+typename staticArray<type, N>::constIterator staticArray<type, N>::begin() const {
+	return data();
+}
+
+template <typename type, int N>
+typename staticArray<type, N>::constIterator staticArray<type, N>::end() const {
+	return data() + Size;
+}
+
+//---------------------------------------------------------------------
+//			Misc
+//---------------------------------------------------------------------
+template <typename type, int N>
+void staticArray<type, N>::copy(staticArray& dest, const staticArray& source) {
+	if (&dest == &source) return;
+
+	dest.clear();
+	utils::constructItems(dest.items(), source.items(), source.Size);
+	dest.Size = source.Size;
+}
+
+template <typename type, int N>
+void staticArray<type, N>::append(staticArray& dest, const staticArray& source) {
+	//'source' may be the same array as 'dest'
+	const int numItems = source.Size;
+	HL_ASSERT(dest.Size + numItems <= N);
+
+	utils::constructItems(dest.items()+dest.Size, source.items(), numItems);
+	dest.Size += numItems;
+}
+
+template <typename type, int N>
+void staticArray<type, N>::resize(int newSize) {
+	//new elements are default-constructed
+	if (newSize < 0) newSize = 0;
+	HL_ASSERT(newSize <= N);
+
+	if (newSize <= Size) {
+		destroy(newSize, Size);
+		Size = newSize;
+		return;
+	}
+
+	while (Size < newSize) {
+		new(items()+Size) type();
+		++Size;
+	}
+}
+
+template <typename type, int N>
+void staticArray<type, N>::reserve(int numItems) {
+	HL_ASSERT(numItems <= N);
+}
+
+template <typename type, int N>
+void staticArray<type, N>::clear() {
+	destroy(0, Size);
+	Size = 0;
+}
+
+template <typename type, int N>
+bool staticArray<type, N>::empty() const {
+	return (Size) ? false : true;
+}
+
+template <typename type, int N>
+bool staticArray<type, N>::full() const {
+	return Size == N;
+}
+
+template <typename type, int N>
+int staticArray<type, N>::size() const {
+	return Size;
+}
+
+template <typename type, int N>
+int staticArray<type, N>::capacity() const {
+	return N;
+}
+
+template <typename type, int N>
+type* staticArray<type, N>::data() const {
+	return const_cast<type*>(items());
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+
+#endif //__HL_STATIC_ARRAY_H__
@@ -3,7 +3,9 @@
 #define __HL_STRING_H__
 
 #include <climits>
+#include "../utils/allocator.h"
 #include "../utils/assert.h"
+#include "../utils/copy.h"
 
 namespace hamLibs {
 namespace containers {
@@ -11,35 +13,45 @@ namespace containers {
 /******************************************************************************
  * Forward Declarations and Typedefs
 ******************************************************************************/
-template <typename charType>
+template <typename charType, typename alloc_t>
 class string_t;
 
-typedef string_t<char>        string;
-typedef string_t<char16_t>    string16;
-typedef string_t<char32_t>    string32;
+typedef string_t<char, utils::heapAllocator>        string;
+typedef string_t<char16_t, utils::heapAllocator>    string16;
+typedef string_t<char32_t, utils::heapAllocator>    string32;
 
 /******************************************************************************
  * HamLibs string class
+ * Character buffers are reserved through 'alloc_t' (see utils/allocator.h).
 ******************************************************************************/
-template <typename charType = char>
+template <typename charType = char, typename alloc_t = utils::heapAllocator>
 class string_t {
     enum : signed int { DEFAULT_GRANULARITY = 1024 };
     
     static inline int getStrLen( const charType* );
+    
+    // buffers always hold one more character than their capacity for the terminator
+    static charType*    allocChars( alloc_t&, int numChars );
+    static void         freeChars( alloc_t&, charType*, int numChars );
         
     private:
+        alloc_t     allocator   = alloc_t();
         int         numUsed     = 0;
         int         numTotal    = DEFAULT_GRANULARITY;
         int         granularity = DEFAULT_GRANULARITY;
         charType*   data        = nullptr;
         
     public:
+        typedef charType*       iterator;
+        typedef const charType* constIterator;
+        
         string_t();
+        explicit string_t( const alloc_t& );
         string_t( string_t&& );
         string_t( const string_t& );
-        string_t( const charType );
-        string_t( const charType* );
-        string_t( int charCount, int totalChars, int grainSize, charType* charArray );
+        string_t( const charType, const alloc_t& = alloc_t() );
+        string_t( const charType*, const alloc_t& = alloc_t() );
+        string_t( int charCount, int totalChars, int grainSize, charType* charArray, const alloc_t& = alloc_t() );
         ~string_t();
         
         string_t        operator +      ( const string_t& ) const;
@@ -74,6 +86,12 @@ class string_t {
         int             maxSize         () const                { return INT_MAX - granularity; }
         const charType* cStr            () const                { return data; }
         bool            empty           () const                { return data[0] != '\0'; }
+        alloc_t&        getAllocator    ()                      { return allocator; }
+        
+        iterator        begin           ()                      { return data; }
+        iterator        end             ()                      { return data + numUsed; }
+        constIterator   begin           () const                { return data; }
+        constIterator   end             () const                { return data + numUsed; }
         
 /* TODO */
 //        void        resize          ( int newSize );
@@ -105,19 +123,38 @@ class string_t {
 /*
  *      STRING -- Getting a C-String's length
  */
-template <typename charType>
-inline int string_t<charType>::getStrLen( const charType* s ) {
+template <typename charType, typename alloc_t>
+inline int string_t<charType, alloc_t>::getStrLen( const charType* s ) {
     int i = 0;
     while ( s[ i++ ] ) {}
     return i-1;
 }
 
+/*
+ *      STRING -- Allocating a zero-filled character buffer
+ */
+template <typename charType, typename alloc_t>
+charType* string_t<charType, alloc_t>::allocChars( alloc_t& a, int numChars ) {
+    charType* const p = utils::allocateItems< charType >( a, numChars + 1 );
+    for ( int i = 0; i <= numChars; ++i )
+        p[ i ] = charType();
+    return p;
+}
+
+/*
+ *      STRING -- Freeing a buffer made by allocChars()
+ */
+template <typename charType, typename alloc_t>
+void string_t<charType, alloc_t>::freeChars( alloc_t& a, charType* p, int numChars ) {
+    utils::deallocateItems( a, p, numChars + 1 );
+}
+
 /*
  *      STRING -- Destructor
  */
-template <typename charType>
-string_t<charType>::~string_t() {
-    delete [] data;
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>::~string_t() {
+    freeChars( allocator, data, numTotal );
     data = nullptr;
     numUsed = 0;
     numTotal = 0;
@@ -127,16 +164,27 @@ string_t<charType>::~string_t() {
 /*
  *      STRING -- Plain Constructor
  */
-template <typename charType>
-string_t<charType>::string_t() {
-    data = new charType[ DEFAULT_GRANULARITY + 1 ]();
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>::string_t() {
+    data = allocChars( allocator, DEFAULT_GRANULARITY );
+}
+
+/*
+ *      STRING -- Constructor using a specific allocator
+ */
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>::string_t( const alloc_t& a ) :
+    allocator( a )
+{
+    data = allocChars( allocator, DEFAULT_GRANULARITY );
 }
 
 /*
  *      STRING -- Move Constructor
  */
-template <typename charType>
-string_t<charType>::string_t( string_t&& s ) :
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>::string_t( string_t&& s ) :
+    allocator( s.allocator ),
     numUsed( s.numUsed ),
     numTotal( s.numTotal ),
     granularity( s.granularity ),
@@ -149,20 +197,28 @@ string_t<charType>::string_t( string_t&& s ) :
 /*
  *      STRING -- Copy Constructor using other strings
  */
-template <typename charType>
-string_t<charType>::string_t( const string_t& s ) {
-    *this = s;
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>::string_t( const string_t& s ) :
+    allocator( s.allocator ),
+    numUsed( s.numUsed ),
+    numTotal( s.numTotal ),
+    granularity( s.granularity )
+{
+    data = allocChars( allocator, numTotal );
+    utils::copyItems( data, s.data, numUsed );
 }
 
 /*
  *      STRING -- Construction using a regular charType
  */
-template <typename charType>
-string_t<charType>::string_t( const charType c ) {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>::string_t( const charType c, const alloc_t& a ) :
+    allocator( a )
+{
     numUsed = 1;
     numTotal = DEFAULT_GRANULARITY + 1;
     
-    data = new charType[ numTotal + 1 ]();
+    data = allocChars( allocator, numTotal );
     
     data[0] = c;
 }
@@ -170,22 +226,25 @@ string_t<charType>::string_t( const charType c ) {
 /*
  *      STRING -- Copy Constructor using C-Style arrays
  */
-template <typename charType>
-string_t<charType>::string_t( const charType* s ) {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>::string_t( const charType* s, const alloc_t& a ) :
+    allocator( a )
+{
     numUsed = getStrLen( s );
     numTotal = numUsed + DEFAULT_GRANULARITY;
     
-    data = new charType[ numTotal + 1 ]();
+    data = allocChars( allocator, numTotal );
     
-    for ( int i = 0; i < numUsed; ++i )
-        data[ i ] = s[ i ];
+    utils::copyItems( data, s, numUsed );
 }
 
 /*
  *      STRING -- for Brace-Initialization
+ *      'charArray' must have been reserved by allocChars() using 'a'.
  */
-template <typename charType>
-string_t<charType>::string_t( int charCount, int totalChars, int grainSize, charType* charArray ) :
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>::string_t( int charCount, int totalChars, int grainSize, charType* charArray, const alloc_t& a ) :
+    allocator( a ),
     numUsed( charCount ),
     numTotal( totalChars ),
     granularity( grainSize ),
@@ -198,39 +257,33 @@ string_t<charType>::string_t( int charCount, int totalChars, int grainSize, char
 /*
  *      STRING -- Combining two strings using the '+' operator
  */
-template <typename charType>
-string_t<charType> string_t<charType>::operator + ( const string_t& s ) const {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t> string_t<charType, alloc_t>::operator + ( const string_t& s ) const {
     // determine the needed length. Use integer overflow to determine if it's too big
     if ( 0 >= (numUsed + s.numUsed + DEFAULT_GRANULARITY + 1) ) {
         return string_t();
     }
     
     int len = numUsed + s.numUsed;
-    charType* temp = new charType[ len + DEFAULT_GRANULARITY + 1 ]();
-    
-    // populate the new array with data from this
-    int i = numUsed;
-    while ( i-- )
-        temp[ i ] = data[ i ];
+    alloc_t a( allocator );
+    charType* temp = allocChars( a, len + DEFAULT_GRANULARITY );
     
-    // append data from "s"
-    i = s.numUsed;
-    while ( i-- )
-        temp[ i+numUsed ] = s.data[ i ];
+    // populate the new array with data from this, then append data from "s"
+    utils::copyItems( temp, data, numUsed );
+    utils::copyItems( temp + numUsed, s.data, s.numUsed );
     
-    return string_t( len, len+DEFAULT_GRANULARITY, DEFAULT_GRANULARITY, temp );
+    return string_t( len, len+DEFAULT_GRANULARITY, DEFAULT_GRANULARITY, temp, a );
 }
 
 /*
  *      STRING -- Appending another string using the '+=' operator
  */
-template <typename charType>
-string_t<charType>& string_t<charType>::operator += ( const string_t& s ) {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>& string_t<charType, alloc_t>::operator += ( const string_t& s ) {
     // determine the needed length. return a blank string if it's too big
     if ( numUsed + s.numUsed < numTotal ) {
-        int i = s.numUsed;
-        while ( i < s.numUsed )
-            data[ numUsed++ ] = s.data[ i++ ];
+        utils::copyItems( data + numUsed, s.data, s.numUsed );
+        numUsed += s.numUsed;
     }
     else {
         *this = *this + s;
@@ -241,26 +294,29 @@ string_t<charType>& string_t<charType>::operator += ( const string_t& s ) {
 /*
  *      STRING -- Assignment operator using another string
  */
-template <typename charType>
-string_t<charType>& string_t<charType>::operator = ( const string_t& s ) {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>& string_t<charType, alloc_t>::operator = ( const string_t& s ) {
     
-    // don't reallocate if the current string is of reasonable size
-    if ( s.numUsed < granularity ) {
-        int i = numTotal;
-        while ( i-- )
-            data[ i ] = (i < s.numUsed) ? s.data[ i ] : '\0';
+    if ( this == &s ) {
+        return *this;
+    }
+    
+    // don't reallocate if the current buffer can hold the other string
+    if ( s.numUsed < numTotal && allocator == s.allocator ) {
+        utils::copyItems( data, s.data, s.numUsed );
+        
+        for ( int i = s.numUsed; i < numTotal; ++i )
+            data[ i ] = '\0';
     }
     else {
-        delete [] data;
-        data = new charType[ s.numTotal + 1 ]();
-
-        int i = s.numUsed;
-        while ( i-- )
-            data[ i ] = s.data[ i ];
+        freeChars( allocator, data, numTotal );
+        allocator = s.allocator;
+        numTotal = s.numTotal;
+        data = allocChars( allocator, numTotal );
+        utils::copyItems( data, s.data, s.numUsed );
     }
     
     numUsed = s.numUsed;
-    numTotal = s.numTotal;
     granularity = s.granularity;
     return *this;
 }
@@ -268,9 +324,15 @@ string_t<charType>& string_t<charType>::operator = ( const string_t& s ) {
 /*
  *      STRING -- Move operator using another string
  */
-template <typename charType>
-string_t<charType>& string_t<charType>::operator = ( string_t&& s ) {
-    delete [] data;
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>& string_t<charType, alloc_t>::operator = ( string_t&& s ) {
+    if ( this == &s ) {
+        return *this;
+    }
+    
+    // the allocator moves along with the buffer it reserved
+    freeChars( allocator, data, numTotal );
+    allocator = s.allocator;
     
     numUsed = s.numUsed;
     numTotal = s.numTotal;
@@ -291,8 +353,8 @@ string_t<charType>& string_t<charType>::operator = ( string_t&& s ) {
 /*
  *      STRING -- Combining a string and C-String string using the '+' operator
  */
-template <typename charType>
-string_t<charType> string_t<charType>::operator + ( const charType* s ) const {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t> string_t<charType, alloc_t>::operator + ( const charType* s ) const {
     // determine the needed length. return a blank string if it's too big
     int len = getStrLen( s );
     
@@ -301,36 +363,29 @@ string_t<charType> string_t<charType>::operator + ( const charType* s ) const {
         return string_t();
     }
     
-    charType* temp;
-    temp = new charType[ numUsed + len + DEFAULT_GRANULARITY + 1 ]();
-    
-    // populate the new array with data from this
-    int i = numUsed;
-    while ( i-- )
-        temp[ i ] = data[ i ];
+    alloc_t a( allocator );
+    charType* temp = allocChars( a, numUsed + len + DEFAULT_GRANULARITY );
     
-    // append data from "s"
-    i = len;
-    while ( i-- )
-        temp[ i + numUsed ] = s[ i ];
+    // populate the new array with data from this, then append data from "s"
+    utils::copyItems( temp, data, numUsed );
+    utils::copyItems( temp + numUsed, s, len );
     
     return string_t(
         numUsed+len, numUsed+len+DEFAULT_GRANULARITY,
-        DEFAULT_GRANULARITY, temp
+        DEFAULT_GRANULARITY, temp, a
     );
 }
 
 /*
  *      STRING -- Appending C-String using the '+=' operator
  */
-template <typename charType>
-string_t<charType>& string_t<charType>::operator += ( const charType* s ) {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>& string_t<charType, alloc_t>::operator += ( const charType* s ) {
     // determine the needed length. return a blank string if it's too big
     int len = getStrLen( s );
     if ( numUsed + len < numTotal ) {
-        int i = 0;
-        while ( i < len )
-            data[ numUsed++ ] = s[ i++ ];
+        utils::copyItems( data + numUsed, s, len );
+        numUsed += len;
     }
     else {
         *this = *this + s;
@@ -342,25 +397,21 @@ string_t<charType>& string_t<charType>::operator += ( const charType* s ) {
 /*
  *      STRING -- Assignment operator using a C-string
  */
-template <typename charType>
-string_t<charType>& string_t<charType>::operator = ( const charType* s ) {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>& string_t<charType, alloc_t>::operator = ( const charType* s ) {
     int len = getStrLen( s );
     
     // don't reallocate if the current string is of reasonable size
     if ( len < granularity ) {
-        int i = len;
-        while ( i-- )
-            data[ i ] = (i < len) ? s[ i ] : '\0';
+        utils::copyItems( data, s, len );
+        data[ len ] = '\0';
         
         numUsed = len;
     }
     else {
-        delete [] data;
-        data = new charType[ len + granularity + 1 ]();
-
-        int i = len;
-        while (i--)
-            data[i] = s[i];
+        freeChars( allocator, data, numTotal );
+        data = allocChars( allocator, len + granularity );
+        utils::copyItems( data, s, len );
         
         numUsed = len;
         numTotal = len + granularity;
@@ -375,12 +426,13 @@ string_t<charType>& string_t<charType>::operator = ( const charType* s ) {
 /*
  *      STRING -- Combining a string and Character using the '+' operator
  */
-template <typename charType>
-string_t<charType> string_t<charType>::operator + ( const charType c ) const {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t> string_t<charType, alloc_t>::operator + ( const charType c ) const {
     charType* temp = nullptr;
+    alloc_t a( allocator );
     
     if ( numUsed < numTotal ) {
-        temp = new charType[ numUsed + DEFAULT_GRANULARITY + 1 ]();
+        temp = allocChars( a, numUsed + DEFAULT_GRANULARITY );
         
         temp[ numUsed ] = c;
     }
@@ -390,31 +442,29 @@ string_t<charType> string_t<charType>::operator + ( const charType c ) const {
         if ( len < 0 )
             return string_t();
             
-        temp = new charType[ len ]();
+        temp = allocChars( a, len - 1 );
         
-        for ( int i = 0; i < numUsed; ++i )
-            temp[ i ] = data[ i ];
+        utils::copyItems( temp, data, numUsed );
             
         temp[ numUsed ] = c;
     }
-    return string_t( numUsed+1, numUsed + DEFAULT_GRANULARITY, DEFAULT_GRANULARITY, temp );
+    return string_t( numUsed+1, numUsed + DEFAULT_GRANULARITY, DEFAULT_GRANULARITY, temp, a );
 }
 
 /*
  *      STRING -- Appending C-String using the '+=' operator
  */
-template <typename charType>
-string_t<charType>& string_t<charType>::operator += ( const charType c ) {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>& string_t<charType, alloc_t>::operator += ( const charType c ) {
     if ( numUsed + 1 < numTotal ) {
         data[ numUsed++ ] = c;
     }
     else {
-        numTotal += granularity;
-        charType* temp = new charType[ numTotal + 1 ]();
-        for ( int i = 0; i < numUsed; ++i )
-            temp[ i ] = data[ i ];
+        charType* temp = allocChars( allocator, numTotal + granularity );
+        utils::copyItems( temp, data, numUsed );
         temp[ numUsed++ ] = c;
-        delete [] data;
+        freeChars( allocator, data, numTotal );
+        numTotal += granularity;
         data = temp;
     }
     
@@ -424,8 +474,8 @@ string_t<charType>& string_t<charType>::operator += ( const charType c ) {
 /*
  *      STRING -- Assignment operator using a C-string
  */
-template <typename charType>
-string_t<charType>& string_t<charType>::operator = ( const charType c ) {
+template <typename charType, typename alloc_t>
+string_t<charType, alloc_t>& string_t<charType, alloc_t>::operator = ( const charType c ) {
     // don't reallocate if the current size equals the granularity value
     if ( numTotal == granularity ) {
         int i = numUsed;
@@ -434,8 +484,8 @@ string_t<charType>& string_t<charType>::operator = ( const charType c ) {
         numUsed = 1;
     }
     else {
-        delete [] data;
-        data = new charType[ granularity + 1 ]();
+        freeChars( allocator, data, numTotal );
+        data = allocChars( allocator, granularity );
         data[0] = c;
         numUsed = 0;
         numTotal = granularity;
@@ -447,14 +497,14 @@ string_t<charType>& string_t<charType>::operator = ( const charType c ) {
 /******************************************************************************
     STRING - SUBSCRIPT OPERATORS
 ******************************************************************************/
-template <typename charType>
-charType string_t<charType>::operator[] ( int i ) const {
+template <typename charType, typename alloc_t>
+charType string_t<charType, alloc_t>::operator[] ( int i ) const {
     HL_ASSERT( i >= 0 && i < numUsed );
     return data[ i ];
 }
 
-template <typename charType>
-charType& string_t<charType>::operator[] ( int i ) {
+template <typename charType, typename alloc_t>
+charType& string_t<charType, alloc_t>::operator[] ( int i ) {
     HL_ASSERT( i >= 0 && i < numUsed );
     return data[ i ];
 }
@@ -463,18 +513,18 @@ charType& string_t<charType>::operator[] ( int i ) {
 /******************************************************************************
     STRING - MISCELLANEOUS
 ******************************************************************************/
-template <typename charType>
-void string_t<charType>::setReserveSize( int r ) {
+template <typename charType, typename alloc_t>
+void string_t<charType, alloc_t>::setReserveSize( int r ) {
     granularity = (r > 0) ? r : 1;
 }
 
-template <typename charType>
-void string_t<charType>::clear() {
-    delete [] data;
+template <typename charType, typename alloc_t>
+void string_t<charType, alloc_t>::clear() {
+    freeChars( allocator, data, numTotal );
     
     numUsed = 0;
     numTotal = granularity;
-    data = new charType[ granularity + 1 ]();
+    data = allocChars( allocator, granularity );
 }
 
 
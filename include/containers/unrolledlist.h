@@ -0,0 +1,677 @@
+/*
+ * An unrolled linked list.
+ * Each node holds a small array of up to N elements, so walking the list
+ * mostly steps through contiguous memory and only follows a link once every
+ * N elements. Inserting into a full node splits it in half, and erasing
+ * from a node which drops below half full merges it with a neighbor when
+ * they fit together, which keeps nodes at least half full on average.
+ *
+ * Navigation follows containers::list: an internal "iter" position is moved
+ * through the list, insertions are made around it and leave it on the new
+ * element, and popping an element moves it to the element which followed,
+ * or to the new last element if the last one was popped. Unlike list, a
+ * position is a node and an index within it, so elements move whenever
+ * their node is shifted, split or merged; pointers returned by the getters
+ * are only valid until the list is next modified.
+ *
+ * The list can also be walked with bidirectional iterators from begin() and
+ * end(), which never disturb "iter". Like element pointers, they are only
+ * valid until the list is next modified.
+ *
+ * Nodes are reserved through 'alloc_t' (see utils/allocator.h).
+ */
+
+#ifndef __HL_UNROLLED_LIST_H__
+#define __HL_UNROLLED_LIST_H__
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../utils/allocator.h"
+#include "../utils/copy.h"
+
+namespace hamLibs {
+namespace containers {
+
+template <
+	typename type,
+	int N = (sizeof(type) <= 32) ? int(256 / sizeof(type)) : 8,
+	typename alloc_t = utils::heapAllocator
+>
+class unrolledList {
+	static_assert(N >= 2, "unrolledList nodes must hold at least two elements.");
+
+	private:
+		struct link {
+			link*	next;
+			link*	prev;
+		};
+
+		struct node : link {
+			int		count;
+			alignas(type) unsigned char storage[sizeof(type) * N];
+
+			type* items() { return reinterpret_cast<type*>(storage); }
+		};
+
+		alloc_t		allocator;
+		link		mainNode;	//mainNode serves as the list's beginning and end
+		link*		iterNode;	//node holding the "iter" position, mainNode if empty
+		int			iterIndex;
+		int			numItems;
+
+		static node*	toNode		(link* l) { return static_cast<node*>(l); }
+		node*			createNode	(link* pos);
+		void			destroyNode	(node* n);
+		template <typename... args_t>
+		type&			insert		(node* n, int index, args_t&&... args);
+		void			erase		(node* n, int index);
+		void			mergeNodes	(node* first, node* second);
+		void			setIter		(link* l, int index);
+
+		//iterates through elements by node and index
+		template <typename value_t>
+		class listIterator {
+			friend class unrolledList;
+			template <typename> friend class listIterator;
+
+			private:
+				link*	current;
+				int		index;
+
+				listIterator(link* l, int i) : current(l), index(i) {}
+
+			public:
+				typedef std::bidirectional_iterator_tag				iterator_category;
+				typedef typename std::remove_const<value_t>::type	value_type;
+				typedef std::ptrdiff_t								difference_type;
+				typedef value_t*									pointer;
+				typedef value_t&									reference;
+
+				listIterator() : current(nullptr), index(0) {}
+
+				template <typename other_t, typename = typename std::enable_if<std::is_convertible<other_t*, value_t*>::value>::type>
+				listIterator(const listIterator<other_t>& i) : current(i.current), index(i.index) {}
+
+				value_t&		operator *	() const { return toNode(current)->items()[index]; }
+				value_t*		operator ->	() const { return toNode(current)->items() + index; }
+
+				listIterator&	operator ++	();
+				listIterator	operator ++	(int) { listIterator temp(*this); ++*this; return temp; }
+				listIterator&	operator --	();
+				listIterator	operator --	(int) { listIterator temp(*this); --*this; return temp; }
+
+				template <typename other_t>
+				bool operator ==	(const listIterator<other_t>& i) const { return current == i.current && index == i.index; }
+				template <typename other_t>
+				bool operator !=	(const listIterator<other_t>& i) const { return !(*this == i); }
+		};
+
+	public:
+		typedef listIterator<type>			iterator;
+		typedef listIterator<const type>	constIterator;
+
+		unrolledList	();
+		explicit unrolledList	(const alloc_t& a);
+		unrolledList	(const unrolledList& listCopy);
+		unrolledList	(unrolledList&& moved);
+		~unrolledList	();
+
+		unrolledList&	operator =	(const unrolledList& listCopy);
+		unrolledList&	operator =	(unrolledList&& moved);
+
+		//link navigation
+		void		goToFront	();			//immediately move "iter" to the front of the list
+		void		goToBack	();			//immediately move "iter" to the end of the list
+		void		goToNext	();			//move iter to the next element if it's not at the end
+		void		goToPrev	();			//move iter to the previous element if it's not at the beginning
+
+		//data acquisition
+		type*		getFirst	();			//get the first item. returns nullptr if the list is empty. Does not move the iterator
+		type*		getLast		();			//get the last item. returns nullptr if the list is empty. Does not move the iterator
+		type*		getCurrent	();			//get the currently selected item. returns nullptr if the list is empty
+		type*		getNext		();			//move iter to the next element and return it (returns nullptr if at the end of the list)
+		type*		getPrev		();			//move iter to the previous element and return it (returns nullptr if at the beginning of the list)
+		type*		peekNext	();			//get the next item without moving the iterator. returns nullptr at the end
+		type*		peekPrev	();			//get the previous item without moving the iterator. returns nullptr at the beginning
+
+		//insertion
+		void		pushFront	(const type& object);	//add an element to the front of the list
+		void		pushBack	(const type& object);	//add an element to the end of the list
+		void		pushBefore	(const type& object);	//add an element in front of the "iter" position; move iter to the new element
+		void		pushAfter	(const type& object);	//add an element behind the "iter" position; move iter to the new element
+		void		pushFront	(type&& object);
+		void		pushBack	(type&& object);
+		void		pushBefore	(type&& object);
+		void		pushAfter	(type&& object);
+		template <typename... args_t>
+		type&		emplaceFront	(args_t&&... args);	//construct an element; "iter" moves to it as with the push methods
+		template <typename... args_t>
+		type&		emplaceBack		(args_t&&... args);
+		template <typename... args_t>
+		type&		emplaceBefore	(args_t&&... args);
+		template <typename... args_t>
+		type&		emplaceAfter	(args_t&&... args);
+
+		//deletion
+		void		popnode		();			//delete the element at "iter", move to the next element
+		void		popFront	();			//delete the front element
+		void		popBack		();			//delete the last element
+		void		clear		();			//delete all elements in the list
+
+		//iteration, independent of "iter"
+		iterator		begin		();
+		iterator		end			();
+		constIterator	begin		() const;
+		constIterator	end			() const;
+
+		//miscellaneous
+		int			size		() const;
+		bool		empty		() const;
+		alloc_t&	getAllocator	();
+};
+
+//-----------------------------------------------------------------------------
+//			Node Storage
+//-----------------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+typename unrolledList<type, N, alloc_t>::node* unrolledList<type, N, alloc_t>::createNode(link* pos) {
+	//the new node is linked in front of "pos"
+	node* n = new(utils::allocateItems<node>(allocator, 1)) node;
+	n->count = 0;
+	n->next = pos;
+	n->prev = pos->prev;
+	pos->prev->next = n;
+	pos->prev = n;
+	return n;
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::destroyNode(node* n) {
+	type* const items = n->items();
+	for (int i = 0; i < n->count; ++i) {
+		items[i].~type();
+	}
+
+	n->prev->next = n->next;
+	n->next->prev = n->prev;
+	n->~node();
+	utils::deallocateItems(allocator, n, 1);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::setIter(link* l, int index) {
+	iterNode = l;
+	iterIndex = index;
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& unrolledList<type, N, alloc_t>::insert(node* n, int index, args_t&&... args) {
+	//appending to a node with room moves nothing, so construct in place
+	if (index == n->count && index < N) {
+		type* const item = new(n->items() + index) type(std::forward<args_t>(args)...);
+		++n->count;
+		++numItems;
+		setIter(n, index);
+		return *item;
+	}
+
+	//elements move to make room, so the new one is built first in case the
+	//arguments refer to one of them
+	type object(std::forward<args_t>(args)...);
+
+	if (n->count == N) {
+		link* const next = n->next;
+		link* const prev = n->prev;
+
+		//spill into a neighbor at either end of the node before splitting it
+		if (index == N) {
+			n = (next != &mainNode && toNode(next)->count < N) ? toNode(next) : createNode(next);
+			index = 0;
+		}
+		else if (index == 0) {
+			n = (prev != &mainNode && toNode(prev)->count < N) ? toNode(prev) : createNode(n);
+			index = n->count;
+		}
+		else {
+			node* const upper = createNode(next);
+			const int half = N / 2;
+			utils::relocateItems(upper->items(), n->items() + half, N - half);
+			upper->count = N - half;
+			n->count = half;
+
+			if (index > half) {
+				n = upper;
+				index -= half;
+			}
+		}
+	}
+
+	type* const items = n->items();
+	if (index < n->count) {
+		new(items + n->count) type(std::move(items[n->count - 1]));
+		utils::moveItems(items + index + 1, items + index, n->count - 1 - index);
+		items[index] = std::move(object);
+	}
+	else {
+		new(items + index) type(std::move(object));
+	}
+
+	++n->count;
+	++numItems;
+	setIter(n, index);
+	return items[index];
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::mergeNodes(node* first, node* second) {
+	//move the elements of "second" onto the end of "first"
+	if (iterNode == second) {
+		setIter(first, first->count + iterIndex);
+	}
+
+	utils::relocateItems(first->items() + first->count, second->items(), second->count);
+	first->count += second->count;
+	second->count = 0;
+	destroyNode(second);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::erase(node* n, int index) {
+	type* const items = n->items();
+	utils::moveItems(items + index, items + index + 1, n->count - 1 - index);
+	items[n->count - 1].~type();
+	--n->count;
+	--numItems;
+
+	link* const next = n->next;
+	link* const prev = n->prev;
+
+	//"iter" moves to the element which followed the erased one
+	if (index < n->count) {
+		setIter(n, index);
+	}
+	else if (next != &mainNode) {
+		setIter(next, 0);
+	}
+	else if (n->count) {
+		setIter(n, n->count - 1);
+	}
+	else {
+		setIter(prev, (prev != &mainNode) ? toNode(prev)->count - 1 : 0);
+	}
+
+	if (n->count == 0) {
+		destroyNode(n);
+	}
+	else if (n->count < N / 2) {
+		if (next != &mainNode && n->count + toNode(next)->count <= N) {
+			mergeNodes(n, toNode(next));
+		}
+		else if (prev != &mainNode && toNode(prev)->count + n->count <= N) {
+			mergeNodes(toNode(prev), n);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//			Construction & Destruction
+//-----------------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+unrolledList<type, N, alloc_t>::unrolledList() :
+	unrolledList(alloc_t())
+{}
+
+template <typename type, int N, typename alloc_t>
+unrolledList<type, N, alloc_t>::unrolledList(const alloc_t& a) :
+	allocator(a),
+	mainNode(),
+	iterNode(&mainNode),
+	iterIndex(0),
+	numItems(0)
+{
+	mainNode.next = &mainNode;
+	mainNode.prev = &mainNode;
+}
+
+template <typename type, int N, typename alloc_t>
+unrolledList<type, N, alloc_t>::unrolledList(const unrolledList& listCopy) :
+	unrolledList(listCopy.allocator)
+{
+	*this = listCopy;
+}
+
+template <typename type, int N, typename alloc_t>
+unrolledList<type, N, alloc_t>::unrolledList(unrolledList&& moved) :
+	unrolledList(moved.allocator)
+{
+	*this = std::move(moved);
+}
+
+template <typename type, int N, typename alloc_t>
+unrolledList<type, N, alloc_t>::~unrolledList() {
+	clear();
+}
+
+template <typename type, int N, typename alloc_t>
+unrolledList<type, N, alloc_t>& unrolledList<type, N, alloc_t>::operator =(const unrolledList& listCopy) {
+	if (this == &listCopy) return *this;
+
+	//nodes are filled completely, regardless of how full the copied ones were
+	clear();
+	for (link* l = listCopy.mainNode.next; l != &listCopy.mainNode; l = l->next) {
+		node* const src = toNode(l);
+		for (int i = 0; i < src->count; ++i) {
+			pushBack(src->items()[i]);
+		}
+	}
+	goToFront();
+	return *this;
+}
+
+template <typename type, int N, typename alloc_t>
+unrolledList<type, N, alloc_t>& unrolledList<type, N, alloc_t>::operator =(unrolledList&& moved) {
+	if (this == &moved) return *this;
+
+	clear();
+	if (!moved.empty()) {
+		//the end nodes point at the other list's main node, so relink them
+		mainNode = moved.mainNode;
+		mainNode.next->prev = &mainNode;
+		mainNode.prev->next = &mainNode;
+		setIter(moved.iterNode, moved.iterIndex);
+		numItems = moved.numItems;
+
+		moved.mainNode.next = moved.mainNode.prev = &moved.mainNode;
+		moved.setIter(&moved.mainNode, 0);
+		moved.numItems = 0;
+	}
+
+	//the allocator moves along with the memory it reserved
+	allocator = std::move(moved.allocator);
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+//			Link Navigation
+//-----------------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::goToFront() {
+	setIter(mainNode.next, 0);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::goToBack() {
+	setIter(mainNode.prev, empty() ? 0 : toNode(mainNode.prev)->count - 1);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::goToNext() {
+	if (iterNode == &mainNode) return;
+
+	if (iterIndex + 1 < toNode(iterNode)->count) {
+		++iterIndex;
+	}
+	else if (iterNode->next != &mainNode) {
+		setIter(iterNode->next, 0);
+	}
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::goToPrev() {
+	if (iterNode == &mainNode) return;
+
+	if (iterIndex > 0) {
+		--iterIndex;
+	}
+	else if (iterNode->prev != &mainNode) {
+		setIter(iterNode->prev, toNode(iterNode->prev)->count - 1);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//			Data Acquisition
+//-----------------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+type* unrolledList<type, N, alloc_t>::getFirst() {
+	return empty() ? nullptr : toNode(mainNode.next)->items();
+}
+
+template <typename type, int N, typename alloc_t>
+type* unrolledList<type, N, alloc_t>::getLast() {
+	return empty() ? nullptr : toNode(mainNode.prev)->items() + toNode(mainNode.prev)->count - 1;
+}
+
+template <typename type, int N, typename alloc_t>
+type* unrolledList<type, N, alloc_t>::getCurrent() {
+	return (iterNode == &mainNode) ? nullptr : toNode(iterNode)->items() + iterIndex;
+}
+
+template <typename type, int N, typename alloc_t>
+type* unrolledList<type, N, alloc_t>::getNext() {
+	type* const next = peekNext();
+	if (next) {
+		goToNext();
+	}
+	return next;
+}
+
+template <typename type, int N, typename alloc_t>
+type* unrolledList<type, N, alloc_t>::getPrev() {
+	type* const prev = peekPrev();
+	if (prev) {
+		goToPrev();
+	}
+	return prev;
+}
+
+template <typename type, int N, typename alloc_t>
+type* unrolledList<type, N, alloc_t>::peekNext() {
+	if (iterNode == &mainNode) return nullptr;
+
+	node* const n = toNode(iterNode);
+	if (iterIndex + 1 < n->count) {
+		return n->items() + iterIndex + 1;
+	}
+	return (n->next != &mainNode) ? toNode(n->next)->items() : nullptr;
+}
+
+template <typename type, int N, typename alloc_t>
+type* unrolledList<type, N, alloc_t>::peekPrev() {
+	if (iterNode == &mainNode) return nullptr;
+
+	node* const n = toNode(iterNode);
+	if (iterIndex > 0) {
+		return n->items() + iterIndex - 1;
+	}
+	return (n->prev != &mainNode) ? toNode(n->prev)->items() + toNode(n->prev)->count - 1 : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+//			Insertion
+//-----------------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::pushFront(const type& object) {
+	emplaceFront(object);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::pushFront(type&& object) {
+	emplaceFront(std::move(object));
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::pushBack(const type& object) {
+	emplaceBack(object);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::pushBack(type&& object) {
+	emplaceBack(std::move(object));
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::pushBefore(const type& object) {
+	emplaceBefore(object);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::pushBefore(type&& object) {
+	emplaceBefore(std::move(object));
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::pushAfter(const type& object) {
+	emplaceAfter(object);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::pushAfter(type&& object) {
+	emplaceAfter(std::move(object));
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& unrolledList<type, N, alloc_t>::emplaceFront(args_t&&... args) {
+	goToFront();
+	return emplaceBefore(std::forward<args_t>(args)...);
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& unrolledList<type, N, alloc_t>::emplaceBack(args_t&&... args) {
+	if (empty()) {
+		return emplaceBefore(std::forward<args_t>(args)...);
+	}
+	node* const last = toNode(mainNode.prev);
+	return insert(last, last->count, std::forward<args_t>(args)...);
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& unrolledList<type, N, alloc_t>::emplaceBefore(args_t&&... args) {
+	if (iterNode != &mainNode) {
+		return insert(toNode(iterNode), iterIndex, std::forward<args_t>(args)...);
+	}
+
+	//an empty node must not outlive a failed construction
+	node* const n = createNode(&mainNode);
+	try {
+		return insert(n, 0, std::forward<args_t>(args)...);
+	}
+	catch (...) {
+		destroyNode(n);
+		throw;
+	}
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename... args_t>
+type& unrolledList<type, N, alloc_t>::emplaceAfter(args_t&&... args) {
+	if (iterNode == &mainNode) {
+		return emplaceBefore(std::forward<args_t>(args)...);
+	}
+	return insert(toNode(iterNode), iterIndex + 1, std::forward<args_t>(args)...);
+}
+
+//-----------------------------------------------------------------------------
+//			Deletion
+//-----------------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::popnode() {
+	//make sure that there's actually something to delete
+	if (iterNode == &mainNode) return;
+	erase(toNode(iterNode), iterIndex);
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::popFront() {
+	goToFront();
+	popnode();
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::popBack() {
+	goToBack();
+	popnode();
+}
+
+template <typename type, int N, typename alloc_t>
+void unrolledList<type, N, alloc_t>::clear() {
+	while (mainNode.next != &mainNode) {
+		destroyNode(toNode(mainNode.next));
+	}
+	setIter(&mainNode, 0);
+	numItems = 0;
+}
+
+//-----------------------------------------------------------------------------
+//			Iteration
+//-----------------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+template <typename value_t>
+typename unrolledList<type, N, alloc_t>::template listIterator<value_t>& unrolledList<type, N, alloc_t>::listIterator<value_t>::operator ++() {
+	if (++index == toNode(current)->count) {
+		current = current->next;
+		index = 0;
+	}
+	return *this;
+}
+
+template <typename type, int N, typename alloc_t>
+template <typename value_t>
+typename unrolledList<type, N, alloc_t>::template listIterator<value_t>& unrolledList<type, N, alloc_t>::listIterator<value_t>::operator --() {
+	//the end of the list steps back onto the last element
+	if (index-- == 0) {
+		current = current->prev;
+		index = toNode(current)->count - 1;
+	}
+	return *this;
+}
+
+template <typename type, int N, typename alloc_t>
+typename unrolledList<type, N, alloc_t>::iterator unrolledList<type, N, alloc_t>::begin() {
+	return iterator(mainNode.next, 0);
+}
+
+template <typename type, int N, typename alloc_t>
+typename unrolledList<type, N, alloc_t>::iterator unrolledList<type, N, alloc_t>::end() {
+	return iterator(&mainNode, 0);
+}
+
+template <typename type, int N, typename alloc_t>
+typename unrolledList<type, N, alloc_t>::constIterator unrolledList<type, N, alloc_t>::begin() const {
+	return constIterator(mainNode.next, 0);
+}
+
+template <typename type, int N, typename alloc_t>
+typename unrolledList<type, N, alloc_t>::constIterator unrolledList<type, N, alloc_t>::end() const {
+	//the main node is never written through a const iterator
+	return constIterator(const_cast<link*>(&mainNode), 0);
+}
+
+//-----------------------------------------------------------------------------
+//			Miscellaneous
+//-----------------------------------------------------------------------------
+template <typename type, int N, typename alloc_t>
+int unrolledList<type, N, alloc_t>::size() const {
+	return numItems;
+}
+
+template <typename type, int N, typename alloc_t>
+bool unrolledList<type, N, alloc_t>::empty() const {
+	return numItems == 0;
+}
+
+template <typename type, int N, typename alloc_t>
+alloc_t& unrolledList<type, N, alloc_t>::getAllocator() {
+	return allocator;
+}
+
+} //end containers namespace
+} //end hamLibs namespace
+
+#endif /* __HL_UNROLLED_LIST_H__ */
@@ -0,0 +1,322 @@
+/*
+ * File:   workstealingdeque.h
+ * Author: hammy
+ *
+ * Lock-free deque for task scheduling, which is filled and drained by one
+ * owner thread while any number of other threads steal from it.
+ */
+
+#ifndef __HL_WORK_STEALING_DEQUE_H__
+#define __HL_WORK_STEALING_DEQUE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include "../utils/allocator.h"
+
+namespace hamLibs {
+namespace containers {
+
+/******************************************************************************
+ *  Work-Stealing Deque Structure Setup
+ *
+ * A Chase-Lev deque. The owner pushes and pops at the bottom, in last-in,
+ * first-out order, so the tasks it works on stay hot in its cache. Thieves
+ * steal from the top, taking the oldest tasks first. The owner only contends
+ * with thieves when a single element is left; every other push and pop is a
+ * handful of plain loads and stores. Memory orderings follow Le, Pop, Cohen
+ * and Zappa Nardelli's C11 version of the algorithm.
+ *
+ * Elements live in a circular array whose size is a power of two. When the
+ * owner runs out of room it copies the live range into an array twice the
+ * size. Thieves may still be reading from the old array, so it is not freed
+ * straight away; each array keeps a link to the one it replaced and the whole
+ * chain is released when the deque is destroyed. Since every array is half
+ * the size of the next, retired arrays never take more memory than the live
+ * one.
+ *
+ * Elements are read by thieves before they know whether their steal will
+ * succeed, so 'type' must be trivially copyable; tasks are usually passed as
+ * pointers or small handles.
+ *
+ * Only the owner thread may call push() and pop(). Any thread may call
+ * steal(). Arrays are reserved through 'alloc_t' by the owner alone, so the
+ * allocator does not need to be thread-safe.
+******************************************************************************/
+template <typename type, typename alloc_t = utils::heapAllocator>
+class workStealingDeque {
+    static_assert( std::is_trivially_copyable< type >::value,
+        "Work-stealing deques can only hold trivially copyable elements." );
+
+    public:
+        enum : unsigned {
+            CACHE_LINE_SIZE = 64
+        };
+
+    private:
+        struct ringArray {
+            std::int64_t            mask;
+            std::atomic< type >*    slots;
+            ringArray*              previous;   // the array this one replaced
+
+            type    get ( std::int64_t i ) const        { return slots[ i & mask ].load( std::memory_order_relaxed ); }
+            void    put ( std::int64_t i, type data )   { slots[ i & mask ].store( data, std::memory_order_relaxed ); }
+        };
+
+        /*
+         * Top and bottom are padded to keep each one on its own cache line.
+         */
+        struct paddedIndex {
+            std::atomic< std::int64_t > index;
+            char padding[ CACHE_LINE_SIZE - sizeof( std::atomic< std::int64_t > ) ];
+
+            paddedIndex() : index{0} {}
+        };
+
+        // Members below are only accessed by the owner
+        alloc_t                     allocator;
+        char                        padding[ CACHE_LINE_SIZE ];
+
+        paddedIndex                 top;        // advanced by thieves, and by the owner for the last element
+        paddedIndex                 bottom;     // only written by the owner
+        std::atomic< ringArray* >   buffer;
+
+        ringArray*          createArray     ( std::int64_t capacity, ringArray* previous );
+        void                destroyArray    ( ringArray* a );
+        ringArray*          grow            ( ringArray* a, std::int64_t b, std::int64_t t );
+
+    public:
+        explicit workStealingDeque  ( unsigned capacity = 64 );
+        workStealingDeque           ( unsigned capacity, const alloc_t& );
+        workStealingDeque           ( const workStealingDeque& ) = delete;
+        workStealingDeque           ( workStealingDeque&& ) = delete;
+
+        ~workStealingDeque          ();
+
+        workStealingDeque&  operator=   ( const workStealingDeque& ) = delete;
+        workStealingDeque&  operator=   ( workStealingDeque&& ) = delete;
+
+        // Owner
+        void                push        ( const type& data );
+        bool                pop         ( type& outData );
+
+        // Thieves
+        bool                steal       ( type& outData );
+
+        // Miscellaneous
+        unsigned            capacity    () const;
+        unsigned            size        () const;
+        bool                empty       () const { return size() == 0; }
+};
+
+/*
+ * Work-Stealing Deque -- Create Array
+ */
+template <typename type, typename alloc_t>
+typename workStealingDeque<type, alloc_t>::ringArray* workStealingDeque<type, alloc_t>::createArray(
+    std::int64_t capacity,
+    ringArray* previous
+) {
+    ringArray* const a = utils::createItem< ringArray >( allocator );
+
+    try {
+        a->slots = utils::allocateItems< std::atomic< type > >( allocator, std::size_t( capacity ) );
+    }
+    catch ( ... ) {
+        utils::destroyItem( allocator, a );
+        throw;
+    }
+
+    for ( std::int64_t i = 0; i < capacity; ++i ) {
+        new( &a->slots[ i ] ) std::atomic< type >();
+    }
+
+    a->mask = capacity - 1;
+    a->previous = previous;
+    return a;
+}
+
+/*
+ * Work-Stealing Deque -- Destroy Array
+ * Release an array along with every array it replaced.
+ */
+template <typename type, typename alloc_t>
+void workStealingDeque<type, alloc_t>::destroyArray( ringArray* a ) {
+    while ( a ) {
+        ringArray* const previous = a->previous;
+        utils::deallocateItems( allocator, a->slots, std::size_t( a->mask + 1 ) );
+        utils::destroyItem( allocator, a );
+        a = previous;
+    }
+}
+
+/*
+ * Work-Stealing Deque -- Grow
+ * Copy the elements in [t, b) into an array twice the size and publish it.
+ * Thieves which loaded the old array can still finish reading from it.
+ */
+template <typename type, typename alloc_t>
+typename workStealingDeque<type, alloc_t>::ringArray* workStealingDeque<type, alloc_t>::grow(
+    ringArray* a,
+    std::int64_t b,
+    std::int64_t t
+) {
+    ringArray* const bigger = createArray( (a->mask + 1) * 2, a );
+
+    for ( std::int64_t i = t; i < b; ++i ) {
+        bigger->put( i, a->get( i ) );
+    }
+
+    buffer.store( bigger, std::memory_order_release );
+    return bigger;
+}
+
+/*
+ * Work-Stealing Deque -- Constructor
+ */
+template <typename type, typename alloc_t>
+workStealingDeque<type, alloc_t>::workStealingDeque( unsigned capacity ) :
+    workStealingDeque( capacity, alloc_t{} )
+{}
+
+/*
+ * Work-Stealing Deque -- Allocator Constructor
+ * The capacity is rounded up to a power of two.
+ */
+template <typename type, typename alloc_t>
+workStealingDeque<type, alloc_t>::workStealingDeque( unsigned capacity, const alloc_t& a ) :
+    allocator{ a },
+    padding{},
+    top{},
+    bottom{},
+    buffer{ nullptr }
+{
+    std::int64_t numSlots = 2;
+
+    while ( numSlots < capacity ) {
+        numSlots <<= 1;
+    }
+
+    buffer.store( createArray( numSlots, nullptr ), std::memory_order_relaxed );
+}
+
+/*
+ * Work-Stealing Deque -- Destructor
+ * No thieves may be using the deque while it is destroyed.
+ */
+template <typename type, typename alloc_t>
+workStealingDeque<type, alloc_t>::~workStealingDeque() {
+    destroyArray( buffer.load( std::memory_order_relaxed ) );
+}
+
+/*
+ * Work-Stealing Deque -- Push
+ * Add an element to the bottom of the deque, growing it if it is full.
+ */
+template <typename type, typename alloc_t>
+void workStealingDeque<type, alloc_t>::push( const type& data ) {
+    const std::int64_t b = bottom.index.load( std::memory_order_relaxed );
+    const std::int64_t t = top.index.load( std::memory_order_acquire );
+    ringArray* a = buffer.load( std::memory_order_relaxed );
+
+    if ( b - t > a->mask ) {
+        a = grow( a, b, t );
+    }
+
+    a->put( b, data );
+
+    // the element must be visible before thieves can see the new bottom
+    std::atomic_thread_fence( std::memory_order_release );
+    bottom.index.store( b + 1, std::memory_order_relaxed );
+}
+
+/*
+ * Work-Stealing Deque -- Pop
+ * Take the element at the bottom of the deque. Returns false if the deque is
+ * empty, or if a thief took the last element first.
+ */
+template <typename type, typename alloc_t>
+bool workStealingDeque<type, alloc_t>::pop( type& outData ) {
+    const std::int64_t b = bottom.index.load( std::memory_order_relaxed ) - 1;
+    ringArray* const a = buffer.load( std::memory_order_relaxed );
+
+    // claim the bottom element before checking for thieves
+    bottom.index.store( b, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    std::int64_t t = top.index.load( std::memory_order_relaxed );
+
+    if ( t > b ) {
+        // the deque was already empty
+        bottom.index.store( b + 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    const type data = a->get( b );
+
+    if ( t == b ) {
+        // only one element was left, so race the thieves for it
+        const bool won = top.index.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+        bottom.index.store( b + 1, std::memory_order_relaxed );
+
+        if ( !won ) {
+            return false;
+        }
+    }
+
+    outData = data;
+    return true;
+}
+
+/*
+ * Work-Stealing Deque -- Steal
+ * Take the element at the top of the deque. Returns false if the deque is
+ * empty, or if another thread took the element first; callers may simply
+ * try again or move on to another deque.
+ */
+template <typename type, typename alloc_t>
+bool workStealingDeque<type, alloc_t>::steal( type& outData ) {
+    std::int64_t t = top.index.load( std::memory_order_acquire );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    const std::int64_t b = bottom.index.load( std::memory_order_acquire );
+
+    if ( t >= b ) {
+        return false;
+    }
+
+    ringArray* const a = buffer.load( std::memory_order_acquire );
+    const type data = a->get( t );
+
+    if ( !top.index.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+        return false;
+    }
+
+    outData = data;
+    return true;
+}
+
+/*
+ * Work-Stealing Deque -- Capacity
+ * Only meaningful when called by the owner.
+ */
+template <typename type, typename alloc_t>
+unsigned workStealingDeque<type, alloc_t>::capacity() const {
+    return unsigned( buffer.load( std::memory_order_relaxed )->mask + 1 );
+}
+
+/*
+ * Work-Stealing Deque -- Size
+ * Only a snapshot; other threads may steal at any time.
+ */
+template <typename type, typename alloc_t>
+unsigned workStealingDeque<type, alloc_t>::size() const {
+    const std::int64_t b = bottom.index.load( std::memory_order_relaxed );
+    const std::int64_t t = top.index.load( std::memory_order_relaxed );
+
+    return (b > t) ? unsigned( b - t ) : 0;
+}
+
+} // end containers namespace
+} // end hamLibs namespace
+
+#endif  /* __HL_WORK_STEALING_DEQUE_H__ */
@@ -91,6 +91,11 @@
 	#endif
 #endif
 
+/* x86 SIMD Extensions */
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define HL_SIMD_SSE2 1
+#endif
+
 /* Itanium */
 #if defined (__IA64__) || defined (_M_IA64) || defined (__itanium__)
 	#define HL_ARCH_IA64 1
@@ -193,6 +198,35 @@
 	#define HL_IMPERATIVE HL_INLINE HL_FASTCALL
 #endif
 
+/*
+ * Keep rarely-taken slow paths out of the functions which call them
+ */
+#if defined (HL_COMPILER_MSC)
+	#define HL_NOINLINE __declspec(noinline)
+#elif defined (HL_COMPILER_GNU)
+	#define HL_NOINLINE __attribute__((noinline))
+#else
+	#define HL_NOINLINE
+#endif
+
+/*
+ * Software prefetching of a read-only address into all levels of cache
+ */
+#if defined (HL_COMPILER_GNU)
+	#define HL_PREFETCH( addr ) __builtin_prefetch( (addr), 0, 3 )
+#else
+	#define HL_PREFETCH( addr )
+#endif
+
+/*
+ * Types which may be used to inspect the bytes of other objects
+ */
+#if defined (HL_COMPILER_GNU)
+	#define HL_MAY_ALIAS __attribute__((__may_alias__))
+#else
+	#define HL_MAY_ALIAS
+#endif
+
 /*
  * Dynamic Library Support
  */
@@ -17,19 +17,39 @@
 //---------------------------------------------------------------------
 //              Meat & Potatoes
 //---------------------------------------------------------------------
+#include "utils/allocator.h"
 #include "utils/assert.h"
+#include "utils/copy.h"
 #include "utils/hash.h"
 #include "utils/logger.h"
+#include "utils/mappedFile.h"
+#include "utils/parallel.h"
 #include "utils/pointer.h"
 #include "utils/randomNum.h"
 #include "utils/timeObject.h"
+#include "utils/workerPool.h"
 
 #include "containers/array.h"
+#include "containers/arttree.h"
 #include "containers/btree.h"
+#include "containers/btreeimage.h"
+#include "containers/ptree.h"
+#include "containers/concurrentbtree.h"
+#include "containers/deque.h"
+#include "containers/intrusivelist.h"
 #include "containers/list.h"
+#include "containers/mpmcqueue.h"
+#include "containers/priorityqueue.h"
 #include "containers/queue.h"
+#include "containers/ringqueue.h"
+#include "containers/slotmap.h"
+#include "containers/smallarray.h"
+#include "containers/spscqueue.h"
 #include "containers/stack.h"
+#include "containers/staticarray.h"
 #include "containers/string.h"
+#include "containers/unrolledlist.h"
+#include "containers/workstealingdeque.h"
 
 #include "math/math.h"
 
@@ -37,8 +37,8 @@ struct vec2_t {
     // Delegated Constructors
 	constexpr vec2_t();
 	constexpr vec2_t(numType n);
-	constexpr vec2_t(const vec2_t<numType>& input);
-	constexpr vec2_t(vec2_t<numType>&& input);
+	constexpr vec2_t(const vec2_t<numType>& input) = default;
+	constexpr vec2_t(vec2_t<numType>&& input) = default;
     
 	~vec2_t() = default;
     
@@ -59,8 +59,8 @@ struct vec2_t {
 	vec2_t			operator 		- 		() const;
 	vec2_t			operator 		* 		(const vec2_t<numType>&) const;
 	vec2_t			operator 		/ 		(const vec2_t<numType>&) const;
-	vec2_t&			operator		= 		(const vec2_t<numType>&);
-	vec2_t&			operator		= 		(vec2_t<numType>&&);
+	vec2_t&			operator		= 		(const vec2_t<numType>&) = default;
+	vec2_t&			operator		= 		(vec2_t<numType>&&) = default;
 	vec2_t&			operator 		+= 		(const vec2_t<numType>&);
 	vec2_t&			operator 		-= 		(const vec2_t<numType>&);
 	vec2_t&			operator 		*= 		(const vec2_t<numType>&);
@@ -137,16 +137,6 @@ constexpr vec2_t<numType>::vec2_t(numType n) :
     v{n, n}
 {}
 
-template <typename numType>
-constexpr vec2_t<numType>::vec2_t(const vec2_t<numType>& v) :
-    v{v.v[0], v.v[1]}
-{}
-
-template <typename numType>
-constexpr vec2_t<numType>::vec2_t(vec2_t<numType>&& v) :
-    v{v.v[0], v.v[1]}
-{}
-
 //---------------------------------------------------------------------
 // Conversions & Casting
 //---------------------------------------------------------------------
@@ -227,20 +217,6 @@ vec2_t<numType>& vec2_t<numType>::operator += (const vec2_t<numType>& input) {
 	return *this;
 }
 
-template <typename numType> inline
-vec2_t<numType>& vec2_t<numType>::operator = (const vec2_t<numType>& input) {
-	v[0] = input.v[0];
-	v[1] = input.v[1];
-	return *this;
-}
-
-template <typename numType> inline
-vec2_t<numType>& vec2_t<numType>::operator = (vec2_t<numType>&& input) {
-	v[0] = input.v[0];
-	v[1] = input.v[1];
-	return *this;
-}
-
 template <typename numType> inline
 vec2_t<numType>& vec2_t<numType>::operator -= (const vec2_t<numType>& input) {
 	v[0] -= input.v[0];
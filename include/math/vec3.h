@@ -36,8 +36,8 @@ struct vec3_t {
 	constexpr vec3_t(numType inX, numType inY, numType inZ);
 	constexpr vec3_t();
 	constexpr vec3_t(numType n);
-	constexpr vec3_t(const vec3_t<numType>& input);
-	constexpr vec3_t(vec3_t<numType>&& input);
+	constexpr vec3_t(const vec3_t<numType>& input) = default;
+	constexpr vec3_t(vec3_t<numType>&& input) = default;
     
 	~vec3_t() = default;
     
@@ -58,8 +58,8 @@ struct vec3_t {
 	vec3_t			operator 		- 		() const;
 	vec3_t			operator 		* 		(const vec3_t<numType>&) const;
 	vec3_t			operator 		/ 		(const vec3_t<numType>&) const;
-	vec3_t&			operator		= 		(const vec3_t<numType>&);
-	vec3_t&			operator		= 		(vec3_t<numType>&&);
+	vec3_t&			operator		= 		(const vec3_t<numType>&) = default;
+	vec3_t&			operator		= 		(vec3_t<numType>&&) = default;
 	vec3_t&			operator 		+= 		(const vec3_t<numType>&);
 	vec3_t&			operator 		-= 		(const vec3_t<numType>&);
 	vec3_t&			operator 		*= 		(const vec3_t<numType>&);
@@ -136,16 +136,6 @@ constexpr vec3_t<numType>::vec3_t(numType n) :
     v{n, n, n}
 {}
 
-template <typename numType>
-constexpr vec3_t<numType>::vec3_t(const vec3_t<numType>& v) :
-    v{v.v[0], v.v[1], v.v[2]}
-{}
-
-template <typename numType>
-constexpr vec3_t<numType>::vec3_t(vec3_t<numType>&& v) :
-    v{v.v[0], v.v[1], v.v[2]}
-{}
-
 //---------------------------------------------------------------------
 // Conversions & Casting
 //---------------------------------------------------------------------
@@ -223,22 +213,6 @@ vec3_t<numType> vec3_t<numType>::operator / (const vec3_t<numType>& input) const
 	);
 }
 
-template <typename numType> inline
-vec3_t<numType>& vec3_t<numType>::operator = (const vec3_t<numType>& input) {
-	v[0] = input.v[0];
-	v[1] = input.v[1];
-	v[2] = input.v[2];
-	return *this;
-}
-
-template <typename numType> inline
-vec3_t<numType>& vec3_t<numType>::operator = (vec3_t<numType>&& input) {
-	v[0] = input.v[0];
-	v[1] = input.v[1];
-	v[2] = input.v[2];
-	return *this;
-}
-
 template <typename numType> inline
 vec3_t<numType>& vec3_t<numType>::operator += (const vec3_t<numType>& input) {
 	v[0] += input.v[0];
@@ -37,8 +37,8 @@ struct vec4_t {
 	constexpr vec4_t(numType inX, numType inY, numType inZ, numType inW);
 	constexpr vec4_t();
 	constexpr vec4_t(numType n);
-	constexpr vec4_t(const vec4_t<numType>& input);
-	constexpr vec4_t(vec4_t<numType>&& input);
+	constexpr vec4_t(const vec4_t<numType>& input) = default;
+	constexpr vec4_t(vec4_t<numType>&& input) = default;
     
 	~vec4_t() = default;
     
@@ -59,8 +59,8 @@ struct vec4_t {
 	vec4_t			operator 		- 		() const;
 	vec4_t			operator 		* 		(const vec4_t<numType>&) const;
 	vec4_t			operator 		/ 		(const vec4_t<numType>&) const;
-	vec4_t&			operator		= 		(const vec4_t<numType>&);
-	vec4_t&			operator		= 		(vec4_t<numType>&&);
+	vec4_t&			operator		= 		(const vec4_t<numType>&) = default;
+	vec4_t&			operator		= 		(vec4_t<numType>&&) = default;
 	vec4_t&			operator 		+= 		(const vec4_t<numType>&);
 	vec4_t&			operator 		-= 		(const vec4_t<numType>&);
 	vec4_t&			operator 		*= 		(const vec4_t<numType>&);
@@ -137,16 +137,6 @@ constexpr vec4_t<numType>::vec4_t(numType n) :
     v{n, n, n, numType(1)}
 {}
 
-template <typename numType>
-constexpr vec4_t<numType>::vec4_t(const vec4_t<numType>& v) :
-    v{v.v[0], v.v[1], v.v[2], v.v[3]}
-{}
-
-template <typename numType>
-constexpr vec4_t<numType>::vec4_t(vec4_t<numType>&& v) :
-    v{v.v[0], v.v[1], v.v[2], v.v[3]}
-{}
-
 //---------------------------------------------------------------------
 // Conversions & Casting
 //---------------------------------------------------------------------
@@ -230,24 +220,6 @@ vec4_t<numType> vec4_t<numType>::operator / (const vec4_t<numType>& input) const
 	);
 }
 
-template <typename numType> inline
-vec4_t<numType>& vec4_t<numType>::operator = (const vec4_t<numType>& input) {
-	v[0] = input.v[0];
-	v[1] = input.v[1];
-	v[2] = input.v[2];
-	v[3] = input.v[3];
-	return *this;
-}
-
-template <typename numType> inline
-vec4_t<numType>& vec4_t<numType>::operator = (vec4_t<numType>&& input) {
-	v[0] = input.v[0];
-	v[1] = input.v[1];
-	v[2] = input.v[2];
-	v[3] = input.v[3];
-	return *this;
-}
-
 template <typename numType> inline
 vec4_t<numType>& vec4_t<numType>::operator += (const vec4_t<numType>& input) {
     v[0] += input.v[0];
@@ -0,0 +1,252 @@
+/*
+ * File:   allocator.h
+ * Author: hammy
+ *
+ * Allocator policies used by the containers.
+ */
+
+#ifndef __HL_ALLOCATOR_H__
+#define	__HL_ALLOCATOR_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace hamLibs {
+namespace utils {
+
+/**
+ * Allocators
+ *
+ * Every container which reserves memory takes an allocator as its last
+ * template parameter. An allocator is any copyable type with the following
+ * members:
+ *
+ *      void* allocate(std::size_t numBytes, std::size_t alignment);
+ *      void deallocate(void* p, std::size_t numBytes, std::size_t alignment);
+ *      bool operator==(const alloc_t&) const;
+ *
+ * allocate() must either return memory or throw std::bad_alloc. The
+ * alignment is always a power of two, and deallocate() is passed the same
+ * size and alignment which reserved the memory. Two allocators compare equal
+ * if memory reserved by one can be released by the other.
+ *
+ * Containers keep a copy of the allocator they were constructed with.
+ * Copying a container copies its allocator; moving a container moves its
+ * allocator along with its memory.
+ */
+
+/**
+ *  Reserve memory from the global operator new. Under C++11, operator new
+ *  only aligns memory to alignof(std::max_align_t). Larger alignments are met
+ *  by over-allocating by 'alignment' plus a pointer's size, and keeping the
+ *  address from operator new just before the returned block.
+ *
+ *  @throws std::bad_alloc if the memory could not be reserved.
+ */
+inline void* alignedNew(std::size_t numBytes, std::size_t alignment) {
+    if (alignment <= alignof(std::max_align_t)) {
+        return ::operator new(numBytes);
+    }
+
+    const std::size_t padding = alignment + sizeof(void*);
+    if (numBytes > std::size_t(-1) - padding) {
+        throw std::bad_alloc();
+    }
+
+    void* const base = ::operator new(numBytes + padding);
+    const std::uintptr_t mask = alignment - 1;
+    const std::uintptr_t start = (reinterpret_cast<std::uintptr_t>(base) + sizeof(void*) + mask) & ~mask;
+
+    reinterpret_cast<void**>(start)[-1] = base;
+    return reinterpret_cast<void*>(start);
+}
+
+/**
+ *  Release memory from alignedNew(), using the alignment it was given.
+ */
+inline void alignedDelete(void* p, std::size_t alignment) {
+    if (p != nullptr && alignment > alignof(std::max_align_t)) {
+        p = static_cast<void**>(p)[-1];
+    }
+
+    ::operator delete(p);
+}
+
+/**
+ * Heap Allocator
+ *
+ * The default allocator for all containers. Memory is reserved with the
+ * global operator new and released with the global operator delete; see
+ * alignedNew() for alignments beyond alignof(std::max_align_t).
+ */
+class heapAllocator {
+    public:
+        void* allocate(std::size_t numBytes, std::size_t alignment = alignof(std::max_align_t)) {
+            return alignedNew(numBytes, alignment);
+        }
+
+        void deallocate(void* p, std::size_t, std::size_t alignment = alignof(std::max_align_t)) {
+            alignedDelete(p, alignment);
+        }
+
+        bool operator==(const heapAllocator&) const { return true; }
+        bool operator!=(const heapAllocator&) const { return false; }
+};
+
+/**
+ * Memory Resource
+ *
+ * Polymorphic interface for memory sources, such as arenas and per-thread
+ * heaps, which are chosen at run-time. Containers use a memory resource
+ * through a resourceAllocator.
+ */
+class memoryResource {
+    public:
+        virtual ~memoryResource() {}
+
+        virtual void* allocate(std::size_t numBytes, std::size_t alignment) = 0;
+        virtual void deallocate(void* p, std::size_t numBytes, std::size_t alignment) = 0;
+};
+
+/**
+ * Heap Resource
+ *
+ * A memory resource which uses the global operator new and delete. Any
+ * alignment is honored, as with heapAllocator.
+ */
+class heapResource final : public memoryResource {
+    public:
+        /**
+         *  @return A memory resource which can be shared by any number of
+         *  containers and threads.
+         */
+        static heapResource* get();
+
+        void* allocate(std::size_t numBytes, std::size_t alignment) override;
+        void deallocate(void* p, std::size_t numBytes, std::size_t alignment) override;
+};
+
+/**
+ * Arena Resource
+ *
+ * Hands out memory from a single buffer by advancing an offset. Individual
+ * deallocations are ignored; all memory is reclaimed at once by reset(),
+ * which makes this suitable for per-frame data. The arena does not own its
+ * buffer.
+ */
+class arenaResource final : public memoryResource {
+    private:
+        unsigned char*  pBuffer     = nullptr;
+        std::size_t     capacity    = 0;
+        std::size_t     offset      = 0;
+
+    public:
+        arenaResource(void* buffer, std::size_t numBytes) :
+            pBuffer{static_cast<unsigned char*>(buffer)},
+            capacity{numBytes}
+        {}
+
+        arenaResource(const arenaResource&) = delete;
+        arenaResource& operator=(const arenaResource&) = delete;
+
+        /**
+         *  @return Memory from the remainder of the buffer.
+         *
+         *  @throws std::bad_alloc if the buffer has been used up.
+         */
+        void* allocate(std::size_t numBytes, std::size_t alignment) override;
+        void deallocate(void*, std::size_t, std::size_t) override {}
+
+        /**
+         *  Make the entire buffer available again. All objects which were
+         *  placed in the arena must have already been destroyed.
+         */
+        void reset() { offset = 0; }
+
+        std::size_t size() const { return offset; }
+        std::size_t maxSize() const { return capacity; }
+};
+
+/**
+ * Resource Allocator
+ *
+ * An allocator which forwards to a memoryResource. Two resource allocators
+ * are equal if they share the same resource.
+ */
+class resourceAllocator {
+    private:
+        memoryResource* pResource;
+
+    public:
+        resourceAllocator(memoryResource* resource = heapResource::get()) :
+            pResource{resource}
+        {}
+
+        void* allocate(std::size_t numBytes, std::size_t alignment = alignof(std::max_align_t)) {
+            return pResource->allocate(numBytes, alignment);
+        }
+
+        void deallocate(void* p, std::size_t numBytes, std::size_t alignment = alignof(std::max_align_t)) {
+            pResource->deallocate(p, numBytes, alignment);
+        }
+
+        memoryResource* resource() const { return pResource; }
+
+        bool operator==(const resourceAllocator& a) const { return pResource == a.pResource; }
+        bool operator!=(const resourceAllocator& a) const { return pResource != a.pResource; }
+};
+
+/**
+ *  Reserve uninitialized memory for 'count' objects of type 'type'.
+ */
+template <typename type, typename alloc_t>
+inline type* allocateItems(alloc_t& allocator, std::size_t count) {
+    return (count > 0)
+        ? static_cast<type*>(allocator.allocate(sizeof(type) * count, alignof(type)))
+        : nullptr;
+}
+
+/**
+ *  Release memory returned by allocateItems(). No destructors are run.
+ */
+template <typename type, typename alloc_t>
+inline void deallocateItems(alloc_t& allocator, type* items, std::size_t count) {
+    if (items != nullptr) {
+        allocator.deallocate(items, sizeof(type) * count, alignof(type));
+    }
+}
+
+/**
+ *  Allocate and construct a single object.
+ */
+template <typename type, typename alloc_t, typename... args_t>
+inline type* createItem(alloc_t& allocator, args_t&&... args) {
+    type* const p = allocateItems<type>(allocator, 1);
+
+    try {
+        return new(p) type(std::forward<args_t>(args)...);
+    }
+    catch (...) {
+        deallocateItems(allocator, p, 1);
+        throw;
+    }
+}
+
+/**
+ *  Destroy and release an object made by createItem(). Null pointers are
+ *  ignored.
+ */
+template <typename type, typename alloc_t>
+inline void destroyItem(alloc_t& allocator, type* p) {
+    if (p != nullptr) {
+        p->~type();
+        deallocateItems(allocator, p, 1);
+    }
+}
+
+} /* end utils namespace */
+} /* end hamLibs namespace */
+
+#endif	/* __HL_ALLOCATOR_H__ */
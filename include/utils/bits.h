@@ -9,6 +9,7 @@
 #define	__HL_BITS_H__
 
 #include <climits>
+#include "../defs/preprocessor.h"
 #include "../utils/assert.h"
 
 #ifndef HL_BITS_PER_BYTE
@@ -20,6 +21,8 @@ namespace utils {
 
 /*
  *  Convenience structure to facilitate bit acquisition of bytes
+ *  Bit masks are read directly from the memory of other objects, so they
+ *  must be allowed to alias any type.
  */
 struct alignas(1) bitMask {
     char byte = 0;
@@ -31,7 +34,7 @@ struct alignas(1) bitMask {
     inline void set(int i, int val) {
         byte = (byte & ~(1 << i)) | (val << i);
     }
-};
+} HL_MAY_ALIAS;
 
 /*
  *  Functions allowing access to individual bytes
@@ -58,7 +61,7 @@ constexpr const bitMask* getByte(const char32_t*, unsigned);
  */
 template <typename key_t>
 constexpr const bitMask* getByte(const key_t* k, unsigned iter) {
-    return (iter < sizeof (k))
+    return (iter < sizeof (key_t))
             ? reinterpret_cast<const bitMask*> (k) + iter
             : nullptr;
 }
@@ -0,0 +1,148 @@
+/*
+ * File:   copy.h
+ * Author: hammy
+ *
+ * Bulk copying of object arrays.
+ */
+
+#ifndef __HL_COPY_H__
+#define	__HL_COPY_H__
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hamLibs {
+namespace utils {
+
+/**
+ * Item Copier
+ *
+ * Copies and moves arrays of objects for the containers. Types which are
+ * trivially copyable are copied with memcpy() or memmove(), which the
+ * compiler and C library turn into vectorized block copies. All other types
+ * are copied one element at a time through their constructors and
+ * assignment operators.
+ */
+template <typename type, bool = std::is_trivially_copyable< type >::value>
+struct itemCopier;
+
+/*
+ * Item Copier -- Trivially Copyable Types
+ */
+template <typename type>
+struct itemCopier<type, true> {
+    static void copy( type* dest, const type* src, std::size_t count ) {
+        if ( count ) {
+            std::memcpy( dest, src, count * sizeof( type ) );
+        }
+    }
+
+    static void move( type* dest, type* src, std::size_t count ) {
+        if ( count ) {
+            std::memmove( dest, src, count * sizeof( type ) );
+        }
+    }
+
+    static void construct( type* dest, const type* src, std::size_t count ) {
+        copy( dest, src, count );
+    }
+
+    static void relocate( type* dest, type* src, std::size_t count ) {
+        copy( dest, src, count );
+    }
+};
+
+/*
+ * Item Copier -- All Other Types
+ */
+template <typename type>
+struct itemCopier<type, false> {
+    static void copy( type* dest, const type* src, std::size_t count ) {
+        for ( std::size_t i = 0; i < count; ++i ) {
+            dest[ i ] = src[ i ];
+        }
+    }
+
+    static void move( type* dest, type* src, std::size_t count ) {
+        if ( dest < src ) {
+            for ( std::size_t i = 0; i < count; ++i ) {
+                dest[ i ] = std::move( src[ i ] );
+            }
+        }
+        else if ( dest > src ) {
+            while ( count-- ) {
+                dest[ count ] = std::move( src[ count ] );
+            }
+        }
+    }
+
+    static void construct( type* dest, const type* src, std::size_t count ) {
+        for ( std::size_t i = 0; i < count; ++i ) {
+            new( dest + i ) type( src[ i ] );
+        }
+    }
+
+    static void relocate( type* dest, type* src, std::size_t count ) {
+        for ( std::size_t i = 0; i < count; ++i ) {
+            new( dest + i ) type( std::move( src[ i ] ) );
+            src[ i ].~type();
+        }
+    }
+};
+
+/**
+ *  Copy-assign 'count' objects into an array of constructed objects. The
+ *  arrays must not overlap.
+ */
+template <typename type>
+inline void copyItems( type* dest, const type* src, std::size_t count ) {
+    itemCopier< type >::copy( dest, src, count );
+}
+
+/**
+ *  Move-assign 'count' objects into an array of constructed objects. The
+ *  arrays may overlap.
+ */
+template <typename type>
+inline void moveItems( type* dest, type* src, std::size_t count ) {
+    itemCopier< type >::move( dest, src, count );
+}
+
+/**
+ *  Copy-construct 'count' objects into uninitialized memory. The arrays must
+ *  not overlap.
+ */
+template <typename type>
+inline void constructItems( type* dest, const type* src, std::size_t count ) {
+    itemCopier< type >::construct( dest, src, count );
+}
+
+/**
+ *  Move 'count' objects into uninitialized memory, then destroy the
+ *  originals. The arrays must not overlap.
+ */
+template <typename type>
+inline void relocateItems( type* dest, type* src, std::size_t count ) {
+    itemCopier< type >::relocate( dest, src, count );
+}
+
+/**
+ *  Move 'value' into position 'index' of an array of 'count' constructed
+ *  objects, shifting the objects from 'index' onward up by one. The slot just
+ *  past the last object must be uninitialized memory, and 'index' must be
+ *  less than 'count'.
+ */
+template <typename type>
+inline void insertItem( type* items, std::size_t count, std::size_t index, type&& value ) {
+    new( items + count ) type( std::move( items[ count-1 ] ) );
+    moveItems( items + index + 1, items + index, count - 1 - index );
+    items[ index ] = std::move( value );
+}
+
+} // end utils namespace
+} // end hamLibs namespace
+
+#endif	/* __HL_COPY_H__ */
@@ -0,0 +1,149 @@
+/*
+ * File:   iterators.h
+ * Author: hammy
+ *
+ * Generic iterators shared by the hamLibs containers.
+ */
+
+#ifndef __HL_ITERATORS_H__
+#define	__HL_ITERATORS_H__
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace hamLibs {
+namespace utils {
+
+/**
+ * Node Iterator
+ *
+ * Walks the nodes of a linked container through their 'next' pointers, and
+ * their 'prev' pointers when 'category_t' is bidirectional. Nodes must hold
+ * their element in a member named 'data'. The end of a container is whatever
+ * node follows its last one, either nullptr or a sentinel node.
+ *
+ * An iterator only holds a node pointer, so any number of them can walk the
+ * same container at once without touching its state. Iterators convert to
+ * their const counterparts, but not back.
+ */
+template <typename node_t, typename value_t, typename category_t = std::forward_iterator_tag>
+class nodeIterator {
+    template <typename, typename, typename>
+    friend class nodeIterator;
+
+    private:
+        node_t* node;
+
+    public:
+        typedef category_t                              iterator_category;
+        typedef typename std::remove_const<value_t>::type value_type;
+        typedef std::ptrdiff_t                          difference_type;
+        typedef value_t*                                pointer;
+        typedef value_t&                                reference;
+
+        nodeIterator() : node{nullptr} {}
+        explicit nodeIterator(node_t* n) : node{n} {}
+
+        template <
+            typename other_t,
+            typename = typename std::enable_if<std::is_convertible<other_t*, value_t*>::value>::type
+        >
+        nodeIterator(const nodeIterator<node_t, other_t, category_t>& i) : node{i.node} {}
+
+        value_t&        operator*   () const { return node->data; }
+        value_t*        operator->  () const { return &node->data; }
+
+        nodeIterator&   operator++  ()      { node = node->next; return *this; }
+        nodeIterator    operator++  (int)   { nodeIterator temp(*this); node = node->next; return temp; }
+        nodeIterator&   operator--  ()      { node = node->prev; return *this; }
+        nodeIterator    operator--  (int)   { nodeIterator temp(*this); node = node->prev; return temp; }
+
+        template <typename other_t>
+        bool operator== (const nodeIterator<node_t, other_t, category_t>& i) const { return node == i.node; }
+        template <typename other_t>
+        bool operator!= (const nodeIterator<node_t, other_t, category_t>& i) const { return node != i.node; }
+
+        /**
+         *  Retrieve the node an iterator refers to, so that containers can
+         *  insert or remove elements at it.
+         */
+        node_t* getNode() const { return node; }
+};
+
+/**
+ * Index Iterator
+ *
+ * Random-access iterator for containers which can be indexed, but whose
+ * elements are not contiguous in memory. Each dereference goes through the
+ * container's operator[]. Iterators convert to their const counterparts,
+ * but not back.
+ */
+template <typename container_t, typename value_t>
+class indexIterator {
+    template <typename, typename>
+    friend class indexIterator;
+
+    private:
+        container_t*    container;
+        int             index;
+
+    public:
+        typedef std::random_access_iterator_tag         iterator_category;
+        typedef typename std::remove_const<value_t>::type value_type;
+        typedef std::ptrdiff_t                          difference_type;
+        typedef value_t*                                pointer;
+        typedef value_t&                                reference;
+
+        indexIterator() : container{nullptr}, index{0} {}
+        indexIterator(container_t* c, int i) : container{c}, index{i} {}
+
+        template <
+            typename other_t,
+            typename other_value_t,
+            typename = typename std::enable_if<std::is_convertible<other_t*, container_t*>::value>::type
+        >
+        indexIterator(const indexIterator<other_t, other_value_t>& i) : container{i.container}, index{i.index} {}
+
+        value_t&        operator*   () const { return (*container)[index]; }
+        value_t*        operator->  () const { return &(*container)[index]; }
+        value_t&        operator[]  (difference_type n) const { return (*container)[index + int(n)]; }
+
+        indexIterator&  operator++  ()      { ++index; return *this; }
+        indexIterator   operator++  (int)   { indexIterator temp(*this); ++index; return temp; }
+        indexIterator&  operator--  ()      { --index; return *this; }
+        indexIterator   operator--  (int)   { indexIterator temp(*this); --index; return temp; }
+
+        indexIterator&  operator+=  (difference_type n)         { index += int(n); return *this; }
+        indexIterator&  operator-=  (difference_type n)         { index -= int(n); return *this; }
+        indexIterator   operator+   (difference_type n) const   { return indexIterator(container, index + int(n)); }
+        indexIterator   operator-   (difference_type n) const   { return indexIterator(container, index - int(n)); }
+
+        friend indexIterator operator+ (difference_type n, const indexIterator& i) { return i + n; }
+
+        template <typename other_t, typename other_value_t>
+        difference_type operator-   (const indexIterator<other_t, other_value_t>& i) const { return index - i.index; }
+
+        template <typename other_t, typename other_value_t>
+        bool operator== (const indexIterator<other_t, other_value_t>& i) const { return index == i.index; }
+        template <typename other_t, typename other_value_t>
+        bool operator!= (const indexIterator<other_t, other_value_t>& i) const { return index != i.index; }
+        template <typename other_t, typename other_value_t>
+        bool operator<  (const indexIterator<other_t, other_value_t>& i) const { return index < i.index; }
+        template <typename other_t, typename other_value_t>
+        bool operator>  (const indexIterator<other_t, other_value_t>& i) const { return index > i.index; }
+        template <typename other_t, typename other_value_t>
+        bool operator<= (const indexIterator<other_t, other_value_t>& i) const { return index <= i.index; }
+        template <typename other_t, typename other_value_t>
+        bool operator>= (const indexIterator<other_t, other_value_t>& i) const { return index >= i.index; }
+
+        /**
+         *  Retrieve the index an iterator refers to.
+         */
+        int getIndex() const { return index; }
+};
+
+} /* end utils namespace */
+} /* end hamLibs namespace */
+
+#endif	/* __HL_ITERATORS_H__ */
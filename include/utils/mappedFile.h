@@ -0,0 +1,68 @@
+/*
+ * File:   mappedFile.h
+ * Author: hammy
+ *
+ * Read-only memory mapping of files.
+ */
+
+#ifndef __HL_MAPPED_FILE_H__
+#define __HL_MAPPED_FILE_H__
+
+#include <cstddef>
+#include "../defs/preprocessor.h"
+
+namespace hamLibs {
+namespace utils {
+
+/**
+ * Mapped File
+ *
+ * Maps the entire contents of a file into the address space of the process
+ * for reading. Pages are loaded by the operating system as they are touched,
+ * so opening a file costs the same regardless of its size.
+ *
+ * POSIX systems use mmap(). Windows uses CreateFileMapping() and
+ * MapViewOfFile().
+ */
+class mappedFile {
+    private:
+        const void*     pData       = nullptr;
+        std::size_t     numBytes    = 0;
+
+    #ifdef HL_OS_WINDOWS
+        void*           hFile       = nullptr;
+        void*           hMapping    = nullptr;
+    #endif
+
+    public:
+        mappedFile      () {}
+        mappedFile      ( const mappedFile& ) = delete;
+        mappedFile      ( mappedFile&& );
+
+        ~mappedFile     () { close(); }
+
+        mappedFile&     operator=   ( const mappedFile& ) = delete;
+        mappedFile&     operator=   ( mappedFile&& );
+
+        /**
+         *  Map a file into memory, closing any file which was already open.
+         *
+         *  @return true if the file was mapped, false if not. Empty files
+         *  cannot be mapped.
+         */
+        bool            open        ( const char* filename );
+
+        /**
+         *  Unmap the current file.
+         */
+        void            close       ();
+
+        bool            isOpen      () const { return pData != nullptr; }
+        const void*     data        () const { return pData; }
+        std::size_t     size        () const { return numBytes; }
+};
+
+} // end utils namespace
+} // end hamLibs namespace
+
+#endif  /* __HL_MAPPED_FILE_H__ */
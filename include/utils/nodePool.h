@@ -0,0 +1,285 @@
+/*
+ * File:   nodePool.h
+ * Author: hammy
+ *
+ * Fixed-size object pool used by node-based containers.
+ */
+
+#ifndef __HL_NODE_POOL_H__
+#define	__HL_NODE_POOL_H__
+
+#include <cstddef>
+#include <utility>
+
+#include "allocator.h"
+
+namespace hamLibs {
+namespace utils {
+
+/**
+ * Node Pool
+ *
+ * Memory for objects of a single type is reserved from the heap in blocks of
+ * 'blockSize' slots. Slots are handed out one at a time, and released slots
+ * are kept in a freelist so they can be reused without touching the heap
+ * again. All blocks are returned to the heap at once when the pool is cleared
+ * or destroyed. One pool can absorb the blocks of another, after which slots
+ * from either pool may be released to the survivor.
+ *
+ * The pool only manages raw memory. Objects must be constructed in the
+ * returned slots using placement-new, and destroyed before being released.
+ * Blocks are reserved through 'alloc_t' (see allocator.h).
+ */
+template <typename type, unsigned blockSize = 256, typename alloc_t = heapAllocator>
+class nodePool {
+    private:
+        union poolSlot {
+            poolSlot* next;
+            alignas(type) unsigned char storage[ sizeof(type) ];
+        };
+
+        struct poolBlock {
+            poolBlock*  next;
+            poolSlot    slots[ blockSize ];
+        };
+
+        alloc_t     allocator;
+        poolBlock*  blocks      = nullptr; // newest block first
+        poolBlock*  lastBlock   = nullptr;
+        poolSlot*   freeSlots   = nullptr;
+        poolSlot*   lastFree    = nullptr;
+        unsigned    numFresh    = 0; // slots never used in the newest block
+        unsigned    numBlocks   = 0;
+        unsigned    numUsed     = 0;
+
+    public:
+        /**
+         *  Constructor
+         *  No memory is reserved until the first call to allocate().
+         */
+        constexpr nodePool() {}
+
+        /**
+         *  Constructor
+         *  Blocks will be reserved from 'a'.
+         */
+        explicit nodePool(const alloc_t& a) :
+            allocator{a}
+        {}
+
+        nodePool(const nodePool&) = delete;
+
+        /**
+         *  Move Constructor
+         *  Takes ownership of all blocks held by another pool.
+         */
+        nodePool(nodePool&& np) :
+            allocator{std::move(np.allocator)},
+            blocks{np.blocks},
+            lastBlock{np.lastBlock},
+            freeSlots{np.freeSlots},
+            lastFree{np.lastFree},
+            numFresh{np.numFresh},
+            numBlocks{np.numBlocks},
+            numUsed{np.numUsed}
+        {
+            np.blocks = np.lastBlock = nullptr;
+            np.freeSlots = np.lastFree = nullptr;
+            np.numFresh = np.numBlocks = np.numUsed = 0;
+        }
+
+        /**
+         *  Destructor
+         *  Returns all blocks to the allocator.
+         */
+        ~nodePool() {
+            clear();
+        }
+
+        nodePool& operator=(const nodePool&) = delete;
+
+        /**
+         *  Move Operator
+         *  Frees all blocks held by *this, then takes ownership of the blocks
+         *  held by another pool.
+         */
+        nodePool& operator=(nodePool&& np) {
+            if (this != &np) {
+                clear();
+
+                allocator = std::move(np.allocator);
+                blocks = np.blocks;
+                lastBlock = np.lastBlock;
+                freeSlots = np.freeSlots;
+                lastFree = np.lastFree;
+                numFresh = np.numFresh;
+                numBlocks = np.numBlocks;
+                numUsed = np.numUsed;
+
+                np.blocks = np.lastBlock = nullptr;
+                np.freeSlots = np.lastFree = nullptr;
+                np.numFresh = np.numBlocks = np.numUsed = 0;
+            }
+
+            return *this;
+        }
+
+        /**
+         *  Reserve memory for a single object.
+         *
+         *  @return A pointer to uninitialized memory large enough to hold an
+         *  object of type 'type'.
+         */
+        type* allocate() {
+            poolSlot* slot = freeSlots;
+
+            if (slot != nullptr) {
+                freeSlots = slot->next;
+            }
+            else {
+                if (numFresh == 0) {
+                    poolBlock* block = allocateItems<poolBlock>(allocator, 1);
+                    if (blocks == nullptr) {
+                        lastBlock = block;
+                    }
+                    block->next = blocks;
+                    blocks = block;
+                    numFresh = blockSize;
+                    ++numBlocks;
+                }
+
+                slot = &blocks->slots[blockSize - numFresh];
+                --numFresh;
+            }
+
+            ++numUsed;
+            return reinterpret_cast<type*>(slot->storage);
+        }
+
+        /**
+         *  Return a slot to the pool so it can be reused by allocate().
+         *
+         *  @param p
+         *  A pointer which was returned by allocate(). The object contained
+         *  at this address must have already been destroyed.
+         */
+        void deallocate(type* p) {
+            poolSlot* slot = reinterpret_cast<poolSlot*>(p);
+            if (freeSlots == nullptr) {
+                lastFree = slot;
+            }
+            slot->next = freeSlots;
+            freeSlots = slot;
+            --numUsed;
+        }
+
+        /**
+         *  Take ownership of every block held by another pool, leaving it
+         *  empty. Objects living in those blocks are unaffected, and their
+         *  slots may later be released to *this. This takes constant time.
+         *
+         *  @param np
+         *  A pool whose allocator compares equal to the allocator of *this.
+         */
+        void absorb(nodePool& np) {
+            if (this == &np || np.blocks == nullptr) {
+                return;
+            }
+
+            if (blocks == nullptr) {
+                blocks = np.blocks;
+                lastBlock = np.lastBlock;
+                numFresh = np.numFresh;
+            }
+            else {
+                // only the newest block may hold fresh slots, so those of
+                // the other pool are moved to its freelist
+                while (np.numFresh) {
+                    poolSlot* slot = &np.blocks->slots[blockSize - np.numFresh];
+                    if (np.freeSlots == nullptr) {
+                        np.lastFree = slot;
+                    }
+                    slot->next = np.freeSlots;
+                    np.freeSlots = slot;
+                    --np.numFresh;
+                }
+
+                np.lastBlock->next = blocks->next;
+                blocks->next = np.blocks;
+                if (lastBlock == blocks) {
+                    lastBlock = np.lastBlock;
+                }
+            }
+
+            if (np.freeSlots != nullptr) {
+                np.lastFree->next = freeSlots;
+                if (freeSlots == nullptr) {
+                    lastFree = np.lastFree;
+                }
+                freeSlots = np.freeSlots;
+            }
+
+            numBlocks += np.numBlocks;
+            numUsed += np.numUsed;
+
+            np.blocks = np.lastBlock = nullptr;
+            np.freeSlots = np.lastFree = nullptr;
+            np.numFresh = np.numBlocks = np.numUsed = 0;
+        }
+
+        /**
+         *  Return all memory held by the pool to its allocator. No destructors
+         *  are run for objects still living in the pool.
+         */
+        void clear() {
+            while (blocks != nullptr) {
+                poolBlock* next = blocks->next;
+                deallocateItems(allocator, blocks, 1);
+                blocks = next;
+            }
+
+            lastBlock = nullptr;
+            freeSlots = lastFree = nullptr;
+            numFresh = numBlocks = numUsed = 0;
+        }
+
+        /**
+         *  @return The allocator which blocks are reserved from.
+         */
+        alloc_t& getAllocator() {
+            return allocator;
+        }
+
+        /**
+         *  @return The allocator which blocks are reserved from.
+         */
+        const alloc_t& getAllocator() const {
+            return allocator;
+        }
+
+        /**
+         *  @return The number of slots currently handed out by the pool.
+         */
+        unsigned size() const {
+            return numUsed;
+        }
+
+        /**
+         *  @return The number of heap allocations currently held by the pool.
+         */
+        unsigned numAllocations() const {
+            return numBlocks;
+        }
+
+        /**
+         *  @return The number of bytes currently reserved from the heap.
+         */
+        std::size_t numBytes() const {
+            return numBlocks * sizeof(poolBlock);
+        }
+};
+
+} /* end utils namespace */
+} /* end hamLibs namespace */
+
+#endif	/* __HL_NODE_POOL_H__ */
@@ -0,0 +1,339 @@
+/*
+ * File:   parallel.h
+ * Author: hammy
+ *
+ * Data-parallel algorithms which run on a workerPool.
+ */
+
+#ifndef __HL_PARALLEL_H__
+#define	__HL_PARALLEL_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "workerPool.h"
+
+namespace hamLibs {
+namespace utils {
+
+/**
+ * Parallel Algorithms
+ *
+ * Each algorithm works on a plain array of elements, such as the data() and
+ * size() of a containers::array, and splits it into chunks of at least
+ * 'grainSize' elements which are processed by the threads of a workerPool.
+ * Smaller grains balance uneven work better, larger grains cost less to
+ * schedule. Arrays smaller than a single grain are processed on the calling
+ * thread.
+ *
+ *      hamLibs::utils::workerPool pool;
+ *      hamLibs::containers::array< float > a( 1 << 24 );
+ *      hamLibs::utils::parallelSort( pool, a.data(), a.size() );
+ *
+ * Operations passed to parallelReduce() and parallelInclusiveScan() must be
+ * associative, since partial results are combined in a different grouping
+ * than a serial loop would use.
+ */
+enum : std::size_t {
+    PARALLEL_GRAIN_SIZE = 16384
+};
+
+/*
+ * Parallel Helpers
+ */
+namespace parallelImpl {
+
+// The number of chunks an array is split into, and the bounds of each one
+inline unsigned numChunks( std::size_t count, std::size_t grainSize, unsigned maxChunks = ~0u ) {
+    const std::size_t grain = grainSize ? grainSize : 1;
+    const std::size_t n = (count + grain - 1) / grain;
+    return n < maxChunks ? static_cast< unsigned >( n ) : maxChunks;
+}
+
+inline std::size_t chunkBegin( std::size_t count, unsigned chunk, unsigned numChunks ) {
+    return count * chunk / numChunks;
+}
+
+/*
+ * Count how many of the first 'k' elements of a stable merge of 'a' and 'b'
+ * come from 'a'. Equal elements are taken from 'a' first.
+ */
+template <typename type, typename compare_t>
+std::size_t coRank(
+    std::size_t k,
+    const type* a, std::size_t na,
+    const type* b, std::size_t nb,
+    compare_t& comp
+) {
+    std::size_t lo = k > nb ? k - nb : 0;
+    std::size_t hi = k < na ? k : na;
+
+    for ( ;; ) {
+        const std::size_t i = lo + (hi - lo) / 2;
+        const std::size_t j = k - i;
+
+        if ( i > 0 && j < nb && comp( b[ j ], a[ i-1 ] ) ) {
+            hi = i - 1;
+        }
+        else if ( j > 0 && i < na && !comp( b[ j-1 ], a[ i ] ) ) {
+            lo = i + 1;
+        }
+        else {
+            return i;
+        }
+    }
+}
+
+/*
+ * One piece of a merge between two sorted runs. Pieces of the same merge
+ * write to disjoint parts of the output.
+ */
+template <typename type>
+struct mergeTask {
+    type*       a;
+    std::size_t na;
+    type*       b;
+    std::size_t nb;
+    type*       dst;
+    std::size_t first; // range of output positions handled
+    std::size_t last;
+};
+
+/*
+ * Sort chunks of an array independently, then merge pairs of sorted runs
+ * until one is left. Each merge is itself split into pieces so every round
+ * keeps all threads busy.
+ */
+template <typename type, typename compare_t>
+void sort( workerPool& pool, type* data, std::size_t count, compare_t comp, std::size_t grainSize, bool stable ) {
+    const unsigned numRuns = numChunks( count, grainSize, pool.concurrency() );
+
+    if ( numRuns <= 1 ) {
+        if ( stable ) {
+            std::stable_sort( data, data + count, comp );
+        }
+        else {
+            std::sort( data, data + count, comp );
+        }
+        return;
+    }
+
+    pool.run( numRuns, [&]( unsigned r ) {
+        type* const first = data + chunkBegin( count, r, numRuns );
+        type* const last = data + chunkBegin( count, r+1, numRuns );
+
+        if ( stable ) {
+            std::stable_sort( first, last, comp );
+        }
+        else {
+            std::sort( first, last, comp );
+        }
+    } );
+
+    // Runs are merged back and forth between the array and a buffer
+    std::vector< type > buffer( data, data + count );
+    std::vector< mergeTask< type > > tasks;
+    type* src = data;
+    type* dst = buffer.data();
+
+    for ( unsigned width = 1; width < numRuns; width *= 2 ) {
+        tasks.clear();
+
+        for ( unsigned r = 0; r < numRuns; r += 2*width ) {
+            const std::size_t first = chunkBegin( count, r, numRuns );
+            const std::size_t mid = chunkBegin( count, std::min( r + width, numRuns ), numRuns );
+            const std::size_t last = chunkBegin( count, std::min( r + 2*width, numRuns ), numRuns );
+            const unsigned numPieces = numChunks( last - first, grainSize );
+
+            for ( unsigned p = 0; p < numPieces; ++p ) {
+                tasks.push_back( mergeTask< type >{
+                    src + first, mid - first,
+                    src + mid, last - mid,
+                    dst + first,
+                    chunkBegin( last - first, p, numPieces ),
+                    chunkBegin( last - first, p+1, numPieces )
+                } );
+            }
+        }
+
+        pool.run( static_cast< unsigned >( tasks.size() ), [&]( unsigned t ) {
+            const mergeTask< type >& task = tasks[ t ];
+            const std::size_t i0 = coRank( task.first, task.a, task.na, task.b, task.nb, comp );
+            const std::size_t i1 = coRank( task.last, task.a, task.na, task.b, task.nb, comp );
+            const std::size_t j0 = task.first - i0;
+            const std::size_t j1 = task.last - i1;
+
+            std::merge(
+                std::make_move_iterator( task.a + i0 ), std::make_move_iterator( task.a + i1 ),
+                std::make_move_iterator( task.b + j0 ), std::make_move_iterator( task.b + j1 ),
+                task.dst + task.first,
+                comp
+            );
+        } );
+
+        std::swap( src, dst );
+    }
+
+    if ( src != data ) {
+        const unsigned numCopies = numChunks( count, grainSize );
+
+        pool.run( numCopies, [&]( unsigned c ) {
+            const std::size_t first = chunkBegin( count, c, numCopies );
+            const std::size_t last = chunkBegin( count, c+1, numCopies );
+            std::move( src + first, src + last, data + first );
+        } );
+    }
+}
+
+} /* end parallelImpl namespace */
+
+/**
+ *  Call 'func( data[ i ] )' for every element of an array.
+ */
+template <typename type, typename func_t>
+void parallelForEach(
+    workerPool& pool, type* data, std::size_t count, func_t func,
+    std::size_t grainSize = PARALLEL_GRAIN_SIZE
+) {
+    const unsigned numChunks = parallelImpl::numChunks( count, grainSize );
+
+    pool.run( numChunks, [&]( unsigned c ) {
+        const std::size_t last = parallelImpl::chunkBegin( count, c+1, numChunks );
+
+        for ( std::size_t i = parallelImpl::chunkBegin( count, c, numChunks ); i < last; ++i ) {
+            func( data[ i ] );
+        }
+    } );
+}
+
+/**
+ *  Store 'func( in[ i ] )' into 'out[ i ]' for every element of an array.
+ *  'in' and 'out' may be the same array.
+ */
+template <typename in_t, typename out_t, typename func_t>
+void parallelTransform(
+    workerPool& pool, const in_t* in, std::size_t count, out_t* out, func_t func,
+    std::size_t grainSize = PARALLEL_GRAIN_SIZE
+) {
+    const unsigned numChunks = parallelImpl::numChunks( count, grainSize );
+
+    pool.run( numChunks, [&]( unsigned c ) {
+        const std::size_t last = parallelImpl::chunkBegin( count, c+1, numChunks );
+
+        for ( std::size_t i = parallelImpl::chunkBegin( count, c, numChunks ); i < last; ++i ) {
+            out[ i ] = func( in[ i ] );
+        }
+    } );
+}
+
+/**
+ *  Combine every element of an array, and 'init', using 'op'.
+ *
+ *  @return op( init, op( data[ 0 ], op( data[ 1 ], ... ) ) ), grouped in an
+ *  unspecified order.
+ */
+template <typename type, typename op_t = std::plus< type > >
+type parallelReduce(
+    workerPool& pool, const type* data, std::size_t count, type init, op_t op = op_t(),
+    std::size_t grainSize = PARALLEL_GRAIN_SIZE
+) {
+    const unsigned numChunks = parallelImpl::numChunks( count, grainSize );
+    std::vector< type > partials( numChunks, init );
+
+    pool.run( numChunks, [&]( unsigned c ) {
+        const std::size_t first = parallelImpl::chunkBegin( count, c, numChunks );
+        const std::size_t last = parallelImpl::chunkBegin( count, c+1, numChunks );
+        type acc = data[ first ];
+
+        for ( std::size_t i = first+1; i < last; ++i ) {
+            acc = op( acc, data[ i ] );
+        }
+
+        partials[ c ] = std::move( acc );
+    } );
+
+    for ( unsigned c = 0; c < numChunks; ++c ) {
+        init = op( init, partials[ c ] );
+    }
+
+    return init;
+}
+
+/**
+ *  Store the running combination of an array into 'out', so that 'out[ i ]'
+ *  holds op( in[ 0 ], ..., in[ i ] ). 'in' and 'out' may be the same array.
+ *
+ *  Chunks are scanned independently, then each chunk is offset by the total
+ *  of the chunks before it. Every element is visited twice.
+ */
+template <typename type, typename op_t = std::plus< type > >
+void parallelInclusiveScan(
+    workerPool& pool, const type* in, std::size_t count, type* out, op_t op = op_t(),
+    std::size_t grainSize = PARALLEL_GRAIN_SIZE
+) {
+    const unsigned numChunks = parallelImpl::numChunks( count, grainSize );
+
+    if ( !numChunks ) {
+        return;
+    }
+
+    pool.run( numChunks, [&]( unsigned c ) {
+        const std::size_t first = parallelImpl::chunkBegin( count, c, numChunks );
+        const std::size_t last = parallelImpl::chunkBegin( count, c+1, numChunks );
+
+        out[ first ] = in[ first ];
+        for ( std::size_t i = first+1; i < last; ++i ) {
+            out[ i ] = op( out[ i-1 ], in[ i ] );
+        }
+    } );
+
+    // offsets[ c ] holds the total of every chunk before chunk c+1
+    std::vector< type > offsets;
+    offsets.reserve( numChunks );
+    offsets.push_back( out[ parallelImpl::chunkBegin( count, 1, numChunks ) - 1 ] );
+
+    for ( unsigned c = 1; c+1 < numChunks; ++c ) {
+        const std::size_t last = parallelImpl::chunkBegin( count, c+1, numChunks );
+        offsets.push_back( op( offsets.back(), out[ last-1 ] ) );
+    }
+
+    pool.run( numChunks-1, [&]( unsigned c ) {
+        const std::size_t first = parallelImpl::chunkBegin( count, c+1, numChunks );
+        const std::size_t last = parallelImpl::chunkBegin( count, c+2, numChunks );
+
+        for ( std::size_t i = first; i < last; ++i ) {
+            out[ i ] = op( offsets[ c ], out[ i ] );
+        }
+    } );
+}
+
+/**
+ *  Sort an array. The order of equal elements is unspecified.
+ */
+template <typename type, typename compare_t = std::less< type > >
+void parallelSort(
+    workerPool& pool, type* data, std::size_t count, compare_t comp = compare_t(),
+    std::size_t grainSize = PARALLEL_GRAIN_SIZE
+) {
+    parallelImpl::sort( pool, data, count, comp, grainSize, false );
+}
+
+/**
+ *  Sort an array, keeping equal elements in their original order.
+ */
+template <typename type, typename compare_t = std::less< type > >
+void parallelStableSort(
+    workerPool& pool, type* data, std::size_t count, compare_t comp = compare_t(),
+    std::size_t grainSize = PARALLEL_GRAIN_SIZE
+) {
+    parallelImpl::sort( pool, data, count, comp, grainSize, true );
+}
+
+} /* end utils namespace */
+} /* end hamLibs namespace */
+
+#endif	/* __HL_PARALLEL_H__ */
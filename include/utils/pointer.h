@@ -11,6 +11,8 @@
 #include <new>
 
 #include "../defs/preprocessor.h"
+#include "allocator.h"
+#include "copy.h"
 
 namespace hamLibs {
 namespace utils {
@@ -23,13 +25,55 @@ namespace utils {
  * without having to worry about the hassle of calling 'new' or delete'. After
  * looking at the implementation of std::unique_ptr from g++, I made this class
  * in order to better suit my needs in other projects.
+ * 
+ * Memory is reserved through 'alloc_t' (see allocator.h). The allocator is
+ * inherited privately so that stateless allocators add nothing to the size of
+ * a pointer.
  */
-template <typename data_t>
-class pointer {
+template <typename data_t, typename alloc_t = heapAllocator>
+class pointer : private alloc_t {
     private:
         data_t* pData = nullptr;
         unsigned count = 0;
         
+        /*
+         * Allocate and default-construct 'numElements' objects. Allocation
+         * failures are reported by returning NULL.
+         */
+        data_t* create(unsigned numElements) {
+            data_t* p = nullptr;
+            
+            try {
+                p = allocateItems<data_t>(getAllocator(), numElements);
+            }
+            catch (const std::bad_alloc&) {
+                return nullptr;
+            }
+            
+            unsigned i = 0;
+            try {
+                for (; i < numElements; ++i) {
+                    new(p+i) data_t;
+                }
+            }
+            catch (...) {
+                destroy(p, i);
+                throw;
+            }
+            
+            return p;
+        }
+        
+        /*
+         * Destroy and release objects made by create().
+         */
+        void destroy(data_t* p, unsigned numElements) {
+            for (unsigned i = 0; i < numElements; ++i) {
+                p[i].~data_t();
+            }
+            deallocateItems(getAllocator(), p, numElements);
+        }
+        
     public:
         /**
          *  Constructor
@@ -43,8 +87,9 @@ class pointer {
          *  @param numElements
          *  Determines the number of items in the array.
          */
-        explicit pointer(unsigned numElements) :
-            pData{numElements > 0 ? new(std::nothrow) data_t[numElements] : nullptr},
+        explicit pointer(unsigned numElements, const alloc_t& a = alloc_t()) :
+            alloc_t(a),
+            pData{create(numElements)},
             count{pData != nullptr ? numElements : 0}
         {}
         
@@ -59,6 +104,15 @@ class pointer {
          */
         constexpr pointer() {}
         
+        /**
+         *  Constructor
+         *  Initializes 'pData' to NULL and 'count' to 0. Any memory reserved
+         *  later on will come from 'a'.
+         */
+        explicit pointer(const alloc_t& a) :
+            alloc_t(a)
+        {}
+        
         /**
          *  Copy Constructor
          *  Dynamically create an array of 'data_t' elements and copy the data
@@ -75,13 +129,12 @@ class pointer {
          *  Determines the number of items in the array.
          */
         explicit pointer(const pointer& p) :
-            pData{new(std::nothrow) data_t[p.count]},
+            alloc_t(p.getAllocator()),
+            pData{create(p.count)},
             count{pData != nullptr ? p.count : 0}
         {
-            // Only loops if pData had successfully allocated memory.
-            for (unsigned i = 0; i < count; ++i) {
-                pData[i] = p.pData[i];
-            }
+            // Only copies if pData had successfully allocated memory.
+            copyItems(pData, p.pData, count);
         }
         
         /**
@@ -95,6 +148,7 @@ class pointer {
          *  Determines the number of items in the array.
          */
         explicit pointer(pointer&& p) :
+            alloc_t(p.getAllocator()),
             pData{p.pData},
             count{p.count}
         {
@@ -107,7 +161,7 @@ class pointer {
          *  Frees all memory used by *this
          */
         ~pointer() {
-            delete [] pData;
+            destroy(pData, count);
             pData = nullptr;
             count = 0;
         }
@@ -130,17 +184,18 @@ class pointer {
          *  @return a reference to *this.
          */
         pointer& operator=(const pointer& p) {
-            if (pData != nullptr) {
-                delete [] pData;
+            if (this == &p) {
+                return *this;
             }
             
-            pData = new(std::nothrow) data_t[p.count];
+            destroy(pData, count);
+            getAllocator() = p.getAllocator();
+            
+            pData = create(p.count);
             count = pData != nullptr ? p.count : 0;
             
-            // Only loops if pData had successfully allocated memory.
-            for (unsigned i = 0; i < count; ++i) {
-                pData[i] = p.pData[i];
-            }
+            // Only copies if pData had successfully allocated memory.
+            copyItems(pData, p.pData, count);
             
             return *this;
         }
@@ -158,10 +213,13 @@ class pointer {
          *  @return a reference to *this.
          */
         pointer& operator=(pointer&& p) {
-            if (pData != nullptr) {
-                delete [] pData;
+            if (this == &p) {
+                return *this;
             }
             
+            destroy(pData, count);
+            getAllocator() = p.getAllocator();
+            
             pData = p.pData;
             p.pData = nullptr;
             
@@ -249,6 +307,20 @@ class pointer {
         inline unsigned size() const {
             return count;
         }
+        
+        /**
+         *  @return The allocator which reserved the memory for 'pData'.
+         */
+        inline alloc_t& getAllocator() {
+            return *this;
+        }
+        
+        /**
+         *  @return The allocator which reserved the memory for 'pData'.
+         */
+        inline const alloc_t& getAllocator() const {
+            return *this;
+        }
 };
 
 HL_DECLARE_CLASS_TYPE(void_ptr, pointer, void*);
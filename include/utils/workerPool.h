@@ -0,0 +1,115 @@
+/*
+ * File:   workerPool.h
+ * Author: hammy
+ *
+ * Fixed set of threads which run batches of tasks.
+ */
+
+#ifndef __HL_WORKER_POOL_H__
+#define	__HL_WORKER_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hamLibs {
+namespace utils {
+
+/**
+ * Worker Pool
+ *
+ * Runs batches of numbered tasks across a fixed set of threads. The thread
+ * which submits a batch works on it as well, and returns once every task in
+ * the batch has finished. Tasks are handed out one at a time from a shared
+ * counter, so uneven tasks are balanced across threads automatically.
+ *
+ * Only one batch runs at a time. Batches submitted from inside a task are
+ * run on the calling thread rather than waiting for the pool, which would
+ * otherwise deadlock.
+ */
+class workerPool {
+    private:
+        /*
+         * A batch of tasks. Batches live on the stack of the thread which
+         * submitted them.
+         */
+        struct batch {
+            void                    (*pTask)( void*, unsigned );
+            void*                   pContext;
+            unsigned                numTasks;
+            std::atomic< unsigned > nextTask;
+            std::atomic< unsigned > numDone;
+            std::exception_ptr      error;
+            std::mutex              errorLock;
+        };
+
+        std::vector< std::thread >  workers;
+        std::mutex                  submitLock; // serializes calls to run()
+        std::mutex                  stateLock;
+        std::condition_variable     wakeWorkers;
+        std::condition_variable     wakeCaller;
+        batch*                      pBatch      = nullptr;
+        unsigned long               generation  = 0;
+        unsigned                    numActive   = 0; // workers inside a batch
+        bool                        stopping    = false;
+
+        static void     work        ( batch& b );
+        void            workerLoop  ();
+        void            runBatch    ( void (*pTask)( void*, unsigned ), void* pContext, unsigned numTasks );
+
+    public:
+        /**
+         *  Constructor
+         *  Start 'numThreads'-1 worker threads. The thread calling run()
+         *  makes up the last one.
+         *
+         *  @param numThreads
+         *  The total number of threads which work on each batch. A value of
+         *  0 uses every hardware thread.
+         */
+        explicit workerPool( unsigned numThreads = 0 );
+
+        workerPool( const workerPool& ) = delete;
+        workerPool( workerPool&& ) = delete;
+
+        /**
+         *  Destructor
+         *  Stops and joins all worker threads.
+         */
+        ~workerPool();
+
+        workerPool& operator=( const workerPool& ) = delete;
+        workerPool& operator=( workerPool&& ) = delete;
+
+        /**
+         *  @return The number of threads which work on each batch, including
+         *  the caller of run().
+         */
+        unsigned concurrency() const { return static_cast< unsigned >( workers.size() ) + 1; }
+
+        /**
+         *  Call 'task( i )' for every 'i' in [0, numTasks), using all threads
+         *  of the pool, and wait for them to finish.
+         *
+         *  If a task throws, the remaining tasks are still run and the first
+         *  exception is rethrown here.
+         */
+        template <typename func_t>
+        void run( unsigned numTasks, func_t&& task ) {
+            typedef typename std::remove_reference< func_t >::type task_t;
+
+            runBatch(
+                []( void* pContext, unsigned i ) { (*static_cast< task_t* >( pContext ))( i ); },
+                const_cast< void* >( static_cast< const void* >( &task ) ), numTasks
+            );
+        }
+};
+
+} /* end utils namespace */
+} /* end hamLibs namespace */
+
+#endif	/* __HL_WORKER_POOL_H__ */
@@ -35,10 +35,12 @@ OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
 
 # Object Files
 OBJECTFILES= \
+	${OBJECTDIR}/src/allocator.o \
 	${OBJECTDIR}/src/assert.o \
 	${OBJECTDIR}/src/bits.o \
 	${OBJECTDIR}/src/fixed.o \
 	${OBJECTDIR}/src/logger.o \
+	${OBJECTDIR}/src/mappedFile.o \
 	${OBJECTDIR}/src/mat_utils.o \
 	${OBJECTDIR}/src/math.o \
 	${OBJECTDIR}/src/matrix2.o \
@@ -53,7 +55,8 @@ OBJECTFILES= \
 	${OBJECTDIR}/src/vec2.o \
 	${OBJECTDIR}/src/vec3.o \
 	${OBJECTDIR}/src/vec4.o \
-	${OBJECTDIR}/src/vec_utils.o
+	${OBJECTDIR}/src/vec_utils.o \
+	${OBJECTDIR}/src/workerPool.o
 
 # Test Directory
 TESTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}/tests
@@ -63,7 +66,18 @@ TESTFILES= \
 	${TESTDIR}/TestFiles/f1 \
 	${TESTDIR}/TestFiles/f2 \
 	${TESTDIR}/TestFiles/f5 \
-	${TESTDIR}/TestFiles/f4
+	${TESTDIR}/TestFiles/f4 \
+	${TESTDIR}/TestFiles/f6 \
+	${TESTDIR}/TestFiles/f7 \
+	${TESTDIR}/TestFiles/f8 \
+	${TESTDIR}/TestFiles/f9 \
+	${TESTDIR}/TestFiles/f10 \
+	${TESTDIR}/TestFiles/f11 \
+	${TESTDIR}/TestFiles/f12 \
+	${TESTDIR}/TestFiles/f13 \
+	${TESTDIR}/TestFiles/f14 \
+	${TESTDIR}/TestFiles/f15 \
+	${TESTDIR}/TestFiles/f16
 
 # C Compiler Flags
 CFLAGS=
@@ -91,6 +105,11 @@ ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/libhamlibs.a: ${OBJECTFILES}
 	${AR} -rv ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/libhamlibs.a ${OBJECTFILES} 
 	$(RANLIB) ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/libhamlibs.a
 
+${OBJECTDIR}/src/allocator.o: nbproject/Makefile-${CND_CONF}.mk src/allocator.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -std=c++11 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/allocator.o src/allocator.cpp
+
 ${OBJECTDIR}/src/assert.o: nbproject/Makefile-${CND_CONF}.mk src/assert.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
@@ -111,6 +130,11 @@ ${OBJECTDIR}/src/logger.o: nbproject/Makefile-${CND_CONF}.mk src/logger.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -s -Iinclude -std=c++11 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/logger.o src/logger.cpp
 
+${OBJECTDIR}/src/mappedFile.o: nbproject/Makefile-${CND_CONF}.mk src/mappedFile.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -std=c++11 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/mappedFile.o src/mappedFile.cpp
+
 ${OBJECTDIR}/src/mat_utils.o: nbproject/Makefile-${CND_CONF}.mk src/mat_utils.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
@@ -186,6 +210,11 @@ ${OBJECTDIR}/src/vec_utils.o: nbproject/Makefile-${CND_CONF}.mk src/vec_utils.cp
 	${RM} "$@.d"
 	$(COMPILE.cc) -s -Iinclude -std=c++11 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/vec_utils.o src/vec_utils.cpp
 
+${OBJECTDIR}/src/workerPool.o: nbproject/Makefile-${CND_CONF}.mk src/workerPool.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -std=c++11 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/workerPool.o src/workerPool.cpp
+
 # Subprojects
 .build-subprojects:
 
@@ -207,6 +236,50 @@ ${TESTDIR}/TestFiles/f4: ${TESTDIR}/_ext/2103785198/pointer_test.o ${OBJECTFILES
 	${MKDIR} -p ${TESTDIR}/TestFiles
 	${LINK.cc}   -o ${TESTDIR}/TestFiles/f4 $^ ${LDLIBSOPTIONS} 
 
+${TESTDIR}/TestFiles/f6: ${TESTDIR}/_ext/2103785198/concurrent_btree_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f6 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f7: ${TESTDIR}/_ext/2103785198/array_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f7 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f8: ${TESTDIR}/_ext/2103785198/allocator_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f8 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f9: ${TESTDIR}/_ext/2103785198/parallel_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f9 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f10: ${TESTDIR}/_ext/2103785198/deque_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f10 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f11: ${TESTDIR}/_ext/2103785198/list_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f11 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f12: ${TESTDIR}/_ext/2103785198/iterator_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f12 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f13: ${TESTDIR}/_ext/2103785198/concurrent_queue_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f13 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f14: ${TESTDIR}/_ext/2103785198/priority_queue_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f14 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f15: ${TESTDIR}/_ext/2103785198/slotmap_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f15 $^ ${LDLIBSOPTIONS} 
+
+${TESTDIR}/TestFiles/f16: ${TESTDIR}/_ext/2103785198/ring_queue_test.o ${OBJECTFILES:%.o=%_nomain.o}
+	${MKDIR} -p ${TESTDIR}/TestFiles
+	${LINK.cc}   -o ${TESTDIR}/TestFiles/f16 $^ ${LDLIBSOPTIONS} 
+
 
 ${TESTDIR}/_ext/2103785198/btree_test.o: ../tests/btree_test.cpp 
 	${MKDIR} -p ${TESTDIR}/_ext/2103785198
@@ -232,6 +305,85 @@ ${TESTDIR}/_ext/2103785198/pointer_test.o: ../tests/pointer_test.cpp
 	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/pointer_test.o ../tests/pointer_test.cpp
 
 
+${TESTDIR}/_ext/2103785198/concurrent_btree_test.o: ../tests/concurrent_btree_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/concurrent_btree_test.o ../tests/concurrent_btree_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/array_test.o: ../tests/array_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/array_test.o ../tests/array_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/allocator_test.o: ../tests/allocator_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/allocator_test.o ../tests/allocator_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/parallel_test.o: ../tests/parallel_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/parallel_test.o ../tests/parallel_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/deque_test.o: ../tests/deque_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/deque_test.o ../tests/deque_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/list_test.o: ../tests/list_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/list_test.o ../tests/list_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/iterator_test.o: ../tests/iterator_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/iterator_test.o ../tests/iterator_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/concurrent_queue_test.o: ../tests/concurrent_queue_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/concurrent_queue_test.o ../tests/concurrent_queue_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/priority_queue_test.o: ../tests/priority_queue_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/priority_queue_test.o ../tests/priority_queue_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/slotmap_test.o: ../tests/slotmap_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/slotmap_test.o ../tests/slotmap_test.cpp
+
+
+${TESTDIR}/_ext/2103785198/ring_queue_test.o: ../tests/ring_queue_test.cpp 
+	${MKDIR} -p ${TESTDIR}/_ext/2103785198
+	${RM} "$@.d"
+	$(COMPILE.cc) -s -Iinclude -I. -std=c++11 -O2 -lpthread -MMD -MP -MF "$@.d" -o ${TESTDIR}/_ext/2103785198/ring_queue_test.o ../tests/ring_queue_test.cpp
+
+
+${OBJECTDIR}/src/allocator_nomain.o: ${OBJECTDIR}/src/allocator.o src/allocator.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/allocator.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.cc) -s -Iinclude -std=c++11 -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/allocator_nomain.o src/allocator.cpp;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/allocator.o ${OBJECTDIR}/src/allocator_nomain.o;\
+	fi
+
 ${OBJECTDIR}/src/assert_nomain.o: ${OBJECTDIR}/src/assert.o src/assert.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/assert.o`; \
@@ -284,6 +436,19 @@ ${OBJECTDIR}/src/logger_nomain.o: ${OBJECTDIR}/src/logger.o src/logger.cpp
 	    ${CP} ${OBJECTDIR}/src/logger.o ${OBJECTDIR}/src/logger_nomain.o;\
 	fi
 
+${OBJECTDIR}/src/mappedFile_nomain.o: ${OBJECTDIR}/src/mappedFile.o src/mappedFile.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/mappedFile.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.cc) -s -Iinclude -std=c++11 -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/mappedFile_nomain.o src/mappedFile.cpp;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/mappedFile.o ${OBJECTDIR}/src/mappedFile_nomain.o;\
+	fi
+
 ${OBJECTDIR}/src/mat_utils_nomain.o: ${OBJECTDIR}/src/mat_utils.o src/mat_utils.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/mat_utils.o`; \
@@ -479,6 +644,19 @@ ${OBJECTDIR}/src/vec_utils_nomain.o: ${OBJECTDIR}/src/vec_utils.o src/vec_utils.
 	    ${CP} ${OBJECTDIR}/src/vec_utils.o ${OBJECTDIR}/src/vec_utils_nomain.o;\
 	fi
 
+${OBJECTDIR}/src/workerPool_nomain.o: ${OBJECTDIR}/src/workerPool.o src/workerPool.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	@NMOUTPUT=`${NM} ${OBJECTDIR}/src/workerPool.o`; \
+	if (echo "$$NMOUTPUT" | ${GREP} '|main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T main$$') || \
+	   (echo "$$NMOUTPUT" | ${GREP} 'T _main$$'); \
+	then  \
+	    ${RM} "$@.d";\
+	    $(COMPILE.cc) -s -Iinclude -std=c++11 -Dmain=__nomain -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/workerPool_nomain.o src/workerPool.cpp;\
+	else  \
+	    ${CP} ${OBJECTDIR}/src/workerPool.o ${OBJECTDIR}/src/workerPool_nomain.o;\
+	fi
+
 # Run Test Targets
 .test-conf:
 	@if [ "${TEST}" = "" ]; \
@@ -487,6 +665,17 @@ ${OBJECTDIR}/src/vec_utils_nomain.o: ${OBJECTDIR}/src/vec_utils.o src/vec_utils.
 	    ${TESTDIR}/TestFiles/f2 || true; \
 	    ${TESTDIR}/TestFiles/f5 || true; \
 	    ${TESTDIR}/TestFiles/f4 || true; \
+	    ${TESTDIR}/TestFiles/f6 || true; \
+	    ${TESTDIR}/TestFiles/f7 || true; \
+	    ${TESTDIR}/TestFiles/f8 || true; \
+	    ${TESTDIR}/TestFiles/f9 || true; \
+	    ${TESTDIR}/TestFiles/f10 || true; \
+	    ${TESTDIR}/TestFiles/f11 || true; \
+	    ${TESTDIR}/TestFiles/f12 || true; \
+	    ${TESTDIR}/TestFiles/f13 || true; \
+	    ${TESTDIR}/TestFiles/f14 || true; \
+	    ${TESTDIR}/TestFiles/f15 || true; \
+	    ${TESTDIR}/TestFiles/f16 || true; \
 	else  \
 	    ./${TEST} || true; \
 	fi
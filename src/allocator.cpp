@@ -0,0 +1,48 @@
+
+#include <cstdint>
+
+#include "../include/utils/allocator.h"
+
+namespace hamLibs {
+namespace utils {
+
+/*
+ * Heap Resource -- Shared Instance
+ */
+heapResource* heapResource::get() {
+    static heapResource resource;
+    return &resource;
+}
+
+/*
+ * Heap Resource -- Allocate
+ */
+void* heapResource::allocate(std::size_t numBytes, std::size_t alignment) {
+    return alignedNew(numBytes, alignment);
+}
+
+/*
+ * Heap Resource -- Deallocate
+ */
+void heapResource::deallocate(void* p, std::size_t, std::size_t alignment) {
+    alignedDelete(p, alignment);
+}
+
+/*
+ * Arena Resource -- Allocate
+ */
+void* arenaResource::allocate(std::size_t numBytes, std::size_t alignment) {
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(pBuffer);
+    const std::uintptr_t mask = alignment - 1;
+    const std::size_t start = ((base + offset + mask) & ~mask) - base;
+
+    if (start > capacity || numBytes > capacity - start) {
+        throw std::bad_alloc();
+    }
+
+    offset = start + numBytes;
+    return pBuffer + start;
+}
+
+} // end utils namespace
+} // end hamLibs namespace
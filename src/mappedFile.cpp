@@ -0,0 +1,160 @@
+
+#include <utility>
+
+#include "../include/utils/mappedFile.h"
+
+#ifdef HL_OS_WINDOWS
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace hamLibs {
+namespace utils {
+
+/*
+ * Move Constructor
+ */
+mappedFile::mappedFile( mappedFile&& mf ) {
+    *this = std::move( mf );
+}
+
+/*
+ * Move Operator
+ */
+mappedFile& mappedFile::operator=( mappedFile&& mf ) {
+    if ( this != &mf ) {
+        close();
+
+        pData = mf.pData;
+        numBytes = mf.numBytes;
+        mf.pData = nullptr;
+        mf.numBytes = 0;
+
+    #ifdef HL_OS_WINDOWS
+        hFile = mf.hFile;
+        hMapping = mf.hMapping;
+        mf.hFile = nullptr;
+        mf.hMapping = nullptr;
+    #endif
+    }
+
+    return *this;
+}
+
+#ifdef HL_OS_WINDOWS
+
+/*
+ * Open (Windows)
+ */
+bool mappedFile::open( const char* filename ) {
+    close();
+
+    HANDLE file = CreateFileA(
+        filename, GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+
+    if ( file == INVALID_HANDLE_VALUE ) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart == 0 ) {
+        CloseHandle( file );
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( !mapping ) {
+        CloseHandle( file );
+        return false;
+    }
+
+    const void* view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    if ( !view ) {
+        CloseHandle( mapping );
+        CloseHandle( file );
+        return false;
+    }
+
+    pData = view;
+    numBytes = static_cast< std::size_t >( fileSize.QuadPart );
+    hFile = file;
+    hMapping = mapping;
+
+    return true;
+}
+
+/*
+ * Close (Windows)
+ */
+void mappedFile::close() {
+    if ( pData ) {
+        UnmapViewOfFile( pData );
+        CloseHandle( static_cast< HANDLE >( hMapping ) );
+        CloseHandle( static_cast< HANDLE >( hFile ) );
+    }
+
+    pData = nullptr;
+    numBytes = 0;
+    hFile = nullptr;
+    hMapping = nullptr;
+}
+
+#else
+
+/*
+ * Open (POSIX)
+ */
+bool mappedFile::open( const char* filename ) {
+    close();
+
+    const int file = ::open( filename, O_RDONLY );
+    if ( file < 0 ) {
+        return false;
+    }
+
+    struct stat fileInfo;
+    if ( fstat( file, &fileInfo ) != 0 || fileInfo.st_size <= 0 ) {
+        ::close( file );
+        return false;
+    }
+
+    void* view = mmap( nullptr, fileInfo.st_size, PROT_READ, MAP_SHARED, file, 0 );
+
+    // The mapping stays valid after its file descriptor is closed
+    ::close( file );
+
+    if ( view == MAP_FAILED ) {
+        return false;
+    }
+
+    pData = view;
+    numBytes = static_cast< std::size_t >( fileInfo.st_size );
+
+    return true;
+}
+
+/*
+ * Close (POSIX)
+ */
+void mappedFile::close() {
+    if ( pData ) {
+        munmap( const_cast< void* >( pData ), numBytes );
+    }
+
+    pData = nullptr;
+    numBytes = 0;
+}
+
+#endif
+
+} // end utils namespace
+} // end hamLibs namespace
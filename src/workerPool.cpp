@@ -0,0 +1,163 @@
+
+#include "../include/utils/workerPool.h"
+
+namespace hamLibs {
+namespace utils {
+
+namespace {
+
+// Set on threads which are currently running a task of any pool
+thread_local bool insideBatch = false;
+
+} // end anonymous namespace
+
+/*
+ * Worker Pool -- Constructor
+ */
+workerPool::workerPool( unsigned numThreads ) {
+    if ( !numThreads ) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+
+    for ( unsigned i = 1; i < numThreads; ++i ) {
+        workers.emplace_back( &workerPool::workerLoop, this );
+    }
+}
+
+/*
+ * Worker Pool -- Destructor
+ */
+workerPool::~workerPool() {
+    {
+        std::lock_guard< std::mutex > guard( stateLock );
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+
+    for ( std::thread& worker : workers ) {
+        worker.join();
+    }
+}
+
+/*
+ * Worker Pool -- Work
+ * Claim and run tasks from a batch until none are left.
+ */
+void workerPool::work( batch& b ) {
+    for ( ;; ) {
+        const unsigned i = b.nextTask.fetch_add( 1, std::memory_order_relaxed );
+
+        if ( i >= b.numTasks ) {
+            return;
+        }
+
+        try {
+            b.pTask( b.pContext, i );
+        }
+        catch ( ... ) {
+            std::lock_guard< std::mutex > guard( b.errorLock );
+
+            if ( !b.error ) {
+                b.error = std::current_exception();
+            }
+        }
+
+        b.numDone.fetch_add( 1, std::memory_order_release );
+    }
+}
+
+/*
+ * Worker Pool -- Worker Thread
+ * Sleep until a batch is submitted, help finish it, then sleep again.
+ */
+void workerPool::workerLoop() {
+    unsigned long seen = 0;
+    insideBatch = true;
+
+    std::unique_lock< std::mutex > lock( stateLock );
+
+    for ( ;; ) {
+        wakeWorkers.wait( lock, [&]() { return stopping || generation != seen; } );
+
+        if ( stopping ) {
+            return;
+        }
+
+        seen = generation;
+
+        // The batch may have been finished by other threads already
+        if ( !pBatch ) {
+            continue;
+        }
+
+        batch* const b = pBatch;
+        ++numActive;
+        lock.unlock();
+
+        work( *b );
+
+        lock.lock();
+        if ( !--numActive ) {
+            wakeCaller.notify_one();
+        }
+    }
+}
+
+/*
+ * Worker Pool -- Run
+ * Publish a batch to the workers, work on it from this thread, and wait for
+ * every worker to let go of it.
+ */
+void workerPool::runBatch( void (*pTask)( void*, unsigned ), void* pContext, unsigned numTasks ) {
+    if ( !numTasks ) {
+        return;
+    }
+
+    batch b;
+    b.pTask = pTask;
+    b.pContext = pContext;
+    b.numTasks = numTasks;
+    b.nextTask.store( 0, std::memory_order_relaxed );
+    b.numDone.store( 0, std::memory_order_relaxed );
+
+    // Nested and single-task batches are not worth waking the pool for
+    if ( insideBatch || workers.empty() || numTasks == 1 ) {
+        const bool wasInside = insideBatch;
+        insideBatch = true;
+        work( b );
+        insideBatch = wasInside;
+
+        if ( b.error ) {
+            std::rethrow_exception( b.error );
+        }
+        return;
+    }
+
+    std::lock_guard< std::mutex > submitGuard( submitLock );
+
+    {
+        std::lock_guard< std::mutex > guard( stateLock );
+        pBatch = &b;
+        ++generation;
+    }
+    wakeWorkers.notify_all();
+
+    insideBatch = true;
+    work( b );
+    insideBatch = false;
+
+    {
+        std::unique_lock< std::mutex > lock( stateLock );
+        wakeCaller.wait( lock, [&]() {
+            return numActive == 0 && b.numDone.load( std::memory_order_acquire ) == numTasks;
+        } );
+        pBatch = nullptr;
+    }
+
+    if ( b.error ) {
+        std::rethrow_exception( b.error );
+    }
+}
+
+} // end utils namespace
+} // end hamLibs namespace
@@ -0,0 +1,349 @@
+// allocator policy tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -O2 allocator_test.cpp ../src/allocator.cpp -o allocator
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "containers/array.h"
+#include "containers/arttree.h"
+#include "containers/btree.h"
+#include "containers/concurrentbtree.h"
+#include "containers/deque.h"
+#include "containers/list.h"
+#include "containers/ptree.h"
+#include "containers/queue.h"
+#include "containers/slotmap.h"
+#include "containers/smallarray.h"
+#include "containers/stack.h"
+#include "containers/string.h"
+#include "utils/allocator.h"
+#include "utils/pointer.h"
+#include "testUtils.h"
+
+#define NUM_ITEMS 1000
+
+namespace containers = hamLibs::containers;
+namespace utils = hamLibs::utils;
+
+typedef utils::resourceAllocator resource_alloc;
+
+/******************************************************************************
+ * Helpers
+******************************************************************************/
+// Every container must have used the resource and released everything it took
+unsigned checkResource( const char* name, const countingResource& res ) {
+    if ( !res.numAllocs || res.numAllocs != res.numFrees || res.numBytes ) {
+        std::cout << "\tError: " << name << " made " << res.numAllocs
+            << " allocations, " << res.numFrees << " frees, leaving "
+            << res.numBytes << " bytes.\n";
+        return 1;
+    }
+
+    std::cout << "\t" << name << ": " << res.numAllocs << " allocations\n";
+    return 0;
+}
+
+/******************************************************************************
+ * Container Tests
+******************************************************************************/
+unsigned testArrays( countingResource& res ) {
+    unsigned numErrors = 0;
+
+    res.reset();
+    {
+        containers::array< std::string, resource_alloc > a{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            a.pushBack( std::to_string( i ) );
+        }
+
+        containers::array< std::string, resource_alloc > b( a );
+        containers::array< std::string, resource_alloc > c( std::move( b ) );
+        a.erase( 0, NUM_ITEMS/2 );
+        a.shrinkToFit();
+
+        numErrors += (c.size() != NUM_ITEMS) || (c[ NUM_ITEMS-1 ] != std::to_string( NUM_ITEMS-1 ));
+        numErrors += (a.size() != NUM_ITEMS/2);
+    }
+    numErrors += checkResource( "array", res );
+
+    res.reset();
+    {
+        containers::smallArray< int, 4, resource_alloc > a{ resource_alloc( &res ) };
+        for ( int i = 0; i < 4; ++i ) {
+            a.pushBack( i );
+        }
+
+        // nothing is allocated until the inline storage runs out
+        numErrors += (res.numAllocs != 0);
+
+        for ( int i = 4; i < NUM_ITEMS; ++i ) {
+            a.pushBack( i );
+        }
+        containers::smallArray< int, 4, resource_alloc > b( a );
+        numErrors += (b[ NUM_ITEMS-1 ] != NUM_ITEMS-1);
+    }
+    numErrors += checkResource( "smallArray", res );
+
+    res.reset();
+    {
+        containers::slotMap< std::string, std::uint32_t, resource_alloc > m{ resource_alloc( &res ) };
+        std::uint32_t h = 0;
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            h = m.push( std::to_string( i ) );
+        }
+        containers::slotMap< std::string, std::uint32_t, resource_alloc > n( m );
+        m.pop( h );
+        numErrors += (n.size() != NUM_ITEMS) || (*n.getData( h ) != std::to_string( NUM_ITEMS-1 )) || m.hasData( h );
+    }
+    numErrors += checkResource( "slotMap", res );
+
+    res.reset();
+    {
+        utils::pointer< std::string, resource_alloc > p( NUM_ITEMS, resource_alloc( &res ) );
+        p[ 0 ] = "first";
+        utils::pointer< std::string, resource_alloc > q( p );
+        numErrors += (q.size() != NUM_ITEMS) || (q[ 0 ] != "first");
+    }
+    numErrors += checkResource( "pointer", res );
+
+    res.reset();
+    {
+        containers::string_t< char, resource_alloc > s( "hello", resource_alloc( &res ) );
+        for ( int i = 0; i < 2048; ++i ) {
+            s += 'a';
+        }
+        containers::string_t< char, resource_alloc > t = s + " world";
+        containers::string_t< char, resource_alloc > u( t );
+        numErrors += (u.size() != 5 + 2048 + 6) || (u[ 0 ] != 'h');
+    }
+    numErrors += checkResource( "string", res );
+
+    return numErrors;
+}
+
+unsigned testLists( countingResource& res ) {
+    unsigned numErrors = 0;
+
+    res.reset();
+    {
+        containers::list< int, resource_alloc > l{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            l.pushBack( i );
+        }
+        l.popFront();
+        numErrors += (l.size() != NUM_ITEMS-1) || (*l.getFirst() != 1);
+    }
+    numErrors += checkResource( "list", res );
+
+    res.reset();
+    {
+        containers::queue< int, resource_alloc > q{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            q.push( i );
+        }
+        q.pop();
+        numErrors += (q.size() != NUM_ITEMS-1);
+    }
+    numErrors += checkResource( "queue", res );
+
+    res.reset();
+    {
+        containers::deque< std::string, resource_alloc > d{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            d.pushBack( std::to_string( i ) );
+            d.pushFront( std::to_string( -i ) );
+        }
+        containers::deque< std::string, resource_alloc > e( d );
+        d.popFront();
+        numErrors += (e.size() != NUM_ITEMS*2) || (e.front() != std::to_string( 1-NUM_ITEMS )) || (d.size() != NUM_ITEMS*2-1);
+    }
+    numErrors += checkResource( "deque", res );
+
+    res.reset();
+    {
+        containers::stack< std::string, resource_alloc > s{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            s.push( std::to_string( i ) );
+        }
+        s.pop();
+        numErrors += (s.size() != NUM_ITEMS-1) || (*s.top() != std::to_string( NUM_ITEMS-2 ));
+        numErrors += (*s.peekNext() != std::to_string( NUM_ITEMS-3 ));
+    }
+    numErrors += checkResource( "stack", res );
+
+    return numErrors;
+}
+
+unsigned testTrees( countingResource& res ) {
+    unsigned numErrors = 0;
+
+    res.reset();
+    {
+        containers::bTree< int, std::string, resource_alloc > t{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            t.push( i, std::to_string( i ) );
+        }
+        containers::bTree< int, std::string, resource_alloc > u( t );
+        t.pop( 7 );
+        t.shrinkToFit();
+        numErrors += (u.size() != NUM_ITEMS) || (*u.getData( 7 ) != "7") || t.hasData( 7 );
+    }
+    numErrors += checkResource( "bTree", res );
+
+    res.reset();
+    {
+        containers::concurrentBTree< int, std::string, resource_alloc > t{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            t.push( i, std::to_string( i ) );
+            t.push( i, std::to_string( -i ) );
+        }
+        t.pop( 3 );
+
+        std::string s;
+        numErrors += !t.getData( 5, s ) || (s != "-5") || t.hasData( 3 );
+    }
+    numErrors += checkResource( "concurrentBTree", res );
+
+    res.reset();
+    {
+        containers::pTree< int, std::string, resource_alloc > t{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            t.push( i, std::to_string( i ) );
+        }
+        containers::pTree< int, std::string, resource_alloc > u( t );
+        t.pop( 7 );
+        numErrors += (u.size() != NUM_ITEMS) || (*u.getData( 7 ) != "7") || t.hasData( 7 );
+    }
+    numErrors += checkResource( "pTree", res );
+
+    res.reset();
+    {
+        containers::artTree< int, std::string, resource_alloc > t{ resource_alloc( &res ) };
+        for ( int i = 0; i < NUM_ITEMS; ++i ) {
+            t.push( i, std::to_string( i ) );
+        }
+        containers::artTree< int, std::string, resource_alloc > u( t );
+        for ( int i = 0; i < NUM_ITEMS; i += 2 ) {
+            t.pop( i );
+        }
+        numErrors += (u.size() != NUM_ITEMS) || (*u.getData( 8 ) != "8") || t.hasData( 8 );
+    }
+    numErrors += checkResource( "artTree", res );
+
+    return numErrors;
+}
+
+/*
+ * Over-aligned elements, such as SIMD vectors or cache-line-padded counters,
+ * need more alignment than operator new guarantees.
+ */
+struct alignas( 64 ) paddedCounter {
+    int value;
+};
+
+template < typename type >
+bool isAligned( const type* p ) {
+    return (reinterpret_cast< std::uintptr_t >( p ) % alignof( type )) == 0;
+}
+
+unsigned testAlignment() {
+    unsigned numErrors = 0;
+
+    containers::array< paddedCounter > a;
+    containers::array< paddedCounter, resource_alloc > b;
+    containers::list< paddedCounter > l;
+
+    for ( int i = 0; i < NUM_ITEMS; ++i ) {
+        a.pushBack( paddedCounter{ i } );
+        b.pushBack( paddedCounter{ i } );
+        l.pushBack( paddedCounter{ i } );
+        numErrors += !isAligned( &a[ 0 ] ) || !isAligned( &b[ 0 ] ) || !isAligned( l.getLast() );
+    }
+
+    for ( int i = 0; i < NUM_ITEMS; ++i ) {
+        numErrors += (a[ i ].value != i) || (b[ i ].value != i);
+    }
+
+    // any power-of-two alignment is honored, not just the ones types ask for
+    for ( std::size_t alignment = 1; alignment <= 4096; alignment *= 2 ) {
+        utils::heapAllocator heap;
+        void* const p = heap.allocate( 24, alignment );
+        void* const q = utils::heapResource::get()->allocate( 24, alignment );
+
+        numErrors += (reinterpret_cast< std::uintptr_t >( p ) % alignment) != 0;
+        numErrors += (reinterpret_cast< std::uintptr_t >( q ) % alignment) != 0;
+
+        heap.deallocate( p, 24, alignment );
+        utils::heapResource::get()->deallocate( q, 24, alignment );
+    }
+
+    std::cout << "\talignment: " << (numErrors ? "misaligned storage" : "honored") << "\n";
+
+    return numErrors;
+}
+
+/*
+ * Per-frame style usage: containers are filled from an arena which is
+ * released all at once.
+ */
+unsigned testArena() {
+    unsigned numErrors = 0;
+
+    alignas( std::max_align_t ) static unsigned char buffer[ 1 << 20 ];
+    utils::arenaResource arena( buffer, sizeof( buffer ) );
+
+    for ( unsigned frame = 0; frame < 4; ++frame ) {
+        {
+            containers::bTree< int, int, resource_alloc > t{ resource_alloc( &arena ) };
+            containers::array< int, resource_alloc > a{ resource_alloc( &arena ) };
+
+            for ( int i = 0; i < NUM_ITEMS; ++i ) {
+                t.push( i, i*2 );
+                a.pushBack( i );
+            }
+
+            for ( int i = 0; i < NUM_ITEMS; ++i ) {
+                numErrors += (*t.getData( i ) != i*2) || (a[ i ] != i);
+            }
+
+            numErrors += (arena.size() == 0) || (arena.size() > arena.maxSize());
+        }
+
+        arena.reset();
+    }
+
+    // running out of space must be reported
+    bool threw = false;
+    try {
+        containers::array< char, resource_alloc > a{ resource_alloc( &arena ) };
+        a.reserve( sizeof( buffer ) + 1 );
+    }
+    catch ( const std::bad_alloc& ) {
+        threw = true;
+    }
+    numErrors += !threw;
+
+    std::cout << "\tarena: " << (threw ? "exhaustion reported" : "exhaustion missed") << "\n";
+
+    return numErrors;
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    std::cout << "\nTESTING ALLOCATORS" << "\n";
+
+    countingResource res;
+    unsigned numErrors = 0;
+
+    numErrors += testArrays( res );
+    numErrors += testLists( res );
+    numErrors += testTrees( res );
+    numErrors += testAlignment();
+    numErrors += testArena();
+
+    std::cout << "Allocator Errors: " << numErrors << "\n";
+}
@@ -0,0 +1,424 @@
+
+// dynamic array tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -O2 array_test.cpp -o array
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "containers/array.h"
+#include "containers/smallarray.h"
+#include "containers/staticarray.h"
+#include "math/vec4.h"
+#include "utils/pointer.h"
+#include "testUtils.h"
+
+#define NUM_ITERATIONS 256
+#define NUM_TESTS 65536
+
+namespace chrono = std::chrono;
+
+typedef chrono::steady_clock hr_clock;
+typedef hr_clock::time_point hr_time;
+
+using hamLibs::containers::array;
+using hamLibs::containers::smallArray;
+using hamLibs::containers::staticArray;
+
+/******************************************************************************
+ * Move-Only Element Test
+******************************************************************************/
+template < typename array_t >
+unsigned testMoveOnly() {
+    typedef std::unique_ptr< int > ptr_t;
+
+    unsigned numErrors = 0;
+    array_t testArray;
+
+    for ( int i = 0; i < 32; ++i ) {
+        testArray.emplaceBack( new int( i ) );
+    }
+
+    testArray.pushFront( ptr_t( new int( -1 ) ) );
+    testArray.push( 2, ptr_t( new int( -2 ) ) );
+    testArray.pushAfter( 2, ptr_t( new int( -3 ) ) );
+    testArray.emplace( 10, new int( -10 ) );
+    testArray.emplaceFront( new int( -4 ) );
+    testArray.pushBack( ptr_t( new int( 32 ) ) );
+
+    numErrors += testArray.size() != 38;
+    numErrors += *testArray[ 0 ] != -4 || *testArray[ 1 ] != -1 || *testArray[ 2 ] != 0;
+    numErrors += *testArray[ 3 ] != -2 || *testArray[ 4 ] != -3 || *testArray[ 11 ] != -10;
+    numErrors += *testArray.back() != 32;
+
+    array_t moveArray( std::move( testArray ) );
+    numErrors += !testArray.empty() || moveArray.size() != 38 || *moveArray[ 0 ] != -4;
+
+    moveArray.erase( 0, 5 );
+    numErrors += *moveArray.front() != 1;
+
+    return numErrors;
+}
+
+/******************************************************************************
+ * Array Test
+******************************************************************************/
+void testArray() {
+    std::cout << "\nTESTING ARRAY" << "\n";
+
+    unsigned numErrors = 0;
+
+    {
+        array< tracked > testArray;
+
+        // appending moves existing elements rather than copying them
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            testArray.emplaceBack( i );
+        }
+        numErrors += tracked::numCopies != 0;
+        numErrors += testArray.size() != NUM_TESTS;
+        numErrors += testArray.capacity() < testArray.size();
+
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            numErrors += testArray[ i ].value != i;
+        }
+
+        // pushing an element of the same array must survive reallocation
+        testArray.shrinkToFit();
+        numErrors += testArray.capacity() != testArray.size();
+        testArray.pushBack( testArray[ 0 ] );
+        numErrors += testArray.back().value != 0;
+        testArray.popBack();
+
+        // erase in place
+        testArray.erase( 0 );
+        testArray.popFront();
+        testArray.erase( 10, 20 );
+        numErrors += testArray.size() != NUM_TESTS - 12;
+        numErrors += testArray[ 0 ].value != 2;
+        numErrors += testArray[ 9 ].value != 11;
+        numErrors += testArray[ 10 ].value != 22;
+
+        // insertion moves temporaries in rather than copying them
+        const int numCopies = tracked::numCopies;
+        testArray.pushFront( tracked( -2 ) );
+        testArray.push( 5, tracked( -5 ) );
+        testArray.pushAfter( 5, tracked( -6 ) );
+        numErrors += testArray[ 0 ].value != -2;
+        numErrors += testArray[ 5 ].value != -5;
+        numErrors += testArray[ 6 ].value != -6;
+        numErrors += testArray[ 7 ].value != 6;
+
+        testArray.emplace( 7, -7 );
+        testArray.emplaceFront( -1 );
+        numErrors += testArray[ 0 ].value != -1 || testArray[ 8 ].value != -7;
+        numErrors += tracked::numCopies != numCopies;
+        testArray.popFront();
+        testArray.pop( 7 );
+
+        // copies and moves
+        array< tracked > copyArray( testArray );
+        numErrors += copyArray != testArray;
+
+        array< tracked > moveArray( std::move( copyArray ) );
+        numErrors += moveArray != testArray || copyArray.size() != 0;
+
+        copyArray = moveArray + testArray;
+        numErrors += copyArray.size() != testArray.size() * 2;
+
+        moveArray = std::move( copyArray );
+        numErrors += moveArray.size() != testArray.size() * 2;
+
+        moveArray += moveArray;
+        numErrors += moveArray.size() != testArray.size() * 4;
+        numErrors += moveArray[ testArray.size() * 3 ] != testArray[ 0 ];
+
+        // resizing
+        const int oldCapacity = moveArray.capacity();
+        moveArray.resize( 16 );
+        numErrors += moveArray.size() != 16 || moveArray.capacity() != oldCapacity;
+        moveArray.resize( 32 );
+        numErrors += moveArray[ 31 ].value != 0;
+
+        moveArray.clear();
+        numErrors += !moveArray.empty();
+        moveArray.shrinkToFit();
+        numErrors += moveArray.capacity() != 0;
+    }
+
+    numErrors += tracked::numAlive != 0;
+
+    // negative indices insert at the front, even into an empty array
+    array< std::string > strings;
+    strings.push( -1, "x" );
+    strings.push( -5, "w" );
+    numErrors += strings.size() != 2 || strings[ 0 ] != "w" || strings[ 1 ] != "x";
+
+    numErrors += testMoveOnly< array< std::unique_ptr< int > > >();
+
+    std::cout << "Array Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Small & Static Array Tests
+******************************************************************************/
+template < typename array_t >
+unsigned testInlineArray( int numItems ) {
+    unsigned numErrors = 0;
+
+    {
+        array_t testArray;
+
+        for ( int i = 0; i < numItems; ++i ) {
+            testArray.emplaceBack( i );
+        }
+        numErrors += testArray.size() != numItems;
+
+        testArray.erase( 0 );
+        testArray.pushFront( tracked( -1 ) );
+        testArray.push( 2, tracked( -2 ) );
+        testArray.popBack();
+        numErrors += testArray[ 0 ].value != -1;
+        numErrors += testArray[ 1 ].value != 1;
+        numErrors += testArray[ 2 ].value != -2;
+        numErrors += testArray.back().value != numItems - 2;
+
+        // negative indices insert at the front, even into an empty array
+        array_t frontArray;
+        frontArray.push( -1, tracked( 5 ) );
+        frontArray.emplace( -3, 4 );
+        numErrors += frontArray.size() != 2 || frontArray[ 0 ].value != 4 || frontArray[ 1 ].value != 5;
+
+        // copies and moves of both inline and spilled storage
+        array_t copyArray( testArray );
+        numErrors += copyArray != testArray;
+
+        array_t moveArray( std::move( copyArray ) );
+        numErrors += moveArray != testArray || !copyArray.empty();
+
+        copyArray = testArray;
+        moveArray = std::move( copyArray );
+        numErrors += moveArray != testArray || !copyArray.empty();
+
+        moveArray.clear();
+        moveArray.shrinkToFit();
+        numErrors += !moveArray.empty();
+        moveArray += testArray;
+        numErrors += moveArray != testArray;
+    }
+
+    numErrors += tracked::numAlive != 0;
+    return numErrors;
+}
+
+void testInlineArrays() {
+    std::cout << "\nTESTING SMALL & STATIC ARRAYS" << "\n";
+
+    unsigned numErrors = 0;
+
+    // inline storage only, then spilling onto the heap
+    numErrors += testInlineArray< smallArray< tracked, 8 > >( 6 );
+    numErrors += testInlineArray< smallArray< tracked, 8 > >( 100 );
+    numErrors += testInlineArray< staticArray< tracked, 64 > >( 6 );
+    numErrors += testInlineArray< staticArray< tracked, 64 > >( 63 );
+    numErrors += testMoveOnly< smallArray< std::unique_ptr< int >, 8 > >();
+    numErrors += testMoveOnly< staticArray< std::unique_ptr< int >, 64 > >();
+
+    smallArray< int, 4 > smallInts;
+    for ( int i = 0; i < 4; ++i ) {
+        smallInts.pushBack( i );
+    }
+    numErrors += smallInts.isSpilled();
+    smallInts.pushBack( 4 );
+    numErrors += !smallInts.isSpilled();
+    smallInts.popBack();
+    smallInts.shrinkToFit();
+    numErrors += smallInts.isSpilled() || smallInts[ 3 ] != 3;
+
+    // static arrays assert instead of growing
+    staticArray< int, 4 > staticInts( 1, 4 );
+    numErrors += !staticInts.full();
+
+    bool overflowCaught = false;
+    try {
+        staticInts.pushBack( 5 );
+    }
+    catch ( hamLibs::utils::error_t ) {
+        overflowCaught = true;
+    }
+    numErrors += !overflowCaught || staticInts.size() != 4;
+
+    std::cout << "Inline Array Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Append Benchmark
+******************************************************************************/
+template < typename container_t, typename push_t >
+void appendBench( const char* name, push_t pushFunc ) {
+    long long checksum = 0;
+
+    const hr_time t1 = hr_clock::now();
+
+    for ( unsigned i = 0; i < NUM_ITERATIONS; ++i ) {
+        container_t testArray;
+
+        for ( int j = 0; j < NUM_TESTS; ++j ) {
+            pushFunc( testArray, j );
+        }
+        checksum += testArray.size();
+    }
+
+    const hr_time t2 = hr_clock::now();
+
+    std::cout
+        << name << ":\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / (double(NUM_ITERATIONS) * NUM_TESTS)
+        << " ns/item\t" << checksum << '\n';
+}
+
+void appendBench() {
+    std::cout << "Running append benchmarks." << std::endl;
+
+    appendBench< std::vector< int > >( "std::vector<int> push_back", []( std::vector< int >& a, int i ) {
+        a.push_back( i );
+    } );
+
+    appendBench< array< int > >( "array<int> pushBack", []( array< int >& a, int i ) {
+        a.pushBack( i );
+    } );
+
+    appendBench< std::vector< std::string > >( "std::vector<string> emplace_back", []( std::vector< std::string >& a, int i ) {
+        a.emplace_back( "An element too long for small string storage", i & 31 );
+    } );
+
+    appendBench< array< std::string > >( "array<string> emplaceBack", []( array< std::string >& a, int i ) {
+        a.emplaceBack( "An element too long for small string storage", i & 31 );
+    } );
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Copy Benchmark
+ * Compares bulk copies of trivially copyable types against a plain loop.
+******************************************************************************/
+template < typename type >
+void copyBench( const char* name ) {
+    const int numItems = NUM_TESTS * 16;
+    const unsigned numRuns = 64;
+
+    array< type > srcArray( type( 1 ), numItems );
+    hamLibs::utils::pointer< type > srcPtr( numItems );
+    type* const loopDest = new type[ numItems ];
+
+    hr_time t1, t2;
+    const double numCopied = double(numRuns) * numItems;
+
+    t1 = hr_clock::now();
+    for ( unsigned i = 0; i < numRuns; ++i ) {
+        const type* const src = srcArray.data();
+        for ( int j = 0; j < numItems; ++j ) {
+            loopDest[ j ] = src[ j ];
+        }
+        // keep the copies from being optimized away
+        srcArray[ i % numItems ] = loopDest[ (i * 7) % numItems ];
+    }
+    t2 = hr_clock::now();
+
+    std::cout
+        << name << " element loop:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numCopied
+        << " ns/item\n";
+
+    array< type > destArray;
+
+    t1 = hr_clock::now();
+    for ( unsigned i = 0; i < numRuns; ++i ) {
+        destArray = srcArray;
+        srcArray[ i % numItems ] = destArray[ (i * 7) % numItems ];
+    }
+    t2 = hr_clock::now();
+
+    std::cout
+        << name << " array copy:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numCopied
+        << " ns/item\n";
+
+    hamLibs::utils::pointer< type > destPtr;
+
+    t1 = hr_clock::now();
+    for ( unsigned i = 0; i < numRuns; ++i ) {
+        destPtr = srcPtr;
+        srcPtr[ i % numItems ] = destPtr[ (i * 7) % numItems ];
+    }
+    t2 = hr_clock::now();
+
+    std::cout
+        << name << " pointer copy:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numCopied
+        << " ns/item\n";
+
+    delete [] loopDest;
+}
+
+void copyBench() {
+    std::cout << "Running copy benchmarks." << std::endl;
+
+    copyBench< float >( "float" );
+    copyBench< hamLibs::math::vec4f >( "vec4f" );
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Small Array Benchmark
+ * Builds many short-lived arrays of a few elements each.
+******************************************************************************/
+template < typename array_t >
+void smallBench( const char* name ) {
+    const unsigned numArrays = NUM_TESTS * 64;
+    long long checksum = 0;
+
+    const hr_time t1 = hr_clock::now();
+
+    for ( unsigned i = 0; i < numArrays; ++i ) {
+        array_t testArray;
+
+        for ( unsigned j = 0; j < 1 + i % 6; ++j ) {
+            testArray.pushBack( i + j );
+        }
+        checksum += testArray.back();
+    }
+
+    const hr_time t2 = hr_clock::now();
+
+    std::cout
+        << name << ":\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / double(numArrays)
+        << " ns/array\t" << checksum << '\n';
+}
+
+void smallBench() {
+    std::cout << "Running small array benchmarks." << std::endl;
+
+    smallBench< array< int > >( "array<int>" );
+    smallBench< smallArray< int, 8 > >( "smallArray<int, 8>" );
+    smallBench< staticArray< int, 8 > >( "staticArray<int, 8>" );
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testArray();
+    testInlineArrays();
+    appendBench();
+    smallBench();
+    copyBench();
+}
@@ -2,13 +2,23 @@
 // binary tree tests
 // g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -pthread -g -O0 btree.cpp -o btree
 
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <cstring>
 #include <map>
+#include <new>
+#include <string>
 #include <chrono>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include "containers/btree.h"
+#include "containers/btreeimage.h"
+#include "containers/ptree.h"
+#include "containers/arttree.h"
+#include "defs/endian.h"
 
 #define NUM_ITERATIONS 4096
 #define NUM_TESTS 4096
@@ -22,6 +32,30 @@ Curabitur lobortis, sem at cursus cursus, felis lacus venenatis sapien, euismod
 
 namespace chrono = std::chrono;
 
+/******************************************************************************
+ * Heap Allocation Counting
+******************************************************************************/
+unsigned long long gNumAllocations = 0;
+unsigned long long gNumBytesAllocated = 0;
+
+void* operator new( std::size_t numBytes ) {
+    ++gNumAllocations;
+    gNumBytesAllocated += numBytes;
+    
+    if ( void* p = std::malloc( numBytes ? numBytes : 1 ) ) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC warns about free() being paired with operator new if this is inlined
+#ifdef HL_COMPILER_GNU
+__attribute__((noinline))
+#endif
+void operator delete( void* p ) noexcept {
+    std::free( p );
+}
+
 typedef chrono::steady_clock hr_clock;
 typedef hr_clock::time_point hr_time;
 typedef chrono::milliseconds hr_prec;
@@ -80,6 +114,747 @@ void bTreeBench() {
             << '\t' << testTree.size() << "\n\n";
 }
 
+/******************************************************************************
+ * PATRICIA Tree Benchmark
+******************************************************************************/
+void pTreeBench() {
+    std::cout.sync_with_stdio( false );
+    std::cout << "Running pTree benchmark." << std::endl;
+    
+    hamLibs::containers::pTree< int, int > testTree;
+    hr_time t1, t2;
+    unsigned numRuns = 0;
+    t1 = hr_clock::now();
+    
+    while ( numRuns < NUM_ITERATIONS ) {
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            testTree[ i ] = i + numRuns;
+        }
+        ++numRuns;
+    }
+    
+    t2 = hr_clock::now();
+    std::cout.precision( std::numeric_limits<double>::digits10 );
+    std::cout
+        << "pTree operation " << numRuns
+            << ":\t" << chrono::duration_cast< hr_prec >( t2 - t1 ).count() / 1000.0
+            << '\t' << testTree.size() << "\n\n";
+}
+
+/******************************************************************************
+ * Lookup Latency & Depth Benchmark
+******************************************************************************/
+template < typename tree_t >
+void lookupBench( const char* name, tree_t& testTree ) {
+    hr_time t1, t2;
+    unsigned numRuns = 0;
+    long long checksum = 0;
+    
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        testTree[ i ] = i;
+    }
+    
+    t1 = hr_clock::now();
+    
+    while ( numRuns < NUM_ITERATIONS ) {
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            checksum += testTree[ i ];
+        }
+        ++numRuns;
+    }
+    
+    t2 = hr_clock::now();
+    const double numLookups = double(NUM_ITERATIONS) * NUM_TESTS;
+    std::cout
+        << name << " lookup:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numLookups
+        << " ns/key\t" << checksum << '\n';
+}
+
+void lookupBench() {
+    std::cout << "Running lookup benchmarks." << std::endl;
+    
+    std::map< int, int > nativeTree;
+    hamLibs::containers::bTree< int, int > bitTree;
+    hamLibs::containers::pTree< int, int > patTree;
+    hamLibs::containers::artTree< int, int > radixTree;
+    
+    lookupBench( "STL Map", nativeTree );
+    lookupBench( "bTree", bitTree );
+    lookupBench( "pTree", patTree );
+    lookupBench( "artTree", radixTree );
+    
+    std::cout
+        << "bTree depth:\t" << sizeof( int ) * HL_BITS_PER_BYTE << '\n'
+        << "pTree depth:\t" << patTree.depth() << '\n'
+        << "artTree depth:\t" << radixTree.depth() - 1 << "\n\n";
+}
+
+/******************************************************************************
+ * Allocation Count & Bytes-Per-Key Benchmark
+******************************************************************************/
+template < typename tree_t >
+void memoryBench( const char* name ) {
+    const unsigned long long startAllocs = gNumAllocations;
+    const unsigned long long startBytes = gNumBytesAllocated;
+    
+    tree_t* testTree = new tree_t();
+    
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        (*testTree)[ i ] = i;
+    }
+    
+    std::cout
+        << name << " allocations:\t" << gNumAllocations - startAllocs
+        << "\tbytes/key:\t" << double(gNumBytesAllocated - startBytes) / NUM_TESTS
+        << '\n';
+    
+    delete testTree;
+}
+
+void memoryBench() {
+    std::cout << "Running memory benchmarks." << std::endl;
+    
+    memoryBench< std::map< int, int > >( "STL Map" );
+    memoryBench< hamLibs::containers::bTree< int, int > >( "bTree" );
+    memoryBench< hamLibs::containers::pTree< int, int > >( "pTree" );
+    memoryBench< hamLibs::containers::artTree< int, int > >( "artTree" );
+    
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * PATRICIA Tree Push/Pop Test
+******************************************************************************/
+void testPTree() {
+    std::cout << "\nTESTING PATRICIA TREE" << "\n";
+    
+    hamLibs::containers::pTree< int, int > testTree;
+    
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        testTree.push( i * 7, i );
+    }
+    
+    for ( int i = 0; i < NUM_TESTS; i += 2 ) {
+        testTree.pop( i * 7 );
+    }
+    
+    unsigned numErrors = 0;
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        const int* pData = testTree.getData( i * 7 );
+        
+        if ( (i % 2 == 0) == (pData != nullptr) || (pData && *pData != i) ) {
+            ++numErrors;
+        }
+    }
+    
+    hamLibs::containers::pTree< int, int > copyTree( testTree );
+    testTree.clear();
+    
+    std::cout << "P-Tree Errors: " << numErrors << "\n";
+    std::cout << "P-Tree Size: " << copyTree.size() << "\n";
+    std::cout << "P-Tree Depth: " << copyTree.depth() << "\n";
+}
+
+/******************************************************************************
+ * Adaptive Radix Tree Grow/Shrink Test
+******************************************************************************/
+void testArtTree() {
+    std::cout << "\nTESTING ADAPTIVE RADIX TREE" << "\n";
+    
+    hamLibs::containers::artTree< int, int > testTree;
+    
+    // Fill every node type on the lowest byte, then empty them out again
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        testTree.push( i, i );
+    }
+    
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        if ( i % 256 >= 2 ) {
+            testTree.pop( i );
+        }
+    }
+    
+    unsigned numErrors = 0;
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        const int* pData = testTree.getData( i );
+        
+        if ( (i % 256 < 2) != (pData != nullptr) || (pData && *pData != i) ) {
+            ++numErrors;
+        }
+    }
+    
+    hamLibs::containers::artTree< int, int > copyTree( testTree );
+    testTree.clear();
+    
+    std::cout << "ART Errors: " << numErrors << "\n";
+    std::cout << "ART Size: " << copyTree.size() << "\n";
+    std::cout << "ART Depth: " << copyTree.depth() - 1 << "\n";
+}
+
+/******************************************************************************
+ * Emplace Test
+ * Elements are built from constructor arguments or moved in, and replace
+ * whatever already lies at their key.
+******************************************************************************/
+template < typename tree_t >
+unsigned testTreeEmplace() {
+    tree_t testTree;
+    unsigned numErrors = 0;
+    
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        numErrors += testTree.emplace( i, 3, char( 'a' + i % 26 ) ).size() != 3;
+    }
+    numErrors += testTree.size() != NUM_TESTS;
+    
+    std::string value( loremIpsum );
+    testTree.push( 1, std::move( value ) );
+    numErrors += !value.empty() || *testTree.getData( 1 ) != loremIpsum;
+    
+    // the arguments may refer to the element being replaced
+    testTree.emplace( 1, *testTree.getData( 1 ), 0, 5 );
+    numErrors += *testTree.getData( 1 ) != "Lorem" || testTree.size() != NUM_TESTS;
+    numErrors += *testTree.getData( 2 ) != "ccc";
+    
+    return numErrors;
+}
+
+void testEmplace() {
+    std::cout << "\nTESTING TREE EMPLACEMENT" << "\n";
+    
+    unsigned numErrors = 0;
+    numErrors += testTreeEmplace< hamLibs::containers::bTree< int, std::string > >();
+    numErrors += testTreeEmplace< hamLibs::containers::pTree< int, std::string > >();
+    numErrors += testTreeEmplace< hamLibs::containers::artTree< int, std::string > >();
+    
+    // values stored within the nodes
+    hamLibs::containers::bTree< int, int > inlineTree;
+    numErrors += inlineTree.emplace( 4, 2 ) != 2 || inlineTree.emplace( 4 ) != 0 || inlineTree.size() != 1;
+    
+    std::cout << "Emplace Errors: " << numErrors << "\n";
+}
+
+/******************************************************************************
+ * B-Tree Ordered Iteration Test
+******************************************************************************/
+void testBTreeIterators() {
+    std::cout << "\nTESTING B-TREE ITERATORS" << "\n";
+    
+    const char* const words[] = {
+        "", "a", "ab", "abc", "abd", "b", "ba", "bab", "c", "ca", "cab", "cb"
+    };
+    const unsigned numWords = sizeof( words ) / sizeof( words[0] );
+    
+    // String keys are decomposed byte-by-byte when the key type is 'char'
+    hamLibs::containers::bTree< char, int > testTree;
+    std::map< std::string, int > nativeTree;
+    
+    for ( unsigned i = numWords; i--; ) {
+        testTree.push( *words[ i ], i );
+        nativeTree[ words[ i ] ] = i;
+    }
+    
+    unsigned numErrors = 0;
+    unsigned char keyBuf[ 8 ];
+    
+    // forward iteration must match the lexicographic order of std::map
+    std::map< std::string, int >::const_iterator nativeIter = nativeTree.begin();
+    for ( auto iter = testTree.begin(); iter != testTree.end(); ++iter, ++nativeIter ) {
+        iter.getKeyBytes( keyBuf );
+        
+        if ( *iter != nativeIter->second
+        || nativeIter->first != std::string( (const char*)keyBuf, iter.keySize() )
+        ) {
+            ++numErrors;
+        }
+    }
+    
+    // reverse iteration
+    std::map< std::string, int >::const_reverse_iterator nativeRIter = nativeTree.rbegin();
+    for ( auto iter = testTree.rbegin(); iter != testTree.rend(); ++iter, ++nativeRIter ) {
+        if ( *iter != nativeRIter->second ) {
+            ++numErrors;
+        }
+    }
+    
+    // bounds of keys which are and are not in the tree
+    const char* const bounds[] = { "", "aa", "ab", "abcd", "bb", "cb", "d" };
+    for ( const char* b : bounds ) {
+        auto lower = testTree.lowerBound( *b );
+        auto upper = testTree.upperBound( *b );
+        auto nativeLower = nativeTree.lower_bound( b );
+        auto nativeUpper = nativeTree.upper_bound( b );
+        
+        if ( (lower == testTree.end()) != (nativeLower == nativeTree.end())
+        || (lower != testTree.end() && *lower != nativeLower->second)
+        || (upper == testTree.end()) != (nativeUpper == nativeTree.end())
+        || (upper != testTree.end() && *upper != nativeUpper->second)
+        ) {
+            ++numErrors;
+        }
+    }
+    
+    // prefix scans
+    unsigned numPrefixed = 0;
+    auto range = testTree.prefixRange( *"ab" );
+    for ( auto iter = range.first; iter != range.second; ++iter ) {
+        ++numPrefixed;
+    }
+    
+    numErrors += numPrefixed != 3;
+    numErrors += testTree.prefixRange( *"abe" ).first != testTree.prefixRange( *"abe" ).second;
+    
+    // range deletion
+    range = testTree.prefixRange( *"c" );
+    testTree.pop( range.first, range.second );
+    
+    numErrors += testTree.size() != numWords - 4;
+    numErrors += testTree.hasData( *"ca" ) || !testTree.hasData( *"bab" );
+    numErrors += testTree.lowerBound( *"c" ) != testTree.end();
+    
+    // integer keys round-trip through an iterator's key bytes
+    hamLibs::containers::bTree< int, int > intTree;
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        intTree.push( i * 3, i );
+    }
+    
+    unsigned numVisited = 0;
+    for ( auto iter = intTree.begin(); iter != intTree.end(); ++iter ) {
+        int key = 0;
+        iter.getKeyBytes( keyBuf );
+        std::memcpy( &key, keyBuf, sizeof( int ) );
+        
+        numErrors += key != *iter * 3;
+        ++numVisited;
+    }
+    
+    numErrors += numVisited != intTree.size();
+    
+    for ( auto iter = intTree.begin(); iter != intTree.end(); ) {
+        iter = intTree.pop( iter );
+    }
+    
+    numErrors += intTree.size() != 0 || intTree.begin() != intTree.end();
+    
+    std::cout << "Iterator Errors: " << numErrors << "\n";
+}
+
+/******************************************************************************
+ * Ordered Scan Benchmark
+******************************************************************************/
+void scanBench() {
+    std::cout << "Running scan benchmarks." << std::endl;
+    
+    std::map< int, int > nativeTree;
+    hamLibs::containers::bTree< int, int > bitTree;
+    
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        nativeTree[ i ] = i;
+        bitTree[ i ] = i;
+    }
+    
+    hr_time t1, t2;
+    long long checksum = 0;
+    
+    t1 = hr_clock::now();
+    for ( unsigned i = 0; i < NUM_ITERATIONS; ++i ) {
+        for ( std::map< int, int >::const_iterator iter = nativeTree.begin(); iter != nativeTree.end(); ++iter ) {
+            checksum += iter->second;
+        }
+    }
+    t2 = hr_clock::now();
+    
+    const double numVisits = double(NUM_ITERATIONS) * NUM_TESTS;
+    std::cout
+        << "STL Map scan:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numVisits
+        << " ns/key\t" << checksum << '\n';
+    
+    checksum = 0;
+    t1 = hr_clock::now();
+    for ( unsigned i = 0; i < NUM_ITERATIONS; ++i ) {
+        for ( hamLibs::containers::bTree< int, int >::iterator iter = bitTree.begin(); iter != bitTree.end(); ++iter ) {
+            checksum += *iter;
+        }
+    }
+    t2 = hr_clock::now();
+    
+    std::cout
+        << "bTree scan:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numVisits
+        << " ns/key\t" << checksum << "\n\n";
+}
+
+/******************************************************************************
+ * B-Tree Pruning & Compaction Test
+******************************************************************************/
+void testBTreePruning() {
+    std::cout << "\nTESTING B-TREE PRUNING" << "\n";
+    
+    hamLibs::containers::bTree< int, int > testTree;
+    unsigned numErrors = 0;
+    
+    // churn through keys; the tree must not grow beyond its live contents
+    for ( int pass = 0; pass < 16; ++pass ) {
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            testTree.push( pass * NUM_TESTS + i, i );
+        }
+        
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            testTree.pop( pass * NUM_TESTS + i );
+        }
+        
+        numErrors += testTree.numBranches() != 0;
+    }
+    
+    const unsigned long churnBytes = testTree.numBytes();
+    
+    for ( int i = 0; i < NUM_TESTS * 4; ++i ) {
+        testTree.push( i, i );
+    }
+    
+    const unsigned fullBranches = testTree.numBranches();
+    
+    // remove most elements using both single and ranged pops
+    for ( int i = 0; i < NUM_TESTS * 2; ++i ) {
+        testTree.pop( i );
+    }
+    
+    testTree.pop( testTree.lowerBound( NUM_TESTS * 2 ), testTree.end() );
+    
+    for ( int i = 0; i < NUM_TESTS * 4; i += 64 ) {
+        testTree.push( i, i );
+    }
+    
+    numErrors += testTree.numBranches() >= fullBranches;
+    
+    const unsigned long sparseBytes = testTree.memoryUsage();
+    testTree.shrinkToFit();
+    
+    numErrors += testTree.memoryUsage() >= sparseBytes;
+    numErrors += testTree.size() != NUM_TESTS * 4 / 64;
+    
+    for ( int i = 0; i < NUM_TESTS * 4; ++i ) {
+        const int* pData = testTree.getData( i );
+        
+        if ( (i % 64 == 0) != (pData != nullptr) || (pData && *pData != i) ) {
+            ++numErrors;
+        }
+    }
+    
+    std::cout << "Pruning Errors: " << numErrors << "\n";
+    std::cout << "Bytes after churn:\t" << churnBytes << "\n";
+    std::cout << "Bytes before compaction:\t" << sparseBytes << "\n";
+    std::cout << "Bytes after compaction:\t" << testTree.memoryUsage() << "\n";
+}
+
+/******************************************************************************
+ * Corrupt B-Tree Images
+ * Damaged images must either be rejected by open() or make lookups fail.
+ * Lookups must never reach past the end of the image.
+******************************************************************************/
+template < typename image_t >
+unsigned testCorruptImage( const unsigned char* image, std::size_t numBytes, int numKeys ) {
+    using hamLibs::containers::bTreeImageHeader;
+    using hamLibs::containers::bTreeImageNode;
+    
+    const char* const imageFile = "btree_test_corrupt.bin";
+    unsigned numErrors = 0;
+    
+    // the buffer is sized exactly, so reading past its end trips sanitizers
+    unsigned char* const buffer = new unsigned char[ numBytes ];
+    bTreeImageHeader* const imgHeader = reinterpret_cast< bTreeImageHeader* >( buffer );
+    image_t corrupt;
+    
+    // a truncated file is rejected
+    std::memcpy( buffer, image, numBytes );
+    std::FILE* outFile = std::fopen( imageFile, "wb" );
+    numErrors += !outFile || std::fwrite( buffer, 1, numBytes / 2, outFile ) != numBytes / 2;
+    numErrors += outFile && std::fclose( outFile ) != 0;
+    numErrors += corrupt.open( imageFile );
+    std::remove( imageFile );
+    
+    // so is a root which points past the branches or data
+    const bTreeImageNode head = imgHeader->head;
+    imgHeader->head.subNodes = imgHeader->numBranches + 1;
+    numErrors += corrupt.open( buffer, numBytes );
+    imgHeader->head = head;
+    imgHeader->head.data = imgHeader->numData + 1;
+    numErrors += corrupt.open( buffer, numBytes );
+    imgHeader->head = head;
+    
+    // damaged branches are only found by the lookups which reach them; the
+    // top levels are left alone since every key passes through them
+    const std::size_t branchOffset = (sizeof( bTreeImageHeader ) + 15) & ~std::size_t( 15 );
+    bTreeImageNode* const nodes = reinterpret_cast< bTreeImageNode* >( buffer + branchOffset );
+    const std::size_t numNodes = imgHeader->numBranches * hamLibs::containers::BNODE_MAX;
+    
+    for ( std::size_t i = numNodes / 2; i < numNodes; i += 7 ) {
+        nodes[ i ].subNodes = nodes[ i ].subNodes ? 0xFFFFFFFF : 0;
+        nodes[ i ].data = nodes[ i ].data ? imgHeader->numData + 1 : 0;
+    }
+    
+    numErrors += !corrupt.open( buffer, numBytes );
+    
+    unsigned numFound = 0;
+    for ( int i = 0; i < numKeys; ++i ) {
+        const int* pData = corrupt.getData( i * 3 );
+        
+        numErrors += pData && (*pData < 0 || *pData >= numKeys);
+        numErrors += corrupt.hasData( i * 3 ) != (pData != nullptr);
+        numFound += pData != nullptr;
+    }
+    numErrors += numFound == 0 || numFound >= corrupt.size();
+    
+    corrupt.close();
+    delete [] buffer;
+    
+    return numErrors;
+}
+
+/******************************************************************************
+ * B-Tree Image Test & Startup Benchmark
+******************************************************************************/
+void testBTreeImage() {
+    std::cout << "\nTESTING B-TREE IMAGES" << "\n";
+    
+    typedef hamLibs::containers::bTreeImage< int, int > image_t;
+    const char* const imageFile = "btree_test_image.bin";
+    
+    hamLibs::containers::bTree< int, int > testTree;
+    hr_time t1, t2;
+    
+    t1 = hr_clock::now();
+    for ( int i = 0; i < NUM_TESTS * 16; ++i ) {
+        testTree.push( i * 3, i );
+    }
+    t2 = hr_clock::now();
+    const auto buildTime = chrono::duration_cast< chrono::microseconds >( t2 - t1 ).count();
+    
+    testTree.pop( 0 );
+    
+    unsigned numErrors = !image_t::write( testTree, imageFile );
+    
+    const unsigned long long startAllocs = gNumAllocations;
+    image_t image;
+    
+    t1 = hr_clock::now();
+    numErrors += !image.open( imageFile );
+    t2 = hr_clock::now();
+    const auto openTime = chrono::duration_cast< chrono::microseconds >( t2 - t1 ).count();
+    
+    numErrors += gNumAllocations != startAllocs;
+    numErrors += image.size() != testTree.size();
+    
+    for ( int i = 0; i < NUM_TESTS * 16; ++i ) {
+        const int* pData = image.getData( i * 3 );
+        
+        if ( (i == 0) != (pData == nullptr) || (pData && *pData != i) || image.hasData( i * 3 + 1 ) ) {
+            ++numErrors;
+        }
+    }
+    
+    // images can also be used directly from memory
+    unsigned char* buffer = new unsigned char[ image_t::imageSize( testTree ) ];
+    image_t::freeze( testTree, buffer );
+    
+    image_t memImage( buffer, image_t::imageSize( testTree ) );
+    numErrors += !memImage.isOpen() || *memImage.getData( 300 ) != 100;
+    numErrors += memImage.open( buffer, sizeof( hamLibs::containers::bTreeImageHeader ) );
+    
+    numErrors += testCorruptImage< image_t >( buffer, image_t::imageSize( testTree ), NUM_TESTS * 16 );
+    
+    delete [] buffer;
+    image.close();
+    std::remove( imageFile );
+    
+    std::cout << "Image Errors: " << numErrors << "\n";
+    std::cout << "Tree build time:\t" << buildTime << " us\n";
+    std::cout << "Image open time:\t" << openTime << " us\n";
+}
+
+/******************************************************************************
+ * Generate keys in the bTree's iteration order
+ * Bytes are walked from the lowest address, so a big-endian integer sorts
+ * the same way in the tree as it does numerically.
+******************************************************************************/
+std::vector< std::pair< int, int > > getSortedPairs( unsigned numPairs ) {
+    std::vector< std::pair< int, int > > pairs;
+    pairs.reserve( numPairs );
+    
+    for ( unsigned i = 0; i < numPairs; ++i ) {
+        const int key = HL_ENDIANNESS == hamLibs::utils::HL_LITTLE_ENDIAN
+            ? (int)hamLibs::utils::btol( (uint32_t)i )
+            : (int)i;
+        pairs.push_back( std::make_pair( key, (int)i ) );
+    }
+    
+    return pairs;
+}
+
+/******************************************************************************
+ * B-Tree Bulk Loading & Batched Lookup Test
+******************************************************************************/
+void testBTreeBatch() {
+    std::cout << "\nTESTING BULK LOADING & BATCHED LOOKUPS" << "\n";
+    
+    unsigned numErrors = 0;
+    const std::vector< std::pair< int, int > > pairs = getSortedPairs( NUM_TESTS );
+    
+    hamLibs::containers::bTree< int, int > testTree;
+    testTree.bulkLoad( pairs.begin(), pairs.end() );
+    numErrors += testTree.size() != NUM_TESTS;
+    
+    // iteration must visit the keys in the order they were loaded
+    unsigned i = 0;
+    for ( hamLibs::containers::bTree< int, int >::iterator iter = testTree.begin(); iter != testTree.end(); ++iter ) {
+        numErrors += *iter != pairs[ i++ ].second;
+    }
+    numErrors += i != NUM_TESTS;
+    
+    // unsorted input and duplicate keys follow the rules of push()
+    std::vector< std::pair< int, int > > unsorted;
+    for ( int j = NUM_TESTS * 2; j--; ) {
+        unsorted.push_back( std::make_pair( j % NUM_TESTS, j ) );
+    }
+    
+    hamLibs::containers::bTree< int, int > pushTree;
+    for ( int j = NUM_TESTS; j--; ) {
+        pushTree.push( j, j );
+    }
+    
+    testTree.clear();
+    testTree.bulkLoad( unsorted.begin(), unsorted.end() );
+    numErrors += testTree.size() != pushTree.size();
+    numErrors += testTree.numBranches() != pushTree.numBranches();
+    
+    for ( int j = 0; j < NUM_TESTS; ++j ) {
+        const int* pData = testTree.getData( j );
+        numErrors += !pData || *pData != j;
+    }
+    
+    // batches of every size must match individual lookups, including misses
+    std::vector< int > keys;
+    for ( int j = 0; j < NUM_TESTS * 2; j += 3 ) {
+        keys.push_back( j );
+    }
+    
+    std::vector< const int* > results( keys.size() );
+    for ( unsigned n = 0; n <= keys.size(); n += 1 + n / 2 ) {
+        std::fill( results.begin(), results.end(), nullptr );
+        testTree.findBatch( keys.begin(), n, results.data() );
+        
+        for ( unsigned j = 0; j < n; ++j ) {
+            numErrors += results[ j ] != testTree.getData( keys[ j ] );
+        }
+    }
+    
+    // string keys are passed by pointer
+    hamLibs::containers::bTree< char, int > strTree;
+    const char* strKeys[] = {testKey1, testKey2, testKey3, loremIpsum, "Hello", ""};
+    
+    strTree.push( *testKey1, 1 );
+    strTree.push( *testKey2, 2 );
+    strTree.push( *loremIpsum, 3 );
+    
+    const int* strResults[ 6 ];
+    strTree.findBatch( strKeys, 6, strResults );
+    
+    numErrors += !strResults[ 0 ] || *strResults[ 0 ] != 1;
+    numErrors += !strResults[ 1 ] || *strResults[ 1 ] != 2;
+    numErrors += strResults[ 2 ] != nullptr;
+    numErrors += !strResults[ 3 ] || *strResults[ 3 ] != 3;
+    numErrors += strResults[ 4 ] != nullptr;
+    numErrors += strResults[ 5 ] != nullptr;
+    
+    std::cout << "Batch Errors: " << numErrors << "\n";
+}
+
+/******************************************************************************
+ * B-Tree Bulk Loading & Batched Lookup Benchmark
+******************************************************************************/
+void batchBench() {
+    std::cout << "Running batch benchmarks." << std::endl;
+    
+    const unsigned numKeys = NUM_TESTS * 64;
+    const unsigned numRuns = 16;
+    const std::vector< std::pair< int, int > > pairs = getSortedPairs( numKeys );
+    
+    hr_time t1, t2;
+    
+    t1 = hr_clock::now();
+    for ( unsigned r = 0; r < numRuns; ++r ) {
+        hamLibs::containers::bTree< int, int > testTree;
+        for ( unsigned i = 0; i < numKeys; ++i ) {
+            testTree.push( pairs[ i ].first, pairs[ i ].second );
+        }
+    }
+    t2 = hr_clock::now();
+    
+    const double numInserts = double(numRuns) * numKeys;
+    std::cout
+        << "bTree push:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numInserts
+        << " ns/key\n";
+    
+    hamLibs::containers::bTree< int, int > testTree;
+    
+    t1 = hr_clock::now();
+    for ( unsigned r = 0; r < numRuns; ++r ) {
+        testTree.clear();
+        testTree.bulkLoad( pairs.begin(), pairs.end() );
+    }
+    t2 = hr_clock::now();
+    
+    std::cout
+        << "bTree bulkLoad:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numInserts
+        << " ns/key\n";
+    
+    // look keys up in a scattered order so each one misses the cache
+    std::vector< int > keys( numKeys );
+    for ( unsigned i = 0; i < numKeys; ++i ) {
+        keys[ i ] = pairs[ (i * 40503u) % numKeys ].first;
+    }
+    
+    long long checksum = 0;
+    
+    t1 = hr_clock::now();
+    for ( unsigned r = 0; r < numRuns; ++r ) {
+        for ( unsigned i = 0; i < numKeys; ++i ) {
+            if ( const int* pData = testTree.getData( keys[ i ] ) ) {
+                checksum += *pData;
+            }
+        }
+    }
+    t2 = hr_clock::now();
+    
+    std::cout
+        << "bTree getData:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numInserts
+        << " ns/key\t" << checksum << '\n';
+    
+    std::vector< const int* > results( numKeys );
+    checksum = 0;
+    
+    t1 = hr_clock::now();
+    for ( unsigned r = 0; r < numRuns; ++r ) {
+        testTree.findBatch( keys.begin(), numKeys, results.data() );
+        
+        for ( unsigned i = 0; i < numKeys; ++i ) {
+            if ( results[ i ] ) {
+                checksum += *results[ i ];
+            }
+        }
+    }
+    t2 = hr_clock::now();
+    
+    std::cout
+        << "bTree findBatch:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / numInserts
+        << " ns/key\t" << checksum << "\n\n";
+}
+
 /******************************************************************************
  * Test Copy function to return an initialized B-Tree
 ******************************************************************************/
@@ -168,9 +943,21 @@ int main() {
     testCopyOp();
     testMoveCtor();
     testMoveOp();
+    testPTree();
+    testArtTree();
+    testEmplace();
+    testBTreeIterators();
+    testBTreeImage();
+    testBTreePruning();
+    testBTreeBatch();
     
     // Multi-threaded benchmarks
     nativeBench();
     bTreeBench();
+    pTreeBench();
+    lookupBench();
+    memoryBench();
+    scanBench();
+    batchBench();
 }
 
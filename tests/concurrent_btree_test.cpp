@@ -0,0 +1,172 @@
+// concurrent binary tree tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -pthread -O2 concurrent_btree_test.cpp -o concurrent_btree
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "containers/btree.h"
+#include "containers/concurrentbtree.h"
+
+#define NUM_KEYS 4096
+#define NUM_LOOKUPS (1 << 21)
+
+namespace chrono = std::chrono;
+
+typedef chrono::steady_clock hr_clock;
+typedef hr_clock::time_point hr_time;
+
+/******************************************************************************
+ * bTree guarded by a single mutex, used as a baseline
+******************************************************************************/
+class lockedBTree {
+    private:
+        mutable std::mutex                      lock;
+        hamLibs::containers::bTree< int, int >  tree;
+
+    public:
+        void push( int k, int d ) {
+            std::lock_guard< std::mutex > guard( lock );
+            tree.push( k, d );
+        }
+
+        bool getData( int k, int& outData ) const {
+            std::lock_guard< std::mutex > guard( lock );
+            const int* pData = const_cast< hamLibs::containers::bTree< int, int >& >( tree ).getData( k );
+
+            if ( pData ) {
+                outData = *pData;
+            }
+            return pData != nullptr;
+        }
+};
+
+/******************************************************************************
+ * Read Throughput Benchmark
+******************************************************************************/
+template < typename tree_t >
+double readBench( const tree_t& testTree, unsigned numThreads ) {
+    std::vector< std::thread > threads;
+    std::atomic< long long > checksum{0};
+
+    const hr_time t1 = hr_clock::now();
+
+    for ( unsigned t = 0; t < numThreads; ++t ) {
+        threads.emplace_back( [&testTree, &checksum, t]() {
+            long long sum = 0;
+            int data = 0;
+
+            for ( unsigned i = 0; i < NUM_LOOKUPS; ++i ) {
+                if ( testTree.getData( (i + t * 977) % NUM_KEYS, data ) ) {
+                    sum += data;
+                }
+            }
+            checksum += sum;
+        } );
+    }
+
+    for ( std::thread& th : threads ) {
+        th.join();
+    }
+
+    const hr_time t2 = hr_clock::now();
+    const double seconds = chrono::duration_cast< chrono::duration< double > >( t2 - t1 ).count();
+
+    return double(NUM_LOOKUPS) * numThreads / seconds / 1000000.0;
+}
+
+void readBench() {
+    std::cout << "Running read scaling benchmark." << std::endl;
+
+    hamLibs::containers::concurrentBTree< int, int > concTree;
+    lockedBTree lockTree;
+
+    for ( int i = 0; i < NUM_KEYS; ++i ) {
+        concTree.push( i, i );
+        lockTree.push( i, i );
+    }
+
+    // Oversubscribed runs still show how each tree behaves under contention
+    unsigned maxThreads = std::thread::hardware_concurrency();
+    if ( maxThreads < 4 ) {
+        maxThreads = 4;
+    }
+
+    std::cout << "Threads\tconcurrentBTree (M/s)\tlocked bTree (M/s)\n";
+
+    for ( unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2 ) {
+        std::cout
+            << numThreads << '\t'
+            << readBench( concTree, numThreads ) << "\t\t\t"
+            << readBench( lockTree, numThreads ) << '\n';
+    }
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Concurrent Read/Write Stress Test
+ * Readers must only ever see a key's original value, its replacement, or
+ * nothing at all (if the key was popped).
+******************************************************************************/
+void testReadWrite() {
+    std::cout << "\nTESTING CONCURRENT READ/WRITE" << "\n";
+
+    hamLibs::containers::concurrentBTree< int, int > testTree;
+
+    for ( int i = 0; i < NUM_KEYS; ++i ) {
+        testTree.push( i, i );
+    }
+
+    std::atomic< bool > done{false};
+    std::atomic< unsigned > numErrors{0};
+    std::vector< std::thread > readers;
+
+    for ( unsigned t = 0; t < 4; ++t ) {
+        readers.emplace_back( [&]() {
+            int data = 0;
+
+            while ( !done.load() ) {
+                for ( int i = 0; i < NUM_KEYS; ++i ) {
+                    if ( testTree.getData( i, data ) && data != i && data != -i ) {
+                        ++numErrors;
+                    }
+                }
+            }
+        } );
+    }
+
+    for ( unsigned pass = 0; pass < 64; ++pass ) {
+        for ( int i = 0; i < NUM_KEYS; ++i ) {
+            if ( i % 3 == 0 ) {
+                testTree.pop( i );
+                testTree.push( i, i );
+            }
+            else {
+                testTree.push( i, (pass & 1) ? -i : i );
+            }
+        }
+    }
+
+    done = true;
+    for ( std::thread& th : readers ) {
+        th.join();
+    }
+
+    numErrors += testTree.size() != NUM_KEYS;
+    testTree.clear();
+    numErrors += testTree.size() != 0 || testTree.hasData( 1 );
+
+    std::cout << "Concurrent Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testReadWrite();
+    readBench();
+}
@@ -0,0 +1,742 @@
+// concurrent queue tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -pthread -O2 concurrent_queue_test.cpp -o concurrent_queue
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "containers/mpmcqueue.h"
+#include "containers/spscqueue.h"
+#include "containers/workstealingdeque.h"
+
+#define NUM_ITEMS (1 << 20)
+#define QUEUE_SIZE 1024
+#define BATCH_SIZE 32
+
+namespace chrono = std::chrono;
+namespace containers = hamLibs::containers;
+
+typedef chrono::steady_clock hr_clock;
+typedef hr_clock::time_point hr_time;
+
+/******************************************************************************
+ * std::queue guarded by a single mutex, used as a baseline
+******************************************************************************/
+class lockedQueue {
+    private:
+        std::mutex              lock;
+        std::queue< unsigned >  items;
+
+    public:
+        explicit lockedQueue( unsigned ) {}
+
+        bool tryPush( unsigned i ) {
+            std::lock_guard< std::mutex > guard( lock );
+            items.push( i );
+            return true;
+        }
+
+        bool tryPop( unsigned& outData ) {
+            std::lock_guard< std::mutex > guard( lock );
+            if ( items.empty() ) {
+                return false;
+            }
+            outData = items.front();
+            items.pop();
+            return true;
+        }
+};
+
+/******************************************************************************
+ * std::deque guarded by a single mutex, used as a work-stealing baseline
+******************************************************************************/
+class lockedDeque {
+    private:
+        std::mutex              lock;
+        std::deque< unsigned >  items;
+
+    public:
+        explicit lockedDeque( unsigned ) {}
+
+        void push( unsigned i ) {
+            std::lock_guard< std::mutex > guard( lock );
+            items.push_back( i );
+        }
+
+        bool pop( unsigned& outData ) {
+            std::lock_guard< std::mutex > guard( lock );
+            if ( items.empty() ) {
+                return false;
+            }
+            outData = items.back();
+            items.pop_back();
+            return true;
+        }
+
+        bool steal( unsigned& outData ) {
+            std::lock_guard< std::mutex > guard( lock );
+            if ( items.empty() ) {
+                return false;
+            }
+            outData = items.front();
+            items.pop_front();
+            return true;
+        }
+};
+
+/******************************************************************************
+ * Helpers
+******************************************************************************/
+// Counts live objects so leaks and double-destruction show up
+struct counted {
+    static std::atomic< int > numLive;
+    int value;
+
+    counted( int v = 0 ) : value( v ) { ++numLive; }
+    counted( const counted& c ) : value( c.value ) { ++numLive; }
+    ~counted() { --numLive; }
+    counted& operator=( const counted& ) = default;
+};
+
+std::atomic< int > counted::numLive{0};
+
+// Run producers and consumers over a queue. Each producer pushes
+// 'numItems / numProducers' values tagged with its own index in the top
+// byte. Consumers check that every producer's values arrive in order and
+// return the sum of everything popped. Returns the number of errors found.
+template < typename queue_t >
+unsigned runProducersConsumers(
+    queue_t& q,
+    unsigned numProducers,
+    unsigned numConsumers,
+    unsigned numItems,
+    unsigned long long& outSum
+) {
+    const unsigned perProducer = numItems / numProducers;
+    const unsigned total = perProducer * numProducers;
+
+    std::atomic< unsigned > numPopped{0};
+    std::atomic< unsigned > numErrors{0};
+    std::atomic< unsigned long long > sum{0};
+    std::vector< std::thread > threads;
+
+    for ( unsigned p = 0; p < numProducers; ++p ) {
+        threads.emplace_back( [&, p]() {
+            for ( unsigned i = 0; i < perProducer; ++i ) {
+                while ( !q.tryPush( (p << 24) | i ) ) {
+                    std::this_thread::yield();
+                }
+            }
+        } );
+    }
+
+    for ( unsigned c = 0; c < numConsumers; ++c ) {
+        threads.emplace_back( [&]() {
+            std::vector< unsigned > lastSeen( numProducers, 0 );
+            unsigned long long localSum = 0;
+            unsigned item = 0;
+
+            while ( numPopped.load( std::memory_order_relaxed ) < total ) {
+                if ( !q.tryPop( item ) ) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                const unsigned p = item >> 24;
+                const unsigned i = item & 0xFFFFFF;
+
+                if ( p >= numProducers || (i != 0 && i <= lastSeen[ p ]) ) {
+                    ++numErrors;
+                }
+                else {
+                    lastSeen[ p ] = i;
+                }
+
+                localSum += i;
+                numPopped.fetch_add( 1, std::memory_order_relaxed );
+            }
+
+            sum += localSum;
+        } );
+    }
+
+    for ( std::thread& th : threads ) {
+        th.join();
+    }
+
+    outSum = sum;
+    return numErrors + (numPopped != total);
+}
+
+// Move 'numItems' sequential values from one thread to another through an
+// spscQueue, filling and draining slots in place up to 'batchSize' at a
+// time. Returns the number of values which arrived out of order.
+template < typename queue_t >
+unsigned runSpscBatches( queue_t& q, unsigned numItems, unsigned batchSize ) {
+    unsigned numErrors = 0;
+
+    std::thread producer( [&q, numItems, batchSize]() {
+        unsigned* slots = nullptr;
+
+        for ( unsigned i = 0; i < numItems; ) {
+            const unsigned wanted = (numItems - i < batchSize) ? numItems - i : batchSize;
+            const unsigned count = q.reserveWrite( wanted, slots );
+
+            for ( unsigned j = 0; j < count; ++j ) {
+                slots[ j ] = i++;
+            }
+
+            if ( count ) {
+                q.commitWrite( count );
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    } );
+
+    unsigned* items = nullptr;
+    for ( unsigned expected = 0; expected < numItems; ) {
+        const unsigned count = q.peekRead( batchSize, items );
+
+        for ( unsigned j = 0; j < count; ++j ) {
+            numErrors += items[ j ] != expected++;
+        }
+
+        if ( count ) {
+            q.releaseRead( count );
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    return numErrors;
+}
+
+// The owner of a deque pushes 'numItems' values in bursts, popping half of
+// each burst back, while thieves steal. Every value must be taken exactly
+// once. Returns the number of errors found, and the number of values which
+// were stolen in 'outStolen'.
+template < typename deque_t >
+unsigned runOwnerThieves( deque_t& dq, unsigned numThieves, unsigned numItems, unsigned& outStolen ) {
+    std::vector< std::atomic< unsigned > > hits( numItems );
+    std::atomic< bool > done{false};
+    std::atomic< unsigned > numStolen{0};
+    std::vector< std::thread > thieves;
+
+    for ( unsigned t = 0; t < numThieves; ++t ) {
+        thieves.emplace_back( [&]() {
+            unsigned stolen = 0;
+            unsigned item = 0;
+
+            while ( !done.load( std::memory_order_relaxed ) ) {
+                if ( dq.steal( item ) ) {
+                    hits[ item ].fetch_add( 1, std::memory_order_relaxed );
+                    ++stolen;
+                }
+            }
+
+            numStolen += stolen;
+        } );
+    }
+
+    unsigned item = 0;
+    for ( unsigned i = 0; i < numItems; ) {
+        const unsigned burst = (numItems - i < 64) ? numItems - i : 64;
+
+        for ( unsigned j = 0; j < burst; ++j ) {
+            dq.push( i++ );
+        }
+        for ( unsigned j = 0; j < burst / 2; ++j ) {
+            if ( dq.pop( item ) ) {
+                hits[ item ].fetch_add( 1, std::memory_order_relaxed );
+            }
+        }
+    }
+
+    // a failed pop means the deque is empty, even if a thief took the last value
+    while ( dq.pop( item ) ) {
+        hits[ item ].fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    done = true;
+    for ( std::thread& th : thieves ) {
+        th.join();
+    }
+
+    unsigned numErrors = 0;
+    for ( const std::atomic< unsigned >& h : hits ) {
+        numErrors += h.load() != 1;
+    }
+
+    outStolen = numStolen;
+    return numErrors;
+}
+
+/******************************************************************************
+ * MPMC Queue Tests
+******************************************************************************/
+unsigned testMpmcSingleThread() {
+    unsigned numErrors = 0;
+    containers::mpmcQueue< int > q( 100 );
+    int item = 0;
+
+    // capacity is rounded up to a power of two
+    numErrors += q.capacity() != 128 || !q.empty() || q.tryPop( item );
+
+    // several laps around the ring
+    for ( int lap = 0; lap < 4; ++lap ) {
+        for ( int i = 0; i < 128; ++i ) {
+            numErrors += !q.tryPush( i );
+        }
+        numErrors += q.tryPush( 128 ) || q.size() != 128;
+
+        for ( int i = 0; i < 128; ++i ) {
+            numErrors += !q.tryPop( item ) || item != i;
+        }
+        numErrors += q.tryPop( item ) || !q.empty();
+    }
+
+    // batches stop at the ends of the queue
+    std::vector< int > items( 200 );
+    for ( int i = 0; i < 200; ++i ) {
+        items[ i ] = i;
+    }
+    numErrors += q.tryPushBatch( items.data(), 100 ) != 100;
+    numErrors += q.tryPushBatch( items.data() + 100, 100 ) != 28;
+    numErrors += q.tryPushBatch( items.data(), 0 ) != 0;
+
+    std::vector< int > popped( 200, -1 );
+    numErrors += q.tryPopBatch( popped.data(), 50 ) != 50;
+    numErrors += q.tryPopBatch( popped.data() + 50, 200 ) != 78;
+    numErrors += q.tryPopBatch( popped.data(), 10 ) != 0;
+    for ( int i = 0; i < 128; ++i ) {
+        numErrors += popped[ i ] != i;
+    }
+
+    // batches and single pushes mix
+    numErrors += !q.tryEmplace( -1 ) || q.tryPushBatch( items.data(), 3 ) != 3;
+    numErrors += !q.tryPop( item ) || item != -1;
+    numErrors += q.tryPopBatch( popped.data(), 8 ) != 3 || popped[ 2 ] != 2;
+
+    return numErrors;
+}
+
+unsigned testMpmcObjects() {
+    unsigned numErrors = 0;
+
+    {
+        containers::mpmcQueue< std::unique_ptr< int > > q( 4 );
+        std::unique_ptr< int > p;
+
+        numErrors += !q.tryPush( std::unique_ptr< int >( new int( 1 ) ) );
+        numErrors += !q.tryEmplace( new int( 2 ) );
+        numErrors += !q.tryPop( p ) || *p != 1;
+        numErrors += !q.tryPop( p ) || *p != 2;
+    }
+
+    // elements left in the queue are destroyed along with it
+    {
+        containers::mpmcQueue< counted > q( 16 );
+        counted c;
+
+        for ( int i = 0; i < 10; ++i ) {
+            q.tryEmplace( i );
+        }
+        q.tryPop( c );
+        numErrors += counted::numLive != 10;
+    }
+    numErrors += counted::numLive != 0;
+
+    return numErrors;
+}
+
+unsigned testMpmcThreads() {
+    unsigned numErrors = 0;
+    const unsigned numItems = NUM_ITEMS / 4;
+
+    const unsigned configs[][ 2 ] = { { 1, 1 }, { 4, 1 }, { 1, 4 }, { 4, 4 } };
+
+    for ( const auto& config : configs ) {
+        containers::mpmcQueue< unsigned > q( 64 );
+        unsigned long long sum = 0;
+
+        numErrors += runProducersConsumers( q, config[ 0 ], config[ 1 ], numItems, sum );
+
+        const unsigned long long perProducer = numItems / config[ 0 ];
+        numErrors += sum != config[ 0 ] * (perProducer * (perProducer - 1) / 2);
+        numErrors += !q.empty();
+    }
+
+    // batch producers against batch consumers
+    containers::mpmcQueue< unsigned > q( 256 );
+    std::atomic< unsigned long long > sum{0};
+    std::vector< std::thread > threads;
+
+    for ( unsigned t = 0; t < 2; ++t ) {
+        threads.emplace_back( [&q, numItems]() {
+            unsigned batch[ BATCH_SIZE ];
+            for ( unsigned i = 0; i < numItems; i += BATCH_SIZE ) {
+                for ( unsigned j = 0; j < BATCH_SIZE; ++j ) {
+                    batch[ j ] = i + j;
+                }
+                for ( unsigned j = 0; j < BATCH_SIZE; ) {
+                    j += q.tryPushBatch( batch + j, BATCH_SIZE - j );
+                }
+            }
+        } );
+
+        threads.emplace_back( [&q, &sum, numItems]() {
+            unsigned batch[ BATCH_SIZE ];
+            unsigned long long localSum = 0;
+            for ( unsigned n = 0; n < numItems; ) {
+                const unsigned count = q.tryPopBatch( batch, BATCH_SIZE );
+                for ( unsigned j = 0; j < count; ++j ) {
+                    localSum += batch[ j ];
+                }
+                n += count;
+            }
+            sum += localSum;
+        } );
+    }
+
+    for ( std::thread& th : threads ) {
+        th.join();
+    }
+    numErrors += sum != 2ull * numItems * (numItems - 1) / 2 || !q.empty();
+
+    return numErrors;
+}
+
+void testMpmcQueue() {
+    std::cout << "\nTESTING MPMC QUEUE" << "\n";
+
+    unsigned numErrors = 0;
+    numErrors += testMpmcSingleThread();
+    numErrors += testMpmcObjects();
+    numErrors += testMpmcThreads();
+
+    std::cout << "MPMC Queue Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * SPSC Queue Tests
+******************************************************************************/
+unsigned testSpscSingleThread() {
+    unsigned numErrors = 0;
+    containers::spscQueue< int > q( 12 );
+    int item = 0;
+    int* slots = nullptr;
+
+    // capacity is rounded up to a power of two, and every slot is usable
+    numErrors += q.capacity() != 16 || !q.empty() || q.tryPop( item );
+
+    for ( int lap = 0; lap < 4; ++lap ) {
+        for ( int i = 0; i < 16; ++i ) {
+            numErrors += !q.tryPush( i );
+        }
+        numErrors += q.tryPush( 16 ) || q.size() != 16;
+        numErrors += q.reserveWrite( 1, slots ) != 0;
+
+        for ( int i = 0; i < 16; ++i ) {
+            numErrors += !q.tryPop( item ) || item != i;
+        }
+        numErrors += q.tryPop( item ) || !q.empty();
+    }
+
+    // reserved runs stop at the end of the ring
+    for ( int i = 0; i < 10; ++i ) {
+        q.tryPush( i );
+        q.tryPop( item );
+    }
+    numErrors += q.reserveWrite( 8, slots ) != 6;
+    for ( int i = 0; i < 6; ++i ) {
+        slots[ i ] = 100 + i;
+    }
+
+    // nothing is visible until it is committed, and only what is committed
+    numErrors += q.peekRead( 1, slots ) != 0;
+    q.commitWrite( 4 );
+    numErrors += q.size() != 4;
+    numErrors += q.reserveWrite( 8, slots ) != 2 || slots[ 0 ] != 104;
+    q.commitWrite( 0 );
+
+    numErrors += q.reserveWrite( 20, slots ) != 2;
+    numErrors += q.reserveWrite( 20, slots ) != 2;   // reserving again hands back the same run
+    q.commitWrite( 2 );
+    numErrors += q.reserveWrite( 20, slots ) != 10;
+    for ( int i = 0; i < 10; ++i ) {
+        slots[ i ] = 200 + i;
+    }
+    q.commitWrite( 10 );
+    numErrors += q.size() != 16;
+
+    // peeked runs also stop at the end of the ring
+    numErrors += q.peekRead( 16, slots ) != 6 || slots[ 0 ] != 100 || slots[ 5 ] != 105;
+    numErrors += q.peekRead( 16, slots ) != 6;
+    q.releaseRead( 3 );
+    numErrors += !q.tryPop( item ) || item != 103;
+    numErrors += q.peekRead( 16, slots ) != 2 || slots[ 1 ] != 105;
+    q.releaseRead( 2 );
+    numErrors += q.peekRead( 16, slots ) != 10 || slots[ 0 ] != 200 || slots[ 9 ] != 209;
+    q.releaseRead( 10 );
+    numErrors += !q.empty();
+
+    return numErrors;
+}
+
+unsigned testSpscObjects() {
+    unsigned numErrors = 0;
+
+    {
+        containers::spscQueue< std::unique_ptr< int > > q( 4 );
+        std::unique_ptr< int > p( new int( 1 ) );
+
+        numErrors += !q.tryPush( std::move( p ) ) || p;
+        numErrors += !q.tryPush( std::unique_ptr< int >( new int( 2 ) ) );
+        numErrors += !q.tryPop( p ) || *p != 1;
+
+        // elements are filled in place
+        std::unique_ptr< int >* slots = nullptr;
+        numErrors += q.reserveWrite( 2, slots ) != 2;
+        slots[ 0 ].reset( new int( 3 ) );
+        slots[ 1 ].reset( new int( 4 ) );
+        q.commitWrite( 2 );
+
+        numErrors += !q.tryPop( p ) || *p != 2;
+        numErrors += q.peekRead( 2, slots ) != 2 || *slots[ 0 ] != 3 || *slots[ 1 ] != 4;
+        q.releaseRead( 2 );
+    }
+
+    // every slot holds a live element until the queue is destroyed
+    {
+        containers::spscQueue< counted > q( 8 );
+        numErrors += counted::numLive != 8;
+        q.tryPush( counted( 1 ) );
+        numErrors += counted::numLive != 8;
+    }
+    numErrors += counted::numLive != 0;
+
+    return numErrors;
+}
+
+unsigned testSpscThreads() {
+    unsigned numErrors = 0;
+    const unsigned numItems = NUM_ITEMS / 4;
+
+    for ( unsigned size = 1; size <= 256; size *= 16 ) {
+        containers::spscQueue< unsigned > q( size );
+        unsigned long long sum = 0;
+
+        numErrors += runProducersConsumers( q, 1, 1, numItems, sum );
+        numErrors += sum != (unsigned long long)numItems * (numItems - 1) / 2;
+
+        numErrors += runSpscBatches( q, numItems, 1 );
+        numErrors += runSpscBatches( q, numItems, BATCH_SIZE );
+        numErrors += !q.empty();
+    }
+
+    return numErrors;
+}
+
+void testSpscQueue() {
+    std::cout << "\nTESTING SPSC QUEUE" << "\n";
+
+    unsigned numErrors = 0;
+    numErrors += testSpscSingleThread();
+    numErrors += testSpscObjects();
+    numErrors += testSpscThreads();
+
+    std::cout << "SPSC Queue Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Work-Stealing Deque Tests
+******************************************************************************/
+unsigned testStealingSingleThread() {
+    unsigned numErrors = 0;
+    containers::workStealingDeque< unsigned > dq( 3 );
+    unsigned item = 0;
+
+    numErrors += dq.capacity() != 4 || !dq.empty();
+    numErrors += dq.pop( item ) || dq.steal( item );
+
+    // the owner pops newest first, thieves steal oldest first
+    for ( unsigned i = 0; i < 1000; ++i ) {
+        dq.push( i );
+    }
+    numErrors += dq.size() != 1000 || dq.capacity() != 1024;
+
+    for ( unsigned i = 0; i < 500; ++i ) {
+        numErrors += !dq.steal( item ) || item != i;
+        numErrors += !dq.pop( item ) || item != 999 - i;
+    }
+    numErrors += dq.pop( item ) || dq.steal( item ) || !dq.empty();
+
+    // indices keep counting up around the ring after it empties
+    for ( unsigned lap = 0; lap < 4; ++lap ) {
+        for ( unsigned i = 0; i < 700; ++i ) {
+            dq.push( i );
+        }
+        for ( unsigned i = 0; i < 700; ++i ) {
+            numErrors += !dq.steal( item ) || item != i;
+        }
+    }
+    numErrors += dq.capacity() != 1024;
+
+    // pointers are the usual tasks
+    int tasks[ 3 ] = { 0, 1, 2 };
+    containers::workStealingDeque< int* > taskDeque;
+    int* task = nullptr;
+    for ( int& t : tasks ) {
+        taskDeque.push( &t );
+    }
+    numErrors += !taskDeque.steal( task ) || task != &tasks[ 0 ];
+    numErrors += !taskDeque.pop( task ) || task != &tasks[ 2 ];
+
+    return numErrors;
+}
+
+unsigned testStealingThreads() {
+    unsigned numErrors = 0;
+    unsigned numStolen = 0;
+
+    for ( unsigned numThieves = 1; numThieves <= 4; numThieves *= 2 ) {
+        // start small so that the deque grows while thieves are stealing
+        containers::workStealingDeque< unsigned > dq( 2 );
+
+        numErrors += runOwnerThieves( dq, numThieves, NUM_ITEMS / 4, numStolen );
+        numErrors += !dq.empty();
+    }
+
+    return numErrors;
+}
+
+void testWorkStealingDeque() {
+    std::cout << "\nTESTING WORK-STEALING DEQUE" << "\n";
+
+    unsigned numErrors = 0;
+    numErrors += testStealingSingleThread();
+    numErrors += testStealingThreads();
+
+    std::cout << "Work-Stealing Deque Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Throughput Benchmarks
+******************************************************************************/
+template < typename queue_t >
+double queueBench( unsigned numProducers, unsigned numConsumers ) {
+    queue_t q( QUEUE_SIZE );
+    unsigned long long sum = 0;
+
+    const hr_time t1 = hr_clock::now();
+    runProducersConsumers( q, numProducers, numConsumers, NUM_ITEMS, sum );
+    const hr_time t2 = hr_clock::now();
+
+    const double seconds = chrono::duration_cast< chrono::duration< double > >( t2 - t1 ).count();
+    return double(NUM_ITEMS) / seconds / 1000000.0;
+}
+
+void mpmcBench() {
+    std::cout << "Running MPMC queue throughput benchmark." << std::endl;
+
+    // Oversubscribed runs still show how each queue behaves under contention
+    unsigned maxThreads = std::thread::hardware_concurrency() / 2;
+    if ( maxThreads < 4 ) {
+        maxThreads = 4;
+    }
+
+    std::cout << "Producers\tConsumers\tmpmcQueue (M/s)\tlocked std::queue (M/s)\n";
+
+    for ( unsigned numProducers = 1; numProducers <= maxThreads; numProducers *= 2 ) {
+        for ( unsigned numConsumers = 1; numConsumers <= maxThreads; numConsumers *= 2 ) {
+            std::cout
+                << numProducers << "\t\t" << numConsumers << "\t\t"
+                << queueBench< containers::mpmcQueue< unsigned > >( numProducers, numConsumers ) << "\t\t"
+                << queueBench< lockedQueue >( numProducers, numConsumers ) << '\n';
+        }
+    }
+
+    std::cout << '\n';
+}
+
+void spscBench() {
+    std::cout << "Running SPSC queue throughput benchmark." << std::endl;
+    std::cout << "Single producer and consumer (M/s)\n";
+
+    std::cout << "spscQueue push/pop:\t" << queueBench< containers::spscQueue< unsigned > >( 1, 1 ) << '\n';
+
+    for ( unsigned batchSize = 8; batchSize <= 64; batchSize *= 8 ) {
+        containers::spscQueue< unsigned > q( QUEUE_SIZE );
+
+        const hr_time t1 = hr_clock::now();
+        runSpscBatches( q, NUM_ITEMS, batchSize );
+        const hr_time t2 = hr_clock::now();
+
+        const double seconds = chrono::duration_cast< chrono::duration< double > >( t2 - t1 ).count();
+        std::cout << "spscQueue batch of " << batchSize << ":\t" << double(NUM_ITEMS) / seconds / 1000000.0 << '\n';
+    }
+
+    std::cout << "mpmcQueue push/pop:\t" << queueBench< containers::mpmcQueue< unsigned > >( 1, 1 ) << '\n';
+    std::cout << "locked std::queue:\t" << queueBench< lockedQueue >( 1, 1 ) << '\n';
+
+    std::cout << '\n';
+}
+
+template < typename deque_t >
+double stealingBench( unsigned numThieves, unsigned& outStolen ) {
+    deque_t dq( QUEUE_SIZE );
+
+    const hr_time t1 = hr_clock::now();
+    runOwnerThieves( dq, numThieves, NUM_ITEMS, outStolen );
+    const hr_time t2 = hr_clock::now();
+
+    const double seconds = chrono::duration_cast< chrono::duration< double > >( t2 - t1 ).count();
+    return double(NUM_ITEMS) / seconds / 1000000.0;
+}
+
+void workStealingBench() {
+    std::cout << "Running work-stealing deque throughput benchmark." << std::endl;
+
+    unsigned maxThreads = std::thread::hardware_concurrency();
+    if ( maxThreads < 4 ) {
+        maxThreads = 4;
+    }
+
+    std::cout << "Thieves\tworkStealingDeque (M/s)\tstolen\tlocked std::deque (M/s)\tstolen\n";
+
+    for ( unsigned numThieves = 0; numThieves < maxThreads; numThieves = numThieves ? numThieves * 2 : 1 ) {
+        unsigned stolen = 0;
+        unsigned lockedStolen = 0;
+        const double rate = stealingBench< containers::workStealingDeque< unsigned > >( numThieves, stolen );
+        const double lockedRate = stealingBench< lockedDeque >( numThieves, lockedStolen );
+
+        std::cout
+            << numThieves << '\t'
+            << rate << "\t\t\t" << stolen << '\t'
+            << lockedRate << "\t\t\t" << lockedStolen << '\n';
+    }
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testMpmcQueue();
+    testSpscQueue();
+    testWorkStealingDeque();
+    mpmcBench();
+    spscBench();
+    workStealingBench();
+}
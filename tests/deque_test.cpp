@@ -0,0 +1,275 @@
+// block deque tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -O2 deque_test.cpp -o deque
+
+#include <deque>
+#include <iostream>
+#include <random>
+#include <utility>
+
+#include "containers/array.h"
+#include "containers/deque.h"
+#include "containers/list.h"
+#include "testUtils.h"
+
+#define NUM_ITERATIONS 64
+#define NUM_TESTS 65536
+
+using hamLibs::containers::array;
+using hamLibs::containers::deque;
+using hamLibs::containers::list;
+
+/******************************************************************************
+ * Deque Test
+ * Runs random operations against both ends and compares with std::deque.
+******************************************************************************/
+template < typename type >
+unsigned compareDeques( const deque< type >& testDeque, const std::deque< type >& expected ) {
+    unsigned numErrors = testDeque.size() != int(expected.size());
+
+    for ( int i = 0; !numErrors && i < testDeque.size(); ++i ) {
+        numErrors += testDeque[ i ] != expected[ i ];
+    }
+
+    // the blocks must cover every element, in order
+    int index = 0;
+    for ( int b = 0; !numErrors && b < testDeque.numBlocks(); ++b ) {
+        const type* const block = testDeque.blockData( b );
+        for ( int i = 0; i < testDeque.blockSize( b ); ++i, ++index ) {
+            numErrors += block[ i ] != expected[ index ];
+        }
+    }
+
+    return numErrors + (index != int(expected.size()));
+}
+
+void testDeque() {
+    std::cout << "\nTESTING DEQUE" << "\n";
+
+    unsigned numErrors = 0;
+
+    {
+        deque< tracked > testDeque;
+        std::deque< tracked > expected;
+        std::mt19937 rng( 1 );
+
+        for ( int i = 0; i < NUM_TESTS * 4; ++i ) {
+            // drift between growing and shrinking so the deque repeatedly
+            // crosses block boundaries at both ends
+            const unsigned op = rng() % ((i / 4096) % 2 ? 6 : 3);
+
+            switch ( op ) {
+                case 0: testDeque.pushBack( tracked( i ) ); expected.push_back( tracked( i ) ); break;
+                case 1: testDeque.emplaceFront( i ); expected.emplace_front( i ); break;
+                case 2: case 4:
+                    testDeque.popBack();
+                    if ( !expected.empty() ) expected.pop_back();
+                    break;
+                default:
+                    testDeque.popFront();
+                    if ( !expected.empty() ) expected.pop_front();
+                    break;
+            }
+
+            if ( i % 1024 == 0 ) {
+                numErrors += compareDeques( testDeque, expected );
+            }
+        }
+        numErrors += compareDeques( testDeque, expected );
+
+        // references stay valid while elements are added at either end
+        testDeque.pushBack( tracked( -2 ) );
+        const tracked* const pBack = &testDeque.back();
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            testDeque.pushFront( testDeque.back() );
+            testDeque.pushBack( testDeque.front() );
+        }
+        numErrors += &testDeque[ testDeque.size() - 1 - NUM_TESTS ] != pBack;
+        numErrors += testDeque.front().value != -2 || testDeque.back().value != -2;
+
+        // copies and moves
+        deque< tracked > copyDeque( testDeque );
+        numErrors += copyDeque != testDeque;
+
+        deque< tracked > moveDeque( std::move( copyDeque ) );
+        numErrors += moveDeque != testDeque || !copyDeque.empty();
+
+        copyDeque = moveDeque;
+        moveDeque = std::move( copyDeque );
+        numErrors += moveDeque != testDeque;
+
+        moveDeque.clear();
+        moveDeque.shrinkToFit();
+        numErrors += !moveDeque.empty() || moveDeque.numBlocks() != 0;
+        moveDeque.pushFront( tracked( 3 ) );
+        numErrors += moveDeque.front().value != 3;
+    }
+
+    numErrors += tracked::numAlive != 0;
+
+    std::cout << "Deque Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Benchmarks
+******************************************************************************/
+// sum every element of a list, walking it with its internal iterator
+long long sumList( list< int >& l ) {
+    long long sum = 0;
+    l.goToFront();
+    for ( int i = 0; i < l.size(); ++i ) {
+        sum += *l.getCurrent();
+        l.goToNext();
+    }
+    return sum;
+}
+
+void pushFrontBench() {
+    std::cout << "Running pushFront/popFront benchmarks." << std::endl;
+
+    // arrays shift every element, so they only get a fraction of the items
+    const int numArrayItems = NUM_TESTS / 16;
+
+    runBench( "array<int>", 4, numArrayItems, [=]() {
+        array< int > a;
+        for ( int i = 0; i < numArrayItems; ++i ) {
+            a.pushFront( i );
+        }
+        long long sum = a.front();
+        while ( !a.empty() ) {
+            a.popFront();
+        }
+        return sum;
+    } );
+
+    runBench( "list<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        list< int > l;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            l.pushFront( i );
+        }
+        long long sum = *l.getFirst();
+        while ( !l.empty() ) {
+            l.popFront();
+        }
+        return sum;
+    } );
+
+    runBench( "deque<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        deque< int > d;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            d.pushFront( i );
+        }
+        long long sum = d.front();
+        while ( !d.empty() ) {
+            d.popFront();
+        }
+        return sum;
+    } );
+
+    std::cout << '\n';
+}
+
+void queueBench() {
+    std::cout << "Running FIFO (pushBack/popFront) benchmarks." << std::endl;
+
+    // a queue which stays around 1024 elements long
+    const int numArrayItems = NUM_TESTS / 4;
+
+    runBench( "array<int>", 4, numArrayItems, [=]() {
+        array< int > a;
+        long long sum = 0;
+        for ( int i = 0; i < numArrayItems; ++i ) {
+            a.pushBack( i );
+            if ( a.size() > 1024 ) {
+                sum += a.front();
+                a.popFront();
+            }
+        }
+        return sum;
+    } );
+
+    runBench( "list<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        list< int > l;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            l.pushBack( i );
+            if ( l.size() > 1024 ) {
+                sum += *l.getFirst();
+                l.popFront();
+            }
+        }
+        return sum;
+    } );
+
+    runBench( "deque<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        deque< int > d;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            d.pushBack( i );
+            if ( d.size() > 1024 ) {
+                sum += d.front();
+                d.popFront();
+            }
+        }
+        return sum;
+    } );
+
+    std::cout << '\n';
+}
+
+void traversalBench() {
+    std::cout << "Running traversal benchmarks." << std::endl;
+
+    array< int > a;
+    list< int > l;
+    deque< int > d;
+
+    for ( int i = 0; i < NUM_TESTS * 4; ++i ) {
+        a.pushBack( i );
+        l.pushBack( i );
+        d.pushBack( i );
+    }
+
+    runBench( "array<int> index", NUM_ITERATIONS, a.size(), [&]() {
+        long long sum = 0;
+        for ( int i = 0; i < a.size(); ++i ) {
+            sum += a[ i ];
+        }
+        return sum;
+    } );
+
+    runBench( "list<int> iterate", NUM_ITERATIONS, l.size(), [&]() {
+        return sumList( l );
+    } );
+
+    runBench( "deque<int> index", NUM_ITERATIONS, d.size(), [&]() {
+        long long sum = 0;
+        for ( int i = 0; i < d.size(); ++i ) {
+            sum += d[ i ];
+        }
+        return sum;
+    } );
+
+    runBench( "deque<int> blocks", NUM_ITERATIONS, d.size(), [&]() {
+        long long sum = 0;
+        for ( int b = 0; b < d.numBlocks(); ++b ) {
+            const int* const block = d.blockData( b );
+            const int count = d.blockSize( b );
+            for ( int i = 0; i < count; ++i ) {
+                sum += block[ i ];
+            }
+        }
+        return sum;
+    } );
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testDeque();
+    pushFrontBench();
+    queueBench();
+    traversalBench();
+}
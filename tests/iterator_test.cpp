@@ -0,0 +1,338 @@
+// container iterator tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -O2 iterator_test.cpp ../src/*.cpp -pthread -o iterator
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "containers/array.h"
+#include "containers/btree.h"
+#include "containers/deque.h"
+#include "containers/intrusivelist.h"
+#include "containers/list.h"
+#include "containers/queue.h"
+#include "containers/slotmap.h"
+#include "containers/smallarray.h"
+#include "containers/stack.h"
+#include "containers/staticarray.h"
+#include "containers/string.h"
+#include "containers/unrolledlist.h"
+#include "testUtils.h"
+
+#define NUM_ITERATIONS 64
+#define NUM_TESTS 65536
+
+namespace containers = hamLibs::containers;
+
+/******************************************************************************
+ * Helpers
+******************************************************************************/
+// Sum a container with a range-based for loop, through a const reference
+template < typename container_t >
+long long sumRange( const container_t& c ) {
+    long long sum = 0;
+    for ( const auto& i : c ) {
+        sum += i;
+    }
+    return sum;
+}
+
+// Check that a container holds 0, 1, 2... in iteration order, both through
+// range-for and through <algorithm>.
+template < typename container_t >
+unsigned checkSequence( container_t& c, int count ) {
+    const container_t& constRef = c;
+    unsigned numErrors = 0;
+
+    numErrors += std::distance( c.begin(), c.end() ) != count;
+    numErrors += std::distance( constRef.begin(), constRef.end() ) != count;
+    numErrors += sumRange( c ) != (long long)count * (count - 1) / 2;
+
+    std::vector< int > expected( count );
+    std::iota( expected.begin(), expected.end(), 0 );
+    numErrors += !std::equal( constRef.begin(), constRef.end(), expected.begin() );
+
+    // iterators compare against, and convert to, their const counterparts
+    typename container_t::constIterator first = c.begin();
+    numErrors += first != constRef.begin() || !(c.begin() == constRef.begin());
+
+    if ( count > 1 ) {
+        numErrors += std::find( c.begin(), c.end(), count - 1 ) == c.end();
+        numErrors += *std::max_element( constRef.begin(), constRef.end() ) != count - 1;
+    }
+    numErrors += std::find( c.begin(), c.end(), count ) != c.end();
+
+    // elements can be written through non-const iterators
+    for ( auto& i : c ) {
+        i += 1;
+    }
+    numErrors += sumRange( c ) != (long long)count * (count + 1) / 2;
+    for ( auto iter = c.begin(); iter != c.end(); ++iter ) {
+        *iter -= 1;
+    }
+
+    return numErrors;
+}
+
+// Walk a bidirectional range backwards from its end
+template < typename container_t >
+unsigned checkReverse( const container_t& c, int count ) {
+    unsigned numErrors = 0;
+
+    typename container_t::constIterator iter = c.end();
+    for ( int i = count - 1; i >= 0; --i ) {
+        --iter;
+        numErrors += *iter != i;
+    }
+
+    return numErrors + (iter != c.begin());
+}
+
+/******************************************************************************
+ * Iterator Tests
+******************************************************************************/
+unsigned testArrays() {
+    unsigned numErrors = 0;
+    containers::array< int > a;
+    containers::smallArray< int, 16 > sa;
+    containers::staticArray< int, 256 > st;
+    containers::slotMap< int > sm;
+
+    for ( int i = 0; i < 256; ++i ) {
+        a.pushBack( i );
+        sa.pushBack( i );
+        st.pushBack( i );
+        sm.push( i );
+    }
+
+    numErrors += checkSequence( a, a.size() ) + checkReverse( a, a.size() );
+    numErrors += checkSequence( sa, sa.size() ) + checkReverse( sa, sa.size() );
+    numErrors += checkSequence( st, st.size() ) + checkReverse( st, st.size() );
+    numErrors += checkSequence( sm, sm.size() ) + checkReverse( sm, sm.size() );
+
+    // random-access iterators work with the sorting algorithms
+    std::reverse( a.begin(), a.end() );
+    numErrors += a[ 0 ] != 255;
+    std::sort( a.begin(), a.end() );
+    numErrors += !std::is_sorted( a.begin(), a.end() ) || a.end() - a.begin() != a.size();
+
+    containers::array< int > empty;
+    numErrors += checkSequence( empty, 0 );
+
+    return numErrors;
+}
+
+unsigned testString() {
+    unsigned numErrors = 0;
+    containers::string s( "hamLibs" );
+
+    numErrors += std::distance( s.begin(), s.end() ) != s.size();
+
+    std::sort( s.begin(), s.end() );
+    numErrors += !std::is_sorted( s.begin(), s.end() ) || s[ 0 ] != 'L';
+
+    const containers::string& constRef = s;
+    int numChars = 0;
+    for ( char c : constRef ) {
+        numChars += c != '\0';
+    }
+    numErrors += numChars != 7;
+
+    return numErrors;
+}
+
+unsigned testLists() {
+    unsigned numErrors = 0;
+    containers::list< int > l;
+    containers::unrolledList< int, 8 > ul;
+    containers::deque< int > d;
+
+    for ( int i = 0; i < 1000; ++i ) {
+        l.pushBack( i );
+        ul.pushBack( i );
+        d.pushBack( i );
+    }
+
+    numErrors += checkSequence( l, l.size() ) + checkReverse( l, l.size() );
+    numErrors += checkSequence( ul, ul.size() ) + checkReverse( ul, ul.size() );
+    numErrors += checkSequence( d, d.size() ) + checkReverse( d, d.size() );
+
+    // iterating never moves the list's own "iter" position
+    l.goToFront();
+    l.goToNext();
+    ul.goToBack();
+    numErrors += sumRange( l ) != sumRange( ul );
+    numErrors += *l.getCurrent() != 1 || *ul.getCurrent() != 999;
+
+    std::sort( d.begin(), d.end(), []( int x, int y ) { return x > y; } );
+    numErrors += d.front() != 999 || d.end() - d.begin() != d.size();
+
+    // copies are made through the list's const iterators
+    containers::list< int > listCopy( l );
+    numErrors += !std::equal( listCopy.begin(), listCopy.end(), l.begin() ) || listCopy.size() != l.size();
+    listCopy = listCopy;
+    numErrors += listCopy.size() != l.size();
+
+    containers::list< int > emptyList;
+    containers::unrolledList< int > emptyUnrolled;
+    numErrors += checkSequence( emptyList, 0 ) + checkSequence( emptyUnrolled, 0 );
+
+    return numErrors;
+}
+
+struct linkedInt : containers::listHook<> {
+    int value;
+    linkedInt( int v = 0 ) : value( v ) {}
+};
+
+unsigned testLinkedContainers() {
+    unsigned numErrors = 0;
+    containers::queue< int > q;
+    containers::stack< int > s;
+
+    for ( int i = 0; i < 100; ++i ) {
+        q.push( i );
+        s.push( i );
+    }
+
+    // iterators walk from front() and top()
+    numErrors += *q.begin() != *q.front() || *s.begin() != *s.top();
+    numErrors += std::distance( q.begin(), q.end() ) != 100 || sumRange( q ) != 4950;
+    numErrors += std::distance( s.begin(), s.end() ) != 100 || sumRange( s ) != 4950;
+
+    for ( int& i : s ) {
+        i = 0;
+    }
+    numErrors += std::count( s.begin(), s.end(), 0 ) != 100;
+
+    std::vector< linkedInt > objects( 100 );
+    containers::intrusiveList< linkedInt > il;
+    for ( int i = 0; i < 100; ++i ) {
+        objects[ i ].value = i;
+        il.pushBack( objects[ i ] );
+    }
+
+    int expected = 0;
+    for ( const linkedInt& obj : il ) {
+        numErrors += obj.value != expected++;
+    }
+    numErrors += expected != 100;
+    numErrors += std::find_if( il.begin(), il.end(), []( const linkedInt& obj ) { return obj.value == 50; } )->value != 50;
+    numErrors += (--il.end())->value != 99;
+    il.clear();
+
+    containers::bTree< int, int > tree;
+    for ( int i = 0; i < 100; ++i ) {
+        tree.push( i, i );
+    }
+    numErrors += std::distance( tree.begin(), tree.end() ) != 100;
+    numErrors += std::accumulate( tree.begin(), tree.end(), 0 ) != 4950;
+    numErrors += std::count_if( tree.begin(), tree.end(), []( int i ) { return i % 2 == 0; } ) != 50;
+
+    return numErrors;
+}
+
+// Several threads may walk the same const container at once
+unsigned testConcurrentReaders() {
+    containers::list< int > l;
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        l.pushBack( i );
+    }
+
+    const containers::list< int >& constRef = l;
+    const long long expected = sumRange( constRef );
+    std::vector< long long > sums( 4, 0 );
+    std::vector< std::thread > threads;
+
+    for ( unsigned t = 0; t < sums.size(); ++t ) {
+        threads.emplace_back( [&, t]() {
+            for ( int i = 0; i < 16; ++i ) {
+                sums[ t ] += sumRange( constRef );
+            }
+        } );
+    }
+    for ( std::thread& t : threads ) {
+        t.join();
+    }
+
+    unsigned numErrors = 0;
+    for ( long long sum : sums ) {
+        numErrors += sum != expected * 16;
+    }
+    return numErrors;
+}
+
+void testIterators() {
+    std::cout << "\nTESTING ITERATORS" << "\n";
+
+    unsigned numErrors = 0;
+    numErrors += testArrays();
+    numErrors += testString();
+    numErrors += testLists();
+    numErrors += testLinkedContainers();
+    numErrors += testConcurrentReaders();
+
+    std::cout << "Iterator Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Benchmarks
+ * Compares walking each container with its iterators against walking it
+ * through its older interface.
+******************************************************************************/
+void iterationBench() {
+    std::cout << "Running iteration benchmarks." << std::endl;
+
+    containers::array< int > a;
+    containers::list< int > l;
+    containers::deque< int > d;
+
+    for ( int i = 0; i < NUM_TESTS * 4; ++i ) {
+        a.pushBack( i );
+        l.pushBack( i );
+        d.pushBack( i );
+    }
+
+    runBench( "array<int> index", NUM_ITERATIONS, a.size(), [&]() {
+        long long sum = 0;
+        for ( int i = 0; i < a.size(); ++i ) {
+            sum += a[ i ];
+        }
+        return sum;
+    } );
+
+    runBench( "array<int> range-for", NUM_ITERATIONS, a.size(), [&]() {
+        return sumRange( a );
+    } );
+
+    runBench( "list<int> getNext", NUM_ITERATIONS, l.size(), [&]() {
+        long long sum = 0;
+        l.goToFront();
+        for ( int i = 0; i < l.size(); ++i ) {
+            sum += *l.getCurrent();
+            l.goToNext();
+        }
+        return sum;
+    } );
+
+    runBench( "list<int> range-for", NUM_ITERATIONS, l.size(), [&]() {
+        return sumRange( l );
+    } );
+
+    runBench( "deque<int> range-for", NUM_ITERATIONS, d.size(), [&]() {
+        return sumRange( d );
+    } );
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testIterators();
+    iterationBench();
+}
@@ -0,0 +1,668 @@
+// linked list tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -O2 list_test.cpp ../src/allocator.cpp ../src/assert.cpp -o list
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "containers/intrusivelist.h"
+#include "containers/list.h"
+#include "containers/queue.h"
+#include "containers/stack.h"
+#include "containers/unrolledlist.h"
+#include "utils/allocator.h"
+#include "testUtils.h"
+
+#define NUM_ITERATIONS 64
+#define NUM_TESTS 65536
+
+namespace utils = hamLibs::utils;
+
+using hamLibs::containers::intrusiveList;
+using hamLibs::containers::list;
+using hamLibs::containers::listHook;
+using hamLibs::containers::queue;
+using hamLibs::containers::stack;
+using hamLibs::containers::unrolledList;
+
+/******************************************************************************
+ * Helpers
+******************************************************************************/
+// Copy the contents of a list into a vector, in order
+template < typename list_t, typename type >
+void toVector( list_t& l, std::vector< type >& out ) {
+    out.clear();
+    l.goToFront();
+    for ( int i = 0; i < l.size(); ++i ) {
+        out.push_back( *l.getCurrent() );
+        l.goToNext();
+    }
+}
+
+/******************************************************************************
+ * Node Pool Test
+******************************************************************************/
+unsigned testListPool() {
+    unsigned numErrors = 0;
+    countingResource res;
+
+    {
+        list< int, utils::resourceAllocator > l{ utils::resourceAllocator( &res ) };
+
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            l.pushBack( i );
+        }
+        const unsigned numAllocs = res.numAllocs;
+
+        // nodes are reserved in blocks rather than one at a time
+        numErrors += numAllocs > NUM_TESTS / 32;
+
+        // popped nodes are reused without touching the allocator
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            l.popFront();
+            l.pushBack( i );
+        }
+        numErrors += res.numAllocs != numAllocs || l.size() != NUM_TESTS;
+    }
+
+    numErrors += res.numAllocs != res.numFrees;
+    return numErrors;
+}
+
+/******************************************************************************
+ * Splice & Merge Tests
+******************************************************************************/
+template < typename alloc_t >
+unsigned testSplice( const alloc_t& a, const alloc_t& b ) {
+    unsigned numErrors = 0;
+    std::vector< std::string > contents;
+
+    list< std::string, alloc_t > first{ a };
+    {
+        list< std::string, alloc_t > second{ b };
+
+        for ( int i = 0; i < 4; ++i ) {
+            first.pushBack( std::to_string( i ) );
+            second.pushBack( std::to_string( 10 + i ) );
+        }
+
+        // move everything from "second" into the middle of "first"
+        first.goToFront();
+        first.goToNext();
+        first.spliceAfter( second );
+        numErrors += !second.empty() || first.size() != 8 || *first.getCurrent() != "10";
+
+        toVector( first, contents );
+        numErrors += contents != std::vector< std::string >{ "0", "1", "10", "11", "12", "13", "2", "3" };
+
+        // move single nodes back
+        first.goToBack();
+        second.spliceNode( first );
+        first.goToFront();
+        second.spliceNode( first );
+        numErrors += first.size() != 6 || second.size() != 2;
+
+        toVector( second, contents );
+        numErrors += contents != std::vector< std::string >{ "0", "3" };
+
+        // "first" keeps nodes which came from "second" after it is destroyed
+        first.goToFront();
+        first.spliceBefore( second );
+    }
+
+    toVector( first, contents );
+    numErrors += contents != std::vector< std::string >{ "0", "3", "1", "10", "11", "12", "13", "2" };
+
+    for ( int i = 0; i < 1000; ++i ) {
+        first.pushFront( std::to_string( i ) );
+        first.popBack();
+    }
+    numErrors += first.size() != 8;
+
+    return numErrors;
+}
+
+template < typename alloc_t >
+unsigned testMerge( const alloc_t& a, const alloc_t& b ) {
+    unsigned numErrors = 0;
+
+    list< int, alloc_t > evens{ a };
+    list< int, alloc_t > odds{ b };
+    std::vector< int > contents;
+
+    for ( int i = 0; i < 1000; ++i ) {
+        evens.pushBack( i * 2 );
+        odds.pushBack( i * 2 + 1 );
+    }
+
+    evens.merge( odds );
+    toVector( evens, contents );
+    numErrors += !odds.empty() || contents.size() != 2000;
+
+    for ( int i = 0; i < int(contents.size()); ++i ) {
+        numErrors += contents[ i ] != i;
+    }
+
+    // descending order and ties
+    list< int, alloc_t > high{ a };
+    list< int, alloc_t > low{ b };
+    high.pushBack( 5 );
+    high.pushBack( 3 );
+    low.pushBack( 5 );
+    low.pushBack( 4 );
+    low.pushBack( 1 );
+    high.merge( low, []( int x, int y ) { return x > y; } );
+
+    toVector( high, contents );
+    numErrors += contents != std::vector< int >{ 5, 5, 4, 3, 1 };
+
+    return numErrors;
+}
+
+// A list which detaches from a shared pool no longer depends on the lists it
+// exchanged nodes with, so it can be handed to another thread
+unsigned testDetachPool() {
+    unsigned numErrors = 0;
+    countingResource res;
+    const utils::resourceAllocator alloc( &res );
+    std::vector< int > contents;
+
+    list< int, utils::resourceAllocator > first{ alloc };
+    {
+        list< int, utils::resourceAllocator > second{ alloc };
+
+        for ( int i = 0; i < 4; ++i ) {
+            first.pushBack( i );
+            second.pushBack( 10 + i );
+        }
+        first.goToBack();
+        first.spliceAfter( second );
+        second.pushBack( 20 );
+
+        first.goToFront();
+        first.goToNext();
+        first.detachPool();
+        numErrors += first.size() != 8 || *first.getCurrent() != 1;
+
+        // a list with a pool of its own is left alone
+        const unsigned numAllocs = res.numAllocs;
+        first.detachPool();
+        numErrors += res.numAllocs != numAllocs || *first.getCurrent() != 1;
+    }
+
+    // only the new pool's node block and its store are left
+    numErrors += res.numAllocs - res.numFrees != 2;
+
+    toVector( first, contents );
+    numErrors += contents != std::vector< int >{ 0, 1, 2, 3, 10, 11, 12, 13 };
+
+    return numErrors;
+}
+
+/******************************************************************************
+ * Emplace Test
+ * Move-only elements are either constructed in place or moved in.
+******************************************************************************/
+typedef std::unique_ptr< int > int_ptr;
+
+template < typename list_t >
+unsigned testEmplaceList() {
+    unsigned numErrors = 0;
+    list_t l;
+
+    for ( int i = 0; i < 64; ++i ) {
+        l.emplaceBack( new int( i ) );
+    }
+    l.pushFront( int_ptr( new int( -1 ) ) );
+    l.goToNext();
+    l.emplaceAfter( new int( -2 ) );
+    l.pushBefore( int_ptr( new int( -3 ) ) );
+    numErrors += **l.getCurrent() != -3;
+    numErrors += *l.emplaceFront( new int( -4 ) ) != -4;
+
+    const int expected[] = { -4, -1, 0, -3, -2, 1 };
+    typename list_t::iterator iter = l.begin();
+    for ( int i : expected ) {
+        numErrors += **iter++ != i;
+    }
+    numErrors += l.size() != 68;
+
+    list_t moved( std::move( l ) );
+    numErrors += !l.empty() || moved.size() != 68 || **moved.getLast() != 63;
+
+    l = std::move( moved );
+    numErrors += !moved.empty() || l.size() != 68 || **l.getFirst() != -4;
+
+    return numErrors;
+}
+
+unsigned testEmplace() {
+    unsigned numErrors = 0;
+
+    numErrors += testEmplaceList< list< int_ptr > >();
+    numErrors += testEmplaceList< unrolledList< int_ptr, 4 > >();
+
+    queue< int_ptr > q;
+    stack< int_ptr > s;
+    for ( int i = 0; i < 8; ++i ) {
+        numErrors += *q.emplace( new int( i ) ) != i;
+        numErrors += *s.emplace( new int( i ) ) != i;
+    }
+    q.push( int_ptr( new int( 8 ) ) );
+    s.push( int_ptr( new int( 8 ) ) );
+    numErrors += q.size() != 9 || **s.top() != 8;
+
+    queue< int_ptr > movedQueue( std::move( q ) );
+    stack< int_ptr > movedStack( std::move( s ) );
+    numErrors += !q.empty() || !s.empty();
+
+    // every element survives the move exactly once
+    bool seen[ 9 ] = {};
+    for ( int i = 0; i <= 8; ++i ) {
+        const int value = **movedQueue.front();
+        numErrors += value < 0 || value > 8 || seen[ value ];
+        seen[ value ] = true;
+        numErrors += **movedStack.top() != 8 - i;
+        movedQueue.pop();
+        movedStack.pop();
+    }
+    numErrors += !movedQueue.empty() || !movedStack.empty();
+
+    return numErrors;
+}
+
+void testList() {
+    std::cout << "\nTESTING LIST" << "\n";
+
+    unsigned numErrors = testListPool();
+    numErrors += testEmplace();
+
+    // lists which can share a pool, and lists which must copy nodes
+    countingResource resA, resB;
+    const utils::resourceAllocator allocA( &resA );
+    const utils::resourceAllocator allocB( &resB );
+
+    numErrors += testSplice( utils::heapAllocator(), utils::heapAllocator() );
+    numErrors += testSplice( allocA, allocB );
+    numErrors += testMerge( utils::heapAllocator(), utils::heapAllocator() );
+    numErrors += testMerge( allocA, allocB );
+    numErrors += resA.numAllocs != resA.numFrees || resB.numAllocs != resB.numFrees;
+    numErrors += testDetachPool();
+
+    std::cout << "List Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Intrusive List Test
+******************************************************************************/
+struct eventTag {};
+struct dirtyTag {};
+
+// an object which can be queued for events and marked dirty at the same time
+struct entity : listHook< eventTag >, listHook< dirtyTag > {
+    int id;
+    float value;
+
+    entity( int i = 0 ) : id( i ), value( 0.f ) {}
+};
+
+typedef intrusiveList< entity, eventTag > event_list;
+typedef intrusiveList< entity, dirtyTag > dirty_list;
+
+template < typename list_t >
+void toIds( const list_t& l, std::vector< int >& out ) {
+    out.clear();
+    for ( entity* e = l.getFirst(); e; e = l.getNext( *e ) ) {
+        out.push_back( e->id );
+    }
+}
+
+void testIntrusiveList() {
+    std::cout << "\nTESTING INTRUSIVE LIST" << "\n";
+
+    unsigned numErrors = 0;
+    std::vector< entity > entities;
+    std::vector< int > ids;
+
+    for ( int i = 0; i < 8; ++i ) {
+        entities.emplace_back( i );
+    }
+
+    {
+        event_list events;
+        dirty_list dirty;
+
+        // the same objects sit in two lists, in different orders
+        for ( entity& e : entities ) {
+            events.pushBack( e );
+            dirty.pushFront( e );
+        }
+        numErrors += events.size() != 8 || dirty.size() != 8;
+
+        events.pop( entities[ 3 ] );
+        events.popFront();
+        dirty.pop( entities[ 5 ] );
+        numErrors += event_list::isLinked( entities[ 3 ] ) || !dirty_list::isLinked( entities[ 3 ] );
+
+        toIds( events, ids );
+        numErrors += ids != std::vector< int >{ 1, 2, 4, 5, 6, 7 };
+        toIds( dirty, ids );
+        numErrors += ids != std::vector< int >{ 7, 6, 4, 3, 2, 1, 0 };
+
+        // objects are linked in place and can be walked backwards
+        events.pushAfter( entities[ 2 ], entities[ 3 ] );
+        events.pushBefore( entities[ 1 ], entities[ 0 ] );
+        numErrors += events.getPrev( entities[ 4 ] ) != &entities[ 3 ];
+        numErrors += events.getPrev( entities[ 0 ] ) != nullptr || events.getLast() != &entities[ 7 ];
+
+        // splicing and moving relink the end objects only
+        event_list other;
+        while ( events.size() > 4 ) {
+            entity* e = events.getLast();
+            events.popBack();
+            other.pushFront( *e );
+        }
+        events.spliceBack( other );
+        numErrors += !other.empty();
+
+        event_list moved( std::move( events ) );
+        toIds( moved, ids );
+        numErrors += !events.empty() || ids != std::vector< int >{ 0, 1, 2, 3, 4, 5, 6, 7 };
+
+        // copying an object does not copy its links
+        entity copy( entities[ 0 ] );
+        numErrors += event_list::isLinked( copy ) || !event_list::isLinked( entities[ 0 ] );
+
+        events = std::move( moved );
+        numErrors += events.size() != 8 || events.getFirst() != &entities[ 0 ];
+        numErrors += !events.contains( entities[ 5 ] ) || moved.contains( entities[ 5 ] );
+
+#ifdef HL_DEBUG
+        // objects can only be popped from the list which holds them
+        bool wrongListCaught = false;
+        try {
+            moved.pop( entities[ 5 ] );
+        }
+        catch ( hamLibs::utils::error_t ) {
+            wrongListCaught = true;
+        }
+        numErrors += !wrongListCaught || events.size() != 8 || moved.size() != 0;
+        numErrors += !events.contains( entities[ 5 ] );
+#endif
+    }
+
+    // destroying the lists unlinked every object
+    for ( const entity& e : entities ) {
+        numErrors += event_list::isLinked( e ) || dirty_list::isLinked( e );
+    }
+
+    std::cout << "Intrusive List Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Unrolled List Test
+ * Runs random operations around the iterator and compares with std::list.
+ * Nodes only hold four elements so that they are constantly split and merged.
+******************************************************************************/
+typedef unrolledList< std::string, 4, utils::resourceAllocator > string_list;
+
+unsigned compareUnrolled( string_list& testList, const std::list< std::string >& expected, std::list< std::string >::iterator iter ) {
+    unsigned numErrors = testList.size() != int(expected.size());
+
+    if ( expected.empty() ) {
+        return numErrors + (testList.getCurrent() != nullptr) + (testList.getFirst() != nullptr);
+    }
+
+    numErrors += !testList.getCurrent() || *testList.getCurrent() != *iter;
+    numErrors += *testList.getFirst() != expected.front() || *testList.getLast() != expected.back();
+
+    std::list< std::string >::iterator next = iter;
+    ++next;
+    numErrors += next == expected.end() ? testList.peekNext() != nullptr : *testList.peekNext() != *next;
+    numErrors += iter == expected.begin() ? testList.peekPrev() != nullptr : *testList.peekPrev() != *std::prev( iter );
+
+    // walk a copy so that the tested list keeps its position
+    string_list copyList( testList );
+    std::vector< std::string > contents;
+    toVector( copyList, contents );
+    return numErrors + !std::equal( contents.begin(), contents.end(), expected.begin() );
+}
+
+void testUnrolledList() {
+    std::cout << "\nTESTING UNROLLED LIST" << "\n";
+
+    unsigned numErrors = 0;
+    countingResource res;
+
+    {
+        string_list testList{ utils::resourceAllocator( &res ) };
+        std::list< std::string > expected;
+        std::list< std::string >::iterator iter = expected.end();
+        std::mt19937 rng( 1 );
+
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            // drift between growing and shrinking the list
+            const unsigned op = rng() % ((i / 2048) % 2 ? 10 : 7);
+            const std::string value = std::to_string( i );
+
+            switch ( op ) {
+                case 0:
+                    testList.pushBefore( value );
+                    iter = expected.insert( iter, value );
+                    break;
+                case 1:
+                    testList.pushAfter( value );
+                    iter = expected.insert( iter == expected.end() ? iter : std::next( iter ), value );
+                    break;
+                case 2:
+                    testList.pushFront( value );
+                    iter = expected.insert( expected.begin(), value );
+                    break;
+                case 3:
+                    testList.pushBack( value );
+                    iter = expected.insert( expected.end(), value );
+                    break;
+                case 4:
+                    testList.goToNext();
+                    if ( iter != expected.end() && std::next( iter ) != expected.end() ) ++iter;
+                    break;
+                case 5:
+                    testList.goToPrev();
+                    if ( iter != expected.begin() ) --iter;
+                    break;
+                case 6: case 7:
+                    testList.popnode();
+                    if ( iter != expected.end() ) iter = expected.erase( iter );
+                    break;
+                case 8:
+                    testList.popFront();
+                    if ( !expected.empty() ) iter = expected.erase( expected.begin() );
+                    break;
+                default:
+                    testList.popBack();
+                    if ( !expected.empty() ) iter = expected.erase( std::prev( expected.end() ) );
+                    break;
+            }
+
+            // popping the last element leaves the iterator on the new last one
+            if ( iter == expected.end() && !expected.empty() ) {
+                --iter;
+            }
+
+            if ( i % 256 == 0 ) {
+                numErrors += compareUnrolled( testList, expected, iter );
+            }
+        }
+        numErrors += compareUnrolled( testList, expected, iter );
+
+        // inserting a copy of an element of the list, into its own node
+        testList.goToFront();
+        testList.pushAfter( *testList.getCurrent() );
+        numErrors += *testList.getFirst() != *testList.getCurrent();
+
+        // copies and moves
+        string_list moveList( std::move( testList ) );
+        numErrors += !testList.empty() || testList.getCurrent() != nullptr;
+
+        testList = moveList;
+        numErrors += testList.size() != moveList.size() || *testList.getLast() != *moveList.getLast();
+
+        testList.clear();
+        testList.pushBack( "x" );
+        testList = std::move( moveList );
+        numErrors += !moveList.empty() || testList.size() != int(expected.size()) + 1;
+    }
+
+    numErrors += res.numAllocs != res.numFrees;
+
+    std::cout << "Unrolled List Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Benchmarks
+******************************************************************************/
+void churnBench() {
+    std::cout << "Running insertion/removal benchmarks." << std::endl;
+
+    runBench( "std::list<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        std::list< int > l;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            l.push_back( i );
+            if ( i % 3 == 0 ) {
+                sum += l.front();
+                l.pop_front();
+            }
+        }
+        return sum + l.size();
+    } );
+
+    runBench( "list<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        list< int > l;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            l.pushBack( i );
+            if ( i % 3 == 0 ) {
+                sum += *l.getFirst();
+                l.popFront();
+            }
+        }
+        return sum + l.size();
+    } );
+
+    std::cout << '\n';
+}
+
+void dirtyBench() {
+    std::cout << "Running dirty-object list benchmarks." << std::endl;
+
+    // each frame a quarter of the objects are marked dirty, then processed
+    std::vector< entity > entities( NUM_TESTS );
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        entities[ i ].id = i;
+    }
+
+    runBench( "list<entity*>", NUM_ITERATIONS, NUM_TESTS / 4, [&]() {
+        list< entity* > dirty;
+        for ( int i = 0; i < NUM_TESTS; i += 4 ) {
+            dirty.pushBack( &entities[ i ] );
+        }
+
+        long long sum = 0;
+        while ( !dirty.empty() ) {
+            sum += (*dirty.getFirst())->id;
+            dirty.popFront();
+        }
+        return sum;
+    } );
+
+    runBench( "intrusiveList<entity>", NUM_ITERATIONS, NUM_TESTS / 4, [&]() {
+        dirty_list dirty;
+        for ( int i = 0; i < NUM_TESTS; i += 4 ) {
+            dirty.pushBack( entities[ i ] );
+        }
+
+        long long sum = 0;
+        while ( !dirty.empty() ) {
+            sum += dirty.getFirst()->id;
+            dirty.popFront();
+        }
+        return sum;
+    } );
+
+    std::cout << '\n';
+}
+
+void traversalBench() {
+    std::cout << "Running traversal benchmarks." << std::endl;
+
+    // insert in a shuffled order so that neighbors were not created together
+    std::vector< int > order( NUM_TESTS * 4 );
+    for ( int i = 0; i < int(order.size()); ++i ) {
+        order[ i ] = i;
+    }
+    std::shuffle( order.begin(), order.end(), std::mt19937( 1 ) );
+
+    std::list< int > stdList;
+    list< int > hlList;
+    unrolledList< int > unrolled;
+    for ( int i : order ) {
+        if ( i & 1 ) {
+            stdList.push_back( i );
+            hlList.pushBack( i );
+            unrolled.pushBack( i );
+        }
+        else {
+            stdList.push_front( i );
+            hlList.pushFront( i );
+            unrolled.pushFront( i );
+        }
+    }
+
+    runBench( "std::list<int>", NUM_ITERATIONS, int(stdList.size()), [&]() {
+        long long sum = 0;
+        for ( int i : stdList ) {
+            sum += i;
+        }
+        return sum;
+    } );
+
+    runBench( "list<int>", NUM_ITERATIONS, hlList.size(), [&]() {
+        long long sum = 0;
+        hlList.goToFront();
+        for ( int i = 0; i < hlList.size(); ++i ) {
+            sum += *hlList.getCurrent();
+            hlList.goToNext();
+        }
+        return sum;
+    } );
+
+    runBench( "unrolledList<int>", NUM_ITERATIONS, unrolled.size(), [&]() {
+        long long sum = 0;
+        unrolled.goToFront();
+        for ( int i = 0; i < unrolled.size(); ++i ) {
+            sum += *unrolled.getCurrent();
+            unrolled.goToNext();
+        }
+        return sum;
+    } );
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testList();
+    testIntrusiveList();
+    testUnrolledList();
+    churnBench();
+    dirtyBench();
+    traversalBench();
+}
@@ -0,0 +1,291 @@
+// parallel algorithm tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -pthread -O2 parallel_test.cpp ../src/workerPool.cpp -o parallel
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "containers/array.h"
+#include "defs/preprocessor.h"
+#include "math/vec3.h"
+#include "utils/parallel.h"
+#include "utils/workerPool.h"
+
+#define NUM_TEST_ITEMS 100003
+#define NUM_BENCH_ITEMS (1 << 22)
+
+namespace chrono = std::chrono;
+
+typedef chrono::steady_clock hr_clock;
+typedef hr_clock::time_point hr_time;
+
+using hamLibs::containers::array;
+using hamLibs::math::vec3f;
+using hamLibs::utils::workerPool;
+
+namespace utils = hamLibs::utils;
+
+/******************************************************************************
+ * Test Data
+******************************************************************************/
+template <typename type>
+void fillRandom( array< type >& a, int numItems, unsigned seed );
+
+template <>
+void fillRandom< float >( array< float >& a, int numItems, unsigned seed ) {
+    std::mt19937 rng( seed );
+    std::uniform_real_distribution< float > dist( -1000.f, 1000.f );
+
+    a.clear();
+    a.reserve( numItems );
+    for ( int i = 0; i < numItems; ++i ) {
+        a.pushBack( dist( rng ) );
+    }
+}
+
+template <>
+void fillRandom< vec3f >( array< vec3f >& a, int numItems, unsigned seed ) {
+    std::mt19937 rng( seed );
+    std::uniform_real_distribution< float > dist( -1000.f, 1000.f );
+
+    a.clear();
+    a.reserve( numItems );
+    for ( int i = 0; i < numItems; ++i ) {
+        a.pushBack( vec3f( dist( rng ), dist( rng ), dist( rng ) ) );
+    }
+}
+
+struct compareX {
+    bool operator()( const vec3f& a, const vec3f& b ) const { return a[ 0 ] < b[ 0 ]; }
+};
+
+// key/position pairs for checking that stable sorts keep the order of ties
+struct keyed {
+    int key;
+    int index;
+};
+
+struct compareKey {
+    bool operator()( const keyed& a, const keyed& b ) const { return a.key < b.key; }
+};
+
+/******************************************************************************
+ * Correctness Tests
+******************************************************************************/
+unsigned testSorts( workerPool& pool, std::size_t grainSize ) {
+    unsigned numErrors = 0;
+
+    array< float > floats;
+    fillRandom( floats, NUM_TEST_ITEMS, 1 );
+    std::vector< float > expected( floats.data(), floats.data() + floats.size() );
+    std::sort( expected.begin(), expected.end() );
+
+    utils::parallelSort( pool, floats.data(), floats.size(), std::less< float >(), grainSize );
+    numErrors += !std::equal( expected.begin(), expected.end(), floats.data() );
+
+    array< vec3f > vecs;
+    fillRandom( vecs, NUM_TEST_ITEMS, 2 );
+    utils::parallelSort( pool, vecs.data(), vecs.size(), compareX(), grainSize );
+    numErrors += !std::is_sorted( vecs.data(), vecs.data() + vecs.size(), compareX() );
+
+    array< keyed > keys;
+    std::mt19937 rng( 3 );
+    for ( int i = 0; i < NUM_TEST_ITEMS; ++i ) {
+        keys.pushBack( keyed{ static_cast< int >( rng() % 64 ), i } );
+    }
+
+    utils::parallelStableSort( pool, keys.data(), keys.size(), compareKey(), grainSize );
+    for ( int i = 1; i < keys.size(); ++i ) {
+        const keyed& a = keys[ i-1 ];
+        const keyed& b = keys[ i ];
+        numErrors += (a.key > b.key) || (a.key == b.key && a.index > b.index);
+    }
+
+    // arrays smaller than one grain, and empty arrays
+    array< float > few;
+    fillRandom( few, 5, 4 );
+    utils::parallelSort( pool, few.data(), few.size() );
+    numErrors += !std::is_sorted( few.data(), few.data() + few.size() );
+    utils::parallelStableSort( pool, few.data(), 0 );
+
+    return numErrors;
+}
+
+unsigned testTransforms( workerPool& pool, std::size_t grainSize ) {
+    unsigned numErrors = 0;
+
+    array< int > ints;
+    ints.resize( NUM_TEST_ITEMS );
+    std::iota( ints.data(), ints.data() + ints.size(), 0 );
+
+    array< long long > squares( NUM_TEST_ITEMS );
+    utils::parallelTransform(
+        pool, ints.data(), ints.size(), squares.data(),
+        []( int i ) { return (long long)i * i; }, grainSize
+    );
+    for ( int i = 0; i < NUM_TEST_ITEMS; ++i ) {
+        numErrors += squares[ i ] != (long long)i * i;
+    }
+
+    utils::parallelForEach( pool, ints.data(), ints.size(), []( int& i ) { i *= 2; }, grainSize );
+    for ( int i = 0; i < NUM_TEST_ITEMS; ++i ) {
+        numErrors += ints[ i ] != i*2;
+    }
+
+    const long long sum = utils::parallelReduce(
+        pool, squares.data(), squares.size(), 7ll, std::plus< long long >(), grainSize
+    );
+    numErrors += sum != std::accumulate( squares.data(), squares.data() + squares.size(), 7ll );
+
+    const int maxVal = utils::parallelReduce(
+        pool, ints.data(), ints.size(), -1, []( int a, int b ) { return std::max( a, b ); }, grainSize
+    );
+    numErrors += maxVal != (NUM_TEST_ITEMS-1) * 2;
+
+    // scan in place
+    std::vector< long long > expected( NUM_TEST_ITEMS );
+    std::partial_sum( squares.data(), squares.data() + squares.size(), expected.begin() );
+    utils::parallelInclusiveScan(
+        pool, squares.data(), squares.size(), squares.data(), std::plus< long long >(), grainSize
+    );
+    numErrors += !std::equal( expected.begin(), expected.end(), squares.data() );
+
+    return numErrors;
+}
+
+unsigned testPool() {
+    unsigned numErrors = 0;
+    workerPool pool( 4 );
+
+    // every task runs exactly once
+    std::vector< int > counts( 1000, 0 );
+    pool.run( 1000, [&]( unsigned i ) { ++counts[ i ]; } );
+    numErrors += std::count( counts.begin(), counts.end(), 1 ) != 1000;
+
+    // nested batches run on the calling thread
+    std::vector< int > nested( 64, 0 );
+    pool.run( 8, [&]( unsigned i ) {
+        pool.run( 8, [&]( unsigned j ) { ++nested[ i*8 + j ]; } );
+    } );
+    numErrors += std::count( nested.begin(), nested.end(), 1 ) != 64;
+
+    // exceptions reach the caller
+    bool caught = false;
+    try {
+        pool.run( 100, []( unsigned i ) {
+            if ( i == 50 ) {
+                throw std::runtime_error( "task failure" );
+            }
+        } );
+    }
+    catch ( const std::runtime_error& ) {
+        caught = true;
+    }
+    numErrors += !caught;
+
+    return numErrors;
+}
+
+void testParallel() {
+    std::cout << "\nTESTING PARALLEL ALGORITHMS" << "\n";
+
+    unsigned numErrors = testPool();
+
+    for ( unsigned numThreads : { 1u, 3u, 8u } ) {
+        workerPool pool( numThreads );
+
+        for ( std::size_t grainSize : { std::size_t( 1000 ), std::size_t( utils::PARALLEL_GRAIN_SIZE ) } ) {
+            numErrors += testSorts( pool, grainSize );
+            numErrors += testTransforms( pool, grainSize );
+        }
+    }
+
+    std::cout << "Parallel Errors: " << numErrors << "\n";
+}
+
+/******************************************************************************
+ * Scaling Benchmarks
+******************************************************************************/
+template <typename func_t>
+double timeMs( func_t func ) {
+    const hr_time t1 = hr_clock::now();
+    func();
+    const hr_time t2 = hr_clock::now();
+    return chrono::duration_cast< chrono::duration< double, std::milli > >( t2 - t1 ).count();
+}
+
+void scalingBench() {
+    std::cout << "\nPARALLEL SCALING BENCHMARK (" << NUM_BENCH_ITEMS << " elements, ms)" << "\n";
+
+    // 1, 2, 4, ... threads, followed by every hardware thread
+    const unsigned maxThreads = HL_MAX( std::thread::hardware_concurrency(), 1u );
+    std::vector< unsigned > threadCounts;
+
+    for ( unsigned n = 1; n < maxThreads; n *= 2 ) {
+        threadCounts.push_back( n );
+    }
+    threadCounts.push_back( maxThreads );
+
+    array< float > source;
+    array< vec3f > vecSource;
+    fillRandom( source, NUM_BENCH_ITEMS, 5 );
+    fillRandom( vecSource, NUM_BENCH_ITEMS, 6 );
+
+    array< float > floats( NUM_BENCH_ITEMS );
+    array< vec3f > vecs( NUM_BENCH_ITEMS );
+
+    {
+        floats = source;
+        const double ms = timeMs( [&]() { std::sort( floats.data(), floats.data() + floats.size() ); } );
+        std::cout << "\tstd::sort (float):\t" << ms << "\n";
+    }
+
+    float checksum = 0.f;
+
+    std::cout << "\tthreads\tsort\tstable\tsortVec\ttransform\treduce\tscan\n";
+
+    for ( unsigned numThreads : threadCounts ) {
+        workerPool pool( numThreads );
+
+        floats = source;
+        const double sortMs = timeMs( [&]() { utils::parallelSort( pool, floats.data(), floats.size() ); } );
+
+        floats = source;
+        const double stableMs = timeMs( [&]() { utils::parallelStableSort( pool, floats.data(), floats.size() ); } );
+
+        vecs = vecSource;
+        const double vecMs = timeMs( [&]() { utils::parallelSort( pool, vecs.data(), vecs.size(), compareX() ); } );
+
+        const double transformMs = timeMs( [&]() {
+            utils::parallelTransform( pool, vecSource.data(), vecSource.size(), floats.data(), []( const vec3f& v ) {
+                return std::sqrt( v[ 0 ]*v[ 0 ] + v[ 1 ]*v[ 1 ] + v[ 2 ]*v[ 2 ] );
+            } );
+        } );
+
+        float sum = 0.f;
+        const double reduceMs = timeMs( [&]() { sum = utils::parallelReduce( pool, source.data(), source.size(), 0.f ); } );
+
+        const double scanMs = timeMs( [&]() { utils::parallelInclusiveScan( pool, source.data(), source.size(), floats.data() ); } );
+
+        std::cout << "\t" << numThreads << "\t" << sortMs << "\t" << stableMs << "\t" << vecMs
+            << "\t" << transformMs << "\t\t" << reduceMs << "\t" << scanMs << "\n";
+
+        checksum += sum + floats[ NUM_BENCH_ITEMS-1 ];
+    }
+
+    std::cout << "\tchecksum: " << checksum << "\n";
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testParallel();
+    scalingBench();
+}
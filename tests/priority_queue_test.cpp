@@ -0,0 +1,403 @@
+// priority queue tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -O2 priority_queue_test.cpp ../src/allocator.cpp ../src/assert.cpp -o priority_queue
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "containers/priorityqueue.h"
+#include "testUtils.h"
+
+#define NUM_ITERATIONS 16
+#define NUM_TESTS 65536
+#define NUM_VERTICES 2048
+
+using hamLibs::containers::dAryHeap;
+using hamLibs::containers::indexedPriorityQueue;
+using hamLibs::containers::priorityQueue;
+
+/******************************************************************************
+ * Helpers
+******************************************************************************/
+// Check the heap property of a queue's array
+template < int D, typename type, typename compare_t >
+unsigned checkHeap( const type* items, int size, compare_t compare ) {
+    unsigned numErrors = 0;
+
+    for ( int i = 1; i < size; ++i ) {
+        numErrors += compare( items[ i ], items[ dAryHeap< D >::parent( i ) ] );
+    }
+
+    return numErrors;
+}
+
+// Pop everything from a queue, checking that it leaves in sorted order
+template < typename queue_t >
+unsigned drainSorted( queue_t& q, std::vector< int > expected ) {
+    unsigned numErrors = q.size() != int(expected.size());
+    std::sort( expected.begin(), expected.end() );
+
+    for ( int i : expected ) {
+        numErrors += q.top() == nullptr || *q.top() != i;
+        q.pop();
+    }
+
+    return numErrors + !q.empty() + (q.top() != nullptr);
+}
+
+struct edge {
+    int to;
+    int weight;
+};
+
+typedef std::vector< std::vector< edge > > graph;
+
+graph makeGraph( unsigned seed ) {
+    std::mt19937 rng( seed );
+    graph g( NUM_VERTICES );
+
+    for ( int v = 0; v < NUM_VERTICES; ++v ) {
+        // a ring keeps every vertex reachable
+        g[ v ].push_back( edge{ (v + 1) % NUM_VERTICES, int(rng() % 1000) + 1 } );
+        for ( int e = 0; e < 8; ++e ) {
+            g[ v ].push_back( edge{ int(rng() % NUM_VERTICES), int(rng() % 1000) + 1 } );
+        }
+    }
+
+    return g;
+}
+
+// Shortest paths with an indexed queue of (distance, vertex) pairs, lowering
+// each vertex's distance in place
+template < int D >
+std::vector< int > dijkstraIndexed( const graph& g ) {
+    typedef std::pair< int, int > entry;
+    std::vector< int > dist( g.size(), -1 );
+    std::vector< int > handles( g.size(), -1 );
+    indexedPriorityQueue< entry, D > q;
+
+    handles[ 0 ] = q.push( entry( 0, 0 ) );
+
+    while ( !q.empty() ) {
+        const entry current = *q.top();
+        q.pop();
+        dist[ current.second ] = current.first;
+
+        for ( const edge& e : g[ current.second ] ) {
+            const int d = current.first + e.weight;
+
+            if ( dist[ e.to ] >= 0 ) {
+                continue;
+            }
+            if ( !q.contains( handles[ e.to ] ) || q.get( handles[ e.to ] ).second != e.to ) {
+                handles[ e.to ] = q.push( entry( d, e.to ) );
+            }
+            else if ( d < q.get( handles[ e.to ] ).first ) {
+                q.decreaseKey( handles[ e.to ], entry( d, e.to ) );
+            }
+        }
+    }
+
+    return dist;
+}
+
+// Shortest paths with lazy deletion, the usual approach for heaps without
+// decrease-key
+template < typename queue_t >
+std::vector< int > dijkstraLazy( const graph& g ) {
+    typedef std::pair< int, int > entry;
+    std::vector< int > dist( g.size(), -1 );
+    queue_t q;
+
+    q.push( entry( 0, 0 ) );
+
+    while ( !q.empty() ) {
+        const entry current = q.top();
+        q.pop();
+        if ( dist[ current.second ] >= 0 ) {
+            continue;
+        }
+        dist[ current.second ] = current.first;
+
+        for ( const edge& e : g[ current.second ] ) {
+            if ( dist[ e.to ] < 0 ) {
+                q.push( entry( current.first + e.weight, e.to ) );
+            }
+        }
+    }
+
+    return dist;
+}
+
+/******************************************************************************
+ * Priority Queue Tests
+******************************************************************************/
+template < int D >
+unsigned testPriorityQueueOps() {
+    unsigned numErrors = 0;
+    std::mt19937 rng( D );
+    priorityQueue< int, D > q;
+    std::vector< int > values;
+
+    // pushes and pops interleaved
+    for ( int i = 0; i < 4096; ++i ) {
+        const int value = int(rng() % 1000);
+        q.push( value );
+        values.push_back( value );
+
+        if ( i % 3 == 0 ) {
+            std::sort( values.begin(), values.end() );
+            numErrors += *q.top() != values.front();
+            values.erase( values.begin() );
+            q.pop();
+        }
+    }
+    numErrors += checkHeap< D >( q.data(), q.size(), std::less< int >() );
+
+    // small batches are sifted in, large ones rebuild the heap
+    std::vector< int > batch( 5000 );
+    for ( int& i : batch ) {
+        i = int(rng() % 100000) - 50000;
+    }
+    q.pushBatch( batch.data(), 100 );
+    numErrors += checkHeap< D >( q.data(), q.size(), std::less< int >() );
+    q.pushBatch( batch.data() + 100, 4900 );
+    numErrors += checkHeap< D >( q.data(), q.size(), std::less< int >() );
+    values.insert( values.end(), batch.begin(), batch.end() );
+
+    priorityQueue< int, D > copied( q );
+    numErrors += drainSorted( q, values );
+    numErrors += drainSorted( copied, values );
+
+    // max-heaps and move-only elements
+    priorityQueue< std::unique_ptr< int >, D, std::function< bool( const std::unique_ptr< int >&, const std::unique_ptr< int >& ) > >
+    ptrs( []( const std::unique_ptr< int >& a, const std::unique_ptr< int >& b ) { return *a > *b; } );
+
+    for ( int i = 0; i < 100; ++i ) {
+        ptrs.emplace( new int( (i * 37) % 100 ) );
+    }
+    for ( int i = 99; i >= 0; --i ) {
+        numErrors += **ptrs.top() != i;
+        ptrs.pop();
+    }
+
+    return numErrors;
+}
+
+template < int D >
+unsigned testIndexedQueueOps() {
+    unsigned numErrors = 0;
+    std::mt19937 rng( D + 100 );
+    indexedPriorityQueue< int, D > q;
+    std::vector< int > handles;
+    std::vector< int > values;
+
+    for ( int i = 0; i < 2000; ++i ) {
+        handles.push_back( q.push( int(rng() % 10000) ) );
+    }
+
+    // remove, update and decrease random elements
+    for ( int i = 0; i < 4000; ++i ) {
+        const int h = handles[ rng() % handles.size() ];
+        if ( !q.contains( h ) ) {
+            continue;
+        }
+
+        switch ( rng() % 3 ) {
+            case 0:
+                q.remove( h );
+                numErrors += q.contains( h );
+                break;
+            case 1:
+                q.decreaseKey( h, q.get( h ) - int(rng() % 500) );
+                break;
+            default:
+                q.update( h, int(rng() % 10000) );
+                break;
+        }
+    }
+
+    for ( int h : handles ) {
+        if ( q.contains( h ) ) {
+            values.push_back( q.get( h ) );
+        }
+    }
+
+    // freed handles are reused
+    const int reused = q.push( -1000000 );
+    numErrors += std::find( handles.begin(), handles.end(), reused ) == handles.end();
+    numErrors += q.topHandle() != reused || q.get( reused ) != -1000000;
+    q.remove( reused );
+    q.remove( reused );
+
+    std::vector< int > batch( 3000 );
+    std::vector< int > batchHandles( 3000 );
+    for ( int& i : batch ) {
+        i = int(rng() % 10000);
+    }
+    q.pushBatch( batch.data(), int(batch.size()), batchHandles.data() );
+    values.insert( values.end(), batch.begin(), batch.end() );
+
+    for ( unsigned i = 0; i < batch.size(); ++i ) {
+        numErrors += q.get( batchHandles[ i ] ) != batch[ i ];
+    }
+
+    numErrors += drainSorted( q, values );
+    numErrors += q.topHandle() != -1 || q.contains( batchHandles[ 0 ] );
+
+    return numErrors;
+}
+
+template < int D >
+unsigned testDijkstra() {
+    const graph g = makeGraph( 5 );
+    typedef std::pair< int, int > entry;
+    typedef std::priority_queue< entry, std::vector< entry >, std::greater< entry > > std_queue;
+
+    return dijkstraIndexed< D >( g ) != dijkstraLazy< std_queue >( g );
+}
+
+void testPriorityQueue() {
+    std::cout << "\nTESTING PRIORITY QUEUE" << "\n";
+
+    unsigned numErrors = 0;
+    numErrors += testPriorityQueueOps< 2 >();
+    numErrors += testPriorityQueueOps< 4 >();
+    numErrors += testPriorityQueueOps< 3 >();
+    numErrors += testIndexedQueueOps< 2 >();
+    numErrors += testIndexedQueueOps< 4 >();
+    numErrors += testDijkstra< 2 >();
+    numErrors += testDijkstra< 4 >();
+
+    std::cout << "Priority Queue Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Benchmarks
+******************************************************************************/
+template < typename queue_t >
+long long pushPop( const std::vector< int >& values ) {
+    queue_t q;
+    long long sum = 0;
+
+    for ( int v : values ) {
+        q.push( v );
+    }
+    while ( !q.empty() ) {
+        sum += *q.top();
+        q.pop();
+    }
+
+    return sum;
+}
+
+void pushPopBench() {
+    std::cout << "Running push/pop benchmarks." << std::endl;
+
+    std::vector< int > values( NUM_TESTS * 4 );
+    std::mt19937 rng( 1 );
+    for ( int& i : values ) {
+        i = int(rng());
+    }
+
+    runBench( "std::priority_queue<int>", NUM_ITERATIONS, int(values.size()), [&]() {
+        std::priority_queue< int, std::vector< int >, std::greater< int > > q;
+        long long sum = 0;
+        for ( int v : values ) {
+            q.push( v );
+        }
+        while ( !q.empty() ) {
+            sum += q.top();
+            q.pop();
+        }
+        return sum;
+    } );
+
+    runBench( "priorityQueue<int, 2>", NUM_ITERATIONS, int(values.size()), [&]() {
+        return pushPop< priorityQueue< int, 2 > >( values );
+    } );
+
+    runBench( "priorityQueue<int, 4>", NUM_ITERATIONS, int(values.size()), [&]() {
+        return pushPop< priorityQueue< int, 4 > >( values );
+    } );
+
+    runBench( "indexedPriorityQueue<int, 4>", NUM_ITERATIONS, int(values.size()), [&]() {
+        return pushPop< indexedPriorityQueue< int, 4 > >( values );
+    } );
+
+    std::cout << '\n';
+}
+
+void rebuildBench() {
+    std::cout << "Running rebuild benchmarks." << std::endl;
+
+    std::vector< int > values( NUM_TESTS * 4 );
+    std::mt19937 rng( 2 );
+    for ( int& i : values ) {
+        i = int(rng());
+    }
+
+    runBench( "priorityQueue<int, 4> push", NUM_ITERATIONS, int(values.size()), [&]() {
+        priorityQueue< int, 4 > q;
+        for ( int v : values ) {
+            q.push( v );
+        }
+        return (long long)*q.top();
+    } );
+
+    runBench( "priorityQueue<int, 4> pushBatch", NUM_ITERATIONS, int(values.size()), [&]() {
+        priorityQueue< int, 4 > q;
+        q.pushBatch( values.data(), int(values.size()) );
+        return (long long)*q.top();
+    } );
+
+    std::cout << '\n';
+}
+
+void dijkstraBench() {
+    std::cout << "Running shortest path benchmarks." << std::endl;
+
+    const graph g = makeGraph( 9 );
+    typedef std::pair< int, int > entry;
+    typedef std::priority_queue< entry, std::vector< entry >, std::greater< entry > > std_queue;
+    typedef priorityQueue< entry, 4 > lazy_queue;
+
+    // a wrapper so both lazy queues share dijkstraLazy()
+    struct hlQueue : lazy_queue {
+        const entry& top() const { return *lazy_queue::top(); }
+    };
+
+    runBench( "std::priority_queue lazy", NUM_ITERATIONS, NUM_VERTICES, [&]() {
+        return (long long)dijkstraLazy< std_queue >( g ).back();
+    } );
+
+    runBench( "priorityQueue<4> lazy", NUM_ITERATIONS, NUM_VERTICES, [&]() {
+        return (long long)dijkstraLazy< hlQueue >( g ).back();
+    } );
+
+    runBench( "indexedPriorityQueue<2> decreaseKey", NUM_ITERATIONS, NUM_VERTICES, [&]() {
+        return (long long)dijkstraIndexed< 2 >( g ).back();
+    } );
+
+    runBench( "indexedPriorityQueue<4> decreaseKey", NUM_ITERATIONS, NUM_VERTICES, [&]() {
+        return (long long)dijkstraIndexed< 4 >( g ).back();
+    } );
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testPriorityQueue();
+    pushPopBench();
+    rebuildBench();
+    dijkstraBench();
+}
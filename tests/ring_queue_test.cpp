@@ -0,0 +1,239 @@
+// ring-buffer queue tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -O2 ring_queue_test.cpp ../src/allocator.cpp ../src/assert.cpp -o ring_queue
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "containers/queue.h"
+#include "containers/ringqueue.h"
+#include "utils/allocator.h"
+#include "testUtils.h"
+
+#define NUM_ITERATIONS 64
+#define NUM_TESTS 65536
+
+namespace utils = hamLibs::utils;
+
+using hamLibs::containers::queue;
+using hamLibs::containers::ringQueue;
+
+typedef std::unique_ptr< int > int_ptr;
+
+/******************************************************************************
+ * Ring Queue Test
+ * Runs random pushes and pops, so that the ring wraps around and grows at
+ * different offsets, and compares with std::deque.
+******************************************************************************/
+template < typename queue_t >
+unsigned compareQueue( const queue_t& q, const std::deque< int >& expected ) {
+    unsigned numErrors = q.size() != int(expected.size()) || q.empty() != expected.empty();
+
+    if ( !expected.empty() ) {
+        numErrors += *q.front() != expected.front() || *q.back() != expected.back();
+        numErrors += (expected.size() > 1) ? *q.peekNext() != expected[ 1 ] : q.peekNext() != nullptr;
+    }
+    else {
+        numErrors += q.front() != nullptr || q.back() != nullptr;
+    }
+
+    numErrors += !std::equal( q.begin(), q.end(), expected.begin() );
+    return numErrors;
+}
+
+unsigned testRingQueueOps() {
+    unsigned numErrors = 0;
+    ringQueue< int > q;
+    std::deque< int > expected;
+    std::mt19937 rng( 7 );
+
+    for ( int i = 0; i < NUM_TESTS; ++i ) {
+        // drift between growing and shrinking phases
+        const bool growing = (i / 4096) % 2 == 0;
+
+        if ( rng() % 8 < (growing ? 5u : 3u) ) {
+            q.push( i );
+            expected.push_back( i );
+        }
+        else {
+            q.pop();
+            if ( !expected.empty() ) {
+                expected.pop_front();
+            }
+        }
+
+        if ( i % 509 == 0 ) {
+            numErrors += compareQueue( q, expected );
+        }
+    }
+    numErrors += compareQueue( q, expected );
+
+    // capacity only grows in powers of two
+    numErrors += (q.capacity() & (q.capacity() - 1)) != 0 || q.capacity() < q.size();
+
+    ringQueue< int > copied( q );
+    numErrors += compareQueue( copied, expected );
+    copied.clear();
+    numErrors += compareQueue( copied, std::deque< int >() );
+    copied = q;
+    numErrors += compareQueue( copied, expected );
+
+    ringQueue< int > moved( std::move( copied ) );
+    numErrors += !copied.empty() || compareQueue( moved, expected );
+    copied = std::move( moved );
+    numErrors += !moved.empty() || compareQueue( copied, expected );
+
+    return numErrors;
+}
+
+unsigned testRingQueueStorage() {
+    unsigned numErrors = 0;
+    countingResource res;
+
+    {
+        const utils::resourceAllocator alloc( &res );
+        ringQueue< std::string, utils::resourceAllocator > q( alloc );
+
+        // once the ring is large enough, pushing and popping never allocate
+        q.reserve( 100 );
+        const unsigned numAllocs = res.numAllocs;
+        numErrors += q.capacity() != 128;
+
+        for ( int i = 0; i < 10000; ++i ) {
+            q.push( std::to_string( i ) );
+            if ( q.size() > 100 ) {
+                q.pop();
+            }
+        }
+        numErrors += res.numAllocs != numAllocs || q.size() != 100 || *q.front() != "9900";
+
+        // elements may be pushed from the queue itself while it grows
+        while ( q.size() < q.capacity() ) {
+            q.push( *q.front() );
+        }
+        q.push( *q.front() );
+        numErrors += q.capacity() != 256 || *q.back() != "9900" || q[ 1 ] != "9901";
+    }
+    numErrors += res.numAllocs != res.numFrees;
+
+    ringQueue< int_ptr > ptrs;
+    for ( int i = 0; i < 20; ++i ) {
+        numErrors += *ptrs.emplace( new int( i ) ) != i;
+        ptrs.push( int_ptr( new int( -i ) ) );
+        ptrs.pop();
+    }
+    numErrors += **ptrs.front() != 10 || **ptrs.back() != -19;
+
+    return numErrors;
+}
+
+void testRingQueue() {
+    std::cout << "\nTESTING RING QUEUE" << "\n";
+
+    unsigned numErrors = 0;
+    numErrors += testRingQueueOps();
+    numErrors += testRingQueueStorage();
+
+    std::cout << "Ring Queue Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Benchmarks
+******************************************************************************/
+void queueBench() {
+    std::cout << "Running queue benchmarks." << std::endl;
+
+    // a queue which stays a few hundred elements deep, as with a work queue
+    runBench( "std::deque<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        std::deque< int > q;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            q.push_back( i );
+            if ( q.size() > 256 ) {
+                sum += q.front();
+                q.pop_front();
+            }
+        }
+        return sum + q.size();
+    } );
+
+    runBench( "queue<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        queue< int > q;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            q.push( i );
+            if ( q.size() > 256 ) {
+                sum += *q.front();
+                q.pop();
+            }
+        }
+        return sum + q.size();
+    } );
+
+    runBench( "ringQueue<int>", NUM_ITERATIONS, NUM_TESTS, []() {
+        ringQueue< int > q;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            q.push( i );
+            if ( q.size() > 256 ) {
+                sum += *q.front();
+                q.pop();
+            }
+        }
+        return sum + q.size();
+    } );
+
+    // a queue which fills up completely, then drains
+    runBench( "std::deque<int> fill/drain", NUM_ITERATIONS, NUM_TESTS, []() {
+        std::deque< int > q;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            q.push_back( i );
+        }
+        while ( !q.empty() ) {
+            sum += q.front();
+            q.pop_front();
+        }
+        return sum;
+    } );
+
+    runBench( "queue<int> fill/drain", NUM_ITERATIONS, NUM_TESTS, []() {
+        queue< int > q;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            q.push( i );
+        }
+        while ( !q.empty() ) {
+            sum += *q.front();
+            q.pop();
+        }
+        return sum;
+    } );
+
+    runBench( "ringQueue<int> fill/drain", NUM_ITERATIONS, NUM_TESTS, []() {
+        ringQueue< int > q;
+        long long sum = 0;
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            q.push( i );
+        }
+        while ( !q.empty() ) {
+            sum += *q.front();
+            q.pop();
+        }
+        return sum;
+    } );
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testRingQueue();
+    queueBench();
+}
@@ -0,0 +1,214 @@
+// slot map tests
+// g++ -std=c++11 -Wall -Wextra -pedantic -pedantic-errors -O2 slotmap_test.cpp -o slotmap
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+#include "containers/array.h"
+#include "containers/slotmap.h"
+#include "testUtils.h"
+
+#define NUM_ITERATIONS 256
+#define NUM_TESTS 65536
+
+namespace chrono = std::chrono;
+
+typedef chrono::steady_clock hr_clock;
+typedef hr_clock::time_point hr_time;
+
+using hamLibs::containers::array;
+using hamLibs::containers::slotMap;
+
+/******************************************************************************
+ * Slot Map Test
+******************************************************************************/
+template < typename handle_t >
+unsigned testSlotMap() {
+    unsigned numErrors = 0;
+
+    {
+        slotMap< tracked, handle_t > testMap;
+        array< handle_t > handles;
+
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            handles.pushBack( testMap.emplace( i ) );
+        }
+        numErrors += testMap.size() != NUM_TESTS;
+        numErrors += !testMap.hasData( handles[ 0 ] ) || handles[ 0 ] == 0;
+
+        // remove every other element; the remainder must stay reachable
+        for ( int i = 0; i < NUM_TESTS; i += 2 ) {
+            numErrors += !testMap.pop( handles[ i ] );
+        }
+        numErrors += testMap.size() != NUM_TESTS/2;
+
+        for ( int i = 0; i < NUM_TESTS; ++i ) {
+            const tracked* item = testMap.getData( handles[ i ] );
+            numErrors += (i % 2) ? (!item || item->value != i) : (item != nullptr);
+        }
+
+        // stale handles stay stale after their slots are reused
+        const handle_t stale = handles[ 0 ];
+        numErrors += testMap.pop( stale );
+        for ( int i = 0; i < NUM_TESTS; i += 2 ) {
+            handles[ i ] = testMap.push( tracked( -i ) );
+        }
+        numErrors += testMap.hasData( stale ) || testMap.getData( handles[ 0 ] )->value != 0;
+
+        // the dense array can be walked directly
+        long long sum = 0;
+        for ( int i = 0; i < testMap.size(); ++i ) {
+            sum += testMap[ i ].value;
+            numErrors += testMap.getData( testMap.getHandle( i ) ) != &testMap[ i ];
+        }
+        numErrors += sum != NUM_TESTS/2;
+
+        // copies keep handles valid
+        slotMap< tracked, handle_t > copyMap( testMap );
+        numErrors += copyMap.size() != testMap.size();
+        numErrors += copyMap.getData( handles[ 5 ] )->value != 5;
+
+        slotMap< tracked, handle_t > moveMap( std::move( copyMap ) );
+        numErrors += !copyMap.empty() || moveMap.getData( handles[ 6 ] )->value != -6;
+
+        moveMap.clear();
+        numErrors += !moveMap.empty() || moveMap.hasData( handles[ 5 ] );
+        numErrors += !testMap.hasData( handles[ 5 ] );
+    }
+
+    // a slot which is reused over and over never hands out a live handle twice
+    {
+        slotMap< int, handle_t > churnMap;
+        const handle_t first = churnMap.push( 0 );
+        handle_t prev = first;
+
+        for ( int i = 1; i < 10000; ++i ) {
+            churnMap.pop( prev );
+            prev = churnMap.push( i );
+            numErrors += churnMap.hasData( first ) || *churnMap.getData( prev ) != i;
+        }
+    }
+
+    numErrors += tracked::numAlive != 0;
+    return numErrors;
+}
+
+/******************************************************************************
+ * Slot Limit Test
+ * 32-bit handles have 20 index bits, and the highest index ends the free slot
+ * list, so only 2^20-1 slots can be handed out.
+******************************************************************************/
+unsigned testSlotLimit() {
+    const int maxSlots = (1 << 20) - 1;
+    unsigned numErrors = 0;
+    slotMap< int > ids;
+    array< std::uint32_t > handles;
+
+    for ( int i = 0; i < maxSlots; ++i ) {
+        handles.pushBack( ids.push( i ) );
+    }
+
+    bool limitCaught = false;
+    try {
+        ids.push( maxSlots );
+    }
+    catch ( hamLibs::utils::error_t ) {
+        limitCaught = true;
+    }
+    numErrors += !limitCaught || ids.size() != maxSlots;
+
+    // popped slots, including the highest one, are all reused
+    for ( int i = 0; i < 1000; ++i ) {
+        numErrors += !ids.pop( handles[ i ] );
+    }
+    numErrors += !ids.pop( handles[ maxSlots - 1 ] );
+
+    for ( int i = 0; i < 1001; ++i ) {
+        numErrors += !ids.hasData( ids.push( -i ) );
+    }
+    numErrors += ids.size() != maxSlots;
+
+    return numErrors;
+}
+
+void testSlotMaps() {
+    std::cout << "\nTESTING SLOT MAP" << "\n";
+
+    unsigned numErrors = testSlotMap< std::uint32_t >() + testSlotMap< std::uint64_t >();
+    numErrors += testSlotLimit();
+
+    std::cout << "Slot Map Errors: " << numErrors << "\n\n";
+}
+
+/******************************************************************************
+ * Removal Benchmark
+ * Removes objects by identity, either by searching and shifting an array or
+ * through the handles of a slot map.
+******************************************************************************/
+void removalBench() {
+    std::cout << "Running removal benchmarks." << std::endl;
+
+    const int numItems = NUM_TESTS / 4;
+    long long checksum = 0;
+    hr_time t1, t2;
+
+    t1 = hr_clock::now();
+    for ( unsigned i = 0; i < NUM_ITERATIONS / 16; ++i ) {
+        array< int > ids;
+        for ( int j = 0; j < numItems; ++j ) {
+            ids.pushBack( j );
+        }
+
+        // removing by index invalidates every later index, so look objects up
+        for ( int j = 0; j < numItems; j += 3 ) {
+            for ( int k = 0; k < ids.size(); ++k ) {
+                if ( ids[ k ] == j ) {
+                    ids.pop( k );
+                    break;
+                }
+            }
+        }
+        checksum += ids.size();
+    }
+    t2 = hr_clock::now();
+
+    std::cout
+        << "array<int> search & pop:\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / (double(NUM_ITERATIONS / 16) * numItems)
+        << " ns/item\t" << checksum << '\n';
+
+    checksum = 0;
+    array< std::uint32_t > handles;
+    handles.resize( numItems );
+
+    t1 = hr_clock::now();
+    for ( unsigned i = 0; i < NUM_ITERATIONS / 16; ++i ) {
+        slotMap< int > ids;
+        for ( int j = 0; j < numItems; ++j ) {
+            handles[ j ] = ids.push( j );
+        }
+
+        for ( int j = 0; j < numItems; j += 3 ) {
+            ids.pop( handles[ j ] );
+        }
+        checksum += ids.size();
+    }
+    t2 = hr_clock::now();
+
+    std::cout
+        << "slotMap<int> pop:\t\t"
+        << chrono::duration_cast< chrono::nanoseconds >( t2 - t1 ).count() / (double(NUM_ITERATIONS / 16) * numItems)
+        << " ns/item\t" << checksum << '\n';
+
+    std::cout << '\n';
+}
+
+/******************************************************************************
+ * Main
+******************************************************************************/
+int main() {
+    testSlotMaps();
+    removalBench();
+}
@@ -0,0 +1,85 @@
+// helpers shared by the container tests
+// Each test is built from a single source file, so the counters below are
+// defined here rather than in a separate translation unit.
+
+#ifndef __HL_TEST_UTILS_H__
+#define __HL_TEST_UTILS_H__
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+#include "utils/allocator.h"
+
+/******************************************************************************
+ * Element type which counts its copies and live instances
+ * Moving an element leaves -1 in the source.
+******************************************************************************/
+struct tracked {
+    static int numCopies;
+    static int numAlive;
+
+    int value;
+
+    tracked( int v = 0 ) : value( v ) { ++numAlive; }
+    tracked( const tracked& t ) : value( t.value ) { ++numCopies; ++numAlive; }
+    tracked( tracked&& t ) : value( t.value ) { t.value = -1; ++numAlive; }
+    ~tracked() { --numAlive; }
+
+    tracked& operator=( const tracked& t ) { value = t.value; ++numCopies; return *this; }
+    tracked& operator=( tracked&& t ) { value = t.value; t.value = -1; return *this; }
+
+    bool operator==( const tracked& t ) const { return value == t.value; }
+    bool operator!=( const tracked& t ) const { return value != t.value; }
+};
+
+int tracked::numCopies = 0;
+int tracked::numAlive = 0;
+
+/******************************************************************************
+ * Memory resource which counts every allocation passed through it
+******************************************************************************/
+class countingResource final : public hamLibs::utils::memoryResource {
+    public:
+        unsigned    numAllocs   = 0;
+        unsigned    numFrees    = 0;
+        std::size_t numBytes    = 0; // bytes currently outstanding
+
+        void* allocate( std::size_t n, std::size_t alignment ) override {
+            ++numAllocs;
+            numBytes += n;
+            return hamLibs::utils::heapResource::get()->allocate( n, alignment );
+        }
+
+        void deallocate( void* p, std::size_t n, std::size_t alignment ) override {
+            ++numFrees;
+            numBytes -= n;
+            hamLibs::utils::heapResource::get()->deallocate( p, n, alignment );
+        }
+
+        void reset() { numAllocs = numFrees = 0; numBytes = 0; }
+};
+
+/******************************************************************************
+ * Benchmark runner
+ * Prints the average time per item over every run, along with a checksum of
+ * the results so the work can't be optimized away.
+******************************************************************************/
+template < typename func_t >
+void runBench( const char* name, unsigned numRuns, int numItems, func_t func ) {
+    typedef std::chrono::steady_clock bench_clock;
+    long long checksum = 0;
+
+    const bench_clock::time_point t1 = bench_clock::now();
+    for ( unsigned i = 0; i < numRuns; ++i ) {
+        checksum += func();
+    }
+    const bench_clock::time_point t2 = bench_clock::now();
+
+    std::cout
+        << name << ":\t"
+        << std::chrono::duration_cast< std::chrono::nanoseconds >( t2 - t1 ).count() / (double(numRuns) * numItems)
+        << " ns/item\t" << checksum << '\n';
+}
+
+#endif /* __HL_TEST_UTILS_H__ */